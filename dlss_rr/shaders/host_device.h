@@ -54,7 +54,72 @@ START_BINDING(SceneBindings)
 END_BINDING();
 
 START_BINDING(RtxBindings)
-  eTlas
+  eTlas,
+  eCostStats
+END_BINDING();
+
+// Set 4, owned by each OctahedralEnv like set 3 by each HdrIbl
+START_BINDING(EnvOctBindings)
+  eOctahedral
+END_BINDING();
+
+// Set 1 of the FusedPresent pipeline, set 0 is ImGui's texture
+START_BINDING(PresentBindings)
+  eTonemapper
+END_BINDING();
+
+// Push descriptors of hdr_display.slang
+START_BINDING(HdrDisplayBindings)
+  eHdrInput,
+  eHdrOutput
+END_BINDING();
+
+// Push descriptors of indirect_rate.slang
+START_BINDING(IndirectRateBindings)
+  eRateDenoised,
+  eRateViewZ,
+  eRateNormal,
+  eRateColor,
+  eRateSpecHitDist,
+  eRateTiles,
+  eRateIndirect,
+  eRateStats
+END_BINDING();
+
+// Push descriptors of stereo_reuse.slang
+START_BINDING(StereoReuseBindings)
+  eStereoColor,
+  eStereoViewZ,
+  eStereoSpecHitDist,
+  eStereoSource,
+  eStereoResult,
+  eStereoStats
+END_BINDING();
+
+// Push descriptors of reference_accum.slang
+START_BINDING(ReferenceBindings)
+  eReferenceColor,
+  eReferenceSum
+END_BINDING();
+
+START_BINDING(GuideStatsBindings)
+  eGuideImage,
+  eGuidePartials
+END_BINDING();
+
+START_BINDING(ReprojectionBindings)
+  eCurViewZ,
+  eCurNormal,
+  eCurAlbedo,
+  eCurMotion,
+  ePrevViewZ,
+  ePrevNormal,
+  ePrevAlbedo,
+  eNextViewZ,
+  eNextNormal,
+  eNextAlbedo,
+  eReprojError,
+  eReprojStats
 END_BINDING();
 
 START_BINDING(DlssBindings)
@@ -85,7 +150,222 @@ struct Light
 #define FLAGS_ENVMAP_SKY BIT(0)
 #define FLAGS_USE_PSR BIT(1)
 #define FLAGS_USE_PATH_REGULARIZATION BIT(2)
+#define FLAGS_COST_ATTRIBUTION BIT(3)
+#define FLAGS_ENV_OCTAHEDRAL BIT(4)     // the HDR environment is sampled from its octahedral copy, see env_octahedral.slang
+#define FLAGS_INDIRECT_RATE BIT(5)      // indirect paths are traced at the rate of their tile, see indirect_rate.slang
+#define FLAGS_FOVEATION BIT(6)          // indirect paths are traced at a rate falling off around the gaze, see Foveation
+#define FLAGS_STEREO_REUSE BIT(7)       // second eye: the first eye's shading is reused where it sees the same surface
+#define FLAGS_HIT_RECORDS BIT(8)        // the hit shaders take the render node's material from their HitRecord
+#define FLAGS_COMPACT_MATERIALS BIT(9)  // materials are evaluated from their CompactMaterial, see material_table.slang
 
+// Per-material and per-instance shader clock counters, accumulated by the hit shaders.
+// The 64 bit cycle count is split in two words, so we get away with 32 bit atomics.
+// Entries [0, costInstanceOffset) are materials, followed by one entry per render node.
+struct CostCounter
+{
+  uint cyclesLo;
+  uint cyclesHi;
+  uint invocations;
+  uint pad;
+};
+
+// Guide buffer statistics, see guide_stats.slang and GuideStats on the host side.
+// Each of the GUIDE_STATS_GROUPS workgroups reduces a strided subset of the pixels of one guide buffer into one
+// GuideStatsPartial; the host sums the partials.
+#define GUIDE_STATS_GROUPS 64
+#define GUIDE_STATS_GROUP_SIZE 256
+
+#define GUIDE_CHECK_UNIT_NORMAL BIT(0)  // xyz must be unit length or zero
+#define GUIDE_CHECK_ZERO_RGB BIT(1)     // 'special' counts pixels with rgb == 0 (e.g. zero albedo)
+#define GUIDE_CHECK_SATURATED BIT(2)    // 'special' counts pixels with |x| >= saturateValue (e.g. ViewZ at infinity)
+
+struct GuideStatsPushConstant
+{
+  float4 rangeMin;  // valid range per channel, values outside count as out of range
+  float4 rangeMax;
+  int2   size;      // region of the buffer that was rendered
+  uint   channels;  // number of meaningful channels
+  uint   checks;    // GUIDE_CHECK_*
+  uint   partialOffset;
+  float  saturateValue;
+  float  normalTolerance;
+  uint   pad;
+};
+
+struct GuideStatsPartial
+{
+  float4 minValue;  // over finite pixels only
+  float4 maxValue;
+  float4 sum;
+  uint   finite;  // pixels without NaN/Inf in any channel
+  uint   nan;
+  uint   inf;
+  uint   outOfRange;
+  uint   special;
+  uint   pad0;
+  uint   pad1;
+  uint   pad2;
+};
+
+// Motion vector reprojection analysis, see reprojection.slang and ReprojectionAnalyzer on the host side.
+// Errors are clamped to [0,1] and summed in fixed point, split in two words for 32 bit atomics.
+#define REPROJECTION_FIXED_POINT 1024.0
+
+struct ReprojectionStats
+{
+  uint valid;      // pixels reprojected onto a previous surface
+  uint offscreen;  // previous position outside the image
+  uint sky;        // current or previous pixel without surface
+  uint bad;        // any error above its tolerance
+  uint depthLo;
+  uint depthHi;
+  uint normalLo;
+  uint normalHi;
+  uint albedoLo;
+  uint albedoHi;
+  uint pad0;
+  uint pad1;
+};
+
+// GPU TLAS instance generation, see instance_gen.slang and InstanceGenerator on the host side
+#define INSTANCE_GEN_GROUP_SIZE 256
+
+// InstanceID() of the per-frame instances: render primitive, LOD level and proxy bit
+#define INSTANCE_PRIM_MASK (BIT(21) - 1)
+#define INSTANCE_LOD_SHIFT 21
+#define INSTANCE_LOD_MASK 3
+
+// Geometry streaming, see GeometryStreamer: a render primitive whose BLAS isn't resident is traced with a
+// proxy. Its BLAS address has the low bit set (addresses are 256 byte aligned) and the instance gets
+// INSTANCE_PROXY_BIT in InstanceID().
+#define BLAS_ADDRESS_PROXY_BIT 1
+#define INSTANCE_PROXY_BIT BIT(23)
+
+// Stochastic LOD, see MeshLods: every render node has one instance per level. The 8 mask bits of an instance
+// are the share of rays that see this level, each ray tests one random bit.
+#define MAX_LOD_LEVELS 4
+
+// Alias table entry of a texel of the octahedral environment: the texel is picked with probability 'q',
+// 'alias' otherwise
+struct EnvAliasEntry
+{
+  uint  alias;
+  float q;
+};
+
+// Simplified triangles (proxy, LOD level), indexing the render primitive's vertices
+struct SimplifiedPrimitive
+{
+  uint3* indices;
+  uint   triangleCount;
+  uint   pad0;
+};
+
+// Compact per-instance description, one per render node
+struct InstanceDesc
+{
+  float4 row0;  // world matrix, row major 3x4 like VkTransformMatrixKHR
+  float4 row1;
+  float4 row2;
+  uint   renderPrimID;  // selects the BLAS and becomes InstanceID()
+  uint   mask;
+  uint   flags;      // VkGeometryInstanceFlagsKHR
+  uint   sbtOffset;  // first hit group of the render node's HitRecords, 0 without
+};
+
+// Shader binding table data of the hit groups of one render node, so that a hit doesn't chase renderNodes[] to
+// materials[]: each render node has its own copy of the primary and secondary hit group, selected by the instance's
+// SBT offset. Only the per-frame TLAS of InstanceGenerator sets these offsets, and only up to HIT_RECORD_MAX_NODES
+// render nodes, which bounds the pipeline's group count.
+#define HIT_RECORD_GROUPS 2  // SBTOFFSET_PRIMARY and SBTOFFSET_SECONDARY
+#define HIT_RECORD_MAX_NODES 4096
+
+struct HitRecord
+{
+  float4 baseColorFactor;   // pbrBaseColorFactor, or pbrDiffuseFactor of spec-gloss materials: the alpha test
+  uint   materialIndex;     // GltfRenderNode::materialID, never negative
+  uint   alphaMode;         // AlphaMode
+  float  alphaCutoff;
+  int    baseColorTexture;  // GltfTextureInfo of the alpha, -1 without
+};
+
+// One cache line copy of a GltfShadeMaterial, see MaterialTable. It holds the factors of the core glTF material and
+// its five textures; every extension is implied at its neutral value, so that the shader compiler folds their code
+// away when evaluating the decoded material. Materials that don't fit are marked COMPACT_MATERIAL_FALLBACK and
+// evaluated from the scene's materials.
+#define COMPACT_MATERIAL_FALLBACK BIT(0)
+#define COMPACT_MATERIAL_ALPHA_SHIFT 1  // AlphaMode, 2 bits
+#define COMPACT_MATERIAL_NO_TEXTURE 0xFFFF
+
+struct CompactMaterial
+{
+  float4 baseColorFactor;
+  float3 emissiveFactor;
+  float  roughnessFactor;
+  float  metallicFactor;
+  float  normalTextureScale;
+  float  ior;
+  float  alphaCutoff;
+  float  occlusionStrength;
+  uint   flags;                   // COMPACT_MATERIAL_* and the alpha mode : 16, occlusionTexture : 16
+  uint   baseColorTextures;       // pbrBaseColorTexture : 16, pbrMetallicRoughnessTexture : 16
+  uint   normalEmissiveTextures;  // normalTexture : 16, emissiveTexture : 16
+};
+
+// Same layout as VkAccelerationStructureInstanceKHR
+struct TlasInstance
+{
+  float4 row0;
+  float4 row1;
+  float4 row2;
+  uint   customIndexAndMask;  // instanceCustomIndex:24, mask:8
+  uint   sbtOffsetAndFlags;   // instanceShaderBindingTableRecordOffset:24, flags:8
+  uint2  blasAddress;
+};
+
+// Stereo shading reuse, see stereo_reuse.slang and StereoReuse on the host side. The second eye's ray generation
+// puts each of its pixels in one of these classes.
+#define STEREO_SKY 0
+#define STEREO_REUSED 1          // shading of the first eye
+#define STEREO_VALIDATED 2       // reusable, shaded anyway to measure the error of the reuse
+#define STEREO_DISOCCLUDED 3     // the first eye sees another surface there
+#define STEREO_OFFSCREEN 4       // outside of the first eye's image
+#define STEREO_VIEW_DEPENDENT 5  // mirror or glossy surface, always shaded
+#define STEREO_CLASSES 6
+#define STEREO_FIXED_POINT 1024.0
+
+// Per pixel of the first eye
+struct StereoSource
+{
+  float3 radiance;  // noisy color, as given to DLSS_RR
+  float  viewZ;
+  float  specHitDist;
+  uint   pad0;
+  uint   pad1;
+  uint   pad2;
+};
+
+struct StereoReuseStats
+{
+  uint pixels[STEREO_CLASSES];  // per STEREO_* class
+  uint depthErrorSum;           // relative ViewZ difference of the reused and validated pixels, fixed point
+  uint lumErrorSum;             // relative luminance difference of the validated pixels, fixed point
+};
+
+struct StereoReusePushConstant
+{
+  int2 size;  // rendered region
+  uint pad0;
+  uint pad1;
+};
+
+// Sum of the noisy color over a range of frame indices, see reference_accum.slang and ReferenceAccumulator
+struct ReferencePushConstant
+{
+  int2 size;  // rendered region
+  uint pad0;
+  uint pad1;
+};
 
 struct FrameInfo
 {
@@ -95,9 +375,18 @@ struct FrameInfo
   float4x4 projInv;
   float4x4 prevMVP;
   float4   envIntensity;
+  float4   foveation;  // gaze position, inner and outer radius in render pixels; only with FLAGS_FOVEATION
   float2   jitter;
   float    envRotation;
   uint     flags;  // beware std430 layout requirements
+  // Only with FLAGS_STEREO_REUSE
+  float4x4      stereoSourceMVP;       // projection * view of the first eye
+  StereoSource* stereoSource;          // per pixel of the first eye
+  float4*       stereoResult;          // per pixel: STEREO_* class, relative depth and luminance error
+  float         stereoDepthTolerance;  // relative ViewZ difference up to which both eyes see the same surface
+  float         stereoMinRoughness;    // smoother surfaces are shaded, their reflections depend on the eye
+  uint          stereoValidation;      // one of this many reusable pixels is shaded anyway; 0: none
+  uint          pad0;
 #if NB_LIGHTS > 0
   Light light[NB_LIGHTS];
 #endif
@@ -114,9 +403,90 @@ struct RtxPushConstant
   int2  mouseCoord;
   float bitangentFlip;
 
-  FrameInfo*             frameInfo;  // Camera info
-  SkyPhysicalParameters* skyParams;  // Sky physical parameters
-  GltfScene*             gltfScene;  // GLTF scene
+  FrameInfo*             frameInfo;         // Camera info
+  SkyPhysicalParameters* skyParams;         // Sky physical parameters
+  GltfScene*             gltfScene;         // GLTF scene
+  SimplifiedPrimitive*   proxies;           // per render primitive, only with geometry streaming
+  SimplifiedPrimitive*   lods;              // per LOD level above 0 and render primitive, only with LODs
+  EnvAliasEntry*         envAlias;          // per texel of the octahedral environment, only with FLAGS_ENV_OCTAHEDRAL
+  uint*                  indirectRates;     // INDIRECT_RATE_* per tile of the previous frame, only with FLAGS_INDIRECT_RATE
+  float4*                indirectRadiance;  // per pixel, see indirect_rate.slang; with FLAGS_INDIRECT_RATE or FLAGS_FOVEATION
+  CompactMaterial*       compactMaterials;  // per material, only with FLAGS_COMPACT_MATERIALS
+
+  uint  costInstanceOffset;  // First per-instance entry in the cost counters
+  uint  lodLevels;           // 1: no LODs, all rays see everything
+  uint  lodInstanceStride;   // render nodes; the instances of LOD level k start at k * lodInstanceStride
+  uint  numRenderPrims;      // stride of the LOD levels in 'lods'
+  uint  envOctSize;          // width and height of the octahedral environment
+  float envSecondaryLod;     // mip level the secondary rays' misses read the octahedral environment at
+  int2  tileOffset;          // first pixel of the launch, see TileDispatch
+  int2  renderSize;          // pixels of the whole frame, the launch may cover a tile of it
+};
+
+struct ReprojectionPushConstant
+{
+  FrameInfo* frameInfo;        // current camera, prevMVP and jitter
+  int2       size;
+  float      depthTolerance;   // relative ViewZ difference
+  float      normalTolerance;  // 1 - cos(angle)
+  float      albedoTolerance;  // max. channel difference
+  uint       pad0;
+};
+
+// Variable rate indirect tracing, see indirect_rate.slang and IndirectRate on the host side. Tiles of
+// INDIRECT_RATE_TILE^2 pixels trace the indirect path in every pixel, every 2nd or every 4th one.
+#define INDIRECT_RATE_TILE 8
+#define INDIRECT_RATE_FULL 0
+#define INDIRECT_RATE_HALF 1
+#define INDIRECT_RATE_QUARTER 2
+#define INDIRECT_RATE_FIXED_POINT 1024.0
+
+struct IndirectRateStats
+{
+  uint fullTiles;
+  uint halfTiles;
+  uint quarterTiles;
+  uint skippedPixels;  // expected in the next frame, sky not excluded
+  uint errorSamples;   // traced pixels predicted from their traced neighbors
+  uint errorSum;       // relative luminance error of the predictions, fixed point
+  uint pad0;
+  uint pad1;
+};
+
+struct IndirectRatePushConstant
+{
+  int2  size;  // rendered region
+  int2  tiles;
+  float threshold;  // complexity below which a tile drops to half rate, a quarter of it to quarter rate
+  uint  frame;
+};
+
+// HDR display mapping, see hdr_display.slang and HdrDisplay on the host side
+#define HDR_DISPLAY_HDR10 1  // BT.2020 primaries, ST 2084 (PQ) encoded, in A2B10G10R10_UNORM
+#define HDR_DISPLAY_SCRGB 2  // BT.709 primaries, linear with 1.0 = 80 nits, in R16G16B16A16_SFLOAT
+
+struct HdrDisplayPushConstant
+{
+  int2  size;
+  int   mode;            // HDR_DISPLAY_*
+  float exposure;        // scene linear multiplier, as the SDR tonemapper's
+  float paperWhiteNits;  // luminance of a scene value of 1.0
+  float peakNits;        // highlights roll off towards it
+  float kneeNits;        // start of the roll off, below it the mapping is linear
+  uint  pad0;
+};
+
+struct InstanceGenPushConstant
+{
+  InstanceDesc* descs;
+  float4*       primBounds;     // local bounding sphere per render primitive, radius < 0 for unknown
+  uint2*        blasAddresses;  // per LOD level and render primitive
+  TlasInstance* instances;
+  float4        cameraCull;     // camera position, cull distance (0: no culling)
+  uint          count;          // render nodes, each has one instance per LOD level
+  uint          numRenderPrims;
+  uint          lodLevels;      // 1: LOD 0 only
+  float         lodThreshold;   // bounding sphere radius / distance below which LOD 1 fades in, 0: LOD 0 only
 };
 
 #ifdef __cplusplus
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "benchmark.hpp"
+
+#include <nvutils/logger.hpp>
+#include <nvutils/parameter_registry.hpp>
+
+#include <fstream>
+
+
+void Benchmark::registerParameters(nvutils::ParameterRegistry& registry, Settings& settings)
+{
+  registry.add({"benchmark", "Run the given number of frames, write a JSON report and exit"}, &settings.frames);
+  registry.add({"benchmarkWarmup", "Frames rendered before measuring"}, &settings.warmupFrames);
+  registry.add({"benchmarkOutput", "Benchmark report file"}, &settings.output);
+}
+
+Benchmark::Event Benchmark::advance()
+{
+  if(!isActive())
+  {
+    return Event::eNone;
+  }
+
+  m_frame++;
+  if(m_frame == m_settings.warmupFrames)
+  {
+    return Event::eWarmupDone;
+  }
+  if(m_frame == m_settings.warmupFrames + m_settings.frames)
+  {
+    m_done = true;
+    return Event::eDone;
+  }
+  return Event::eNone;
+}
+
+bool Benchmark::writeReport(nlohmann::json report) const
+{
+  report["benchmark"] = {{"frames", m_settings.frames}, {"warmup_frames", m_settings.warmupFrames}};
+
+  std::ofstream file(m_settings.output);
+  if(!file)
+  {
+    LOGE("Could not write %s\n", m_settings.output.string().c_str());
+    return false;
+  }
+  file << report.dump(2);
+  LOGI("Benchmark report written to %s\n", m_settings.output.string().c_str());
+  return true;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <tinygltf/json.hpp>
+
+#include <filesystem>
+
+namespace nvutils {
+class ParameterRegistry;
+}
+
+
+// Benchmark runs a fixed number of frames after a warm-up and writes a JSON report, then the sample exits.
+// The report content is provided by the sample; Benchmark only sequences the run and adds the run settings.
+class Benchmark
+{
+public:
+  struct Settings
+  {
+    int                   frames       = 0;  // 0: disabled
+    int                   warmupFrames = 32;
+    std::filesystem::path output       = "benchmark.json";
+  };
+
+  enum class Event
+  {
+    eNone,
+    eWarmupDone,  // statistics collected so far should be discarded
+    eDone,        // write the report and exit
+  };
+
+  // Registers --benchmark, --benchmarkWarmup and --benchmarkOutput
+  static void registerParameters(nvutils::ParameterRegistry& registry, Settings& settings);
+
+  void init(const Settings& settings) { m_settings = settings; }
+
+  bool            isActive() const { return m_settings.frames > 0 && !m_done; }
+  const Settings& settings() const { return m_settings; }
+
+  // Call once per rendered frame
+  Event advance();
+  // Runs again from the warm-up, e.g. with other settings
+  void restart()
+  {
+    m_frame = 0;
+    m_done  = false;
+  }
+
+  // Writes 'report' together with the run settings to the output file
+  bool writeReport(nlohmann::json report) const;
+
+private:
+  Settings m_settings;
+  int      m_frame = 0;
+  bool     m_done  = false;
+};
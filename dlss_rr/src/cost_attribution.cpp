@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "cost_attribution.hpp"
+
+#include <imgui/imgui.h>
+
+#include <nvgui/file_dialog.hpp>
+#include <nvutils/logger.hpp>
+#include <nvvk/check_error.hpp>
+#include <nvvk/debug_util.hpp>
+
+#include <tinygltf/json.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <numeric>
+
+
+CostAttribution::~CostAttribution()
+{
+  assert(m_counters.buffer == VK_NULL_HANDLE && "Must call deinit");
+}
+
+void CostAttribution::init(nvvk::ResourceAllocator* alloc, uint32_t frameCycleSize)
+{
+  m_alloc          = alloc;
+  m_frameCycleSize = frameCycleSize;
+
+  // Dummy counter, so the descriptor is valid before a scene is loaded
+  NVVK_CHECK(m_alloc->createBuffer(m_counters, sizeof(shaderio::CostCounter),
+                                   VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_2_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_2_TRANSFER_DST_BIT));
+  NVVK_DBG_NAME(m_counters.buffer);
+  m_readback.init(m_alloc, m_counters.bufferSize, m_frameCycleSize);
+}
+
+void CostAttribution::deinit()
+{
+  m_readback.deinit();
+  m_alloc->destroyBuffer(m_counters);
+  m_materials.clear();
+  m_instances.clear();
+}
+
+void CostAttribution::setScene(const nvvkgltf::Scene& scene)
+{
+  const tinygltf::Model&                   model       = scene.getModel();
+  const std::vector<nvvkgltf::RenderNode>& renderNodes = scene.getRenderNodes();
+
+  m_materials.clear();
+  m_instances.clear();
+
+  // There is always at least one (default) material in the shading material buffer
+  const size_t numMaterials = std::max<size_t>(1, model.materials.size());
+  for(size_t i = 0; i < numMaterials; ++i)
+  {
+    Entry entry;
+    entry.id   = int32_t(i);
+    entry.name = (i < model.materials.size() && !model.materials[i].name.empty()) ? model.materials[i].name :
+                                                                                     "Material " + std::to_string(i);
+    m_materials.push_back(entry);
+  }
+
+  for(size_t i = 0; i < renderNodes.size(); ++i)
+  {
+    const nvvkgltf::RenderNode& renderNode = renderNodes[i];
+    const tinygltf::Node&       node       = model.nodes[renderNode.refNodeID];
+
+    Entry entry;
+    entry.id           = int32_t(i);
+    entry.name         = node.name.empty() ? "Node " + std::to_string(renderNode.refNodeID) : node.name;
+    entry.materialName = m_materials[std::max(0, renderNode.materialID)].name;
+    m_instances.push_back(entry);
+  }
+
+  m_materialOrder.resize(m_materials.size());
+  std::iota(m_materialOrder.begin(), m_materialOrder.end(), 0);
+  m_instanceOrder.resize(m_instances.size());
+  std::iota(m_instanceOrder.begin(), m_instanceOrder.end(), 0);
+
+  // Resize the counter buffer; the caller has to re-write the descriptor
+  m_readback.deinit();
+  m_alloc->destroyBuffer(m_counters);
+
+  const VkDeviceSize size = sizeof(shaderio::CostCounter) * (m_materials.size() + m_instances.size());
+  NVVK_CHECK(m_alloc->createBuffer(m_counters, size,
+                                   VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_2_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_2_TRANSFER_DST_BIT));
+  NVVK_DBG_NAME(m_counters.buffer);
+  m_readback.init(m_alloc, size, m_frameCycleSize);
+
+  m_frames = 0;
+}
+
+void CostAttribution::accumulate(const shaderio::CostCounter* counters, std::vector<Entry>& entries, uint32_t offset)
+{
+  for(size_t i = 0; i < entries.size(); ++i)
+  {
+    const shaderio::CostCounter& c = counters[offset + i];
+    entries[i].cycles += (uint64_t(c.cyclesHi) << 32) | uint64_t(c.cyclesLo);
+    entries[i].invocations += c.invocations;
+  }
+}
+
+void CostAttribution::readResults(uint32_t cycleIndex)
+{
+  const auto* counters = m_readback.map<shaderio::CostCounter>(cycleIndex);
+  if(counters == nullptr || !m_enabled)
+  {
+    return;
+  }
+  // Submissions that don't read back (disabled, or the first slices of a tiled frame) leave the slot as it was
+  m_readback.consume(cycleIndex);
+
+  // Every hit counts once in the material entries
+  uint64_t cycles = 0, invocations = 0;
+  for(uint32_t i = 0; i < instanceOffset(); ++i)
+  {
+    cycles += (uint64_t(counters[i].cyclesHi) << 32) | uint64_t(counters[i].cyclesLo);
+    invocations += counters[i].invocations;
+  }
+  m_lastCyclesPerHit = invocations ? double(cycles) / double(invocations) : 0.0;
+
+  accumulate(counters, m_materials, 0);
+  accumulate(counters, m_instances, instanceOffset());
+  m_frames++;
+}
+
+void CostAttribution::cmdClear(VkCommandBuffer cmd)
+{
+  vkCmdFillBuffer(cmd, m_counters.buffer, 0, VK_WHOLE_SIZE, 0);
+
+  const VkMemoryBarrier2 barrier{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                 .srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                 .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                 .dstStageMask  = VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
+                                 .dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT};
+  const VkDependencyInfo depInfo{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &barrier};
+  vkCmdPipelineBarrier2(cmd, &depInfo);
+}
+
+void CostAttribution::cmdReadback(VkCommandBuffer cmd, uint32_t cycleIndex)
+{
+  const VkMemoryBarrier2 barrier{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                 .srcStageMask  = VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
+                                 .srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                                 .dstStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                 .dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT};
+  const VkDependencyInfo depInfo{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &barrier};
+  vkCmdPipelineBarrier2(cmd, &depInfo);
+
+  m_readback.cmdCopy(cmd, m_counters.buffer, cycleIndex);
+}
+
+void CostAttribution::reset()
+{
+  for(Entry& e : m_materials)
+  {
+    e.cycles = e.invocations = 0;
+  }
+  for(Entry& e : m_instances)
+  {
+    e.cycles = e.invocations = 0;
+  }
+  m_frames           = 0;
+  m_lastCyclesPerHit = 0.0;
+  // Copies recorded before the reset (or before the counters were disabled) belong to the discarded results
+  m_readback.invalidate();
+}
+
+bool CostAttribution::onUI(GLFWwindow* window)
+{
+  bool changed = ImGui::Checkbox("Enable", &m_enabled);
+  if(changed)
+  {
+    reset();
+  }
+  ImGui::SameLine();
+  if(ImGui::Button("Reset"))
+  {
+    reset();
+  }
+  ImGui::SameLine();
+  if(ImGui::Button("Export JSON"))
+  {
+    std::filesystem::path filename = nvgui::windowSaveFileDialog(window, "Export Cost Attribution", "JSON(.json)|*.json");
+    if(!filename.empty())
+    {
+      exportJson(filename);
+    }
+  }
+  ImGui::Text("Frames accumulated: %u", m_frames);
+
+  if(ImGui::TreeNodeEx("Materials", ImGuiTreeNodeFlags_DefaultOpen))
+  {
+    tableUI("MaterialCost", m_materials, m_materialOrder, false);
+    ImGui::TreePop();
+  }
+  if(ImGui::TreeNode("Instances"))
+  {
+    tableUI("InstanceCost", m_instances, m_instanceOrder, true);
+    ImGui::TreePop();
+  }
+
+  return changed;
+}
+
+void CostAttribution::tableUI(const char* tableId, const std::vector<Entry>& entries, std::vector<uint32_t>& order, bool showMaterial)
+{
+  enum Column
+  {
+    eName,
+    eMaterial,
+    eInvocations,
+    eTicks,
+    eTicksPerInvocation,
+    eShare,
+  };
+
+  uint64_t totalCycles = 0;
+  for(const Entry& e : entries)
+  {
+    totalCycles += e.cycles;
+  }
+
+  const ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_SortTristate | ImGuiTableFlags_Borders
+                                | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+  if(!ImGui::BeginTable(tableId, 6, flags, ImVec2(0, ImGui::GetTextLineHeightWithSpacing() * 12)))
+  {
+    return;
+  }
+
+  ImGui::TableSetupScrollFreeze(0, 1);
+  ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch, 0, eName);
+  ImGui::TableSetupColumn("Material", (showMaterial ? 0 : ImGuiTableColumnFlags_Disabled) | ImGuiTableColumnFlags_WidthStretch, 0, eMaterial);
+  ImGui::TableSetupColumn("Invocations", ImGuiTableColumnFlags_WidthFixed, 0, eInvocations);
+  ImGui::TableSetupColumn("Ticks", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 0, eTicks);
+  ImGui::TableSetupColumn("Ticks/Call", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 0,
+                          eTicksPerInvocation);
+  ImGui::TableSetupColumn("%", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort
+                                   | ImGuiTableColumnFlags_PreferSortDescending,
+                          0, eShare);
+  ImGui::TableHeadersRow();
+
+  auto ticksPerCall = [](const Entry& e) { return e.invocations ? double(e.cycles) / double(e.invocations) : 0.0; };
+
+  // Re-sort every frame, the values keep changing while accumulating
+  if(ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs(); sortSpecs && sortSpecs->SpecsCount > 0)
+  {
+    const ImGuiTableColumnSortSpecs& spec      = sortSpecs->Specs[0];
+    const bool                       ascending = spec.SortDirection == ImGuiSortDirection_Ascending;
+    auto less = [&](const Entry& a, const Entry& b) {
+      switch(spec.ColumnUserID)
+      {
+        case eName:
+          return a.name < b.name;
+        case eMaterial:
+          return a.materialName < b.materialName;
+        case eInvocations:
+          return a.invocations < b.invocations;
+        case eTicksPerInvocation:
+          return ticksPerCall(a) < ticksPerCall(b);
+        default:
+          return a.cycles < b.cycles;
+      }
+    };
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+      return ascending ? less(entries[a], entries[b]) : less(entries[b], entries[a]);
+    });
+  }
+
+  ImGuiListClipper clipper;
+  clipper.Begin(int(order.size()));
+  while(clipper.Step())
+  {
+    for(int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+    {
+      const Entry& e = entries[order[row]];
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(e.name.c_str());
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(e.materialName.c_str());
+      ImGui::TableNextColumn();
+      ImGui::Text("%llu", static_cast<unsigned long long>(e.invocations));
+      ImGui::TableNextColumn();
+      ImGui::Text("%llu", static_cast<unsigned long long>(e.cycles));
+      ImGui::TableNextColumn();
+      ImGui::Text("%.1f", ticksPerCall(e));
+      ImGui::TableNextColumn();
+      ImGui::Text("%.2f", totalCycles ? 100.0 * double(e.cycles) / double(totalCycles) : 0.0);
+    }
+  }
+
+  ImGui::EndTable();
+}
+
+bool CostAttribution::exportJson(const std::filesystem::path& filename) const
+{
+  using json = nlohmann::json;
+
+  auto toJson = [](const std::vector<Entry>& entries, bool withMaterial) {
+    json array = json::array();
+    for(const Entry& e : entries)
+    {
+      json j = {{"id", e.id}, {"name", e.name}, {"invocations", e.invocations}, {"ticks", e.cycles}};
+      if(withMaterial)
+      {
+        j["material"] = e.materialName;
+      }
+      array.push_back(j);
+    }
+    return array;
+  };
+
+  json root;
+  root["frames"]    = m_frames;
+  root["materials"] = toJson(m_materials, false);
+  root["instances"] = toJson(m_instances, true);
+
+  std::ofstream file(filename);
+  if(!file)
+  {
+    LOGE("Could not write %s\n", filename.string().c_str());
+    return false;
+  }
+  file << root.dump(2);
+  LOGI("Cost attribution written to %s\n", filename.string().c_str());
+  return true;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <nvvk/resource_allocator.hpp>
+#include <nvvkgltf/scene.hpp>
+
+#include "readback_ring.hpp"
+#include "shaders/host_device.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+struct GLFWwindow;
+
+
+// CostAttribution maps GPU shader time to glTF assets.
+// The closest-hit and any-hit shaders measure their duration with the shader clock and accumulate it, together
+// with an invocation count, per material and per instance (render node) into a counter buffer, see cost_stats.slang.
+// The counters are cleared every frame, read back asynchronously through a ReadbackRing and accumulated on the host.
+class CostAttribution
+{
+public:
+  struct Entry
+  {
+    std::string name;
+    std::string materialName;  // only for instances
+    int32_t     id          = 0;
+    uint64_t    cycles      = 0;  // accumulated since the last reset()
+    uint64_t    invocations = 0;
+  };
+
+  CostAttribution() = default;
+  ~CostAttribution();
+
+  void init(nvvk::ResourceAllocator* alloc, uint32_t frameCycleSize);
+  void deinit();
+
+  // (Re)creates the counter buffer and the name tables for a newly loaded scene
+  void setScene(const nvvkgltf::Scene& scene);
+
+  bool isEnabled() const { return m_enabled && m_counters.buffer != VK_NULL_HANDLE; }
+
+  // Buffer to bind at RtxBindings::eCostStats; always valid after init()
+  const nvvk::Buffer& counterBuffer() const { return m_counters; }
+  uint32_t            instanceOffset() const { return uint32_t(m_materials.size()); }
+
+  // Accumulate the counters of the frame that last used 'cycleIndex'. Call at the beginning of a frame.
+  void readResults(uint32_t cycleIndex);
+  // Clear the counters before tracing
+  void cmdClear(VkCommandBuffer cmd);
+  // Schedule the readback of this frame's counters, after tracing
+  void cmdReadback(VkCommandBuffer cmd, uint32_t cycleIndex);
+
+  // Discard the accumulated results
+  void reset();
+
+  // Shader clocks per hit shader invocation of the frame read last, for A/B measurements; 0 without results
+  double lastCyclesPerHit() const { return m_lastCyclesPerHit; }
+
+  // Returns true if the feature was toggled. 'window' is the parent of the export file dialog.
+  bool onUI(GLFWwindow* window);
+
+  bool exportJson(const std::filesystem::path& filename) const;
+
+  const std::vector<Entry>& materials() const { return m_materials; }
+  const std::vector<Entry>& instances() const { return m_instances; }
+
+private:
+  void tableUI(const char* tableId, const std::vector<Entry>& entries, std::vector<uint32_t>& order, bool showMaterial);
+  void accumulate(const shaderio::CostCounter* counters, std::vector<Entry>& entries, uint32_t offset);
+
+  nvvk::ResourceAllocator* m_alloc          = nullptr;
+  uint32_t                 m_frameCycleSize = 1;
+
+  nvvk::Buffer m_counters;
+  ReadbackRing m_readback;
+
+  // Entries are kept in counter buffer order, the tables sort these indices instead
+  std::vector<Entry>    m_materials;
+  std::vector<Entry>    m_instances;
+  std::vector<uint32_t> m_materialOrder;
+  std::vector<uint32_t> m_instanceOrder;
+  uint32_t              m_frames           = 0;  // frames accumulated
+  double                m_lastCyclesPerHit = 0.0;
+  bool                  m_enabled          = false;
+};
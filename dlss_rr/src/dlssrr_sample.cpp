@@ -56,6 +56,7 @@
 #include "nvutils/logger.hpp"
 #include "nvutils/file_operations.hpp"
 #include "nvutils/camera_manipulator.hpp"
+#include "nvutils/parameter_parser.hpp"
 
 #include "nvvk/barriers.hpp"
 #include "nvvk/gbuffers.hpp"
@@ -83,20 +84,62 @@
 #include "tonemapper.slang.h"
 #include "sky_physical.slang.h"
 #include "hdr_dome.slang.h"
+#include "guide_stats.slang.h"
+#include "reprojection.slang.h"
+#include "instance_gen.slang.h"
+#include "tonemap_present.slang.h"
+#include "hdr_display.slang.h"
+#include "indirect_rate.slang.h"
+#include "stereo_reuse.slang.h"
+#include "reference_accum.slang.h"
 
 #include "shaders/host_device.h"
 #include "nvshaders/gltf_scene_io.h.slang"
 #include "nvshaders/sky_io.h.slang"
 
 #include "dlssrr_wrapper.hpp"
+#include "cost_attribution.hpp"
+#include "pass_profiler.hpp"
+#include "perf_counters.hpp"
+#include "pipeline_stats.hpp"
+#include "benchmark.hpp"
+#include "guide_stats.hpp"
+#include "reprojection.hpp"
+#include "instance_gen.hpp"
+#include "geometry_streamer.hpp"
+#include "mesh_lod.hpp"
+#include "trace_comparison.hpp"
+#include "material_editor.hpp"
+#include "environment_loader.hpp"
+#include "stress_scene.hpp"
+#include "fused_present.hpp"
+#include "hdr_display.hpp"
+#include "indirect_rate.hpp"
+#include "foveation.hpp"
+#include "stereo_reuse.hpp"
+#include "reference_accumulator.hpp"
+#include "tiled_still.hpp"
+#include "frame_hashes.hpp"
+#include "profile_database.hpp"
+#include "tile_dispatch.hpp"
+#include "material_table.hpp"
+#include "image_readback.hpp"
 
 #include <glm/gtc/type_ptr.hpp>
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
+#include <limits>
 #include <math.h>
 #include <memory>
+#include <optional>
+#include <span>
+#include <utility>
 
 using namespace glm;
 
@@ -155,12 +198,27 @@ class DlssApplet : public nvapp::IAppElement
 
   enum OutputBufferName
   {
-    eGBufColorOut,  // denoised
-    eGBufLdr,
+    eGBufColorOut,        // denoised
+    eGBufColorOutSecond,  // denoised second eye, see StereoReuse
+    eGBufLdr,             // last: not allocated with the fused present; HDR encoded with the HDR display output
 
     eNumOutputBufferNames
   };
 
+  // Passes timed by the profiler, in recording order
+  enum ProfilerPass
+  {
+    ePassInstances,  // per-frame TLAS instances, empty with the static TLAS
+    ePassRaytrace,
+    ePassDenoise,
+    ePassStereoTrace,    // second eye, empty without stereo
+    ePassStereoDenoise,
+    ePassTonemap,
+    ePassAnalysis,   // optional guide buffer validation
+    ePassComposite,  // viewport draw in the UI rendering, timed by FusedPresent's draw callbacks
+    eNumProfilerPasses
+  };
+
   struct Settings
   {
     int       maxFrames{200000};
@@ -170,7 +228,37 @@ class DlssApplet : public nvapp::IAppElement
   } m_settings;
 
 public:
-  DlssApplet()           = default;
+  struct InitInfo
+  {
+    bool                performanceQuery   = false;  // VK_KHR_performance_query was enabled
+    bool                pipelineStatistics = false;  // VK_KHR_pipeline_executable_properties was enabled
+    bool                transferQueue      = false;  // a second queue uploads streamed geometry, else the rendering one
+    Benchmark::Settings benchmark;
+    ReferenceCoordinator::Settings reference;  // a worker's range, see ReferenceAccumulator
+    int                 instanceGeneration   = 0;  // InstanceGenerator::Mode
+    float               instanceCullDistance = 0.0f;
+    int                 geometryBudgetMB     = 0;  // > 0 streams the BLASes, see GeometryStreamer
+    int                 lodLevels            = 1;  // > 1 adds simplified levels of detail, see MeshLods
+    StressSceneSettings stressScene;                 // Reported with the scene it generated
+    bool                envOctahedral = false;       // HDR environment from its octahedral copy, see OctahedralEnv
+    bool                fusedPresent  = false;       // tonemap in the viewport composite, see FusedPresent
+    HdrDisplay::Settings hdrDisplay;                 // HDR10/scRGB output written to a file, see HdrDisplay
+    bool                indirectRate  = false;       // variable rate indirect paths, see IndirectRate
+    bool                foveation     = false;       // indirect rate falling off around the gaze, see Foveation
+    int                 gaze          = 0;           // Foveation::GazeSource
+    bool                stereo        = false;       // second eye reusing the first one's shading, see StereoReuse
+    bool                hitRecords    = true;        // hit groups per render node holding its material, see HitRecord
+    TiledStill::Settings still;                      // offline still larger than DLSS_RR outputs, see TiledStill
+    FrameHashes::Settings hashes;                    // deterministic mode and per frame image hashes, see FrameHashes
+    ProfileDatabase::Settings profiles;              // per GPU costs and the defaults chosen from them
+    TileDispatch::Settings tiles;                    // ray tracing in ordered, time sliced tiles, see TileDispatch
+    MaterialTable::Settings materials;               // one cache line records of the materials, see MaterialTable
+  };
+
+  explicit DlssApplet(const InitInfo& info)
+      : m_info(info)
+  {
+  }
   ~DlssApplet() override = default;
 
   void onAttach(nvapp::Application* app) override
@@ -202,20 +290,70 @@ public:
     m_skyEnv.init(&m_alloc, sky_physical_slang);  //void
     m_alloc.createBuffer(m_skyParamBuffer, sizeof(shaderio::SkyPhysicalParameters), VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT);
 
-    m_hdrEnv.init(&m_alloc, &m_samplerPool);  //void
+    m_env = std::make_unique<Environment>();
+    m_env->init(&m_alloc, &m_samplerPool);  //void
+    m_envOctahedral = m_info.envOctahedral;
+    m_envLoader.init(m_app, &m_alloc, &m_samplerPool);
 
+    m_costAttribution.init(&m_alloc, m_app->getFrameCycleSize());
+    m_materialEditor.init(m_app, &m_alloc);
+    m_materialTable.init(&m_alloc, m_info.materials);
+    m_hitRecordsEnabled = m_info.hitRecords;
+
+    m_profiler.init(m_device, m_app->getPhysicalDevice(), {"Instances", "Raytrace", "Denoise", "Stereo Trace", "Stereo Denoise", "Tonemap", "Analysis", "Composite"},
+                    m_app->getFrameCycleSize());
+    if(m_info.performanceQuery
+       && m_perfCounterProvider.init(m_device, m_app->getPhysicalDevice(), m_app->getQueue(0).queue, m_app->getQueue(0).familyIndex))
+    {
+      // The composite is recorded by the UI rendering, it can't be replayed
+      const std::vector<std::string>& names = m_profiler.passNames();
+      m_perfCounters.init(&m_perfCounterProvider, {names.begin(), names.begin() + ePassComposite});
+    }
+    m_fusedPresent.init(m_app, &m_alloc, tonemap_present_slang, &m_profiler, ePassComposite);
+    m_fusedPresentEnabled = m_info.fusedPresent;
+    m_hdrDisplay.init(m_app, &m_alloc, hdr_display_slang, m_info.hdrDisplay);
+    m_benchmark.init(m_info.benchmark);
+    m_guideStats.init(&m_alloc, guide_stats_slang, guideBufferChecks(), m_app->getFrameCycleSize());
+    m_instanceGen.init(&m_alloc, m_app->getPhysicalDevice(), instance_gen_slang, m_app->getFrameCycleSize());
+    m_instanceGen.setMode(InstanceGenerator::Mode(std::clamp(m_info.instanceGeneration, 0, 2)));
+    if(m_info.lodLevels > 1 && m_instanceGen.mode() == InstanceGenerator::Mode::eStatic)
+    {
+      m_instanceGen.setMode(InstanceGenerator::Mode::eGpu);  // the static TLAS has LOD 0 only
+    }
+    m_instanceGen.cullDistance = m_info.instanceCullDistance;
+    const uint32_t uploadQueue = m_info.transferQueue ? 1 : 0;
+    m_streamer.init(m_app, &m_alloc, m_app->getQueue(uploadQueue).queue, m_app->getQueue(uploadQueue).familyIndex);
+    m_streamer.settings.budget = uint64_t(std::max(m_info.geometryBudgetMB, 0)) << 20;
+    {
+      VkSampler sampler;
+      m_samplerPool.acquireSampler(sampler);
+      m_reprojection.init(&m_alloc, reprojection_slang, sampler, m_app->getTextureDescriptorPool(), m_app->getFrameCycleSize());
+    }
+    m_indirectRate.init(&m_alloc, indirect_rate_slang, m_app->getFrameCycleSize());
+    m_indirectRateEnabled = m_info.indirectRate;
+    m_foveation.enabled = m_info.foveation;
+    m_foveation.source  = Foveation::GazeSource(std::clamp(m_info.gaze, 0, 2));
+    m_stereo.init(&m_alloc, stereo_reuse_slang, m_app->getFrameCycleSize());
+    m_stereo.enabled = m_info.stereo;
+    m_reference.init(&m_alloc, reference_accum_slang, m_info.reference);
+    m_still.init(m_info.still);
+    m_tileDispatch.init(m_info.tiles, m_app->getFrameCycleSize());
+    if(!m_hashes.init(m_info.hashes))
+    {
+      exit(EXIT_FAILURE);
+    }
 
     // Requesting ray tracing properties (this can be moved into m_sbt.init()
-    VkPhysicalDeviceRayTracingPipelinePropertiesKHR rt_prop{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_PROPERTIES_KHR};
     VkPhysicalDeviceProperties2 prop2{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2};
-    prop2.pNext = &rt_prop;
+    prop2.pNext = &m_rtProperties;
     vkGetPhysicalDeviceProperties2(m_app->getPhysicalDevice(), &prop2);
 
     // Create utilities to create the Shading Binding Table (SBT)
     uint32_t gct_queue_index = m_app->getQueue(0).familyIndex;
-    m_sbt.init(m_app->getDevice(), rt_prop);  // void
+    m_sbt.init(m_app->getDevice(), m_rtProperties);  // void
 
-    m_outputSize = {app->getWindowSize().width, app->getWindowSize().height};
+    m_outputSize = m_still.isActive() ? m_still.tileSize() : glm::uvec2{app->getWindowSize().width, app->getWindowSize().height};
+    initProfileDefaults();
 
     createVulkanBuffers();
 
@@ -249,6 +387,10 @@ public:
   void onDetach() override
   {
     vkDeviceWaitIdle(m_device);
+    if(m_hdrDisplay.isHdr())
+    {
+      m_hdrDisplay.writeImage(m_outputBuffers.getColorImage(eGBufLdr), m_outputBuffers.getSize());
+    }
     destroyResources();
   }
 
@@ -257,6 +399,8 @@ public:
     vkDeviceWaitIdle(m_device);
 
     m_dlss.deinit();
+    m_dlssSecond.deinit();
+    m_tileDispatch.cancelFrame();  // the render buffers are recreated
 
     if(querySizes)
     {
@@ -272,16 +416,24 @@ public:
                                         .quality    = m_dlssQuality,
                                         .preset     = m_dlssPreset},
                                        m_dlss));
-
+    if(m_stereo.enabled)
+    {
+      NGX_ABORT_ON_FAIL(m_ngx.initDlssRR({.inputSize  = {m_renderBuffers.getSize()},
+                                          .outputSize = {m_outputSize.x, m_outputSize.y},
+                                          .quality    = m_dlssQuality,
+                                          .preset     = m_dlssPreset},
+                                         m_dlssSecond));
+    }
   }
 
-  void setDlssResources()
+  // Both eyes share the render buffers, each has its own instance and output
+  void setDlssResources(DlssRR& dlss, OutputBufferName output)
   {
     auto dlssRenderResourceFromGBufTexture = [&](DlssRR::DlssResource dlssResource, RenderBufferName gbufIndex) {
-      m_dlssBufferEnable[gbufIndex] ? m_dlss.setResource(dlssResource, m_renderBuffers.getColorImage(gbufIndex),
-                                                         m_renderBuffers.getDescriptorImageInfo(gbufIndex).imageView,
-                                                         m_renderBuffers.getColorFormat(gbufIndex)) :
-                                      m_dlss.resetResource(dlssResource);
+      m_dlssBufferEnable[gbufIndex] ? dlss.setResource(dlssResource, m_renderBuffers.getColorImage(gbufIndex),
+                                                       m_renderBuffers.getDescriptorImageInfo(gbufIndex).imageView,
+                                                       m_renderBuffers.getColorFormat(gbufIndex)) :
+                                      dlss.resetResource(dlssResource);
     };
 
     // #DLSS provide the input and guide buffers to DLSS_RR
@@ -294,10 +446,10 @@ public:
     dlssRenderResourceFromGBufTexture(DlssRR::RESOURCE_SPECULAR_HITDISTANCE, eGBufSpecHitDist);
 
     auto dlssOutputResourceFromGBufTexture = [&](DlssRR::DlssResource dlssResource, OutputBufferName gbufIndex) {
-      m_dlss.setResource(dlssResource, m_outputBuffers.getColorImage(gbufIndex),
-                         m_outputBuffers.getDescriptorImageInfo(gbufIndex).imageView, m_outputBuffers.getColorFormat(gbufIndex));
+      dlss.setResource(dlssResource, m_outputBuffers.getColorImage(gbufIndex),
+                       m_outputBuffers.getDescriptorImageInfo(gbufIndex).imageView, m_outputBuffers.getColorFormat(gbufIndex));
     };
-    dlssOutputResourceFromGBufTexture(DlssRR::RESOURCE_COLOR_OUT, eGBufColorOut);
+    dlssOutputResourceFromGBufTexture(DlssRR::RESOURCE_COLOR_OUT, output);
   }
 
   void onResize(VkCommandBuffer cmd, const VkExtent2D& size) override
@@ -308,11 +460,23 @@ public:
     // #DLSS
     // Work around a bug in DLSS_RR that causes a crash below a certain image size
     m_outputSize = glm::max({256, 256}, m_outputSize);
+    // A tiled still renders its tiles and the profile sweep its resolutions, whatever the size of the window
+    if(m_still.isActive())
+    {
+      m_outputSize = m_still.tileSize();
+    }
+    if(!m_profileSweep.empty())
+    {
+      m_outputSize = m_profileSweep[m_profileSweepIndex].outputSize;
+    }
 
     createOutputGbuffer(m_outputSize);
     reinitDlss(true);
   }
 
+  // False when frame hashes differed from the compared ones, or a reference worker couldn't write its partial
+  bool succeeded() const { return m_hashesMatch && m_referenceWritten; }
+
   void onUIMenu() override
   {
     bool load_file{false};
@@ -345,16 +509,26 @@ public:
   {
     namespace fs = std::filesystem;
 
+    auto extension = filename.extension();
+
+    // Once the ray tracing pipeline knows the environment's layout, a new one is loaded without stopping the rendering
+    if(extension == ".hdr" && m_env->hdr.getDescriptorSetLayout() != VK_NULL_HANDLE)
+    {
+      m_envFile = filename;
+      m_envLoader.load(filename, m_envOctahedral, m_envComparison.running() || m_envComparisonPending);
+      return;
+    }
+
     // Make sure none of the resources is still in use
     vkDeviceWaitIdle(m_device);
 
-    auto extension = filename.extension();
     if(extension == fs::path(".gltf") || extension == fs::path(".glb"))
     {
       createScene(filename);
     }
     else if(extension == ".hdr")
     {
+      m_envFile = filename;
       createHdr(filename);
       resetFrame();
     }
@@ -366,6 +540,25 @@ public:
   {
     using namespace nvgui;
 
+    // The next configuration of the profile sweep, before the UI refers to the output images
+    if(m_profileSweepNext)
+    {
+      m_profileSweepNext = false;
+      vkDeviceWaitIdle(m_device);
+      applyProfileConfig(m_profileSweep[m_profileSweepIndex]);
+      createOutputGbuffer(m_outputSize);
+      reinitDlss(true);
+      resetFrame();
+      m_benchmark.restart();
+    }
+    // Fused present toggled by the last UI frame, whose draw list held the old output images
+    if(m_fusedPresentNext)
+    {
+      m_fusedPresentEnabled = *std::exchange(m_fusedPresentNext, std::nullopt);
+      vkDeviceWaitIdle(m_device);
+      createOutputGbuffer(m_outputSize);  // with or without the 8 bit image
+    }
+
     bool reset{false};
     // Pick under mouse cursor
     if(ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left) || ImGui::IsKeyPressed(ImGuiKey_Space))
@@ -436,6 +629,30 @@ public:
         if(!(m_frameInfo.flags & FLAGS_ENVMAP_SKY))
         {
           PropertyEditor::entry("Rotation", [&] { return ImGui::SliderAngle("Rotation", &m_settings.envRotation); }, "Rotating the environment");
+          ImGui::BeginDisabled(m_envComparison.running() || m_envComparisonPending);
+          if(PropertyEditor::entry("Octahedral", [&] { return ImGui::Checkbox("##octahedral", &m_envOctahedral); },
+                                   "Equal-area octahedral RGBA16F copy with mips and a per texel alias table"))
+          {
+            reset = true;
+            // Built on the side like a dropped file; the octahedral copy keeps rendering until the equirectangular
+            // image it released is back. A load in progress was started for the other setting.
+            const bool stale = m_envLoader.isLoading();
+            if(m_envOctahedral && (!m_env->octahedral.isValid() || stale) && !m_envFile.empty())
+            {
+              m_envLoader.load(m_envFile, true);
+            }
+            else if(!m_envOctahedral && (!m_env->equirect || stale) && !m_envFile.empty())
+            {
+              m_envLoader.load(m_envFile, false);
+            }
+          }
+          ImGui::EndDisabled();
+          if(m_envOctahedral)
+          {
+            reset |= PropertyEditor::entry(
+                "Secondary LOD", [&] { return ImGui::SliderFloat("##envLod", &m_envSecondaryLod, 0.0f, 6.0f, "%.1f"); },
+                "Mip level the misses of the bounces read; coarser levels are smaller and fetch fewer cache lines");
+          }
         }
         else
         {
@@ -443,11 +660,75 @@ public:
         }
 
         PropertyEditor::end();
+        m_envLoader.onUI();
+        if(!(m_frameInfo.flags & FLAGS_ENVMAP_SKY))
+        {
+          octahedralEnvUI();
+        }
       }
 
       if(ImGui::CollapsingHeader("Tonemapper"))
       {
         nvgui::tonemapperWidget(m_tonemapperData);
+        presentUI();
+      }
+
+      if(ImGui::CollapsingHeader("Cost Attribution"))
+      {
+        m_costAttribution.onUI(m_app->getWindowHandle());
+      }
+
+      if(ImGui::CollapsingHeader("Profiler"))
+      {
+        profilerUI();
+      }
+
+      if(ImGui::CollapsingHeader("TLAS Instances"))
+      {
+        if(m_instanceGen.onUI())
+        {
+          // The traced TLAS changes
+          vkDeviceWaitIdle(m_device);
+          writeRtxSet();
+        }
+      }
+
+      if(ImGui::CollapsingHeader("Geometry Streaming"))
+      {
+        m_streamer.onUI();
+      }
+
+      if(ImGui::CollapsingHeader("Level of Detail"))
+      {
+        lodUI();
+      }
+      if(ImGui::CollapsingHeader("Variable Rate Indirect"))
+      {
+        indirectRateUI();
+      }
+      if(ImGui::CollapsingHeader("Foveation"))
+      {
+        foveationUI();
+      }
+      if(ImGui::CollapsingHeader("Stereo"))
+      {
+        stereoUI();
+      }
+      if(ImGui::CollapsingHeader("Tiled Dispatch"))
+      {
+        tileDispatchUI();
+      }
+      if(ImGui::CollapsingHeader("Hit Records"))
+      {
+        hitRecordUI();
+      }
+      if(ImGui::CollapsingHeader("Compact Materials"))
+      {
+        materialTableUI();
+      }
+      if(ImGui::CollapsingHeader("Material Editor"))
+      {
+        m_materialEditor.onUI(m_app->getWindowHandle());
       }
 
       if(ImGui::CollapsingHeader("DLSS RR", ImGuiTreeNodeFlags_DefaultOpen))
@@ -547,9 +828,56 @@ public:
           PropertyEditor::entry(
               "Show Buffers Scaled", [&]() { return ImGui::Checkbox("##", &m_dlssShowScaledBuffers); },
               "Whether to show the input at their native resolution or scaled to the viewport");
+
+          bool guideStats = m_guideStats.isEnabled();
+          PropertyEditor::entry(
+              "Validate Guide Buffers", [&]() { return ImGui::Checkbox("##GuideStats", &guideStats); },
+              "Count NaN/Inf and out-of-range values in the guide buffers, shown below the thumbnails");
+          m_guideStats.setEnabled(guideStats);
+
+          bool reprojection = m_reprojection.isEnabled();
+          PropertyEditor::entry(
+              "Analyze Reprojection", [&]() { return ImGui::Checkbox("##Reprojection", &reprojection); },
+              "Warp the previous ViewZ/normal/albedo with the motion vectors and measure the error");
+          m_reprojection.setEnabled(reprojection);
         }
         PropertyEditor::end();
 
+        if(m_reprojection.isEnabled() && ImGui::TreeNode("Reprojection"))
+        {
+          if(m_reprojection.onUI())
+          {
+            const ReprojectionAnalyzer::InputImages images{
+                .viewZ        = m_renderBuffers.getColorImage(eGBufViewZ),
+                .viewZFormat  = m_renderBuffers.getColorFormat(eGBufViewZ),
+                .normal       = m_renderBuffers.getColorImage(eGBufNormalRoughness),
+                .normalFormat = m_renderBuffers.getColorFormat(eGBufNormalRoughness),
+                .albedo       = m_renderBuffers.getColorImage(eGBufBaseColor_Metalness),
+                .albedoFormat = m_renderBuffers.getColorFormat(eGBufBaseColor_Metalness),
+                .motion       = m_renderBuffers.getColorImage(eGBufMotionVectors),
+                .motionFormat = m_renderBuffers.getColorFormat(eGBufMotionVectors)};
+            // Still the frame info of the last rendered frame; with stereo the buffers are the second eye's
+            m_reprojection.verifyOnCpu(m_app, images, m_stereo.enabled ? m_frameInfoSecond : m_frameInfo);
+          }
+          ImGui::TreePop();
+        }
+
+        if(m_guideStats.isEnabled() && ImGui::TreeNode("Guide Buffer Validation"))
+        {
+          if(m_guideStats.onUI())
+          {
+            std::array<VkImage, eNumRenderBufferNames>  images;
+            std::array<VkFormat, eNumRenderBufferNames> formats;
+            for(uint32_t i = 0; i < eNumRenderBufferNames; ++i)
+            {
+              images[i]  = m_renderBuffers.getColorImage(i);
+              formats[i] = m_renderBuffers.getColorFormat(i);
+            }
+            m_guideStats.verifyOnCpu(m_app, images, formats);
+          }
+          ImGui::TreePop();
+        }
+
         ImVec2 tumbnailSize = {100 * m_renderBuffers.getAspectRatio(), 100};
 
         auto showBuffer = [&](const char* name, RenderBufferName buffer, bool optional = false) {
@@ -557,7 +885,8 @@ public:
           ImGui::TableNextColumn();
           if(ImGui::ImageButton(name, (ImTextureID)m_renderBuffers.getDescriptorSet(buffer), tumbnailSize))
           {
-            m_showBuffer = buffer;
+            m_showBuffer            = buffer;
+            m_showReprojectionError = false;
           }
           if(optional)
           {
@@ -565,6 +894,7 @@ public:
             ImGui::SameLine();
           }
           ImGui::Text("%s", name);
+          m_guideStats.statsUI(buffer);
           ImGui::PopID();
         };
 
@@ -588,9 +918,20 @@ public:
           ImGui::TableNextColumn();
 
           ImGui::Text("Denoised & Tonemapped Output");
-          if(ImGui::ImageButton("Denoised", (ImTextureID)m_outputBuffers.getDescriptorSet(eGBufLdr), tumbnailSize))
+          if(m_fusedPresent.image((ImTextureID)m_outputBuffers.getDescriptorSet(presentBuffer()), tumbnailSize, fusedPresent()))
+          {
+            m_showBuffer            = eNumRenderBufferNames;
+            m_showReprojectionError = false;
+          }
+
+          if(m_reprojection.isEnabled())
           {
-            m_showBuffer = eNumRenderBufferNames;
+            ImGui::TableNextColumn();
+            ImGui::Text("Reprojection Error");
+            if(ImGui::ImageButton("Reprojection", (ImTextureID)m_reprojection.errorDescriptorSet(), tumbnailSize))
+            {
+              m_showReprojectionError = true;
+            }
           }
 
           ImGui::EndTable();
@@ -609,14 +950,35 @@ public:
       // Rendering Viewport
       ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0.0F, 0.0F));
       ImGui::Begin("Viewport");
+      m_fusedPresent.beginTiming();
 
       ImVec2 imageSize = m_dlssShowScaledBuffers ? ImGui::GetContentRegionAvail() :
                                                    ImVec2(float(m_renderSize.x), float(m_renderSize.y));
       // Display the G-Buffer image in the main viewport
-      (m_showBuffer == eNumRenderBufferNames) ?
-          ImGui::Image((ImTextureID)m_outputBuffers.getDescriptorSet(eGBufLdr), ImGui::GetContentRegionAvail()) :
-          ImGui::Image((ImTextureID)m_renderBuffers.getDescriptorSet(m_showBuffer), imageSize);
+      if(m_showReprojectionError && m_reprojection.isEnabled())
+      {
+        ImGui::Image((ImTextureID)m_reprojection.errorDescriptorSet(), imageSize);
+      }
+      else if(m_showBuffer == eNumRenderBufferNames && m_tileDispatch.inFrame() && m_tileDispatch.settings.progressive)
+      {
+        // The tiles traced so far, until the frame's last submission denoises it
+        ImGui::Image((ImTextureID)m_renderBuffers.getDescriptorSet(eGBufColor), imageSize);
+      }
+      else if(m_showBuffer == eNumRenderBufferNames)
+      {
+        m_fusedPresent.image((ImTextureID)m_outputBuffers.getDescriptorSet(presentBuffer()), ImGui::GetContentRegionAvail(), fusedPresent());
+        m_foveation.trackViewport(ImGui::GetItemRectMin(), ImGui::GetItemRectSize(), ImGui::IsItemHovered());
+        if(m_foveation.enabled && !m_stereo.enabled)
+        {
+          m_foveation.drawOverlay(ImGui::GetItemRectMin(), ImGui::GetItemRectSize());
+        }
+      }
+      else
+      {
+        ImGui::Image((ImTextureID)m_renderBuffers.getDescriptorSet(m_showBuffer), imageSize);
+      }
 
+      m_fusedPresent.endTiming();
       ImGui::End();
       ImGui::PopStyleVar();
     }
@@ -631,18 +993,112 @@ public:
 
     NVVK_DBG_SCOPE(cmd);
 
+    // Tiled dispatch: a frame whose tiles didn't fit the earlier submissions continues with the state it began with
+    if(m_tileDispatch.inFrame())
+    {
+      m_profiler.cmdBeginFrame(cmd, m_app->getFrameCycleIndex());
+      if(cmdFramePasses(cmd))
+      {
+        endFrame();
+      }
+      return;
+    }
+
+    // Deterministic mode: the buffers of the frame rendered last are hashed, the download waits for that frame
+    if(m_hashes.hasPending())
+    {
+      hashFrameBuffers();
+    }
+    if(m_hashes.isComplete())
+    {
+      m_hashesMatch = m_hashes.finish();
+      m_app->close();
+      return;
+    }
+
+    // An environment loaded in the background replaces the current one at this frame
+    if(std::unique_ptr<Environment> environment = m_envLoader.poll())
+    {
+      m_envLoader.retire(std::exchange(m_env, std::move(environment)));
+      resetFrame();
+      if(std::exchange(m_envComparisonPending, false) && m_env->equirect && m_env->octahedral.isValid())
+      {
+        startComparison(m_envComparison);
+      }
+    }
+    // Outside of the comparison, the octahedral copy replaces the equirectangular image
+    if(m_envOctahedral && m_env->equirect && m_env->octahedral.isValid() && !m_envComparison.running()
+       && !m_envComparisonPending && !m_envLoader.isLoading() && !m_envFile.empty())
+    {
+      m_envLoader.load(m_envFile, true);
+    }
+
+    // Material edits of the UI, before the frame reads the materials
+    m_materialEditor.beginFrame();
+    m_materialEditor.applyTextures(m_stagingUploader, m_sceneBindings.getSet(0), shaderio::SceneBindings::eTextures);
+    m_materialEditor.cmdApplyMaterials(cmd);
+    if(m_materialEditor.consumeHistoryReset())
+    {
+      resetFrame();
+    }
+    if(m_materialEditor.editCount() != m_materialEdits)
+    {
+      m_materialEdits = m_materialEditor.editCount();
+      cmdUpdateHitRecords(cmd);
+      m_materialTable.cmdUpdate(cmd, m_materialEditor.materials());
+    }
+
+    // Reference worker: the frame index alone selects the samples. Once the range is accumulated, write it and exit.
+    // Checkpoints copied by an earlier frame go to the disk in the background.
+    if(m_reference.isActive())
+    {
+      if(m_reference.isComplete())
+      {
+        // The coordinator retries a chunk whose worker failed
+        m_referenceWritten = m_reference.writePartial(m_app);
+        m_app->close();
+        return;
+      }
+      m_reference.collectCheckpoint(m_app->getFrameCycleIndex());
+      m_frame = m_reference.frameIndex();
+    }
+
+    // Tiled still: the last warm up frame of a tile was submitted with the previous frame, the download waits for it.
+    // Each tile starts from a reset DLSS_RR history.
+    if(m_still.isActive())
+    {
+      if(m_still.tileRendered())
+      {
+        const glm::uvec2 size = m_still.tileSize();
+        m_still.addTile(downloadImage(m_app, &m_alloc, m_outputBuffers.getColorImage(eGBufColorOut),
+                                      m_outputBuffers.getColorFormat(eGBufColorOut), {size.x, size.y}));
+      }
+      if(m_still.isComplete())
+      {
+        m_still.writeImage();
+        m_app->close();
+        return;
+      }
+      m_frame = m_still.frame();
+    }
+
     // Get camera info
-    double view_aspect_ratio = (double)m_renderSize.x / m_renderSize.y;
+    double view_aspect_ratio = m_still.isActive() ? m_still.aspectRatio() : (double)m_renderSize.x / m_renderSize.y;
 
     m_frameInfo.prevMVP = m_frameInfo.proj * m_frameInfo.view;
 
     // Update Frame buffer uniform buffer
-    const auto& clip = m_cameraManip->getClipPlanes();
-    m_frameInfo.view = m_cameraManip->getViewMatrix();
+    const auto&     clip       = m_cameraManip->getClipPlanes();
+    const glm::mat4 cameraView = m_cameraManip->getViewMatrix();
+    m_frameInfo.view           = m_stereo.enabled ? m_stereo.eyeView(cameraView, 0) : cameraView;
     m_frameInfo.proj = glm::perspectiveRH_ZO(glm::radians(m_cameraManip->getFov()), view_aspect_ratio, clip.x, clip.y);
 
     // Were're feeding the raytracer with a flipped matrix for convenience
     m_frameInfo.proj[1][1] *= -1;
+    if(m_still.isActive())
+    {
+      m_frameInfo.proj = m_still.projection(m_frameInfo.proj);  // the current tile's part of the still
+    }
 
     m_frameInfo.projInv      = glm::inverse(m_frameInfo.proj);
     m_frameInfo.viewInv      = glm::inverse(m_frameInfo.view);
@@ -650,141 +1106,252 @@ public:
     m_frameInfo.envIntensity = m_settings.envIntensity;
     m_frameInfo.jitter       = halton(m_frame) - vec2(0.5);
 
-    vkCmdUpdateBuffer(cmd, m_bFrameInfo.buffer, 0, sizeof(shaderio::FrameInfo), &m_frameInfo);
-
-    // Push constant
-    m_pushConst.maxDepth   = m_settings.maxDepth;
-    m_pushConst.frame      = m_frame;
-    m_pushConst.mouseCoord = g_dbgPrintf->getMouseCoord();
-
-    // Helper lambdas to make writing image pipeline barriers easier
-    auto imageShaderWriteToRead = [](VkImage image, VkPipelineStageFlagBits2 srcStage, VkPipelineStageFlagBits2 dstStage) {
-      return nvvk::makeImageMemoryBarrier({
-          .image         = image,
-          .oldLayout     = VK_IMAGE_LAYOUT_GENERAL,
-          .newLayout     = VK_IMAGE_LAYOUT_GENERAL,
-          .srcStageMask  = srcStage,
-          .dstStageMask  = dstStage,
-          .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
-          .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
-      });
-    };
-    auto imageShaderReadToWrite = [](VkImage image, VkPipelineStageFlagBits2 srcStage, VkPipelineStageFlagBits2 dstStage) {
-      return nvvk::makeImageMemoryBarrier({.image         = image,
-                                           .oldLayout     = VK_IMAGE_LAYOUT_GENERAL,
-                                           .newLayout     = VK_IMAGE_LAYOUT_GENERAL,
-                                           .srcStageMask  = srcStage,
-                                           .dstStageMask  = dstStage,
-                                           .srcAccessMask = VK_ACCESS_SHADER_READ_BIT,
-                                           .dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT});
-    };
-
-    auto gbufferShaderWriteToRead = [&]<typename T, size_t N, typename G>(const G& gbuffer, const T(&buffers)[N],
-                                                                          VkPipelineStageFlagBits2 srcStage,
-                                                                          VkPipelineStageFlagBits2 dstStage) {
-      std::array<VkImageMemoryBarrier2, N> x;
-      for(size_t i = 0; i < N; ++i)
-        x[i] = imageShaderWriteToRead(gbuffer.getColorImage(buffers[i]), srcStage, dstStage);
-      return x;
-    };
-    auto gbufferShaderReadToWrite = [&]<typename T, size_t N, typename G>(const G& gbuffer, const T(&buffers)[N],
-                                                                          VkPipelineStageFlagBits2 srcStage,
-                                                                          VkPipelineStageFlagBits2 dstStage) {
-      std::array<VkImageMemoryBarrier2, N> x;
-      for(size_t i = 0; i < N; ++i)
-        x[i] = imageShaderReadToWrite(gbuffer.getColorImage(buffers[i]), srcStage, dstStage);
-      return x;
-    };
-
-    auto renderBufferShaderWriteToRead = [&]<std::size_t N>(const RenderBufferName(&buffers)[N], VkPipelineStageFlagBits2 srcStage,
-                                                            VkPipelineStageFlagBits2 dstStage) {
-      return gbufferShaderWriteToRead(m_renderBuffers, buffers, srcStage, dstStage);
-    };
-    auto renderBufferShaderReadToWrite = [&]<std::size_t N>(const RenderBufferName(&buffers)[N], VkPipelineStageFlagBits2 srcStage,
-                                                            VkPipelineStageFlagBits2 dstStage) {
-      return gbufferShaderReadToWrite(m_renderBuffers, buffers, srcStage, dstStage);
-    };
-    auto outputBufferShaderReadToWrite = [&]<std::size_t N>(const OutputBufferName(&buffers)[N], VkPipelineStageFlagBits2 srcStage,
-                                                            VkPipelineStageFlagBits2 dstStage) {
-      return gbufferShaderReadToWrite(m_outputBuffers, buffers, srcStage, dstStage);
-    };
-    auto outputBufferShaderWriteToRead = [&]<std::size_t N>(const OutputBufferName(&buffers)[N], VkPipelineStageFlagBits2 srcStage,
-                                                            VkPipelineStageFlagBits2 dstStage) {
-      return gbufferShaderWriteToRead(m_outputBuffers, buffers, srcStage, dstStage);
-    };
-
-    auto cmdImageBarriers = [&](const std::initializer_list<const std::span<const VkImageMemoryBarrier2>>& barriers) {
-      std::vector<VkImageMemoryBarrier2> final;
-      for(auto b : barriers)
-        final.insert(final.end(), b.begin(), b.end());
-
-      const VkDependencyInfo depInfo{.sType                   = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
-                                     .imageMemoryBarrierCount = (uint32_t) final.size(),
-                                     .pImageMemoryBarriers    = final.data()};
-      vkCmdPipelineBarrier2(cmd, &depInfo);
-    };
-
-    // Make Guide Buffers writeable to raytracer
-    cmdImageBarriers({renderBufferShaderReadToWrite(
-        {eGBufBaseColor_Metalness, eGBufSpecAlbedo, eGBufSpecHitDist, eGBufNormalRoughness, eGBufMotionVectors, eGBufViewZ, eGBufColor},
-        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR)});
-
-    // Pathtrace the scene
-    raytraceScene(cmd);
-
-    // Make Guide Buffers readable to DLSS_RR
-    cmdImageBarriers({renderBufferShaderWriteToRead({eGBufBaseColor_Metalness, eGBufSpecAlbedo, eGBufSpecHitDist,
-                                                     eGBufNormalRoughness, eGBufMotionVectors, eGBufViewZ, eGBufColor},
-                                                    VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT),
-                      outputBufferShaderReadToWrite({eGBufColorOut}, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                                                    VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT)});
+    // Collect the cost counters of an earlier frame; this frame's counters are read back when the cycle comes around
+    m_costAttribution.readResults(m_app->getFrameCycleIndex());
+    m_frameInfo.flags = (m_frameInfo.flags & ~FLAGS_COST_ATTRIBUTION) | (m_costAttribution.isEnabled() ? FLAGS_COST_ATTRIBUTION : 0);
+    m_guideStats.readResults(m_app->getFrameCycleIndex());
+    m_reprojection.readResults(m_app->getFrameCycleIndex());
+    m_foveation.advance({m_renderSize.x, m_renderSize.y});
+    m_indirectRate.setEnabled(m_indirectRateEnabled);
+    m_indirectRate.setFoveated(m_foveation.enabled && !m_stereo.enabled, m_foveation.tileRates({m_renderSize.x, m_renderSize.y}));
+    m_indirectRate.readResults(m_app->getFrameCycleIndex());
+    m_frameInfo.flags = (m_frameInfo.flags & ~FLAGS_INDIRECT_RATE) | (m_indirectRate.isEnabled() && !m_stereo.enabled ? FLAGS_INDIRECT_RATE : 0);
+    m_frameInfo.flags = (m_frameInfo.flags & ~FLAGS_FOVEATION) | (m_foveation.enabled && !m_stereo.enabled ? FLAGS_FOVEATION : 0);
+    m_frameInfo.foveation = m_foveation.frameParams({m_renderSize.x, m_renderSize.y});
+    const bool octahedral = m_env->octahedral.isValid() && (m_envOctahedral || !m_env->equirect);
+    m_frameInfo.flags     = (m_frameInfo.flags & ~FLAGS_ENV_OCTAHEDRAL) | (octahedral ? FLAGS_ENV_OCTAHEDRAL : 0);
+    m_frameInfo.flags     = (m_frameInfo.flags & ~FLAGS_HIT_RECORDS) | (hitRecordsActive() ? FLAGS_HIT_RECORDS : 0);
+    m_frameInfo.flags = (m_frameInfo.flags & ~FLAGS_COMPACT_MATERIALS) | (m_materialTable.isEnabled() ? FLAGS_COMPACT_MATERIALS : 0);
 
-    // #DLSS
-    setDlssResources();
-    // Check, but don't exit here, because we can disable non-optional guide buffers
-    NGX_CHECK(m_dlss.denoise(cmd, m_renderSize, m_frameInfo.jitter, m_frameInfo.view, m_frameInfo.proj, m_frame == 0));
-
-    // Make denoised image readable to tonemapper
-    cmdImageBarriers(
-        {outputBufferShaderWriteToRead({eGBufColorOut}, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT),
-         outputBufferShaderReadToWrite({eGBufLdr}, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT)});
-
-    // Apply tonemapper
-    m_tonemapper.runCompute(cmd, m_outputBuffers.getSize(), m_tonemapperData, m_outputBuffers.getDescriptorImageInfo(eGBufColorOut),
-                            m_outputBuffers.getDescriptorImageInfo(eGBufLdr));
+    vkCmdUpdateBuffer(cmd, m_bFrameInfo.buffer, 0, sizeof(shaderio::FrameInfo), &m_frameInfo);
 
-    // Make tonemapped image readabble to ImGUI
-    cmdImageBarriers({outputBufferShaderReadToWrite({eGBufLdr}, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                                                    VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT)});
+    // Second eye: the same frame seen from the other eye, reusing the first eye's shading
+    m_stereo.readResults(m_app->getFrameCycleIndex());
+    if(m_stereo.enabled)
+    {
+      const glm::mat4 prevMVPSecond = m_frameInfoSecond.proj * m_frameInfoSecond.view;
+      m_frameInfoSecond             = m_frameInfo;
+      m_frameInfoSecond.prevMVP     = prevMVPSecond;
+      m_frameInfoSecond.view        = m_stereo.eyeView(cameraView, 1);
+      m_frameInfoSecond.viewInv     = glm::inverse(m_frameInfoSecond.view);
+      m_frameInfoSecond.flags &= ~FLAGS_COST_ATTRIBUTION;  // the costs are the first eye's
+      m_stereo.setFrameInfo(m_frameInfoSecond, m_frameInfo);
+      vkCmdUpdateBuffer(cmd, m_bFrameInfoSecond.buffer, 0, sizeof(shaderio::FrameInfo), &m_frameInfoSecond);
+    }
+    m_fusedPresent.cmdUpdate(cmd, m_tonemapperData);
 
-    m_frame++;
+    // Push constant
+    m_pushConst.maxDepth        = m_settings.maxDepth;
+    m_pushConst.frame           = m_frame;
+    m_pushConst.mouseCoord      = g_dbgPrintf->getMouseCoord();
+    m_pushConst.envSecondaryLod = m_envSecondaryLod;
+
+    // Timings of the frame that used this cycle index before
+    m_profiler.cmdBeginFrame(cmd, m_app->getFrameCycleIndex());
+    if(m_tileDispatch.isEnabled())
+    {
+      m_tileDispatch.beginFrame(m_renderSize);
+    }
+    if(cmdFramePasses(cmd))
+    {
+      endFrame();
+    }
   }
 
 private:
-  void createScene(const std::filesystem::path& filename)
+  // Records the passes of the frame; with a tiled dispatch, those of this submission's slice of tiles. False while
+  // tiles of the frame remain for the next submissions.
+  bool cmdFramePasses(VkCommandBuffer cmd)
   {
-    m_sceneRtx.destroy();
-    m_sceneVk.destroy();
-    m_scene.destroy();
-
-    if(!m_scene.load(filename))
+    m_tileDispatch.addTiming(m_app->getFrameCycleIndex(), m_profiler.statistics(ePassRaytrace).lastMs);
+    m_tileSlice.reset();
+    if(m_tileDispatch.inFrame())
     {
-      LOGE("Error loading scene");
-      return;
+      m_tileSlice = m_tileDispatch.nextSlice(m_app->getFrameCycleIndex());
     }
 
-    m_cameraManip->fit(m_scene.getSceneBounds().min(), m_scene.getSceneBounds().max());  // Navigation help
-
-    auto cmd = m_app->createTempCmdBuffer();
+    const bool first = !m_tileSlice || m_tileSlice->first;
+    const bool last  = !m_tileSlice || m_tileSlice->last;
+    for(uint32_t pass = 0; pass < ePassComposite; ++pass)
+    {
+      if((pass < ePassRaytrace && !first) || (pass > ePassRaytrace && !last))
+      {
+        continue;
+      }
+      PassProfiler::Section section(m_profiler, cmd, pass);
+      cmdPass(cmd, ProfilerPass(pass));
+    }
+    return last;
+  }
 
-    {  // Create the Vulkan side of the scene
+  // A/B comparison of a feature and the pass whose time it compares
+  struct Comparison
+  {
+    TraceComparison* time   = nullptr;
+    ProfilerPass     pass   = ePassRaytrace;
+    TraceComparison* clocks = nullptr;  // hit shader clocks in the same phases, with the cost attribution
+  };
+  std::array<Comparison, 7> comparisons()
+  {
+    return {{{&m_lodComparison},
+             {&m_indirectComparison},
+             {&m_foveationComparison},
+             {&m_stereoComparison, ePassStereoTrace},
+             {&m_envComparison},
+             {&m_hitRecordComparison, ePassRaytrace, &m_hitRecordCostComparison},
+             {&m_materialComparison, ePassRaytrace, &m_materialCostComparison}}};
+  }
+  void startComparison(TraceComparison& time)
+  {
+    for(const Comparison& comparison : comparisons())
+    {
+      if(comparison.time == &time)
+      {
+        time.start(8, 60, m_app->getFrameCycleSize() + 1);
+        if(comparison.clocks)
+        {
+          comparison.clocks->start(8, 60, m_app->getFrameCycleSize() + 1);
+        }
+      }
+    }
+  }
+
+  // Once the last passes of a frame are recorded: the comparisons and the benchmark advance, then the frame index
+  void endFrame()
+  {
+    for(const Comparison& comparison : comparisons())
+    {
+      // The hit shader clocks, in step with the trace time; only measured with the cost attribution
+      if(comparison.clocks && comparison.time->running())
+      {
+        comparison.clocks->endFrame(m_costAttribution.isEnabled() ? m_costAttribution.lastCyclesPerHit() : 0.0);
+      }
+      // A tiled dispatch spreads the ray tracing of a frame over the submissions of its slices
+      const bool sliced = comparison.pass == ePassRaytrace && m_tileDispatch.isEnabled();
+      comparison.time->endFrame(sliced ? m_tileDispatch.frameMs() : m_profiler.statistics(comparison.pass).lastMs);
+    }
+
+    switch(m_benchmark.advance())
+    {
+      case Benchmark::Event::eWarmupDone:
+        m_profiler.resetStatistics();
+        m_instanceGen.resetStatistics();
+        break;
+      case Benchmark::Event::eDone:
+        m_benchmark.writeReport(profileJson());
+        if(!m_info.profiles.file.empty())
+        {
+          recordProfilePoint();
+        }
+        if(!m_profileSweep.empty() && m_profileSweepIndex + 1 < m_profileSweep.size())
+        {
+          m_profileSweepIndex++;
+          m_profileSweepNext = true;
+          break;
+        }
+        m_app->close();
+        break;
+      default:
+        break;
+    }
+
+    // The warm up of a tile starts once the environment is loaded
+    if(m_still.isActive() && !m_envLoader.isLoading())
+    {
+      m_still.advance();
+    }
+    // Frames before the environment arrived are not hashed: its arrival depends on timing and resets the frame index
+    if(m_hashes.isActive() && !m_envLoader.isLoading())
+    {
+      m_hashes.frameRendered(m_frame);
+    }
+
+    m_frame++;
+  }
+
+  void createScene(const std::filesystem::path& filename)
+  {
+    // Timings of the old scene
+    for(const Comparison& comparison : comparisons())
+    {
+      comparison.time->stop();
+      if(comparison.clocks)
+      {
+        comparison.clocks->stop();
+      }
+    }
+    m_materialEditor.destroyScene();
+    m_materialTable.destroyScene();
+    m_streamer.destroyScene();
+    m_instanceGen.destroyScene();
+    m_lods.destroy();
+    m_sceneRtx.destroy();
+    m_sceneVk.destroy();
+    m_scene.destroy();
+
+    m_sceneStats      = {};
+    m_sceneStats.file = filename.filename().string();
+
+    auto start = std::chrono::steady_clock::now();
+    if(!m_scene.load(filename))
+    {
+      LOGE("Error loading scene");
+      return;
+    }
+    m_sceneStats.loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Navigation help; the deterministic mode doesn't animate the camera towards it over time
+    if(m_hashes.isDeterministic())
+    {
+      m_cameraManip->fit(m_scene.getSceneBounds().min(), m_scene.getSceneBounds().max(), true);
+    }
+    else
+    {
+      m_cameraManip->fit(m_scene.getSceneBounds().min(), m_scene.getSceneBounds().max());
+    }
+
+    m_lods.create(m_app, &m_alloc, m_scene, uint32_t(std::max(m_info.lodLevels, 1)));  // Simplified BLASes, waits
+
+    start    = std::chrono::steady_clock::now();
+    auto cmd = m_app->createTempCmdBuffer();
+    {  // Create the Vulkan side of the scene
       m_sceneVk.create(cmd, m_stagingUploader, m_scene);
-      m_stagingUploader.cmdUploadAppended(cmd);  //make sure the scene buffers are on the GPU by the time we build
-                                                 //the Acceleration Structures
+      m_stagingUploader.cmdUploadAppended(cmd);
+    }
+    m_app->submitAndWaitTempCmdBuffer(cmd);
+    m_stagingUploader.releaseStaging();
+    m_sceneStats.uploadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Separate submit, so the scaling reports can tell the upload and the acceleration structure build apart
+    start = std::chrono::steady_clock::now();
+    cmd   = m_app->createTempCmdBuffer();
+    {
       m_sceneRtx.create(cmd, m_stagingUploader, m_scene, m_sceneVk, VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR);  // Create BLAS / TLAS
+      m_instanceGen.setScene(m_stagingUploader, m_scene, m_sceneRtx.blasAddresses(),
+                             m_lods.blasAddresses());  // Per-frame TLAS, built when rendering
       m_stagingUploader.cmdUploadAppended(cmd);
     }
 
+    m_app->submitAndWaitTempCmdBuffer(cmd);
+    m_stagingUploader.releaseStaging();
+    m_sceneStats.accelerationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    m_sceneStats.blasBytes      = m_sceneRtx.blasBytes();  // before the streaming takes them over
+
+    if(m_info.geometryBudgetMB > 0)
+    {
+      m_streamer.setScene(m_scene, m_sceneRtx, m_instanceGen);  // Replaces the BLASes with proxies
+    }
+
+    m_costAttribution.setScene(m_scene);
+    m_materialEditor.setScene(m_scene, m_sceneVk);
+    m_materialEdits = m_materialEditor.editCount();
+
+    // Compact records of the materials just read back
+    cmd = m_app->createTempCmdBuffer();
+    {
+      m_materialTable.setScene(m_stagingUploader, m_materialEditor.materials());
+      m_stagingUploader.cmdUploadAppended(cmd);
+    }
     m_app->submitAndWaitTempCmdBuffer(cmd);
     m_stagingUploader.releaseStaging();
 
@@ -794,6 +1361,27 @@ private:
     createRtxPipeline();  // must recreate due to texture changes
     writeSceneSet();
     writeRtxSet();
+
+    m_sceneStats.deviceMemoryBytes = deviceLocalUsage();
+  }
+
+  // Bytes allocated in the device local heaps, as VMA tracks them
+  uint64_t deviceLocalUsage() const
+  {
+    VkPhysicalDeviceMemoryProperties memoryProps;
+    vkGetPhysicalDeviceMemoryProperties(m_app->getPhysicalDevice(), &memoryProps);
+    std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets{};
+    vmaGetHeapBudgets(m_alloc, budgets.data());
+
+    uint64_t usage = 0;
+    for(uint32_t heap = 0; heap < memoryProps.memoryHeapCount; ++heap)
+    {
+      if(memoryProps.memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+      {
+        usage += budgets[heap].statistics.allocationBytes;
+      }
+    }
+    return usage;
   }
 
   void createInputGbuffers(const glm::uvec2& inputSize)
@@ -825,7 +1413,14 @@ private:
 
     auto cmd = m_app->createTempCmdBuffer();
     NVVK_CHECK(m_renderBuffers.update(cmd, vk_size));
+    m_reprojection.resize(cmd, vk_size);
+    m_indirectRate.resize(cmd, vk_size);
     m_app->submitAndWaitTempCmdBuffer(cmd);
+    m_stereo.resize(vk_size);
+    if(m_reference.isActive())
+    {
+      m_reference.resize(vk_size);
+    }
 
     writeDlssSet();
 
@@ -839,11 +1434,16 @@ private:
 
     VkExtent2D vk_size{outputSize.x, outputSize.y};
 
-    std::vector<VkFormat> colorBuffers((size_t(eNumOutputBufferNames)));
-    colorBuffers[eGBufLdr] = VK_FORMAT_R8G8B8A8_UNORM;
+    // The fused present reads the denoised image directly, there is no 8 bit copy
+    std::vector<VkFormat> colorBuffers((size_t(fusedPresent() ? eGBufLdr : eNumOutputBufferNames)));
+    if(!fusedPresent())
+    {
+      colorBuffers[eGBufLdr] = m_hdrDisplay.format();  // R8G8B8A8_UNORM unless the output is HDR
+    }
 
     // #DLSS
-    colorBuffers[eGBufColorOut] = VK_FORMAT_R16G16B16A16_SFLOAT;
+    colorBuffers[eGBufColorOut]       = VK_FORMAT_R16G16B16A16_SFLOAT;
+    colorBuffers[eGBufColorOutSecond] = VK_FORMAT_R16G16B16A16_SFLOAT;
 
     VkSampler sampler;
     m_samplerPool.acquireSampler(sampler);
@@ -867,6 +1467,8 @@ private:
   {
     NVVK_CHECK(m_alloc.createBuffer(m_bFrameInfo, sizeof(shaderio::FrameInfo), VK_BUFFER_USAGE_2_UNIFORM_BUFFER_BIT));
     NVVK_DBG_NAME(m_bFrameInfo.buffer);
+    NVVK_CHECK(m_alloc.createBuffer(m_bFrameInfoSecond, sizeof(shaderio::FrameInfo), VK_BUFFER_USAGE_2_UNIFORM_BUFFER_BIT));
+    NVVK_DBG_NAME(m_bFrameInfoSecond.buffer);
   }
 
   //--------------------------------------------------------------------------------------------------
@@ -879,6 +1481,9 @@ private:
     vkDestroyPipelineLayout(m_device, m_rtPipelineLayout, nullptr);
     m_rtPipelineLayout = VK_NULL_HANDLE;
     m_alloc.destroyBuffer(m_sbtBuffer);
+    // Drops the hit records of the previous scene
+    m_sbt.deinit();
+    m_sbt.init(m_device, m_rtProperties);
 
     // Creating all shaders
     enum StageIndices
@@ -957,12 +1562,23 @@ private:
     group.anyHitShader     = eSecondaryAnyHit;
     shaderGroups.push_back(group);
 
+    // Both hit groups again for every other render node, so that each has its own HitRecord; the instances select
+    // theirs with the SBT offset
+    m_hitRecords = makeHitRecords();
+    const std::array<VkRayTracingShaderGroupCreateInfoKHR, HIT_RECORD_GROUPS> hitGroups{shaderGroups[shaderGroups.size() - 2],
+                                                                                        shaderGroups.back()};
+    for(size_t node = 1; node < m_hitRecords.size(); ++node)
+    {
+      shaderGroups.insert(shaderGroups.end(), hitGroups.begin(), hitGroups.end());
+    }
+
     // Push constant: we want to be able to update constants used by the shaders
     VkPushConstantRange push_constant{VK_SHADER_STAGE_ALL, 0, sizeof(shaderio::RtxPushConstant)};
 
     NVVK_CHECK(nvvk::createPipelineLayout(m_device, &m_rtPipelineLayout,
                                           {m_rtBindings.getLayout(), m_sceneBindings.getLayout(),
-                                           m_DlssRRBindings.getLayout(), m_hdrEnv.getDescriptorSetLayout()},
+                                           m_DlssRRBindings.getLayout(), m_env->hdr.getDescriptorSetLayout(),
+                                           m_env->octahedral.getDescriptorSetLayout()},
                                           {push_constant}));
     NVVK_DBG_NAME(m_rtPipelineLayout);
 
@@ -974,13 +1590,27 @@ private:
     ray_pipeline_info.pGroups                      = shaderGroups.data();
     ray_pipeline_info.maxPipelineRayRecursionDepth = 2;  // Ray depth
     ray_pipeline_info.layout                       = m_rtPipelineLayout;
+    if(m_info.pipelineStatistics)
+    {
+      ray_pipeline_info.flags |= VK_PIPELINE_CREATE_CAPTURE_STATISTICS_BIT_KHR;
+    }
 
     vkCreateRayTracingPipelinesKHR(m_device, {}, {}, 1, &ray_pipeline_info, nullptr, &m_rtPipeline);
     NVVK_DBG_NAME(m_rtPipeline);
 
-    // Creating the SBT
+    // Register, stack and spill usage per stage
+    if(m_info.pipelineStatistics)
+    {
+      m_rtPipelineStats = getPipelineExecutableStats(m_device, m_rtPipeline);
+      logPipelineExecutableStats("Raytrace", m_rtPipelineStats);
+    }
+
+    // Creating the SBT, the data sets the stride of the hit records
+    addHitRecordData();
     auto sbtSize = m_sbt.calculateSBTBufferSize(m_rtPipeline, ray_pipeline_info);
-    m_alloc.createBuffer(m_sbtBuffer, sbtSize, VK_BUFFER_USAGE_2_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_2_SHADER_BINDING_TABLE_BIT_KHR,
+    m_alloc.createBuffer(m_sbtBuffer, sbtSize,
+                         VK_BUFFER_USAGE_2_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_2_SHADER_BINDING_TABLE_BIT_KHR
+                             | VK_BUFFER_USAGE_2_TRANSFER_DST_BIT,  // material edits update the hit records
                          VMA_MEMORY_USAGE_AUTO, VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
                          m_sbt.getBufferAlignment());
     NVVK_DBG_NAME(m_sbtBuffer.buffer);
@@ -994,6 +1624,102 @@ private:
     }
   }
 
+  // One HitRecord per render node from the current materials, empty beyond HIT_RECORD_MAX_NODES: InstanceGenerator
+  // then leaves the SBT offsets at 0 and the hit shaders read the render nodes
+  std::vector<shaderio::HitRecord> makeHitRecords() const
+  {
+    std::vector<shaderio::HitRecord> records;
+    const auto&                      renderNodes = m_scene.getRenderNodes();
+    if(renderNodes.size() > HIT_RECORD_MAX_NODES)
+    {
+      return records;
+    }
+    records.reserve(renderNodes.size());
+    for(const nvvkgltf::RenderNode& renderNode : renderNodes)
+    {
+      // Mirrors makeHitRecord() in secondary_rahit.slang
+      const uint32_t                     matIndex  = uint32_t(std::max(0, renderNode.materialID));
+      const shaderio::GltfShadeMaterial& mat       = m_materialEditor.material(matIndex);
+      const bool                         specGloss = mat.usePbrSpecularGlossiness != 0;
+      records.push_back({.baseColorFactor  = specGloss ? mat.pbrDiffuseFactor : mat.pbrBaseColorFactor,
+                         .materialIndex    = matIndex,
+                         .alphaMode        = uint32_t(mat.alphaMode),
+                         .alphaCutoff      = mat.alphaCutoff,
+                         .baseColorTexture = specGloss ? mat.pbrDiffuseTexture : mat.pbrBaseColorTexture});
+    }
+    return records;
+  }
+
+  // Hit group index 'node * HIT_RECORD_GROUPS + k' is the copy of hit group k of render node 'node'
+  void addHitRecordData()
+  {
+    for(size_t node = 0; node < m_hitRecords.size(); ++node)
+    {
+      for(uint32_t k = 0; k < HIT_RECORD_GROUPS; ++k)
+      {
+        m_sbt.addData(nvvk::SBTGenerator::eHit, uint32_t(node * HIT_RECORD_GROUPS + k), m_hitRecords[node]);
+      }
+    }
+  }
+
+  // Records the updates of the hit records whose alpha test constants changed with material edits. The frames in
+  // flight read the SBT, so the writes go through the queue instead of the mapping, like MaterialTable::cmdUpdate().
+  void cmdUpdateHitRecords(VkCommandBuffer cmd)
+  {
+    const std::vector<shaderio::HitRecord> records = makeHitRecords();
+    if(records.size() != m_hitRecords.size())
+    {
+      return;
+    }
+    std::vector<uint32_t> changed;
+    for(uint32_t node = 0; node < uint32_t(records.size()); ++node)
+    {
+      if(memcmp(&records[node], &m_hitRecords[node], sizeof(shaderio::HitRecord)) != 0)
+      {
+        m_hitRecords[node] = records[node];
+        changed.push_back(node);
+      }
+    }
+    if(changed.empty())
+    {
+      return;
+    }
+    // Kept for the next populateSBTBuffer() of a pipeline rebuild
+    addHitRecordData();
+
+    VkMemoryBarrier2 barrier{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                             .srcStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                             .srcAccessMask = VK_ACCESS_2_MEMORY_READ_BIT,
+                             .dstStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                             .dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT};
+    VkDependencyInfo depInfo{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &barrier};
+    vkCmdPipelineBarrier2(cmd, &depInfo);
+
+    // A record is the group handle followed by its data; both groups of a node carry the same HitRecord
+    const VkStridedDeviceAddressRegionKHR& hit = m_sbt.getSBTRegions(0).hit;
+    const VkDeviceSize hitOffset = hit.deviceAddress - m_sbtBuffer.address + m_rtProperties.shaderGroupHandleSize;
+    for(uint32_t node : changed)
+    {
+      for(uint32_t k = 0; k < HIT_RECORD_GROUPS; ++k)
+      {
+        vkCmdUpdateBuffer(cmd, m_sbtBuffer.buffer, hitOffset + (node * HIT_RECORD_GROUPS + k) * hit.stride,
+                          sizeof(shaderio::HitRecord), &m_hitRecords[node]);
+      }
+    }
+
+    barrier.srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barrier.dstStageMask  = VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR;
+    barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+    vkCmdPipelineBarrier2(cmd, &depInfo);
+  }
+
+  // The static TLAS of SceneRtx has no SBT offsets
+  bool hitRecordsActive() const
+  {
+    return m_hitRecordsEnabled && !m_hitRecords.empty() && m_instanceGen.mode() != InstanceGenerator::Mode::eStatic;
+  }
+
   void createDlssSet()
   {
     m_DlssRRBindings.deinit();
@@ -1040,11 +1766,18 @@ private:
 
     // This descriptor set, holds the top level acceleration structure and the output image
     d.addBinding(shaderio::RtxBindings::eTlas, VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, 1, VK_SHADER_STAGE_ALL);
+    d.addBinding(shaderio::RtxBindings::eCostStats, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_ALL);
 
     NVVK_CHECK(m_rtBindings.init(d, m_device));
     NVVK_DBG_NAME(m_rtBindings.getLayout());
   }
 
+  // The TLAS that is traced
+  VkAccelerationStructureKHR activeTlas() const
+  {
+    return m_instanceGen.mode() == InstanceGenerator::Mode::eStatic ? m_sceneRtx.tlas() : m_instanceGen.tlas();
+  }
+
   void writeRtxSet()
   {
     if(!m_scene.valid())
@@ -1053,10 +1786,9 @@ private:
     }
 
     // Write to descriptors
-    VkAccelerationStructureKHR tlas = m_sceneRtx.tlas();
-
     nvvk::WriteSetContainer writes;
-    writes.append(m_rtBindings.makeWrite(shaderio::RtxBindings::eTlas), tlas);
+    writes.append(m_rtBindings.makeWrite(shaderio::RtxBindings::eTlas), activeTlas());
+    writes.append(m_rtBindings.makeWrite(shaderio::RtxBindings::eCostStats), m_costAttribution.counterBuffer());
 
     vkUpdateDescriptorSets(m_device, writes.size(), writes.data(), 0, nullptr);
   }
@@ -1072,27 +1804,483 @@ private:
     d.addBinding(shaderio::SceneBindings::eTextures, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_sceneVk.nbTextures(),
                  VK_SHADER_STAGE_ALL);
 
-    NVVK_CHECK(m_sceneBindings.init(d, m_device));
-    NVVK_DBG_NAME(m_sceneBindings.getLayout());
+    NVVK_CHECK(m_sceneBindings.init(d, m_device));
+    NVVK_DBG_NAME(m_sceneBindings.getLayout());
+  }
+
+  void writeSceneSet()
+  {
+    if(!m_scene.valid())
+    {
+      return;
+    }
+
+    nvvk::WriteSetContainer writes;
+
+    std::vector<VkDescriptorImageInfo> diit;
+    for(const auto& texture : m_sceneVk.textures())  // All texture samplers
+    {
+      diit.emplace_back(m_materialEditor.textureDescriptor(uint32_t(diit.size()), texture.descriptor));
+    }
+    writes.append(m_sceneBindings.makeWrite(shaderio::SceneBindings::eTextures), diit.data());
+
+    vkUpdateDescriptorSets(m_device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+  }
+
+  //--------------------------------------------------------------------------------------------------
+  // Validation rules for the guide buffers, indexed by RenderBufferName
+  //
+  static std::vector<GuideStats::Check> guideBufferChecks()
+  {
+    const float kInfDistance = 65504.0f;  // DLSS_INF_DISTANCE, written for sky pixels
+
+    std::vector<GuideStats::Check> checks(eNumRenderBufferNames);
+    checks[eGBufBaseColor_Metalness] = {.name         = "Diffuse Albedo",
+                                        .rangeMin     = glm::vec4(0.0f),
+                                        .rangeMax     = glm::vec4(1.0f),
+                                        .checks       = GUIDE_CHECK_ZERO_RGB,
+                                        .specialLabel = "Zero albedo"};
+    checks[eGBufSpecAlbedo]          = {.name         = "Specular Albedo",
+                                        .rangeMin     = glm::vec4(0.0f),
+                                        .rangeMax     = glm::vec4(1.0f),
+                                        .checks       = GUIDE_CHECK_ZERO_RGB,
+                                        .specialLabel = "Zero albedo"};
+    checks[eGBufSpecHitDist]         = {.name          = "Specular Hitdist",
+                                        .rangeMin      = glm::vec4(0.0f),
+                                        .rangeMax      = glm::vec4(kInfDistance),
+                                        .channels      = 1,
+                                        .checks        = GUIDE_CHECK_SATURATED,
+                                        .saturateValue = kInfDistance,
+                                        .specialLabel  = "At infinity"};
+    checks[eGBufNormalRoughness]     = {.name         = "Normal/Roughness",
+                                        .rangeMin     = glm::vec4(-1.0f, -1.0f, -1.0f, 0.0f),
+                                        .rangeMax     = glm::vec4(1.0f),
+                                        .checks       = GUIDE_CHECK_UNIT_NORMAL | GUIDE_CHECK_ZERO_RGB,
+                                        .specialLabel = "No surface"};
+    checks[eGBufMotionVectors]       = {.name = "Motion vectors", .channels = 2};
+    checks[eGBufViewZ]               = {.name          = "ViewZ",
+                                        .rangeMin      = glm::vec4(0.0f),
+                                        .rangeMax      = glm::vec4(kInfDistance),
+                                        .channels      = 1,
+                                        .checks        = GUIDE_CHECK_SATURATED,
+                                        .saturateValue = kInfDistance,
+                                        .specialLabel  = "Saturated (sky)"};
+    checks[eGBufColor]               = {.name = "Color", .rangeMin = glm::vec4(0.0f), .channels = 3};
+    return checks;
+  }
+
+  //--------------------------------------------------------------------------------------------------
+  // Pass timings, hardware counter capture and export
+  //
+  void profilerUI()
+  {
+    m_profiler.onUI();
+    if(ImGui::TreeNode("Pipeline Statistics"))
+    {
+      pipelineExecutableStatsUI("Raytrace", m_rtPipelineStats);
+      ImGui::TreePop();
+    }
+    if(ImGui::Button("Reset Timings"))
+    {
+      m_profiler.resetStatistics();
+    }
+    ImGui::SameLine();
+    if(ImGui::Button("Export Profile"))
+    {
+      std::filesystem::path filename = nvgui::windowSaveFileDialog(m_app->getWindowHandle(), "Export Profile", "JSON(.json)|*.json");
+      if(!filename.empty())
+      {
+        exportProfile(filename);
+      }
+    }
+
+    ImGui::Separator();
+    if(!m_perfCounters.isValid())
+    {
+      ImGui::TextDisabled("Hardware counters not available (VK_KHR_performance_query)");
+      return;
+    }
+    if(m_perfCounters.onUI() && m_scene.valid())
+    {
+      capturePerfCounters();
+    }
+  }
+
+  // LOD settings and the A/B comparison of the trace time without and with them
+  void lodUI()
+  {
+    using namespace nvgui;
+
+    m_lods.onUI();
+    if(m_lods.levels() <= 1)
+    {
+      return;
+    }
+
+    ImGui::BeginDisabled(m_lodComparison.running());
+    PropertyEditor::begin();
+    PropertyEditor::entry("Enable", [&] { return ImGui::Checkbox("##lod", &m_instanceGen.lodEnabled); },
+                          "Off: only the original geometry is traced");
+    PropertyEditor::entry(
+        "Threshold",
+        [&] {
+          return ImGui::SliderFloat("##lodThreshold", &m_instanceGen.lodThreshold, 0.001f, 1.0f, "%.3f", ImGuiSliderFlags_Logarithmic);
+        },
+        "Bounding sphere radius / distance below which LOD 1 fades in; every halving moves one level down");
+    PropertyEditor::end();
+    ImGui::EndDisabled();
+
+    if(m_instanceGen.mode() == InstanceGenerator::Mode::eStatic)
+    {
+      ImGui::TextDisabled("The static TLAS has LOD 0 only, see TLAS Instances");
+      return;
+    }
+
+    if(m_lodComparison.onUI())
+    {
+      startComparison(m_lodComparison);
+    }
+  }
+
+  // Tonemapping in the viewport composite instead of a compute pass, and the time of both paths
+  bool             fusedPresent() const { return m_fusedPresentEnabled && m_fusedPresent.isSupported() && !m_hdrDisplay.isHdr(); }
+  OutputBufferName presentBuffer() const { return fusedPresent() ? denoisedBuffer() : eGBufLdr; }
+  // Denoised output of the eye shown
+  OutputBufferName denoisedBuffer() const { return m_stereo.enabled && m_stereo.showEye == 1 ? eGBufColorOutSecond : eGBufColorOut; }
+  // The per-tile rates need the last frame's buffers of the same eye; with stereo they hold the second one
+  bool indirectRateActive() const { return m_indirectRate.isActive() && !m_stereo.enabled; }
+
+  void presentUI()
+  {
+    m_hdrDisplay.onUI();
+    ImGui::BeginDisabled(!m_fusedPresent.isSupported() || m_hdrDisplay.isHdr());
+    bool fused = m_fusedPresentNext.value_or(m_fusedPresentEnabled);
+    if(ImGui::Checkbox("Fused Present", &fused))
+    {
+      m_fusedPresentNext = fused;
+    }
+    ImGui::EndDisabled();
+    ImGui::SetItemTooltip("Tonemap while ImGui draws the viewport, skipping the compute pass and its 8 bit image");
+    ImGui::Text("%s %.3f ms + composite %.3f ms", m_hdrDisplay.isHdr() ? "Display transform" : "Tonemap",
+                m_profiler.statistics(ePassTonemap).averageMs,
+                m_profiler.statistics(ePassComposite).averageMs);
+  }
+
+  // Variable rate indirect tracing, its savings and reconstruction error
+  void indirectRateUI()
+  {
+    using namespace nvgui;
+
+    ImGui::BeginDisabled(m_indirectComparison.running());
+    PropertyEditor::begin();
+    PropertyEditor::entry("Enable", [&] { return ImGui::Checkbox("##indirectRate", &m_indirectRateEnabled); },
+                          "Flat, low-frequency tiles trace half or a quarter of their indirect paths");
+    PropertyEditor::end();
+    ImGui::EndDisabled();
+    m_indirectRate.onUI();
+
+    if(m_indirectComparison.onUI())
+    {
+      startComparison(m_indirectComparison);
+    }
+  }
+
+  // Gaze driven indirect rates; the sample renders one view, so its time is the time per eye
+  void foveationUI()
+  {
+    ImGui::BeginDisabled(m_foveationComparison.running());
+    m_foveation.onUI();
+    ImGui::EndDisabled();
+    if(m_foveation.enabled)
+    {
+      ImGui::Text("Indirect paths skipped: %.1f%%", m_foveation.skippedFraction({m_renderSize.x, m_renderSize.y}) * 100.0);
+    }
+
+    if(m_foveationComparison.onUI())
+    {
+      startComparison(m_foveationComparison);
+    }
+  }
+
+  // Ray tracing in tiles; with a budget, the raytrace timings are those of a submission's slice of tiles, the
+  // comparisons take the sum over the slices of a frame
+  void tileDispatchUI()
+  {
+    m_tileDispatch.onUI();
+    if(!m_tileDispatch.isEnabled())
+    {
+      return;
+    }
+    ImGui::Text("%u tiles, %.3f ms per tile, %u submissions per frame", m_tileDispatch.tileCount(),
+                m_tileDispatch.msPerTile(), m_tileDispatch.slicesPerFrame());
+    ImGui::Text("Raytrace: %.3f ms per frame", m_tileDispatch.frameMs());
+    if(m_stereo.enabled)
+    {
+      ImGui::TextDisabled("The second eye is traced in one launch");
+    }
+  }
+
+  // Second eye and its reuse of the first eye's shading
+  void stereoUI()
+  {
+    ImGui::BeginDisabled(m_stereoComparison.running());
+    if(m_stereo.onUI())
+    {
+      // The second DLSS_RR instance follows the stereo setting
+      reinitDlss(false);
+      resetFrame();
+    }
+    ImGui::EndDisabled();
+    if(!m_stereo.enabled)
+    {
+      return;
+    }
+    if(m_indirectRate.isEnabled() || m_foveation.enabled)
+    {
+      ImGui::TextDisabled("Variable rate indirect and foveation are off in stereo");
+    }
+    ImGui::Text("Raytrace: %.3f ms first eye, %.3f ms second eye", m_profiler.statistics(ePassRaytrace).averageMs,
+                m_profiler.statistics(ePassStereoTrace).averageMs);
+
+    if(m_stereoComparison.onUI())
+    {
+      startComparison(m_stereoComparison);
+    }
+  }
+
+  // Material constants in the SBT records of the hit groups, see HitRecord
+  void hitRecordUI()
+  {
+    ImGui::BeginDisabled(m_hitRecordComparison.running());
+    ImGui::Checkbox("Material from the hit record", &m_hitRecordsEnabled);
+    ImGui::EndDisabled();
+    if(m_hitRecords.empty())
+    {
+      ImGui::TextDisabled("More than %d render nodes: the hit shaders read the render nodes", HIT_RECORD_MAX_NODES);
+      return;
+    }
+    if(m_instanceGen.mode() == InstanceGenerator::Mode::eStatic)
+    {
+      ImGui::TextDisabled("The static TLAS has no SBT offsets: choose a per-frame mode in TLAS Instances");
+      return;
+    }
+    ImGui::Text("%zu hit groups, %llu byte records", m_hitRecords.size() * HIT_RECORD_GROUPS,
+                static_cast<unsigned long long>(m_sbt.getSBTRegions(0).hit.stride));
+    if(m_costAttribution.isEnabled())
+    {
+      ImGui::Text("Hit shaders: %.0f clocks per invocation", m_costAttribution.lastCyclesPerHit());
+    }
+
+    if(m_hitRecordComparison.onUI())
+    {
+      startComparison(m_hitRecordComparison);
+    }
+    m_hitRecordCostComparison.resultUI();
+  }
+
+  // Materials evaluated from their one cache line record, see MaterialTable
+  void materialTableUI()
+  {
+    ImGui::BeginDisabled(m_materialComparison.running());
+    m_materialTable.onUI();
+    ImGui::EndDisabled();
+    if(m_costAttribution.isEnabled())
+    {
+      ImGui::Text("Hit shaders: %.0f clocks per invocation", m_costAttribution.lastCyclesPerHit());
+    }
+
+    if(m_materialComparison.onUI())
+    {
+      startComparison(m_materialComparison);
+    }
+    m_materialCostComparison.resultUI();
+  }
+
+  void octahedralEnvUI()
+  {
+    const OctahedralEnv& octahedral = m_env->octahedral;
+    if(!octahedral.isValid())
+    {
+      return;
+    }
+    ImGui::Text("Octahedral %ux%u, %u mips, converted in %.1f ms", octahedral.size(), octahedral.size(),
+                octahedral.mipLevels(), octahedral.convertMs());
+    ImGui::Text("VRAM: %.1f MB octahedral, %.1f MB equirectangular%s", double(octahedral.bytes()) / (1 << 20),
+                double(octahedral.equirectBytes()) / (1 << 20), m_env->equirect ? "" : " (released)");
+
+    if(m_envComparisonPending)
+    {
+      ImGui::Text("Loading the equirectangular image...");
+    }
+    else if(m_envComparison.onUI())
+    {
+      // Both layouts have to be resident while the comparison alternates between them
+      if(m_env->equirect)
+      {
+        startComparison(m_envComparison);
+      }
+      else
+      {
+        m_envComparisonPending = true;
+        m_envLoader.load(m_envFile, true, true);
+      }
+    }
+  }
+
+  // Replays each pass of the current frame in its own command buffer, once per counter pass and repeat
+  void capturePerfCounters()
+  {
+    vkDeviceWaitIdle(m_device);
+    // The replays record the GPU work only; streaming, readbacks, accumulation and frame counters stay with the frame
+    m_replaying = true;
+    m_perfCounters.capture(m_perfCounters.repeats(), [&](VkCommandBuffer cmd, uint32_t pass) { cmdPass(cmd, ProfilerPass(pass)); });
+    m_replaying = false;
+    // The replays fed DLSS_RR with repeated frames
+    resetFrame();
+  }
+
+  // Timings, counters and shader statistics; also the content of the benchmark report
+  nlohmann::json profileJson() const
+  {
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(m_app->getPhysicalDevice(), &props);
+
+    nlohmann::json root;
+    root["device"]              = props.deviceName;
+    root["driver"]              = props.driverVersion;
+    root["render_size"]         = {m_renderSize.x, m_renderSize.y};
+    root["output_size"]         = {m_outputSize.x, m_outputSize.y};
+    root["dlss"]                = {{"quality", int(m_dlssQuality)}, {"preset", int(m_dlssPreset)}, {"max_depth", m_settings.maxDepth}};
+    root["timers"]              = m_profiler.toJson();
+    root["counters"]            = m_perfCounters.toJson();
+    root["pipelines"]           = {{"raytrace", pipelineExecutableStatsToJson(m_rtPipelineStats)}};
+    root["instance_generation"] = m_instanceGen.toJson();
+    root["geometry_streaming"]  = m_streamer.toJson();
+    root["lod"]                 = {{"meshes", m_lods.toJson()}, {"comparison", m_lodComparison.toJson()}};
+    root["material_editing"]    = m_materialEditor.toJson();
+    root["indirect_rate"]       = {{"rates", m_indirectRate.toJson()}, {"comparison", m_indirectComparison.toJson()}};
+    root["foveation"]           = {{"settings", m_foveation.toJson()},
+                                   {"skipped_fraction", m_foveation.skippedFraction({m_renderSize.x, m_renderSize.y})},
+                                   {"comparison_per_eye", m_foveationComparison.toJson()}};
+    root["stereo"]              = {{"reuse", m_stereo.toJson()}, {"comparison_second_eye", m_stereoComparison.toJson()}};
+    root["tile_dispatch"]       = m_tileDispatch.toJson();
+    root["hit_records"]         = {{"enabled", hitRecordsActive()},
+                                   {"render_nodes", m_hitRecords.size()},
+                                   {"comparison", m_hitRecordComparison.toJson()},
+                                   {"comparison_hit_clocks", m_hitRecordCostComparison.toJson()}};
+    root["compact_materials"]   = {{"table", m_materialTable.toJson()},
+                                   {"comparison", m_materialComparison.toJson()},
+                                   {"comparison_hit_clocks", m_materialCostComparison.toJson()}};
+    root["environment_loading"] = m_envLoader.toJson();
+    root["scene"]               = {{"file", m_sceneStats.file},
+                                   {"load_ms", m_sceneStats.loadMs},
+                                   {"upload_ms", m_sceneStats.uploadMs},
+                                   {"as_build_ms", m_sceneStats.accelerationMs},
+                                   {"blas_bytes", m_sceneStats.blasBytes},
+                                   {"device_memory_bytes", m_sceneStats.deviceMemoryBytes},
+                                   {"render_nodes", m_scene.getRenderNodes().size()},
+                                   {"render_primitives", m_scene.getRenderPrimitives().size()}};
+    if(m_info.stressScene.isEnabled())
+    {
+      root["scene"]["stress"] = m_info.stressScene.toJson();
+    }
+    root["present"]                = {{"fused", fusedPresent()},
+                                      {"fused_supported", m_fusedPresent.isSupported()},
+                                      {"hdr_display", m_hdrDisplay.toJson()}};
+    root["environment_octahedral"] = {{"enabled", m_envOctahedral},
+                                      {"equirect_resident", m_env->equirect},
+                                      {"secondary_lod", m_envSecondaryLod},
+                                      {"map", m_env->octahedral.toJson()},
+                                      {"comparison", m_envComparison.toJson()}};
+    return root;
+  }
+
+  // Device and driver the profile database keys the costs by
+  std::pair<std::string, std::string> profileDeviceKey() const
+  {
+    VkPhysicalDeviceDriverProperties driver{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DRIVER_PROPERTIES};
+    VkPhysicalDeviceProperties2      props{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2, &driver};
+    vkGetPhysicalDeviceProperties2(m_app->getPhysicalDevice(), &props);
+    return {props.properties.deviceName,
+            driver.driverInfo[0] != '\0' ? driver.driverInfo : std::to_string(props.properties.driverVersion)};
+  }
+
+  ProfileConfig profileConfig() const
+  {
+    return {.quality = int(m_dlssQuality), .preset = int(m_dlssPreset), .maxDepth = m_settings.maxDepth, .outputSize = m_outputSize};
   }
 
-  void writeSceneSet()
+  void applyProfileConfig(const ProfileConfig& config)
   {
-    if(!m_scene.valid())
+    m_dlssQuality       = NVSDK_NGX_PerfQuality_Value(config.quality);
+    m_dlssPreset        = NVSDK_NGX_RayReconstruction_Hint_Render_Preset(config.preset);
+    m_settings.maxDepth = config.maxDepth;
+    m_outputSize        = config.outputSize;
+  }
+
+  // Starts the profile sweep, or picks the defaults meeting the target frame time from the costs measured on this GPU
+  void initProfileDefaults()
+  {
+    const ProfileDatabase::Settings& settings = m_info.profiles;
+    if(settings.file.empty() || !m_profileDb.load(settings.file))
+    {
+      return;
+    }
+    if(settings.sweep)
+    {
+      m_profileSweep = ProfileDatabase::sweepConfigs();
+      applyProfileConfig(m_profileSweep.front());
+      return;
+    }
+    if(settings.targetMs <= 0.0f)
     {
       return;
     }
 
-    nvvk::WriteSetContainer writes;
+    const auto [device, driver]         = profileDeviceKey();
+    const ProfileDevice*         entry  = m_profileDb.find(device, driver);
+    std::optional<ProfileConfig> config = entry ? ProfileDatabase::choose(entry->points, m_outputSize, settings.targetMs) : std::nullopt;
+    if(!config)
+    {
+      LOGW("No costs of %s in %s, keeping the default settings\n", device.c_str(), settings.file.string().c_str());
+      return;
+    }
+    applyProfileConfig(*config);
+    LOGI("Settings for %.2f ms on %s (costs measured with driver %s): quality %d, preset %d, depth %d, estimated %.2f ms\n",
+         settings.targetMs, device.c_str(), entry->driver.c_str(), config->quality, config->preset, config->maxDepth,
+         ProfileDatabase::estimateMs(entry->points, config->quality, config->preset, config->maxDepth, m_outputSize).value_or(0.0));
+  }
 
-    std::vector<VkDescriptorImageInfo> diit;
-    for(const auto& texture : m_sceneVk.textures())  // All texture samplers
+  // Adds the costs of the benchmark that just ended to the profile database
+  void recordProfilePoint()
+  {
+    ProfilePoint point{.config = profileConfig()};
+    for(uint32_t pass = 0; pass < eNumProfilerPasses; ++pass)
     {
-      diit.emplace_back(texture.descriptor);
+      const double ms                            = m_profiler.statistics(pass).averageMs;
+      point.passMs[m_profiler.passNames()[pass]] = ms;
+      point.frameMs += ms;
     }
-    writes.append(m_sceneBindings.makeWrite(shaderio::SceneBindings::eTextures), diit.data());
+    const auto [device, driver] = profileDeviceKey();
+    m_profileDb.record(device, driver, point);
+    m_profileDb.save(m_info.profiles.file);  // after every point, a sweep takes a while
+    LOGI("Profile of quality %d, preset %d, depth %d at %ux%u: %.3f ms\n", point.config.quality, point.config.preset,
+         point.config.maxDepth, point.config.outputSize.x, point.config.outputSize.y, point.frameMs);
+  }
 
-    vkUpdateDescriptorSets(m_device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+  bool exportProfile(const std::filesystem::path& filename) const
+  {
+    const nlohmann::json root = profileJson();
+
+    std::ofstream file(filename);
+    if(!file)
+    {
+      LOGE("Could not write %s\n", filename.string().c_str());
+      return false;
+    }
+    file << root.dump(2);
+    LOGI("Profile written to %s\n", filename.string().c_str());
+    return true;
   }
 
   //--------------------------------------------------------------------------------------------------
@@ -1100,6 +2288,36 @@ private:
   //
   void resetFrame() { m_frame = 0; }
 
+  // Hashes what the frame rendered last left in the render and output buffers, see FrameHashes
+  void hashFrameBuffers()
+  {
+    static const char* renderNames[] = {"base_color_metalness", "spec_albedo", "spec_hit_dist", "normal_roughness",
+                                        "motion_vectors",       "view_z",      "color"};
+    static_assert(std::size(renderNames) == eNumRenderBufferNames);
+    static const char* outputNames[] = {"denoised", "denoised_second", "ldr"};
+    static_assert(std::size(outputNames) == eNumOutputBufferNames);
+
+    auto hash = [&](nvvk::GBuffer& gbuffer, uint32_t index, const char* name, glm::uvec2 size) {
+      const VkFormat format = gbuffer.getColorFormat(index);
+      m_hashes.add(name, format, {size.x, size.y},
+                   downloadImageTexels(m_app, &m_alloc, gbuffer.getColorImage(index), format, {size.x, size.y}));
+    };
+    for(uint32_t i = 0; i < eNumRenderBufferNames; ++i)
+    {
+      hash(m_renderBuffers, i, renderNames[i], m_renderSize);
+    }
+    hash(m_outputBuffers, eGBufColorOut, outputNames[eGBufColorOut], m_outputSize);
+    if(m_stereo.enabled)
+    {
+      hash(m_outputBuffers, eGBufColorOutSecond, outputNames[eGBufColorOutSecond], m_outputSize);
+    }
+    if(!fusedPresent())
+    {
+      hash(m_outputBuffers, eGBufLdr, outputNames[eGBufLdr], m_outputSize);
+    }
+    m_hashes.endFrame();
+  }
+
   void windowTitle()
   {
     // Window Title
@@ -1124,7 +2342,7 @@ private:
   //
   void screenPicking()
   {
-    auto* tlas = m_sceneRtx.tlas();
+    auto* tlas = activeTlas();
     if(tlas == VK_NULL_HANDLE)
       return;
 
@@ -1149,7 +2367,7 @@ private:
     pick_info.pickPos        = {local_mouse_pos.x, local_mouse_pos.y};
     pick_info.modelViewInv   = glm::inverse(view);
     pick_info.perspectiveInv = glm::inverse(proj);
-    pick_info.tlas           = m_sceneRtx.tlas();
+    pick_info.tlas           = tlas;
 
     // Run and wait for result
     m_picker.run(cmd, pick_info);
@@ -1177,17 +2395,302 @@ private:
     m_cameraManip->getLookat(eye, center, up);
     m_cameraManip->setLookat(eye, world_pos, up, false);
 
-    // Logging picking info.
-    const nvvkgltf::RenderNode& renderNode = m_scene.getRenderNodes()[pr.instanceID];
-    const tinygltf::Node&       node       = m_scene.getModel().nodes[renderNode.refNodeID];
+    // Logging picking info. Every LOD level has its own instances of the render nodes.
+    const size_t                renderNodeID = size_t(pr.instanceID) % m_scene.getRenderNodes().size();
+    const nvvkgltf::RenderNode& renderNode   = m_scene.getRenderNodes()[renderNodeID];
+    const tinygltf::Node&       node         = m_scene.getModel().nodes[renderNode.refNodeID];
 
     LOGI("Node Name: %s\n", node.name.c_str());
     LOGI(" - GLTF: NodeID: %d, MeshID: %d, TriangleId: %d\n", renderNode.refNodeID, node.mesh, pr.primitiveID);
-    LOGI(" - Render: GltfRenderNode: %d, RenderPrim: %d\n", pr.instanceID, pr.instanceCustomIndex);
+    LOGI(" - Render: GltfRenderNode: %zu, RenderPrim: %d, LOD: %d\n", renderNodeID, pr.instanceCustomIndex & INSTANCE_PRIM_MASK,
+         (pr.instanceCustomIndex >> INSTANCE_LOD_SHIFT) & INSTANCE_LOD_MASK);
     LOGI("{%3.2f, %3.2f, %3.2f}, Dist: %3.2f\n", world_pos.x, world_pos.y, world_pos.z, pr.hitT);
   }
 
-  void raytraceScene(VkCommandBuffer cmd)
+  //--------------------------------------------------------------------------------------------------
+  // Records one pass of the frame, starting with the barriers making its inputs available.
+  // Each pass is self contained so it can be timed, and replayed on its own for counter collection.
+  // A replay leaves the host side of the frame as it is.
+  //
+  void cmdPass(VkCommandBuffer cmd, ProfilerPass pass)
+  {
+    const uint32_t readbackSlot = m_replaying ? ReadbackRing::kReplaySlot : m_app->getFrameCycleIndex();
+
+    // Helper lambdas to make writing image pipeline barriers easier
+    auto imageShaderWriteToRead = [](VkImage image, VkPipelineStageFlagBits2 srcStage, VkPipelineStageFlagBits2 dstStage) {
+      return nvvk::makeImageMemoryBarrier({
+          .image         = image,
+          .oldLayout     = VK_IMAGE_LAYOUT_GENERAL,
+          .newLayout     = VK_IMAGE_LAYOUT_GENERAL,
+          .srcStageMask  = srcStage,
+          .dstStageMask  = dstStage,
+          .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+          .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+      });
+    };
+    auto imageShaderReadToWrite = [](VkImage image, VkPipelineStageFlagBits2 srcStage, VkPipelineStageFlagBits2 dstStage) {
+      return nvvk::makeImageMemoryBarrier({.image         = image,
+                                           .oldLayout     = VK_IMAGE_LAYOUT_GENERAL,
+                                           .newLayout     = VK_IMAGE_LAYOUT_GENERAL,
+                                           .srcStageMask  = srcStage,
+                                           .dstStageMask  = dstStage,
+                                           .srcAccessMask = VK_ACCESS_SHADER_READ_BIT,
+                                           .dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT});
+    };
+
+    auto gbufferShaderWriteToRead = [&]<typename T, size_t N, typename G>(const G& gbuffer, const T(&buffers)[N],
+                                                                          VkPipelineStageFlagBits2 srcStage,
+                                                                          VkPipelineStageFlagBits2 dstStage) {
+      std::array<VkImageMemoryBarrier2, N> x;
+      for(size_t i = 0; i < N; ++i)
+        x[i] = imageShaderWriteToRead(gbuffer.getColorImage(buffers[i]), srcStage, dstStage);
+      return x;
+    };
+    auto gbufferShaderReadToWrite = [&]<typename T, size_t N, typename G>(const G& gbuffer, const T(&buffers)[N],
+                                                                          VkPipelineStageFlagBits2 srcStage,
+                                                                          VkPipelineStageFlagBits2 dstStage) {
+      std::array<VkImageMemoryBarrier2, N> x;
+      for(size_t i = 0; i < N; ++i)
+        x[i] = imageShaderReadToWrite(gbuffer.getColorImage(buffers[i]), srcStage, dstStage);
+      return x;
+    };
+
+    auto renderBufferShaderWriteToRead = [&]<std::size_t N>(const RenderBufferName(&buffers)[N], VkPipelineStageFlagBits2 srcStage,
+                                                            VkPipelineStageFlagBits2 dstStage) {
+      return gbufferShaderWriteToRead(m_renderBuffers, buffers, srcStage, dstStage);
+    };
+    auto renderBufferShaderReadToWrite = [&]<std::size_t N>(const RenderBufferName(&buffers)[N], VkPipelineStageFlagBits2 srcStage,
+                                                            VkPipelineStageFlagBits2 dstStage) {
+      return gbufferShaderReadToWrite(m_renderBuffers, buffers, srcStage, dstStage);
+    };
+    auto outputBufferShaderReadToWrite = [&]<std::size_t N>(const OutputBufferName(&buffers)[N], VkPipelineStageFlagBits2 srcStage,
+                                                            VkPipelineStageFlagBits2 dstStage) {
+      return gbufferShaderReadToWrite(m_outputBuffers, buffers, srcStage, dstStage);
+    };
+    auto outputBufferShaderWriteToRead = [&]<std::size_t N>(const OutputBufferName(&buffers)[N], VkPipelineStageFlagBits2 srcStage,
+                                                            VkPipelineStageFlagBits2 dstStage) {
+      return gbufferShaderWriteToRead(m_outputBuffers, buffers, srcStage, dstStage);
+    };
+
+    auto cmdImageBarriers = [&](const std::initializer_list<const std::span<const VkImageMemoryBarrier2>>& barriers) {
+      std::vector<VkImageMemoryBarrier2> final;
+      for(auto b : barriers)
+        final.insert(final.end(), b.begin(), b.end());
+
+      const VkDependencyInfo depInfo{.sType                   = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+                                     .imageMemoryBarrierCount = (uint32_t) final.size(),
+                                     .pImageMemoryBarriers    = final.data()};
+      vkCmdPipelineBarrier2(cmd, &depInfo);
+    };
+
+    switch(pass)
+    {
+      case ePassInstances:
+        // Residency decisions and uploads are made once per frame
+        if(!m_replaying)
+        {
+          m_streamer.cmdUpdate(cmd, m_instanceGen, glm::vec3(m_frameInfo.viewInv[3]),
+                               -glm::normalize(glm::vec3(m_frameInfo.viewInv[2])), m_app->getFrameCycleIndex());
+        }
+        m_instanceGen.cmdGenerate(cmd, glm::vec3(m_frameInfo.viewInv[3]), m_app->getFrameCycleIndex());
+        break;
+
+      case ePassRaytrace:
+        if(!m_tileSlice || m_tileSlice->first)
+        {
+          // Rates from the last frame's buffers, before the trace overwrites them
+          if(indirectRateActive())
+          {
+            m_indirectRate.cmdComputeRates(cmd, indirectRateInputs(), {m_renderSize.x, m_renderSize.y});
+          }
+
+          // Make Guide Buffers writeable to raytracer
+          cmdImageBarriers({renderBufferShaderReadToWrite(
+              {eGBufBaseColor_Metalness, eGBufSpecAlbedo, eGBufSpecHitDist, eGBufNormalRoughness, eGBufMotionVectors, eGBufViewZ, eGBufColor},
+              VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR)});
+
+          if(m_costAttribution.isEnabled())
+          {
+            m_costAttribution.cmdClear(cmd);
+          }
+        }
+        else
+        {
+          // The progressive display read the color of the earlier slices
+          cmdImageBarriers({renderBufferShaderReadToWrite({eGBufColor}, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                                                          VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR)});
+        }
+
+        // Pathtrace the scene, or this submission's tiles of it
+        if(m_tileSlice)
+        {
+          raytraceScene(cmd, m_bFrameInfo.address, m_tileSlice->tiles);
+        }
+        else
+        {
+          raytraceScene(cmd, m_bFrameInfo.address);
+        }
+        if(m_tileSlice && !m_tileSlice->last)
+        {
+          // Tiles of the frame remain; the viewport shows the ones traced so far
+          cmdImageBarriers({renderBufferShaderWriteToRead({eGBufColor}, VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
+                                                          VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT)});
+          break;
+        }
+
+        if(indirectRateActive())
+        {
+          m_indirectRate.cmdReconstruct(cmd, indirectRateInputs(), {m_renderSize.x, m_renderSize.y}, readbackSlot);
+        }
+
+        if(m_costAttribution.isEnabled())
+        {
+          m_costAttribution.cmdReadback(cmd, readbackSlot);
+        }
+        break;
+
+      case ePassDenoise:
+        // Make Guide Buffers readable to DLSS_RR
+        cmdImageBarriers({renderBufferShaderWriteToRead({eGBufBaseColor_Metalness, eGBufSpecAlbedo, eGBufSpecHitDist,
+                                                         eGBufNormalRoughness, eGBufMotionVectors, eGBufViewZ, eGBufColor},
+                                                        VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT),
+                          outputBufferShaderReadToWrite({eGBufColorOut},
+                                                        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                                                        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT)});
+
+        // #DLSS
+        setDlssResources(m_dlss, eGBufColorOut);
+        // Check, but don't exit here, because we can disable non-optional guide buffers
+        NGX_CHECK(m_dlss.denoise(cmd, m_renderSize, m_frameInfo.jitter, m_frameInfo.view, m_frameInfo.proj, m_frame == 0));
+        break;
+
+      case ePassStereoTrace:
+        if(!m_stereo.enabled)
+        {
+          break;
+        }
+        // The first eye's shading, before the second eye overwrites the render buffers
+        if(m_stereo.reuse)
+        {
+          m_stereo.cmdCapture(cmd, stereoInputs(), {m_renderSize.x, m_renderSize.y});
+        }
+        cmdImageBarriers({renderBufferShaderReadToWrite(
+            {eGBufBaseColor_Metalness, eGBufSpecAlbedo, eGBufSpecHitDist, eGBufNormalRoughness, eGBufMotionVectors, eGBufViewZ, eGBufColor},
+            VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR)});
+
+        raytraceScene(cmd, m_bFrameInfoSecond.address);
+        if(m_stereo.reuse)
+        {
+          m_stereo.cmdReduce(cmd, stereoInputs(), {m_renderSize.x, m_renderSize.y}, readbackSlot);
+        }
+        break;
+
+      case ePassStereoDenoise:
+        if(!m_stereo.enabled)
+        {
+          break;
+        }
+        cmdImageBarriers({renderBufferShaderWriteToRead({eGBufBaseColor_Metalness, eGBufSpecAlbedo, eGBufSpecHitDist,
+                                                         eGBufNormalRoughness, eGBufMotionVectors, eGBufViewZ, eGBufColor},
+                                                        VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT),
+                          outputBufferShaderReadToWrite({eGBufColorOutSecond},
+                                                        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                                                        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT)});
+        setDlssResources(m_dlssSecond, eGBufColorOutSecond);
+        NGX_CHECK(m_dlssSecond.denoise(cmd, m_renderSize, m_frameInfoSecond.jitter, m_frameInfoSecond.view,
+                                       m_frameInfoSecond.proj, m_frame == 0));
+        break;
+
+      case ePassTonemap:
+        if(fusedPresent())
+        {
+          // Tonemapped by the viewport composite
+          cmdImageBarriers({outputBufferShaderWriteToRead({denoisedBuffer()}, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                                          VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT)});
+          break;
+        }
+
+        // Make denoised image readable to tonemapper
+        cmdImageBarriers(
+            {outputBufferShaderWriteToRead({denoisedBuffer()}, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT),
+             outputBufferShaderReadToWrite({eGBufLdr}, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT)});
+
+        // Apply tonemapper, or the HDR display mapping in its place
+        if(m_hdrDisplay.isHdr())
+        {
+          m_hdrDisplay.cmdApply(cmd, m_outputBuffers.getSize(), m_tonemapperData.exposure,
+                                m_outputBuffers.getDescriptorImageInfo(denoisedBuffer()), m_outputBuffers.getDescriptorImageInfo(eGBufLdr));
+        }
+        else
+        {
+          m_tonemapper.runCompute(cmd, m_outputBuffers.getSize(), m_tonemapperData,
+                                  m_outputBuffers.getDescriptorImageInfo(denoisedBuffer()), m_outputBuffers.getDescriptorImageInfo(eGBufLdr));
+        }
+
+        // Make tonemapped image readabble to ImGUI
+        cmdImageBarriers({outputBufferShaderReadToWrite({eGBufLdr}, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                                        VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT)});
+        break;
+
+      case ePassAnalysis:
+        // Guide buffers are still readable by compute after DLSS_RR
+        if(m_guideStats.isEnabled())
+        {
+          std::array<VkDescriptorImageInfo, eNumRenderBufferNames> images;
+          for(uint32_t i = 0; i < eNumRenderBufferNames; ++i)
+          {
+            images[i] = m_renderBuffers.getDescriptorImageInfo(i);
+          }
+          m_guideStats.cmdReduce(cmd, images, {m_renderSize.x, m_renderSize.y}, readbackSlot);
+        }
+        if(m_reprojection.isEnabled())
+        {
+          const ReprojectionAnalyzer::Inputs inputs{.viewZ  = m_renderBuffers.getDescriptorImageInfo(eGBufViewZ),
+                                                    .normal = m_renderBuffers.getDescriptorImageInfo(eGBufNormalRoughness),
+                                                    .albedo = m_renderBuffers.getDescriptorImageInfo(eGBufBaseColor_Metalness),
+                                                    .motion = m_renderBuffers.getDescriptorImageInfo(eGBufMotionVectors)};
+          // With stereo, the render buffers hold the second eye
+          const VkDeviceAddress frameInfo = m_stereo.enabled ? m_bFrameInfoSecond.address : m_bFrameInfo.address;
+          m_reprojection.cmdAnalyze(cmd, inputs, frameInfo, {m_renderSize.x, m_renderSize.y}, readbackSlot);
+        }
+        // Not before the environment is in place, and a replay would add the frame's samples again
+        if(m_reference.isActive() && !m_envLoader.isLoading() && !m_replaying)
+        {
+          m_reference.cmdAccumulate(cmd, m_renderBuffers.getDescriptorImageInfo(eGBufColor), {m_renderSize.x, m_renderSize.y},
+                                    referenceKey(), m_app->getFrameCycleIndex());
+        }
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  IndirectRate::Inputs indirectRateInputs() const
+  {
+    return {.denoised    = m_outputBuffers.getDescriptorImageInfo(eGBufColorOut),
+            .viewZ       = m_renderBuffers.getDescriptorImageInfo(eGBufViewZ),
+            .normal      = m_renderBuffers.getDescriptorImageInfo(eGBufNormalRoughness),
+            .color       = m_renderBuffers.getDescriptorImageInfo(eGBufColor),
+            .specHitDist = m_renderBuffers.getDescriptorImageInfo(eGBufSpecHitDist)};
+  }
+
+  // What the samples of a reference partial depend on besides the frame index; the camera comes from the scene
+  std::string referenceKey() const
+  {
+    return m_sceneStats.file + " | " + m_envFile.filename().string() + " | " + std::to_string(m_renderSize.x) + "x"
+           + std::to_string(m_renderSize.y) + " | depth " + std::to_string(m_settings.maxDepth);
+  }
+
+  StereoReuse::Inputs stereoInputs() const
+  {
+    return {.color       = m_renderBuffers.getDescriptorImageInfo(eGBufColor),
+            .viewZ       = m_renderBuffers.getDescriptorImageInfo(eGBufViewZ),
+            .specHitDist = m_renderBuffers.getDescriptorImageInfo(eGBufSpecHitDist)};
+  }
+
+  // 'frameInfo' selects the eye. One launch over the render size, or one per tile of a tiled dispatch.
+  void raytraceScene(VkCommandBuffer cmd, VkDeviceAddress frameInfo, std::span<const DispatchTile> tiles = {})
   {
     NVVK_DBG_SCOPE(cmd);
 
@@ -1197,25 +2700,47 @@ private:
 
     // Ray trace
     std::vector<VkDescriptorSet> desc_sets{m_rtBindings.getSet(0), m_sceneBindings.getSet(0),
-                                           m_DlssRRBindings.getSet(0), m_hdrEnv.getDescriptorSet()};
+                                           m_DlssRRBindings.getSet(0), m_env->hdr.getDescriptorSet(),
+                                           m_env->octahedral.getDescriptorSet()};
     vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, m_rtPipelineLayout, 0,
                             static_cast<uint32_t>(desc_sets.size()), desc_sets.data(), 0, nullptr);
 
 
-    m_pushConst.frameInfo = (shaderio::FrameInfo*)m_bFrameInfo.address;
+    m_pushConst.frameInfo = (shaderio::FrameInfo*)frameInfo;
     m_pushConst.gltfScene = (shaderio::GltfScene*)m_sceneVk.sceneDesc().address;
+    m_pushConst.compactMaterials = (shaderio::CompactMaterial*)m_materialTable.address();
+    m_pushConst.proxies   = (shaderio::SimplifiedPrimitive*)m_streamer.proxyTable();
+    m_pushConst.lods      = (shaderio::SimplifiedPrimitive*)m_lods.table();
+    m_pushConst.envAlias  = (shaderio::EnvAliasEntry*)m_env->octahedral.aliasTable();
     m_pushConst.skyParams = (shaderio::SkyPhysicalParameters*)m_skyParamBuffer.address;
-    vkCmdPushConstants(cmd, m_rtPipelineLayout, VK_SHADER_STAGE_ALL, 0, sizeof(shaderio::RtxPushConstant), &m_pushConst);
-
+    m_pushConst.costInstanceOffset = m_costAttribution.instanceOffset();
+    m_pushConst.lodLevels          = m_instanceGen.activeLodLevels();
+    m_pushConst.lodInstanceStride  = m_instanceGen.nodeCount();
+    m_pushConst.numRenderPrims     = uint32_t(m_scene.getRenderPrimitives().size());
+    m_pushConst.envOctSize         = m_env->octahedral.size();
+    m_pushConst.indirectRates      = (uint32_t*)m_indirectRate.tileRates();
+    m_pushConst.indirectRadiance   = (glm::vec4*)m_indirectRate.indirectRadiance();
+    m_pushConst.renderSize         = glm::ivec2(m_renderSize);
+
+    const DispatchTile wholeFrame{{0, 0}, m_renderSize};
+    if(tiles.empty())
+    {
+      tiles = {&wholeFrame, 1};
+    }
     const auto& sbtRegions = m_sbt.getSBTRegions(0);
-    vkCmdTraceRaysKHR(cmd, &sbtRegions.raygen, &sbtRegions.miss, &sbtRegions.hit, &sbtRegions.callable, m_renderSize.x, m_renderSize.y, 1);
+    for(const DispatchTile& tile : tiles)
+    {
+      m_pushConst.tileOffset = glm::ivec2(tile.offset);
+      vkCmdPushConstants(cmd, m_rtPipelineLayout, VK_SHADER_STAGE_ALL, 0, sizeof(shaderio::RtxPushConstant), &m_pushConst);
+      vkCmdTraceRaysKHR(cmd, &sbtRegions.raygen, &sbtRegions.miss, &sbtRegions.hit, &sbtRegions.callable, tile.size.x, tile.size.y, 1);
+    }
   }
 
   void createHdr(const std::filesystem::path& filename)
   {
     auto cmd = m_app->createTempCmdBuffer();
-    m_hdrEnv.destroyEnvironment();
-    m_hdrEnv.loadEnvironment(cmd, m_stagingUploader, filename);
+    m_env->hdr.destroyEnvironment();
+    m_env->load(cmd, m_stagingUploader, filename, m_envOctahedral, false);
     m_stagingUploader.cmdUploadAppended(cmd);
 
     m_app->submitAndWaitTempCmdBuffer(cmd);
@@ -1226,18 +2751,36 @@ private:
   void destroyResources()
   {
     m_dlss.deinit();
+    m_dlssSecond.deinit();
     m_ngx.deinit();
 
     m_alloc.destroyBuffer(m_bFrameInfo);
+    m_alloc.destroyBuffer(m_bFrameInfoSecond);
 
+    m_streamer.deinit();
+    m_instanceGen.deinit();
+    m_lods.destroy();
     m_sceneRtx.deinit();
     m_sceneVk.deinit();
     m_scene.destroy();
 
-    m_hdrEnv.deinit();
+    m_envLoader.deinit();
+    m_env->deinit();
     m_skyEnv.deinit();
+    m_costAttribution.deinit();
+    m_materialEditor.deinit();
+    m_materialTable.deinit();
     m_alloc.destroyBuffer(m_skyParamBuffer);
 
+    m_guideStats.deinit();
+    m_reprojection.deinit();
+    m_indirectRate.deinit();
+    m_stereo.deinit();
+    m_reference.deinit();
+    m_perfCounters.deinit();
+    m_perfCounterProvider.deinit();
+    m_profiler.deinit();
+
     m_renderBuffers.deinit();
     m_outputBuffers.deinit();
 
@@ -1255,6 +2798,8 @@ private:
 
     m_picker.deinit();
     m_tonemapper.deinit();
+    m_fusedPresent.deinit();
+    m_hdrDisplay.deinit();
     m_samplerPool.deinit();
 
     m_stagingUploader.deinit();
@@ -1281,6 +2826,7 @@ private:
 
   NgxContext                                     m_ngx;
   DlssRR                                         m_dlss;
+  DlssRR                                         m_dlssSecond;  // second eye, only with stereo
   NVSDK_NGX_PerfQuality_Value                    m_dlssQuality = NVSDK_NGX_PerfQuality_Value_MaxQuality;
   NVSDK_NGX_RayReconstruction_Hint_Render_Preset m_dlssPreset  = NVSDK_NGX_RayReconstruction_Hint_Render_Preset_Default;
   NgxContext::SupportedSizes                     m_dlssSizes;
@@ -1290,6 +2836,7 @@ private:
 
   // Resources
   nvvk::Buffer m_bFrameInfo;
+  nvvk::Buffer m_bFrameInfoSecond;  // second eye, only with stereo
 
   // Pipeline
   shaderio::RtxPushConstant m_pushConst{
@@ -1317,31 +2864,107 @@ private:
   std::shared_ptr<nvutils::CameraManipulator> m_cameraManip;
 
   shaderio::FrameInfo m_frameInfo{.flags = FLAGS_USE_PSR | FLAGS_USE_PATH_REGULARIZATION};
+  shaderio::FrameInfo m_frameInfoSecond{};  // second eye, only with stereo
 
   nvvkgltf::Scene    m_scene;
   nvvkgltf::SceneVk  m_sceneVk;
-  nvvkgltf::SceneRtx m_sceneRtx;
+  SceneRtxBlas       m_sceneRtx;
+
+  VkPhysicalDeviceRayTracingPipelinePropertiesKHR m_rtProperties{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_PROPERTIES_KHR};
 
   nvvk::SBTGenerator m_sbt;  // Shading binding table wrapper
   nvvk::Buffer       m_sbtBuffer;
 
-  nvvk::RayPicker   m_picker;  // For ray picking info
-  nvvk::HdrIbl      m_hdrEnv;
+  std::vector<shaderio::HitRecord> m_hitRecords;  // per render node, written into the SBT
+  bool                             m_hitRecordsEnabled = true;
+
+  TraceComparison m_hitRecordComparison{{"Hit record", "Raytrace", "render nodes", "hit records"}, &m_hitRecordsEnabled};
+  TraceComparison m_hitRecordCostComparison{{"Hit record clock", "Hit shaders", "render nodes", "hit records", "clocks"}};
+
+  MaterialTable   m_materialTable;      // Compact one cache line records of the materials
+  uint32_t        m_materialEdits = 0;  // material editor edits the hit records and the table are up to date with
+  TraceComparison m_materialComparison{{"Material", "Raytrace", "full", "compact"}, &m_materialTable.settings.enabled};
+  TraceComparison m_materialCostComparison{{"Material clock", "Hit shaders", "full", "compact", "clocks"}};
+
+  nvvk::RayPicker   m_picker;       // For ray picking info
   nvvk::SamplerPool m_samplerPool;  // HdrEnvDome wants this
 
+  std::unique_ptr<Environment> m_env;  // swapped by m_envLoader
+  EnvironmentLoader            m_envLoader;
+  std::filesystem::path        m_envFile;  // reloaded when the octahedral copy is first enabled
+  bool                         m_envOctahedral   = false;
+  float                        m_envSecondaryLod = 1.0f;
+  TraceComparison              m_envComparison{{"Environment", "Raytrace", "equirectangular", "octahedral"}, &m_envOctahedral};
+  bool                         m_envComparisonPending = false;  // waits for both layouts to be loaded
+
   nvshaders::SkyPhysical          m_skyEnv;
   shaderio::SkyPhysicalParameters m_skyParams;
   nvvk::Buffer                    m_skyParamBuffer;
 
   nvshaders::Tonemapper    m_tonemapper;
   shaderio::TonemapperData m_tonemapperData;
+  FusedPresent             m_fusedPresent;
+  bool                     m_fusedPresentEnabled = false;
+  std::optional<bool>      m_fusedPresentNext;  // applied before the next frame refers to the output images
+  HdrDisplay               m_hdrDisplay;  // HDR10/scRGB output in place of the tonemapper
+
+  CostAttribution m_costAttribution;  // Per-material/instance shader clock statistics
+  MaterialEditor  m_materialEditor;   // In-place material and texture changes
+
+  InitInfo              m_info;
+  PassProfiler          m_profiler;             // GPU time per pass
+  VkPerfCounterProvider m_perfCounterProvider;  // Only initialized with VK_KHR_performance_query
+  PerfCounterCapture    m_perfCounters;         // Hardware counters per pass, captured on demand
+  bool                  m_replaying = false;    // cmdPass() records a counter replay, see capturePerfCounters()
+  Benchmark             m_benchmark;
+
+  std::vector<PipelineExecutableStats> m_rtPipelineStats;
+
+  GuideStats           m_guideStats;    // Per-frame validation of the DLSS_RR guide buffers
+  ReprojectionAnalyzer m_reprojection;  // Motion vector check against the previous frame
+  InstanceGenerator    m_instanceGen;   // Per-frame TLAS instances on the host or GPU
+  GeometryStreamer     m_streamer;      // BLAS residency within a memory budget, when enabled
+  MeshLods             m_lods;          // Simplified BLASes of the LOD levels > 0, when enabled
+  TraceComparison      m_lodComparison{{"LOD", "Raytrace", "without", "with LODs"}, &m_instanceGen.lodEnabled};
+  IndirectRate         m_indirectRate;  // Fewer indirect paths in flat regions, when enabled
+  bool                 m_indirectRateEnabled = false;  // applied at the start of the frame
+  TraceComparison      m_indirectComparison{{"Variable rate indirect", "Raytrace", "full rate", "variable rate"}, &m_indirectRateEnabled};
+  Foveation            m_foveation;  // Indirect rate falling off around the gaze, when enabled
+  TraceComparison      m_foveationComparison{{"Foveation", "Raytrace per eye", "full rate", "foveated"}, &m_foveation.enabled};
+  StereoReuse          m_stereo;  // Second eye reusing the first eye's shading, when enabled
+  TraceComparison      m_stereoComparison{{"Stereo reuse", "Second eye", "shaded", "reused"}, &m_stereo.reuse};
+  ReferenceAccumulator m_reference;  // Worker of a distributed reference accumulation, when started as one
+  TiledStill           m_still;      // Offline still rendered in tiles, when started as one
+  FrameHashes          m_hashes;     // Hashes of the buffers of every frame in the deterministic mode
+  bool                 m_hashesMatch      = true;
+  bool                 m_referenceWritten = true;
+
+  TileDispatch                       m_tileDispatch;  // Ray tracing in ordered tiles spread over submissions, when enabled
+  std::optional<TileDispatch::Slice> m_tileSlice;     // tiles of the submission being recorded, with a tiled dispatch
+
+  ProfileDatabase            m_profileDb;     // Measured costs per GPU, when a database is given
+  std::vector<ProfileConfig> m_profileSweep;  // Configurations benchmarked one after the other
+  size_t                     m_profileSweepIndex = 0;
+  bool                       m_profileSweepNext  = false;  // switch to the next one before the next frame
+
+  // Loading costs of the current scene, for the scaling curves of the stress scenes
+  struct SceneStats
+  {
+    std::string file;
+    double      loadMs            = 0.0;
+    double      uploadMs          = 0.0;  // SceneVk: buffers and textures
+    double      accelerationMs    = 0.0;  // SceneRtx BLASes and TLAS, TLAS instances
+    uint64_t    blasBytes         = 0;
+    uint64_t    deviceMemoryBytes = 0;    // everything allocated once the scene is loaded
+  } m_sceneStats;
 
 
-  RenderBufferName m_showBuffer = eNumRenderBufferNames;
+  RenderBufferName m_showBuffer            = eNumRenderBufferNames;
+  bool             m_showReprojectionError = false;
 };
 
 //////////////////////////////////////////////////////////////////////////
-int main(int, char**)
+int main(int argc, char** argv)
 {
   nvapp::ApplicationCreateInfo appInitInfo;
   appInitInfo.name  = TARGET_NAME " Example";
@@ -1349,6 +2972,142 @@ int main(int, char**)
   // spec.headless = true;
   // spec.headlessFrameCount = 10;
 
+  DlssApplet::InitInfo appletInfo;
+  bool                 perfCounterSelfTest = false;
+  bool                 guideStatsSelfTest  = false;
+  bool                 residencySelfTest   = false;
+  {
+    nvutils::ParameterRegistry parameterRegistry;
+    nvutils::ParameterParser   parameterParser(nvutils::getExecutablePath().stem().string());
+    parameterRegistry.add({"headless", "Run without a window"}, &appInitInfo.headless);
+    Benchmark::registerParameters(parameterRegistry, appletInfo.benchmark);
+    ReferenceCoordinator::registerParameters(parameterRegistry, appletInfo.reference);
+    TiledStill::registerParameters(parameterRegistry, appletInfo.still);
+    FrameHashes::registerParameters(parameterRegistry, appletInfo.hashes);
+    ProfileDatabase::registerParameters(parameterRegistry, appletInfo.profiles);
+    TileDispatch::registerParameters(parameterRegistry, appletInfo.tiles);
+    MaterialTable::registerParameters(parameterRegistry, appletInfo.materials);
+    HdrDisplay::registerParameters(parameterRegistry, appletInfo.hdrDisplay);
+    parameterRegistry.add({"perfCounterSelfTest", "Check the counter selection and aggregation with a fake provider and exit"},
+                          &perfCounterSelfTest);
+    parameterRegistry.add({"guideStatsSelfTest", "Check the guide buffer statistics on synthetic pixels and exit"}, &guideStatsSelfTest);
+    parameterRegistry.add({"residencySelfTest", "Check the geometry streaming's residency policy and exit"}, &residencySelfTest);
+    parameterRegistry.add({"instanceGeneration", "TLAS instances: 0 static, 1 host per frame, 2 GPU per frame"},
+                          &appletInfo.instanceGeneration);
+    parameterRegistry.add({"instanceCullDistance", "Distance culling of TLAS instances, 0 disables"}, &appletInfo.instanceCullDistance);
+    parameterRegistry.add({"geometryBudget", "Streams the BLASes within this many MB, with proxies for the others. 0 keeps all resident"},
+                          &appletInfo.geometryBudgetMB);
+    parameterRegistry.add({"lodLevels", "Levels of detail per mesh, including the original (1 disables, at most 4)"}, &appletInfo.lodLevels);
+    StressSceneSettings::registerParameters(parameterRegistry, appletInfo.stressScene);
+    parameterRegistry.add({"fusedPresent", "Tonemap while compositing the viewport, without the 8 bit output image"},
+                          &appletInfo.fusedPresent);
+    parameterRegistry.add({"indirectRate", "Trace half or a quarter of the indirect paths in flat, low-frequency tiles"},
+                          &appletInfo.indirectRate);
+    parameterRegistry.add({"foveation", "Trace fewer indirect paths away from the gaze"}, &appletInfo.foveation);
+    parameterRegistry.add({"gaze", "Gaze stand-in of the foveation: 0 image center, 1 mouse, 2 orbit around the center"}, &appletInfo.gaze);
+    parameterRegistry.add({"stereo", "Render a second eye that reuses the first eye's shading where it sees the same surface"},
+                          &appletInfo.stereo);
+    parameterRegistry.add({"envOctahedral", "Sample the HDR environment from an octahedral RGBA16F copy with mips"},
+                          &appletInfo.envOctahedral);
+    parameterRegistry.add({"hitRecords", "Hit groups per render node whose SBT records hold its material, with per-frame TLAS instances"},
+                          &appletInfo.hitRecords);
+    parameterParser.add(parameterRegistry);
+    parameterParser.parse(argc, argv);
+  }
+
+  // The coordinator starts the sample as its workers, it doesn't render itself
+  if(appletInfo.reference.isCoordinator())
+  {
+    return ReferenceCoordinator::run(appletInfo.reference, argc, argv);
+  }
+  if(appletInfo.reference.isWorker())
+  {
+    // Features depending on timing or on the last frame's buffers would make the samples depend on more than the frame index
+    appletInfo.geometryBudgetMB = 0;
+    appletInfo.indirectRate     = false;
+    appletInfo.foveation        = false;
+    appletInfo.stereo           = false;
+    appletInfo.tiles.enabled    = false;  // one frame per submission, the checkpoints follow the frame cycle
+    // Runs until the last frame of the range closes it
+    appInitInfo.headlessFrameCount = std::numeric_limits<int32_t>::max();
+  }
+
+  if(appletInfo.still.selfTest)
+  {
+    return TiledStill::selfTest() ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  if(appletInfo.still.isActive())
+  {
+    // Offline: every tile is rendered alike and a pass that varies the sampling per tile would show at the seams
+    appletInfo.geometryBudgetMB    = 0;
+    appletInfo.indirectRate        = false;
+    appletInfo.foveation           = false;
+    appletInfo.stereo              = false;
+    appletInfo.tiles.enabled       = false;
+    appInitInfo.headless           = true;
+    appInitInfo.headlessFrameCount = std::numeric_limits<int32_t>::max();  // the last tile closes it
+  }
+  if(appletInfo.tiles.selfTest)
+  {
+    return TileDispatch::selfTest() ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  if(appletInfo.materials.selfTest)
+  {
+    return MaterialTable::selfTest() ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  if(perfCounterSelfTest)
+  {
+    return PerfCounterCapture::selfTest() ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  if(guideStatsSelfTest)
+  {
+    return GuideStats::selfTest() ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  if(residencySelfTest)
+  {
+    return ::residencySelfTest() ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  if(appletInfo.profiles.selfTest)
+  {
+    return ProfileDatabase::selfTest() ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  if(appletInfo.profiles.sweep)
+  {
+    // Every configuration is a benchmark run, its costs go to the database
+    if(appletInfo.profiles.file.empty())
+    {
+      appletInfo.profiles.file = "profiles.json";
+    }
+    if(appletInfo.benchmark.frames == 0)
+    {
+      appletInfo.benchmark.frames = 64;
+    }
+  }
+  if(appletInfo.hashes.isDeterministic())
+  {
+    // Without input and UI, a frame depends on its index alone: the seeds and the jitter derive from it. Streaming
+    // follows timing, and the indirect rate and the orbiting gaze carry state from before the environment arrived.
+    appletInfo.geometryBudgetMB = 0;
+    appletInfo.indirectRate     = false;
+    appletInfo.foveation        = false;
+    appInitInfo.headless        = true;
+    if(appletInfo.hashes.frames > 0)
+    {
+      appInitInfo.headlessFrameCount = std::numeric_limits<int32_t>::max();  // the last hashed frame closes it
+    }
+  }
+
+  if(appletInfo.hdrDisplay.isHdr())
+  {
+    // nvapp's swapchain is SDR, an HDR10 or scRGB signal can't be shown: the last frame is written to a file instead
+    appletInfo.fusedPresent = false;
+    appInitInfo.headless    = true;
+    if(appInitInfo.headlessFrameCount != std::numeric_limits<int32_t>::max())  // unless a still or a range closes it
+    {
+      appInitInfo.headlessFrameCount = std::max(appletInfo.hdrDisplay.frames, 1);
+    }
+  }
+
   if(appInitInfo.headless)
   {
     glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
@@ -1359,6 +3118,9 @@ int main(int, char**)
   VkPhysicalDeviceRayQueryFeaturesKHR    ray_query_features{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_QUERY_FEATURES_KHR};
   VkPhysicalDeviceShaderClockFeaturesKHR clockFeature{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_CLOCK_FEATURES_KHR};
   VkPhysicalDeviceShaderObjectFeaturesEXT shaderObjectFeature{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_OBJECT_FEATURES_EXT};
+  VkPhysicalDevicePerformanceQueryFeaturesKHR perfQueryFeature{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PERFORMANCE_QUERY_FEATURES_KHR};
+  VkPhysicalDevicePipelineExecutablePropertiesFeaturesKHR pipelineExecutableFeature{
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_EXECUTABLE_PROPERTIES_FEATURES_KHR};
 
   nvvk::ContextInitInfo ctxInfo{
       .instanceExtensions = {VK_EXT_DEBUG_UTILS_EXTENSION_NAME},
@@ -1372,7 +3134,9 @@ int main(int, char**)
                            {VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME},
                            {VK_KHR_SWAPCHAIN_EXTENSION_NAME},
                            {VK_EXT_SHADER_OBJECT_EXTENSION_NAME, &shaderObjectFeature},
-                           {VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME}},
+                           {VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME},
+                           {VK_KHR_PERFORMANCE_QUERY_EXTENSION_NAME, &perfQueryFeature, false},
+                           {VK_KHR_PIPELINE_EXECUTABLE_PROPERTIES_EXTENSION_NAME, &pipelineExecutableFeature, false}},
   };
 
 #if NVVK_SUPPORTS_AFTERMATH
@@ -1407,7 +3171,12 @@ int main(int, char**)
   ctxInfo.preSelectPhysicalDeviceCallback = [](VkInstance instance, VkPhysicalDevice physicalDevice) {
     return NVSDK_NGX_SUCCEED(NgxContext::isDlssRRAvailable(instance, physicalDevice));
   };
-  ctxInfo.postSelectPhysicalDeviceCallback = [](VkInstance instance, VkPhysicalDevice physicalDevice, nvvk::ContextInitInfo& info) {
+  // The first queue renders. The second one uploads streamed geometry, on a dedicated transfer family when the
+  // device has one. It is optional: without a queue left for transfers, the rendering queue does the uploads.
+  ctxInfo.queues = {VK_QUEUE_GRAPHICS_BIT};
+
+  ctxInfo.postSelectPhysicalDeviceCallback = [&appletInfo](VkInstance instance, VkPhysicalDevice physicalDevice,
+                                                           nvvk::ContextInitInfo& info) {
     static std::vector<VkExtensionProperties> dlssrrExtensions;
     NGX_CHECK(NgxContext::getDlssRRRequiredDeviceExtensions(instance, physicalDevice, dlssrrExtensions));
     for(const auto& e : dlssrrExtensions)
@@ -1415,12 +3184,35 @@ int main(int, char**)
       info.deviceExtensions.push_back({.extensionName = e.extensionName, .specVersion = e.specVersion});
     }
 
+    // Transfer queues beyond the one the graphics queue takes
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, families.data());
+    uint32_t transferQueues = 0;
+    bool     graphicsTaken  = false;
+    for(const VkQueueFamilyProperties& family : families)
+    {
+      if(family.queueFlags & VK_QUEUE_TRANSFER_BIT)
+      {
+        const bool graphics = !graphicsTaken && (family.queueFlags & VK_QUEUE_GRAPHICS_BIT);
+        transferQueues += family.queueCount - (graphics ? 1 : 0);
+      }
+      graphicsTaken |= (family.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
+    }
+    appletInfo.transferQueue = transferQueues > 0;
+    if(appletInfo.transferQueue)
+    {
+      info.queues.push_back(VK_QUEUE_TRANSFER_BIT);
+    }
+    else
+    {
+      LOGI("No separate transfer queue, the rendering queue uploads streamed geometry\n");
+    }
+
     return true;
   };
 
-  // We need one queue. This queue will have "queue family index 0"
-  ctxInfo.queues = {VK_QUEUE_GRAPHICS_BIT};
-
   nvvk::Context vkCtx;
   if(vkCtx.init(ctxInfo) != VK_SUCCESS)
   {
@@ -1431,14 +3223,21 @@ int main(int, char**)
   appInitInfo.physicalDevice = vkCtx.getPhysicalDevice();
   appInitInfo.device         = vkCtx.getDevice();
   appInitInfo.queues.push_back(vkCtx.getQueueInfo(0));
+  if(appletInfo.transferQueue)
+  {
+    appInitInfo.queues.push_back(vkCtx.getQueueInfo(1));
+  }
 
   // Create the application
   nvapp::Application app;
   app.init(appInitInfo);
 
   // Create application elements
-  std::shared_ptr<nvapp::IAppElement> dlss_applet = std::make_shared<DlssApplet>();
-  g_elem_camera                                   = std::make_shared<nvapp::ElementCamera>();
+  // Hardware counters and pipeline statistics are optional, the extensions are not exposed everywhere
+  appletInfo.performanceQuery   = perfQueryFeature.performanceCounterQueryPools == VK_TRUE;
+  appletInfo.pipelineStatistics = pipelineExecutableFeature.pipelineExecutableInfo == VK_TRUE;
+  std::shared_ptr<DlssApplet> dlss_applet = std::make_shared<DlssApplet>(appletInfo);
+  g_elem_camera                           = std::make_shared<nvapp::ElementCamera>();
 
   app.addElement(g_elem_camera);
   app.addElement(dlss_applet);
@@ -1455,7 +3254,19 @@ int main(int, char**)
   dlss_applet->onFileDrop(hdr_file);
 
   // Load scene
-  std::filesystem::path scn_file = nvutils::findFile(R"(ABeautifulGame/glTF/ABeautifulGame.gltf)", default_search_paths);
+  std::filesystem::path scn_file;
+  if(appletInfo.stressScene.isEnabled())
+  {
+    scn_file = std::filesystem::temp_directory_path() / "dlss_rr_stress" / (appletInfo.stressScene.name() + ".glb");
+    if(!std::filesystem::exists(scn_file) && !writeStressScene(appletInfo.stressScene, scn_file))
+    {
+      scn_file.clear();
+    }
+  }
+  if(scn_file.empty())
+  {
+    scn_file = nvutils::findFile(R"(ABeautifulGame/glTF/ABeautifulGame.gltf)", default_search_paths);
+  }
   dlss_applet->onFileDrop(scn_file);
 
   // Run as fast as possible, without waiting for display vertical syncs.
@@ -1463,11 +3274,12 @@ int main(int, char**)
 
   app.run();
   app.deinit();
+  const bool succeeded = dlss_applet->succeeded();
   dlss_applet.reset();
   g_elem_camera.reset();
   g_dbgPrintf.reset();
 
   vkCtx.deinit();
 
-  return EXIT_SUCCESS;
+  return succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
 }
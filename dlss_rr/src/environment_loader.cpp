@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "environment_loader.hpp"
+
+#include <imgui/imgui.h>
+
+#include <nvapp/application.hpp>
+#include <nvutils/logger.hpp>
+#include <nvvk/check_error.hpp>
+#include <nvvk/debug_util.hpp>
+
+#include <cassert>
+
+
+EnvironmentLoader::~EnvironmentLoader()
+{
+  assert(m_pool == VK_NULL_HANDLE && "Must call deinit");
+}
+
+void EnvironmentLoader::init(nvapp::Application* app, nvvk::ResourceAllocator* alloc, nvvk::SamplerPool* samplerPool)
+{
+  assert(m_pool == VK_NULL_HANDLE && "Init already called");
+
+  m_app         = app;
+  m_alloc       = alloc;
+  m_samplerPool = samplerPool;
+
+  // Recorded by the worker, submitted to the rendering queue by poll()
+  const VkDevice                device = m_alloc->getDevice();
+  const VkCommandPoolCreateInfo poolInfo{.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+                                         .flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+                                         .queueFamilyIndex = m_app->getQueue(0).familyIndex};
+  NVVK_CHECK(vkCreateCommandPool(device, &poolInfo, nullptr, &m_pool));
+  NVVK_DBG_NAME(m_pool);
+  const VkCommandBufferAllocateInfo allocInfo{.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+                                              .commandPool        = m_pool,
+                                              .level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+                                              .commandBufferCount = 1};
+  NVVK_CHECK(vkAllocateCommandBuffers(device, &allocInfo, &m_cmd));
+  const VkFenceCreateInfo fenceInfo{.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+  NVVK_CHECK(vkCreateFence(device, &fenceInfo, nullptr, &m_fence));
+  NVVK_DBG_NAME(m_fence);
+
+  m_staging.init(m_alloc);
+  m_staging.setEnableLayoutBarriers(true);
+}
+
+void EnvironmentLoader::deinit()
+{
+  if(m_pool == VK_NULL_HANDLE)
+  {
+    return;
+  }
+  waitAndDrop();
+  releaseRetired(true);
+  m_staging.deinit();
+
+  const VkDevice device = m_alloc->getDevice();
+  vkDestroyFence(device, m_fence, nullptr);
+  vkDestroyCommandPool(device, m_pool, nullptr);
+  m_fence = VK_NULL_HANDLE;
+  m_pool  = VK_NULL_HANDLE;
+  m_cmd   = VK_NULL_HANDLE;
+}
+
+void EnvironmentLoader::waitAndDrop()
+{
+  if(m_worker.joinable())
+  {
+    m_worker.join();
+  }
+  if(m_state == State::eUploading)
+  {
+    NVVK_CHECK(vkWaitForFences(m_alloc->getDevice(), 1, &m_fence, VK_TRUE, UINT64_MAX));
+  }
+  m_staging.releaseStaging();
+  if(m_loading)
+  {
+    m_loading->deinit();
+    m_loading.reset();
+  }
+  m_state = State::eIdle;
+}
+
+void EnvironmentLoader::load(const std::filesystem::path& filename, bool octahedral, bool keepEquirect)
+{
+  if(isLoading())
+  {
+    LOGI("Dropping the environment being loaded, %s replaces it\n", filename.string().c_str());
+    waitAndDrop();
+  }
+
+  m_filename     = filename;
+  m_octahedral   = octahedral;
+  m_keepEquirect = keepEquirect;
+  m_start        = Clock::now();
+  m_recorded = false;
+  m_state    = State::eRecording;
+
+  // init() acquires a sampler, the pool isn't thread safe
+  m_loading = std::make_unique<Environment>();
+  m_loading->init(m_alloc, m_samplerPool);
+
+  m_worker = std::thread([this] {
+    const VkCommandBufferBeginInfo beginInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+                                             .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT};
+    NVVK_CHECK(vkResetCommandBuffer(m_cmd, 0));
+    NVVK_CHECK(vkBeginCommandBuffer(m_cmd, &beginInfo));
+    m_loading->load(m_cmd, m_staging, m_filename, m_octahedral, m_keepEquirect);  // decode and importance tables
+    m_staging.cmdUploadAppended(m_cmd);
+    NVVK_CHECK(vkEndCommandBuffer(m_cmd));
+
+    m_recordMs = std::chrono::duration<double, std::milli>(Clock::now() - m_start).count();
+    m_recorded.store(true, std::memory_order_release);
+  });
+}
+
+std::unique_ptr<Environment> EnvironmentLoader::poll()
+{
+  ++m_frame;
+  releaseRetired(false);
+
+  if(m_state == State::eRecording && m_recorded.load(std::memory_order_acquire))
+  {
+    m_worker.join();
+    m_prepareMs = m_recordMs;
+
+    // Same queue as the frames: the swap needs no ownership transfer, the fence tells when the staging is free
+    NVVK_CHECK(vkResetFences(m_alloc->getDevice(), 1, &m_fence));
+    const VkSubmitInfo submitInfo{.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO, .commandBufferCount = 1, .pCommandBuffers = &m_cmd};
+    NVVK_CHECK(vkQueueSubmit(m_app->getQueue(0).queue, 1, &submitInfo, m_fence));
+    m_submitted = Clock::now();
+    m_state     = State::eUploading;
+    return nullptr;
+  }
+
+  if(m_state == State::eUploading && vkGetFenceStatus(m_alloc->getDevice(), m_fence) == VK_SUCCESS)
+  {
+    const Clock::time_point now = Clock::now();
+    m_uploadMs                  = std::chrono::duration<double, std::milli>(now - m_submitted).count();
+    m_totalMs                   = std::chrono::duration<double, std::milli>(now - m_start).count();
+    m_lastFile                  = m_filename.filename().string();
+    m_loads++;
+    m_staging.releaseStaging();
+    m_state = State::eIdle;
+    LOGI("Environment %s: %.1f ms decode and importance tables, %.1f ms upload, %.1f ms until bound\n",
+         m_lastFile.c_str(), m_prepareMs, m_uploadMs, m_totalMs);
+    return std::move(m_loading);
+  }
+  return nullptr;
+}
+
+void EnvironmentLoader::retire(std::unique_ptr<Environment> environment)
+{
+  if(environment)
+  {
+    m_retired.push_back({std::move(environment), m_frame});
+  }
+}
+
+void EnvironmentLoader::releaseRetired(bool all)
+{
+  // poll() of frame F runs once the fence of frame F - cycle size was waited on
+  const uint64_t cycleSize = m_app->getFrameCycleSize();
+  std::erase_if(m_retired, [&](Retired& retired) {
+    if(!all && retired.frame + cycleSize > m_frame)
+    {
+      return false;
+    }
+    retired.environment->deinit();
+    return true;
+  });
+}
+
+void EnvironmentLoader::onUI() const
+{
+  if(isLoading())
+  {
+    ImGui::Text("Loading %s...", m_filename.filename().string().c_str());
+  }
+  if(m_loads > 0)
+  {
+    ImGui::Text("Last load: %s", m_lastFile.c_str());
+    ImGui::Text("Decode + tables %.1f ms, upload %.1f ms, total %.1f ms", m_prepareMs, m_uploadMs, m_totalMs);
+  }
+}
+
+nlohmann::json EnvironmentLoader::toJson() const
+{
+  return {{"loads", m_loads},
+          {"file", m_lastFile},
+          {"prepare_ms", m_prepareMs},
+          {"upload_ms", m_uploadMs},
+          {"total_ms", m_totalMs}};
+}
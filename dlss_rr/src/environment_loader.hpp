@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <nvvk/hdr_ibl.hpp>
+#include <nvvk/resource_allocator.hpp>
+#include <nvvk/sampler_pool.hpp>
+#include <nvvk/staging.hpp>
+#include <tinygltf/json.hpp>
+
+#include "octahedral_env.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nvapp {
+class Application;
+}
+
+
+// The HDR environment as the renderer binds it: nvvk::HdrIbl in descriptor set 3, its octahedral copy in set 4.
+// Once the octahedral copy exists the shaders don't read set 3, so the HdrIbl only holds its 1x1 texture unless
+// 'keepEquirect' asks for both layouts, as the trace time comparison does.
+struct Environment
+{
+  nvvk::HdrIbl  hdr;
+  OctahedralEnv octahedral;
+  bool          equirect = false;  // hdr holds the file, not the 1x1 texture
+
+  void load(VkCommandBuffer cmd, nvvk::StagingUploader& staging, const std::filesystem::path& filename, bool convert, bool keepEquirect)
+  {
+    octahedral.load(cmd, staging, filename, convert);
+    equirect = !octahedral.isValid() || keepEquirect;
+    hdr.loadEnvironment(cmd, staging, equirect ? filename : std::filesystem::path());  // no file: 1x1 texture
+  }
+
+  void init(nvvk::ResourceAllocator* alloc, nvvk::SamplerPool* samplerPool)
+  {
+    hdr.init(alloc, samplerPool);
+    octahedral.init(alloc, samplerPool);
+  }
+  void deinit()
+  {
+    octahedral.deinit();
+    hdr.deinit();
+  }
+};
+
+
+// EnvironmentLoader builds a new Environment off to the side while the current one keeps rendering.
+// A worker thread decodes the HDR, builds the importance sampling table and records the upload into its own
+// command buffer and staging space. poll() submits that command buffer once the worker is done and hands the
+// environment over at the frame after the upload completed; the caller rebinds descriptor sets 3 and 4. Replaced
+// environments are destroyed once the frames in flight are done with them.
+class EnvironmentLoader
+{
+public:
+  EnvironmentLoader() = default;
+  ~EnvironmentLoader();
+
+  void init(nvapp::Application* app, nvvk::ResourceAllocator* alloc, nvvk::SamplerPool* samplerPool);
+  void deinit();  // waits for a load in progress
+
+  // Starts loading 'filename', with its octahedral copy when 'octahedral' is set, see Environment::load().
+  // A load already in progress is completed and its result dropped.
+  void load(const std::filesystem::path& filename, bool octahedral, bool keepEquirect = false);
+  bool isLoading() const { return m_state != State::eIdle; }
+
+  // Call once per frame, at its start. Returns the loaded environment in the frame it may first be bound.
+  std::unique_ptr<Environment> poll();
+
+  // Destroys 'environment' once the frames in flight that may use it are done
+  void retire(std::unique_ptr<Environment> environment);
+
+  void           onUI() const;
+  nlohmann::json toJson() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  enum class State
+  {
+    eIdle,
+    eRecording,  // worker thread decoding and recording
+    eUploading,  // submitted, waiting for the fence
+  };
+
+  struct Retired
+  {
+    std::unique_ptr<Environment> environment;
+    uint64_t                     frame = 0;
+  };
+
+  void waitAndDrop();
+  void releaseRetired(bool all);
+
+  nvapp::Application*      m_app         = nullptr;
+  nvvk::ResourceAllocator* m_alloc       = nullptr;
+  nvvk::SamplerPool*       m_samplerPool = nullptr;
+  VkCommandPool            m_pool        = VK_NULL_HANDLE;
+  VkCommandBuffer          m_cmd         = VK_NULL_HANDLE;
+  VkFence                  m_fence       = VK_NULL_HANDLE;
+  nvvk::StagingUploader    m_staging;  // the worker's, the renderer's uploader isn't thread safe
+
+  State                        m_state = State::eIdle;
+  std::thread                  m_worker;
+  std::atomic<bool>            m_recorded = false;
+  std::unique_ptr<Environment> m_loading;
+  std::filesystem::path        m_filename;
+  bool                         m_octahedral   = false;
+  bool                         m_keepEquirect = false;
+  std::vector<Retired>         m_retired;
+  uint64_t                     m_frame = 0;
+
+  // Timings of the last completed load
+  Clock::time_point m_start;
+  Clock::time_point m_submitted;
+  std::string       m_lastFile;
+  double            m_recordMs  = 0.0;  // written by the worker
+  double            m_prepareMs = 0.0;  // decode, importance tables and staging copy, on the worker
+  double            m_uploadMs  = 0.0;  // submit to fence
+  double            m_totalMs   = 0.0;  // load() to the frame binding it
+  uint32_t          m_loads     = 0;
+};
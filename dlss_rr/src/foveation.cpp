@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "foveation.hpp"
+
+#include <nvgui/property_editor.hpp>
+
+#include "shaders/host_device.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+void Foveation::trackViewport(const ImVec2& min, const ImVec2& size, bool hovered)
+{
+  if(hovered && size.x > 0.0f && size.y > 0.0f)
+  {
+    const ImVec2 mouse = ImGui::GetMousePos();
+    m_mouse            = glm::clamp(glm::vec2((mouse.x - min.x) / size.x, (mouse.y - min.y) / size.y), glm::vec2(0.0f), glm::vec2(1.0f));
+  }
+}
+
+void Foveation::advance(VkExtent2D renderSize)
+{
+  switch(source)
+  {
+    case GazeSource::eMouse:
+      m_gaze = m_mouse;
+      break;
+    case GazeSource::eOrbit: {
+      // A circle in pixels: the x offset in normalized coordinates shrinks with the aspect ratio
+      const float angle  = float(m_frame % std::max(orbitFrames, 1u)) / float(std::max(orbitFrames, 1u)) * 6.2831853f;
+      const float aspect = float(renderSize.height) / float(std::max(renderSize.width, 1u));
+      m_gaze             = glm::vec2(0.5f) + orbitRadius * glm::vec2(std::cos(angle) * aspect, std::sin(angle));
+      break;
+    }
+    default:
+      m_gaze = glm::vec2(0.5f);
+      break;
+  }
+  m_frame++;
+}
+
+glm::vec4 Foveation::frameParams(VkExtent2D renderSize) const
+{
+  const float height = float(renderSize.height);
+  const float inner  = innerRadius * height;
+  return {m_gaze.x * float(renderSize.width), m_gaze.y * height, inner, std::max(outerRadius * height, inner)};
+}
+
+glm::uvec3 Foveation::tileRates(VkExtent2D renderSize) const
+{
+  // Per tile center, like the rates of IndirectRate
+  const glm::vec4 params = frameParams(renderSize);
+  const uint32_t  tilesX = (renderSize.width + INDIRECT_RATE_TILE - 1) / INDIRECT_RATE_TILE;
+  const uint32_t  tilesY = (renderSize.height + INDIRECT_RATE_TILE - 1) / INDIRECT_RATE_TILE;
+  glm::uvec3      rates(0);
+  for(uint32_t y = 0; y < tilesY; ++y)
+  {
+    for(uint32_t x = 0; x < tilesX; ++x)
+    {
+      const glm::vec2 center   = (glm::vec2(x, y) + 0.5f) * float(INDIRECT_RATE_TILE);
+      const float     distance = glm::length(center - glm::vec2(params));
+      rates[distance < params.z ? INDIRECT_RATE_FULL : (distance < params.w ? INDIRECT_RATE_HALF : INDIRECT_RATE_QUARTER)]++;
+    }
+  }
+  return rates;
+}
+
+double Foveation::skippedFraction(VkExtent2D renderSize) const
+{
+  const glm::uvec3 rates = tileRates(renderSize);
+  const uint32_t   tiles = rates.x + rates.y + rates.z;
+  return tiles > 0 ? (0.5 * rates.y + 0.75 * rates.z) / double(tiles) : 0.0;
+}
+
+void Foveation::drawOverlay(const ImVec2& min, const ImVec2& size) const
+{
+  ImDrawList*  drawList = ImGui::GetWindowDrawList();
+  const ImVec2 gaze(min.x + m_gaze.x * size.x, min.y + m_gaze.y * size.y);
+  drawList->AddCircle(gaze, innerRadius * size.y, IM_COL32(80, 255, 80, 160), 64, 1.5f);
+  drawList->AddCircle(gaze, std::max(outerRadius, innerRadius) * size.y, IM_COL32(255, 200, 60, 160), 64, 1.5f);
+  drawList->AddCircleFilled(gaze, 3.0f, IM_COL32(255, 255, 255, 200));
+}
+
+void Foveation::onUI()
+{
+  using namespace nvgui;
+
+  int gazeSource = int(source);
+  PropertyEditor::begin();
+  PropertyEditor::entry("Enable", [&] { return ImGui::Checkbox("##foveation", &enabled); },
+                        "Half rate indirect paths beyond the inner radius, quarter rate beyond the outer one");
+  if(PropertyEditor::entry(
+         "Gaze", [&] { return ImGui::Combo("##gaze", &gazeSource, "Center\0Mouse\0Orbit\0"); },
+         "Stand-in for an eye tracker: the image center, the mouse over the viewport, or a circle around the center"))
+  {
+    source = GazeSource(gazeSource);
+  }
+  PropertyEditor::entry(
+      "Inner Radius", [&] { return ImGui::SliderFloat("##inner", &innerRadius, 0.0f, 1.0f, "%.2f"); },
+      "Full rate region, fraction of the image height");
+  PropertyEditor::entry(
+      "Outer Radius", [&] { return ImGui::SliderFloat("##outer", &outerRadius, 0.0f, 1.5f, "%.2f"); },
+      "Half rate region, fraction of the image height");
+  if(source == GazeSource::eOrbit)
+  {
+    PropertyEditor::entry(
+        "Orbit Radius", [&] { return ImGui::SliderFloat("##orbit", &orbitRadius, 0.0f, 0.5f, "%.2f"); },
+        "Distance of the orbiting gaze to the center, fraction of the image height");
+  }
+  PropertyEditor::end();
+}
+
+nlohmann::json Foveation::toJson() const
+{
+  static const char* sources[] = {"center", "mouse", "orbit"};
+  return {{"enabled", enabled},
+          {"gaze", sources[int(source)]},
+          {"inner_radius", innerRadius},
+          {"outer_radius", outerRadius},
+          {"orbit_radius", orbitRadius},
+          {"orbit_frames", orbitFrames}};
+}
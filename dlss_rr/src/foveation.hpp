@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <glm/glm.hpp>
+#include <imgui/imgui.h>
+#include <tinygltf/json.hpp>
+
+#include <cstdint>
+
+
+// Foveation lowers the indirect path rate with the distance to the gaze: full rate within the inner radius, half
+// rate up to the outer radius, a quarter beyond (FLAGS_FOVEATION in primary_rgen.slang). IndirectRate reconstructs
+// the skipped pixels. Primary rays and guide buffers stay at full resolution, DLSS_RR needs them. Without an eye
+// tracker, the gaze is a stand-in: the image center, the mouse over the viewport, or a deterministic orbit around
+// the center for benchmarks. Radii are fractions of the image height.
+class Foveation
+{
+public:
+  enum class GazeSource
+  {
+    eCenter,
+    eMouse,
+    eOrbit,
+  };
+
+  bool       enabled     = false;
+  GazeSource source      = GazeSource::eCenter;
+  float      innerRadius = 0.15f;
+  float      outerRadius = 0.35f;
+  float      orbitRadius = 0.25f;  // of the orbiting gaze, fraction of the image height like the other radii
+  uint32_t   orbitFrames = 240;    // per revolution
+
+  // Mouse stand-in: the viewport image's screen rectangle, and whether the mouse is over it
+  void trackViewport(const ImVec2& min, const ImVec2& size, bool hovered);
+
+  // Moves the orbiting gaze; once per frame
+  void advance(VkExtent2D renderSize);
+
+  // FrameInfo::foveation for the render size: gaze, inner and outer radius in pixels
+  glm::vec4 frameParams(VkExtent2D renderSize) const;
+
+  // Tiles of IndirectRate at full, half and quarter rate by their center, ignoring the adaptive rates
+  glm::uvec3 tileRates(VkExtent2D renderSize) const;
+  // Share of the pixels skipping their indirect path, ignoring the adaptive rates
+  double skippedFraction(VkExtent2D renderSize) const;
+
+  // Gaze and radii on top of the viewport image
+  void drawOverlay(const ImVec2& min, const ImVec2& size) const;
+
+  void           onUI();
+  nlohmann::json toJson() const;
+
+private:
+  glm::vec2 m_gaze{0.5f};   // normalized image coordinates
+  glm::vec2 m_mouse{0.5f};  // last position over the viewport
+  uint32_t  m_frame = 0;
+};
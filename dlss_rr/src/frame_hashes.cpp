@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "frame_hashes.hpp"
+
+#include <nvutils/logger.hpp>
+#include <nvutils/parameter_registry.hpp>
+
+#include <cinttypes>
+#include <cstdio>
+#include <sstream>
+
+
+namespace {
+
+constexpr uint32_t kLoggedMismatches = 16;  // the first ones are the interesting ones
+
+}  // namespace
+
+
+uint64_t hashBytes(std::span<const uint8_t> data)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for(uint8_t byte : data)
+  {
+    hash = (hash ^ byte) * 1099511628211ull;
+  }
+  return hash;
+}
+
+
+void FrameHashes::registerParameters(nvutils::ParameterRegistry& registry, Settings& settings)
+{
+  registry.add({"deterministic", "Render every frame from its index alone: headless, fixed seeds and jitter, no timing dependent features"},
+               &settings.deterministic);
+  registry.add({"hashFrames", "Deterministic mode: hash the buffers of this many frames on the CPU, then exit"}, &settings.frames);
+  registry.add({"hashOutput", "File the frame hashes are written to"}, &settings.output);
+  registry.add({"hashCompare", "Frame hashes of an earlier run; exits with a failure when a hash differs"}, &settings.compare);
+}
+
+bool FrameHashes::init(const Settings& settings)
+{
+  m_settings = settings;
+  if(!isActive())
+  {
+    return true;
+  }
+
+  if(!settings.compare.empty())
+  {
+    std::ifstream file(settings.compare);
+    if(!file)
+    {
+      LOGE("Could not read the frame hashes %s\n", settings.compare.string().c_str());
+      return false;
+    }
+    std::string line;
+    while(std::getline(file, line))
+    {
+      std::istringstream fields(line);
+      uint32_t           frame = 0;
+      std::string        buffer, size, format;
+      uint64_t           hash = 0;
+      if(fields >> frame >> buffer >> size >> format >> std::hex >> hash)
+      {
+        m_expected[{frame, buffer}] = hash;
+      }
+    }
+  }
+
+  m_output.open(settings.output);
+  if(!m_output)
+  {
+    LOGE("Could not write the frame hashes %s\n", settings.output.string().c_str());
+    return false;
+  }
+  return true;
+}
+
+void FrameHashes::frameRendered(uint32_t frame)
+{
+  m_pending      = true;
+  m_pendingFrame = frame;
+}
+
+void FrameHashes::add(const std::string& buffer, VkFormat format, VkExtent2D size, std::span<const uint8_t> texels)
+{
+  const uint64_t hash = hashBytes(texels);
+  char           line[256];
+  snprintf(line, sizeof(line), "%u %s %ux%u %d %016" PRIx64 "\n", m_pendingFrame, buffer.c_str(), size.width,
+           size.height, int(format), hash);
+  m_output << line;
+
+  if(m_settings.compare.empty())
+  {
+    return;
+  }
+  m_compared++;
+  auto       expected = m_expected.find({m_pendingFrame, buffer});
+  const bool missing  = expected == m_expected.end();
+  if(missing || expected->second != hash)
+  {
+    if(m_mismatches++ < kLoggedMismatches)
+    {
+      LOGW("Frame %u, %s: hash %016" PRIx64 " %s\n", m_pendingFrame, buffer.c_str(), hash,
+           missing ? "missing in the comparison" : "differs");
+    }
+  }
+  // What remains at the end wasn't produced
+  if(!missing)
+  {
+    m_expected.erase(expected);
+  }
+}
+
+void FrameHashes::endFrame()
+{
+  m_output.flush();
+  m_pending = false;
+  m_hashed++;
+}
+
+bool FrameHashes::finish()
+{
+  if(m_settings.compare.empty())
+  {
+    LOGI("Hashes of %u frames written to %s\n", m_hashed, m_settings.output.string().c_str());
+    return true;
+  }
+  // Buffers of the earlier run this one never hashed, e.g. after an early exit or a skipped buffer
+  const uint32_t unproduced = uint32_t(m_expected.size());
+  uint32_t       logged     = 0;
+  for(const auto& [key, hash] : m_expected)
+  {
+    if(logged++ == kLoggedMismatches)
+    {
+      break;
+    }
+    LOGW("Frame %u, %s: hash %016" PRIx64 " of the comparison not produced\n", key.first, key.second.c_str(), hash);
+  }
+
+  const bool unchanged = m_mismatches == 0 && unproduced == 0;
+  LOGI("Frame hashes %s: %u of %u buffers differ from %s, %u of its buffers not produced\n", unchanged ? "unchanged" : "CHANGED",
+       m_mismatches, m_compared, m_settings.compare.string().c_str(), unproduced);
+  return unchanged;
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <span>
+#include <string>
+#include <utility>
+
+namespace nvutils {
+class ParameterRegistry;
+}
+
+
+// 64 bit FNV-1a of 'data'
+uint64_t hashBytes(std::span<const uint8_t> data);
+
+
+// FrameHashes proves that two builds render the same frames: in the deterministic mode every frame depends on its
+// index alone, and the buffers of each frame are downloaded and hashed on the CPU. The hashes are written one line
+// per buffer, "<frame> <buffer> <width>x<height> <format> <hash>", and optionally compared with those of an earlier
+// run, so that a performance change can be gated on unchanged hashes.
+class FrameHashes
+{
+public:
+  struct Settings
+  {
+    bool                  deterministic = false;  // also implied by 'frames'
+    int                   frames        = 0;      // > 0: hash this many frames, then exit
+    std::filesystem::path output        = "frame_hashes.txt";
+    std::filesystem::path compare;                // hashes of an earlier run
+
+    bool isDeterministic() const { return deterministic || frames > 0; }
+  };
+
+  // Registers the --deterministic and --hash* options
+  static void registerParameters(nvutils::ParameterRegistry& registry, Settings& settings);
+
+  // Opens the output and reads the hashes to compare with; false when either fails
+  bool init(const Settings& settings);
+
+  bool isDeterministic() const { return m_settings.isDeterministic(); }
+  bool isActive() const { return m_settings.frames > 0; }
+  bool isComplete() const { return isActive() && m_hashed == uint32_t(m_settings.frames); }
+
+  // The buffers hold 'frame' once the commands recorded so far are done
+  void frameRendered(uint32_t frame);
+  bool hasPending() const { return m_pending; }
+
+  // Hashes a buffer of the pending frame
+  void add(const std::string& buffer, VkFormat format, VkExtent2D size, std::span<const uint8_t> texels);
+  // Done with the pending frame
+  void endFrame();
+
+  uint32_t mismatches() const { return m_mismatches; }
+  // Logs the comparison; true unless a hash differed, was missing in the comparison, or a compared one wasn't produced
+  bool finish();
+
+private:
+  Settings                                             m_settings;
+  std::ofstream                                        m_output;
+  std::map<std::pair<uint32_t, std::string>, uint64_t> m_expected;  // (frame, buffer) not produced yet
+  bool                                                 m_pending      = false;
+  uint32_t                                             m_pendingFrame = 0;
+  uint32_t                                             m_hashed       = 0;
+  uint32_t                                             m_compared     = 0;
+  uint32_t                                             m_mismatches   = 0;
+};
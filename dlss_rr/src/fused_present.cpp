@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "fused_present.hpp"
+
+#include <imgui/backends/imgui_impl_vulkan.h>
+
+#include <nvapp/application.hpp>
+#include <nvutils/logger.hpp>
+#include <nvvk/check_error.hpp>
+#include <nvvk/debug_util.hpp>
+#include <nvvk/pipeline.hpp>
+#include <nvvk/shaders.hpp>
+
+#include "pass_profiler.hpp"
+#include "shaders/host_device.h"
+
+#include <GLFW/glfw3.h>
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+
+// The swapchain's format, picked the way nvvk::Swapchain does: the first of B8G8R8A8_UNORM and R8G8B8A8_UNORM
+// in sRGB nonlinear space the surface supports. Undefined when there is no window or neither is supported, the
+// swapchain then has a format the pipeline can't know.
+static VkFormat querySwapchainFormat(nvapp::Application* app)
+{
+  GLFWwindow* window = app->getWindowHandle();
+  if(window == nullptr)
+  {
+    return VK_FORMAT_UNDEFINED;
+  }
+  VkSurfaceKHR surface = VK_NULL_HANDLE;
+  if(glfwCreateWindowSurface(app->getInstance(), window, nullptr, &surface) != VK_SUCCESS)
+  {
+    return VK_FORMAT_UNDEFINED;
+  }
+  uint32_t count = 0;
+  vkGetPhysicalDeviceSurfaceFormatsKHR(app->getPhysicalDevice(), surface, &count, nullptr);
+  std::vector<VkSurfaceFormatKHR> formats(count);
+  vkGetPhysicalDeviceSurfaceFormatsKHR(app->getPhysicalDevice(), surface, &count, formats.data());
+  vkDestroySurfaceKHR(app->getInstance(), surface, nullptr);
+
+  for(VkFormat preferred : {VK_FORMAT_B8G8R8A8_UNORM, VK_FORMAT_R8G8B8A8_UNORM})
+  {
+    for(const VkSurfaceFormatKHR& format : formats)
+    {
+      if(format.format == preferred && format.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR)
+      {
+        return preferred;
+      }
+    }
+  }
+  return VK_FORMAT_UNDEFINED;
+}
+
+
+FusedPresent::~FusedPresent()
+{
+  assert(m_alloc == nullptr && "Must call deinit");
+}
+
+void FusedPresent::init(nvapp::Application* app, nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv, PassProfiler* profiler, uint32_t profilerPass)
+{
+  assert(m_alloc == nullptr && "Init already called");
+  m_app          = app;
+  m_alloc        = alloc;
+  m_profiler     = profiler;
+  m_profilerPass = profilerPass;
+
+  const VkFormat format = querySwapchainFormat(m_app);
+  if(format == VK_FORMAT_UNDEFINED)
+  {
+    LOGI("Fused present unavailable: no window or unknown swapchain format\n");
+    return;
+  }
+  const VkDevice device = m_alloc->getDevice();
+
+  // Set 0 as ImGui's backend declares it, one texture for the fragment shader
+  nvvk::DescriptorBindings imguiBindings;
+  imguiBindings.addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT);
+  NVVK_CHECK(imguiBindings.createDescriptorSetLayout(device, 0, &m_imguiSetLayout));
+  NVVK_DBG_NAME(m_imguiSetLayout);
+
+  nvvk::DescriptorBindings bindings;
+  bindings.addBinding(shaderio::PresentBindings::eTonemapper, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_FRAGMENT_BIT);
+  NVVK_CHECK(m_bindings.init(bindings, device));
+  NVVK_DBG_NAME(m_bindings.getLayout());
+
+  NVVK_CHECK(m_alloc->createBuffer(m_tonemapper, sizeof(shaderio::TonemapperData),
+                                   VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_2_TRANSFER_DST_BIT));
+  NVVK_DBG_NAME(m_tonemapper.buffer);
+  nvvk::WriteSetContainer writes;
+  writes.append(m_bindings.makeWrite(shaderio::PresentBindings::eTonemapper), m_tonemapper);
+  vkUpdateDescriptorSets(device, writes.size(), writes.data(), 0, nullptr);
+
+  // ImGui's push constant range: its scale and translation stay valid across the pipeline switch
+  const VkPushConstantRange pushConstant{VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(float) * 4};
+  NVVK_CHECK(nvvk::createPipelineLayout(device, &m_pipelineLayout, {m_imguiSetLayout, m_bindings.getLayout()}, {pushConstant}));
+  NVVK_DBG_NAME(m_pipelineLayout);
+
+  VkShaderModule module = VK_NULL_HANDLE;
+  NVVK_CHECK(nvvk::createShaderModule(module, device, spirv));
+  const std::array<VkPipelineShaderStageCreateInfo, 2> stages{{
+      {.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, .stage = VK_SHADER_STAGE_VERTEX_BIT, .module = module, .pName = "vertexMain"},
+      {.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, .stage = VK_SHADER_STAGE_FRAGMENT_BIT, .module = module, .pName = "fragmentMain"},
+  }};
+
+  // ImDrawVert
+  const VkVertexInputBindingDescription                vertexBinding{0, sizeof(ImDrawVert), VK_VERTEX_INPUT_RATE_VERTEX};
+  const std::array<VkVertexInputAttributeDescription, 3> vertexAttributes{{
+      {0, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(ImDrawVert, pos)},
+      {1, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(ImDrawVert, uv)},
+      {2, 0, VK_FORMAT_R8G8B8A8_UNORM, offsetof(ImDrawVert, col)},
+  }};
+  const VkPipelineVertexInputStateCreateInfo vertexInput{.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+                                                         .vertexBindingDescriptionCount   = 1,
+                                                         .pVertexBindingDescriptions      = &vertexBinding,
+                                                         .vertexAttributeDescriptionCount = uint32_t(vertexAttributes.size()),
+                                                         .pVertexAttributeDescriptions    = vertexAttributes.data()};
+  const VkPipelineInputAssemblyStateCreateInfo inputAssembly{.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+                                                             .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST};
+  const VkPipelineViewportStateCreateInfo viewport{.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+                                                   .viewportCount = 1,
+                                                   .scissorCount  = 1};
+  const VkPipelineRasterizationStateCreateInfo rasterization{.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+                                                             .polygonMode = VK_POLYGON_MODE_FILL,
+                                                             .cullMode    = VK_CULL_MODE_NONE,
+                                                             .frontFace   = VK_FRONT_FACE_COUNTER_CLOCKWISE,
+                                                             .lineWidth   = 1.0f};
+  const VkPipelineMultisampleStateCreateInfo multisample{.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+                                                         .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT};
+  const VkPipelineDepthStencilStateCreateInfo depthStencil{.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO};
+  // ImGui's blending
+  const VkPipelineColorBlendAttachmentState blendAttachment{.blendEnable         = VK_TRUE,
+                                                            .srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA,
+                                                            .dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+                                                            .colorBlendOp        = VK_BLEND_OP_ADD,
+                                                            .srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
+                                                            .dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+                                                            .alphaBlendOp        = VK_BLEND_OP_ADD,
+                                                            .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
+                                                                              | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT};
+  const VkPipelineColorBlendStateCreateInfo colorBlend{.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+                                                       .attachmentCount = 1,
+                                                       .pAttachments    = &blendAttachment};
+  const std::array<VkDynamicState, 2>    dynamicStates{VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+  const VkPipelineDynamicStateCreateInfo dynamicState{.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+                                                      .dynamicStateCount = uint32_t(dynamicStates.size()),
+                                                      .pDynamicStates    = dynamicStates.data()};
+  // ImGui renders with dynamic rendering into the swapchain image
+  const VkPipelineRenderingCreateInfo rendering{.sType                   = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+                                                .colorAttachmentCount    = 1,
+                                                .pColorAttachmentFormats = &format};
+
+  const VkGraphicsPipelineCreateInfo pipelineInfo{.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+                                                  .pNext               = &rendering,
+                                                  .stageCount          = uint32_t(stages.size()),
+                                                  .pStages             = stages.data(),
+                                                  .pVertexInputState   = &vertexInput,
+                                                  .pInputAssemblyState = &inputAssembly,
+                                                  .pViewportState      = &viewport,
+                                                  .pRasterizationState = &rasterization,
+                                                  .pMultisampleState   = &multisample,
+                                                  .pDepthStencilState  = &depthStencil,
+                                                  .pColorBlendState    = &colorBlend,
+                                                  .pDynamicState       = &dynamicState,
+                                                  .layout              = m_pipelineLayout};
+  NVVK_CHECK(vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipeline));
+  NVVK_DBG_NAME(m_pipeline);
+
+  vkDestroyShaderModule(device, module, nullptr);
+}
+
+void FusedPresent::deinit()
+{
+  if(m_alloc == nullptr)
+  {
+    return;
+  }
+  const VkDevice device = m_alloc->getDevice();
+  vkDestroyPipeline(device, m_pipeline, nullptr);
+  vkDestroyPipelineLayout(device, m_pipelineLayout, nullptr);
+  vkDestroyDescriptorSetLayout(device, m_imguiSetLayout, nullptr);
+  m_bindings.deinit();
+  m_alloc->destroyBuffer(m_tonemapper);
+  m_pipeline       = VK_NULL_HANDLE;
+  m_pipelineLayout = VK_NULL_HANDLE;
+  m_imguiSetLayout = VK_NULL_HANDLE;
+  m_alloc          = nullptr;
+}
+
+void FusedPresent::cmdUpdate(VkCommandBuffer cmd, const shaderio::TonemapperData& tonemapper)
+{
+  if(!isSupported())
+  {
+    return;
+  }
+
+  // The previous frame's composite may still read the settings
+  VkMemoryBarrier2 barrier{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                           .srcStageMask  = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                           .srcAccessMask = VK_ACCESS_2_SHADER_READ_BIT,
+                           .dstStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                           .dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT};
+  VkDependencyInfo depInfo{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &barrier};
+  vkCmdPipelineBarrier2(cmd, &depInfo);
+
+  vkCmdUpdateBuffer(cmd, m_tonemapper.buffer, 0, sizeof(tonemapper), &tonemapper);
+
+  barrier.srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+  barrier.dstStageMask  = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+  barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
+  vkCmdPipelineBarrier2(cmd, &depInfo);
+}
+
+VkCommandBuffer FusedPresent::renderCommandBuffer()
+{
+  // Set by the Vulkan backend while it calls the draw callbacks
+  const auto* state = static_cast<const ImGui_ImplVulkan_RenderState*>(ImGui::GetPlatformIO().Renderer_RenderState);
+  return state->CommandBuffer;
+}
+
+bool FusedPresent::image(ImTextureID texture, const ImVec2& size, bool fused)
+{
+  ImDrawList* drawList = ImGui::GetWindowDrawList();
+  fused = fused && isSupported() && ImGui::GetWindowViewport() == ImGui::GetMainViewport();
+
+  if(fused)
+  {
+    // Bound after ImGui's set 0, which stays valid: both layouts declare it identically. ImGui binds the
+    // texture's set for the draw with its own layout, leaving set 1 alone.
+    drawList->AddCallback(
+        [](const ImDrawList*, const ImDrawCmd* drawCmd) {
+          const auto*           self = static_cast<const FusedPresent*>(drawCmd->UserCallbackData);
+          const VkCommandBuffer cmd  = renderCommandBuffer();
+          const VkDescriptorSet set  = self->m_bindings.getSet(0);
+          vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, self->m_pipeline);
+          vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, self->m_pipelineLayout, 1, 1, &set, 0, nullptr);
+        },
+        this);
+  }
+  ImGui::Image(texture, size);
+  const bool clicked = ImGui::IsItemClicked();
+  if(fused)
+  {
+    drawList->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+  }
+  return clicked;
+}
+
+void FusedPresent::beginTiming()
+{
+  ImGui::GetWindowDrawList()->AddCallback(
+      [](const ImDrawList*, const ImDrawCmd* drawCmd) {
+        const auto* self = static_cast<const FusedPresent*>(drawCmd->UserCallbackData);
+        self->m_profiler->cmdBeginPass(renderCommandBuffer(), self->m_profilerPass);
+      },
+      this);
+}
+
+void FusedPresent::endTiming()
+{
+  ImGui::GetWindowDrawList()->AddCallback(
+      [](const ImDrawList*, const ImDrawCmd* drawCmd) {
+        const auto* self = static_cast<const FusedPresent*>(drawCmd->UserCallbackData);
+        self->m_profiler->cmdEndPass(renderCommandBuffer(), self->m_profilerPass);
+      },
+      this);
+}
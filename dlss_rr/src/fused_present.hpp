@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <imgui/imgui.h>
+
+#include <nvshaders_host/tonemapper.hpp>
+#include <nvvk/descriptors.hpp>
+#include <nvvk/resource_allocator.hpp>
+
+#include <span>
+
+namespace nvapp {
+class Application;
+}
+class PassProfiler;
+
+
+// FusedPresent tonemaps the denoised image while ImGui composites the viewport to the swapchain, instead of a
+// compute pass writing an 8 bit copy that ImGui samples again. Draw callbacks around the viewport's ImGui::Image
+// swap ImGui's pipeline for tonemap_present.slang, which keeps ImGui's vertices, push constants and texture set
+// and only adds the tonemapper settings in set 1. The pipeline targets the swapchain format, so it is only used
+// in the main window. Timing callbacks measure the viewport draw either way, for the comparison.
+class FusedPresent
+{
+public:
+  FusedPresent() = default;
+  ~FusedPresent();
+
+  // 'profilerPass' is the pass of 'profiler' the viewport draw is timed in
+  void init(nvapp::Application* app, nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv, PassProfiler* profiler, uint32_t profilerPass);
+  void deinit();
+
+  // False without a window, or when the swapchain format isn't known
+  bool isSupported() const { return m_pipeline != VK_NULL_HANDLE; }
+
+  // Outside of rendering, before the UI is drawn: the settings the fragment shader reads
+  void cmdUpdate(VkCommandBuffer cmd, const shaderio::TonemapperData& tonemapper);
+
+  // ImGui::Image() of 'texture', tonemapped if 'fused' and drawn in the main window. Returns whether it was clicked.
+  bool image(ImTextureID texture, const ImVec2& size, bool fused);
+
+  // Around the viewport's draws: the GPU time between both lands in the profiler pass
+  void beginTiming();
+  void endTiming();
+
+private:
+  static VkCommandBuffer renderCommandBuffer();
+
+  nvapp::Application*      m_app          = nullptr;
+  nvvk::ResourceAllocator* m_alloc        = nullptr;
+  PassProfiler*            m_profiler     = nullptr;
+  uint32_t                 m_profilerPass = 0;
+
+  VkDescriptorSetLayout m_imguiSetLayout = VK_NULL_HANDLE;  // identical to ImGui's: set 0 stays compatible
+  nvvk::DescriptorPack  m_bindings;
+  VkPipelineLayout      m_pipelineLayout = VK_NULL_HANDLE;
+  VkPipeline            m_pipeline       = VK_NULL_HANDLE;
+  nvvk::Buffer          m_tonemapper;
+};
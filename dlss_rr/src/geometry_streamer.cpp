@@ -0,0 +1,548 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "geometry_streamer.hpp"
+
+#include <imgui/imgui.h>
+
+#include <nvapp/application.hpp>
+#include <nvgui/property_editor.hpp>
+#include <nvutils/logger.hpp>
+#include <nvvk/check_error.hpp>
+#include <nvvk/debug_util.hpp>
+
+#include "mesh_simplify.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <chrono>
+#include <cstring>
+
+
+static const uint32_t     kProxyGridResolution = 16;   // cells along the largest extent of a mesh
+static const uint32_t     kMinProxyReduction   = 4;    // meshes whose proxy isn't that much smaller aren't streamed
+static const VkDeviceSize kSerializedAlignment = 256;  // serialized BLAS addresses
+
+static VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+{
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+
+GeometryStreamer::~GeometryStreamer()
+{
+  assert(m_transferPool == VK_NULL_HANDLE && "Must call deinit");
+}
+
+void GeometryStreamer::init(nvapp::Application* app, nvvk::ResourceAllocator* alloc, VkQueue transferQueue, uint32_t transferFamily)
+{
+  assert(m_transferPool == VK_NULL_HANDLE && "Init already called");
+
+  m_app            = app;
+  m_alloc          = alloc;
+  m_device         = alloc->getDevice();
+  m_transferQueue  = transferQueue;
+  m_transferFamily = transferFamily;
+  m_mainFamily     = app->getQueue(0).familyIndex;
+
+  const VkCommandPoolCreateInfo poolInfo{.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+                                         .flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+                                         .queueFamilyIndex = transferFamily};
+  NVVK_CHECK(vkCreateCommandPool(m_device, &poolInfo, nullptr, &m_transferPool));
+  NVVK_DBG_NAME(m_transferPool);
+
+  // Tells when uploads are done, without waiting for them
+  const VkSemaphoreTypeCreateInfo timelineInfo{.sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+                                               .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+                                               .initialValue  = 0};
+  const VkSemaphoreCreateInfo semaphoreInfo{.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO, .pNext = &timelineInfo};
+  NVVK_CHECK(vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &m_timeline));
+  NVVK_DBG_NAME(m_timeline);
+
+  m_garbage.resize(app->getFrameCycleSize());
+}
+
+void GeometryStreamer::deinit()
+{
+  destroyScene();
+
+  vkDestroyCommandPool(m_device, m_transferPool, nullptr);
+  vkDestroySemaphore(m_device, m_timeline, nullptr);
+  m_transferPool = VK_NULL_HANDLE;
+  m_timeline     = VK_NULL_HANDLE;
+}
+
+void GeometryStreamer::setScene(const nvvkgltf::Scene& scene, SceneRtxBlas& sceneRtx, InstanceGenerator& instances)
+{
+  destroyScene();
+
+  std::vector<nvvk::AccelerationStructure> blas = sceneRtx.releaseBlas();
+  m_meshes.resize(blas.size());
+  for(size_t i = 0; i < blas.size(); ++i)
+  {
+    m_meshes[i].blas     = blas[i];
+    m_meshes[i].blasSize = blas[i].buffer.bufferSize;
+  }
+  if(m_meshes.empty())
+  {
+    return;
+  }
+
+  buildProxies(scene);
+  serializeBlas();
+
+  // World space bounds of every instance, for the priorities
+  const std::vector<glm::vec4> bounds = computePrimitiveBounds(scene, m_meshes.size());
+  for(const nvvkgltf::RenderNode& renderNode : scene.getRenderNodes())
+  {
+    const glm::vec4& sphere = bounds[renderNode.renderPrimID];
+    const glm::mat4& world  = renderNode.worldMatrix;
+    const float      scale =
+        std::max(std::max(glm::length(glm::vec3(world[0])), glm::length(glm::vec3(world[1]))), glm::length(glm::vec3(world[2])));
+    m_instances.push_back({.renderPrimID = uint32_t(renderNode.renderPrimID),
+                           .center       = glm::vec3(world * glm::vec4(glm::vec3(sphere), 1.0f)),
+                           .radius       = sphere.w < 0.0f ? -1.0f : sphere.w * scale});
+  }
+
+  // The static TLAS references the released BLASes
+  instances.setStaticAllowed(false);
+  uint32_t streamed = 0;
+  for(uint32_t i = 0; i < uint32_t(m_meshes.size()); ++i)
+  {
+    if(m_meshes[i].state == State::eProxy)
+    {
+      instances.setBlasAddress(i, m_proxies.blasAddress(i) | BLAS_ADDRESS_PROXY_BIT);
+      streamed++;
+    }
+  }
+
+  size_t hostBytes = 0;
+  for(const Mesh& mesh : m_meshes)
+  {
+    hostBytes += mesh.serialized.size();
+  }
+  LOGI("Geometry streaming: %u of %zu render primitives streamed, %.1f MB serialized, %.1f MB of proxies\n", streamed,
+       m_meshes.size(), double(hostBytes) / (1 << 20), double(m_proxies.bytes()) / (1 << 20));
+}
+
+void GeometryStreamer::destroyScene()
+{
+  if(m_transferQueue != VK_NULL_HANDLE)
+  {
+    NVVK_CHECK(vkQueueWaitIdle(m_transferQueue));
+  }
+
+  std::vector<VkCommandBuffer> cmds;
+  for(Upload& upload : m_uploads)
+  {
+    m_alloc->destroyBuffer(upload.staging);
+    m_alloc->destroyBuffer(upload.device);
+    if(std::find(cmds.begin(), cmds.end(), upload.cmd) == cmds.end())
+    {
+      cmds.push_back(upload.cmd);
+    }
+  }
+  if(!cmds.empty())
+  {
+    vkFreeCommandBuffers(m_device, m_transferPool, uint32_t(cmds.size()), cmds.data());
+  }
+  m_uploads.clear();
+
+  for(Garbage& garbage : m_garbage)
+  {
+    releaseGarbage(garbage);
+  }
+  for(Mesh& mesh : m_meshes)
+  {
+    m_alloc->destroyAcceleration(mesh.blas);
+  }
+  m_meshes.clear();
+  m_instances.clear();
+
+  m_proxies.destroy();
+
+  m_loadCount  = 0;
+  m_evictCount = 0;
+}
+
+void GeometryStreamer::buildProxies(const nvvkgltf::Scene& scene)
+{
+  // Render primitives without a proxy get an empty slot and keep their BLAS
+  const tinygltf::Model&      model = scene.getModel();
+  std::vector<SimplifiedMesh> proxies(m_meshes.size());
+  for(size_t i = 0; i < m_meshes.size(); ++i)
+  {
+    const tinygltf::Primitive* primitive = scene.getRenderPrimitive(i).pPrimitive;
+    MeshData                   mesh;
+    if(primitive == nullptr || !readMeshData(model, *primitive, mesh))
+    {
+      continue;
+    }
+
+    SimplifiedMesh proxy = simplifyMesh(mesh.positions, mesh.triangles, kProxyGridResolution);
+    if(proxy.triangles.empty() || proxy.triangles.size() * kMinProxyReduction > mesh.triangles.size())
+    {
+      continue;
+    }
+    m_meshes[i].state = State::eProxy;
+    proxies[i]        = std::move(proxy);
+  }
+
+  m_proxies.create(m_app, m_alloc, proxies);
+}
+
+void GeometryStreamer::serializeBlas()
+{
+  std::vector<uint32_t>                   streamed;
+  std::vector<VkAccelerationStructureKHR> handles;
+  for(uint32_t i = 0; i < uint32_t(m_meshes.size()); ++i)
+  {
+    if(m_meshes[i].state == State::eProxy)
+    {
+      streamed.push_back(i);
+      handles.push_back(m_meshes[i].blas.accel);
+    }
+  }
+  if(streamed.empty())
+  {
+    return;
+  }
+  const uint32_t count = uint32_t(streamed.size());
+
+  VkQueryPool                 queryPool = VK_NULL_HANDLE;
+  const VkQueryPoolCreateInfo queryInfo{.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+                                        .queryType  = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_SERIALIZATION_SIZE_KHR,
+                                        .queryCount = count};
+  NVVK_CHECK(vkCreateQueryPool(m_device, &queryInfo, nullptr, &queryPool));
+
+  VkCommandBuffer cmd = m_app->createTempCmdBuffer();
+  vkCmdResetQueryPool(cmd, queryPool, 0, count);
+  vkCmdWriteAccelerationStructuresPropertiesKHR(cmd, count, handles.data(),
+                                                VK_QUERY_TYPE_ACCELERATION_STRUCTURE_SERIALIZATION_SIZE_KHR, queryPool, 0);
+  m_app->submitAndWaitTempCmdBuffer(cmd);
+
+  std::vector<VkDeviceSize> sizes(count);
+  NVVK_CHECK(vkGetQueryPoolResults(m_device, queryPool, 0, count, std::span(sizes).size_bytes(), sizes.data(),
+                                   sizeof(VkDeviceSize), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT));
+  vkDestroyQueryPool(m_device, queryPool, nullptr);
+
+  std::vector<VkDeviceSize> offsets(count);
+  VkDeviceSize              total = 0;
+  for(uint32_t k = 0; k < count; ++k)
+  {
+    offsets[k] = total;
+    total      = alignUp(total + sizes[k], kSerializedAlignment);
+  }
+
+  nvvk::Buffer readback;
+  NVVK_CHECK(m_alloc->createBuffer(readback, total, VK_BUFFER_USAGE_2_SHADER_DEVICE_ADDRESS_BIT, VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+                                   VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT, kSerializedAlignment));
+
+  cmd = m_app->createTempCmdBuffer();
+  for(uint32_t k = 0; k < count; ++k)
+  {
+    const VkCopyAccelerationStructureToMemoryInfoKHR copyInfo{.sType = VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_TO_MEMORY_INFO_KHR,
+                                                              .src   = handles[k],
+                                                              .dst   = {.deviceAddress = readback.address + offsets[k]},
+                                                              .mode  = VK_COPY_ACCELERATION_STRUCTURE_MODE_SERIALIZE_KHR};
+    vkCmdCopyAccelerationStructureToMemoryKHR(cmd, &copyInfo);
+  }
+  const VkMemoryBarrier2 toHost{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                .srcStageMask  = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                                .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+                                .dstStageMask  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                .dstAccessMask = VK_ACCESS_2_HOST_READ_BIT};
+  const VkDependencyInfo depToHost{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &toHost};
+  vkCmdPipelineBarrier2(cmd, &depToHost);
+  m_app->submitAndWaitTempCmdBuffer(cmd);
+
+  NVVK_CHECK(vmaInvalidateAllocation(*m_alloc, readback.allocation, 0, VK_WHOLE_SIZE));
+  const uint8_t* data = static_cast<const uint8_t*>(readback.mapping);
+  for(uint32_t k = 0; k < count; ++k)
+  {
+    Mesh& mesh = m_meshes[streamed[k]];
+    mesh.serialized.assign(data + offsets[k], data + offsets[k] + sizes[k]);
+    m_alloc->destroyAcceleration(mesh.blas);
+  }
+  m_alloc->destroyBuffer(readback);
+}
+
+void GeometryStreamer::startUploads(const std::vector<uint32_t>& renderPrimIDs)
+{
+  const VkCommandBufferAllocateInfo allocInfo{.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+                                              .commandPool        = m_transferPool,
+                                              .level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+                                              .commandBufferCount = 1};
+  VkCommandBuffer                   cmd = VK_NULL_HANDLE;
+  NVVK_CHECK(vkAllocateCommandBuffers(m_device, &allocInfo, &cmd));
+  const VkCommandBufferBeginInfo beginInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+                                           .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT};
+  NVVK_CHECK(vkBeginCommandBuffer(cmd, &beginInfo));
+
+  // Written on the transfer queue, read by the rendering queue
+  const uint32_t            families[] = {m_mainFamily, m_transferFamily};
+  std::span<const uint32_t> sharing;
+  if(m_mainFamily != m_transferFamily)
+  {
+    sharing = families;
+  }
+
+  const uint64_t value = ++m_timelineValue;
+  for(uint32_t renderPrimID : renderPrimIDs)
+  {
+    Mesh&              mesh = m_meshes[renderPrimID];
+    const VkDeviceSize size = mesh.serialized.size();
+
+    Upload upload{.renderPrimID = renderPrimID, .cmd = cmd, .value = value};
+    NVVK_CHECK(m_alloc->createBuffer(upload.staging, size, VK_BUFFER_USAGE_2_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+                                     VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT));
+    memcpy(upload.staging.mapping, mesh.serialized.data(), size);
+    NVVK_CHECK(vmaFlushAllocation(*m_alloc, upload.staging.allocation, 0, VK_WHOLE_SIZE));
+
+    NVVK_CHECK(m_alloc->createBuffer(upload.device, size,
+                                     VK_BUFFER_USAGE_2_TRANSFER_DST_BIT | VK_BUFFER_USAGE_2_SHADER_DEVICE_ADDRESS_BIT
+                                         | VK_BUFFER_USAGE_2_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR,
+                                     VMA_MEMORY_USAGE_AUTO, {}, kSerializedAlignment, sharing));
+    NVVK_DBG_NAME(upload.device.buffer);
+
+    const VkBufferCopy region{.size = size};
+    vkCmdCopyBuffer(cmd, upload.staging.buffer, upload.device.buffer, 1, &region);
+
+    mesh.state = State::eLoading;
+    m_uploads.push_back(upload);
+  }
+  NVVK_CHECK(vkEndCommandBuffer(cmd));
+
+  const VkCommandBufferSubmitInfo cmdInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO, .commandBuffer = cmd};
+  const VkSemaphoreSubmitInfo     signal{.sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+                                         .semaphore = m_timeline,
+                                         .value     = value,
+                                         .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT};
+  const VkSubmitInfo2             submit{.sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+                                         .commandBufferInfoCount   = 1,
+                                         .pCommandBufferInfos      = &cmdInfo,
+                                         .signalSemaphoreInfoCount = 1,
+                                         .pSignalSemaphoreInfos    = &signal};
+  NVVK_CHECK(vkQueueSubmit2(m_transferQueue, 1, &submit, VK_NULL_HANDLE));
+}
+
+void GeometryStreamer::releaseGarbage(Garbage& garbage)
+{
+  for(nvvk::AccelerationStructure& accel : garbage.accels)
+  {
+    m_alloc->destroyAcceleration(accel);
+  }
+  for(nvvk::Buffer& buffer : garbage.buffers)
+  {
+    m_alloc->destroyBuffer(buffer);
+  }
+  garbage.accels.clear();
+  garbage.buffers.clear();
+}
+
+void GeometryStreamer::cmdUpdate(VkCommandBuffer cmd, InstanceGenerator& instances, const glm::vec3& eye, const glm::vec3& forward, uint32_t cycleIndex)
+{
+  if(!isActive())
+  {
+    return;
+  }
+  const auto start = std::chrono::steady_clock::now();
+
+  // The frame that used this cycle index before has completed
+  Garbage& garbage = m_garbage[cycleIndex];
+  releaseGarbage(garbage);
+
+  // Finished uploads become BLASes. All uploads of a batch finish together.
+  uint64_t completed = 0;
+  NVVK_CHECK(vkGetSemaphoreCounterValue(m_device, m_timeline, &completed));
+  uint64_t                     waitValue = 0;
+  std::vector<VkCommandBuffer> doneCmds;
+  for(auto it = m_uploads.begin(); it != m_uploads.end();)
+  {
+    if(it->value > completed)
+    {
+      ++it;
+      continue;
+    }
+
+    Mesh&                                      mesh = m_meshes[it->renderPrimID];
+    const VkAccelerationStructureCreateInfoKHR createInfo{.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR,
+                                                          .size  = mesh.blasSize,
+                                                          .type  = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR};
+    NVVK_CHECK(m_alloc->createAcceleration(mesh.blas, createInfo));
+    NVVK_DBG_NAME(mesh.blas.accel);
+
+    const VkCopyMemoryToAccelerationStructureInfoKHR copyInfo{.sType = VK_STRUCTURE_TYPE_COPY_MEMORY_TO_ACCELERATION_STRUCTURE_INFO_KHR,
+                                                              .src   = {.deviceAddress = it->device.address},
+                                                              .dst   = mesh.blas.accel,
+                                                              .mode  = VK_COPY_ACCELERATION_STRUCTURE_MODE_DESERIALIZE_KHR};
+    vkCmdCopyMemoryToAccelerationStructureKHR(cmd, &copyInfo);
+
+    instances.setBlasAddress(it->renderPrimID, mesh.blas.address);
+    mesh.state = State::eResident;
+    m_loadCount++;
+
+    waitValue = std::max(waitValue, it->value);
+    m_alloc->destroyBuffer(it->staging);
+    garbage.buffers.push_back(it->device);  // read by this frame
+    if(std::find(doneCmds.begin(), doneCmds.end(), it->cmd) == doneCmds.end())
+    {
+      doneCmds.push_back(it->cmd);
+    }
+    it = m_uploads.erase(it);
+  }
+  if(!doneCmds.empty())
+  {
+    vkFreeCommandBuffers(m_device, m_transferPool, uint32_t(doneCmds.size()), doneCmds.data());
+  }
+
+  if(waitValue > 0)
+  {
+    // The instance generation's TLAS build references the new BLASes
+    const VkMemoryBarrier2 barrier{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                   .srcStageMask  = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                                   .srcAccessMask = VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+                                   .dstStageMask = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR | VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
+                                   .dstAccessMask = VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR};
+    const VkDependencyInfo depInfo{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &barrier};
+    vkCmdPipelineBarrier2(cmd, &depInfo);
+
+    // Makes the uploaded data visible to this frame's submit; already signaled, nothing is waited for
+    m_app->addWaitSemaphore({.sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+                             .semaphore = m_timeline,
+                             .value     = waitValue,
+                             .stageMask = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR});
+  }
+
+  // Priorities from the camera, the largest of all instances of a render primitive
+  for(Mesh& mesh : m_meshes)
+  {
+    mesh.priority = 0.0f;
+  }
+  for(const Instance& instance : m_instances)
+  {
+    const float priority = instance.radius < 0.0f ? FLT_MAX : residencyPriority(instance.center, instance.radius, eye, forward);
+    Mesh&       mesh     = m_meshes[instance.renderPrimID];
+    mesh.priority        = std::max(mesh.priority, priority);
+  }
+
+  std::vector<ResidencyItem> items(m_meshes.size());
+  for(size_t i = 0; i < m_meshes.size(); ++i)
+  {
+    const Mesh& mesh = m_meshes[i];
+    if(mesh.state != State::eFixed)
+    {
+      items[i] = {.bytes    = mesh.blasSize,
+                  .priority = mesh.priority,
+                  .resident = mesh.state == State::eLoading || mesh.state == State::eResident,
+                  .locked   = mesh.state == State::eLoading};
+    }
+  }
+  const ResidencyDecision decision = decideResidency(settings, items);
+
+  // Traced with the proxy from this frame on, the BLAS goes once the frames in flight are done
+  for(uint32_t renderPrimID : decision.evictions)
+  {
+    Mesh& mesh = m_meshes[renderPrimID];
+    instances.setBlasAddress(renderPrimID, m_proxies.blasAddress(renderPrimID) | BLAS_ADDRESS_PROXY_BIT);
+    garbage.accels.push_back(mesh.blas);
+    mesh.blas  = {};
+    mesh.state = State::eProxy;
+    m_evictCount++;
+  }
+  if(!decision.loads.empty())
+  {
+    startUploads(decision.loads);
+  }
+
+  m_lastUpdateMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void GeometryStreamer::onUI()
+{
+  using namespace nvgui;
+
+  if(!isActive())
+  {
+    ImGui::TextDisabled("Not active, see --geometryBudget");
+    return;
+  }
+
+  int budgetMB = int(settings.budget >> 20);
+  int maxLoads = int(settings.maxLoads);
+  PropertyEditor::begin();
+  if(PropertyEditor::entry(
+         "Budget (MB)", [&] { return ImGui::DragInt("##budget", &budgetMB, 1.0f, 0, 1 << 16); },
+         "Device memory for the full resolution BLASes of streamed render primitives"))
+  {
+    settings.budget = uint64_t(std::max(budgetMB, 0)) << 20;
+  }
+  if(PropertyEditor::entry(
+         "Loads per Frame", [&] { return ImGui::SliderInt("##loads", &maxLoads, 1, 64); }, "Uploads started per frame"))
+  {
+    settings.maxLoads = uint32_t(maxLoads);
+  }
+  PropertyEditor::entry(
+      "Resident Bias", [&] { return ImGui::SliderFloat("##bias", &settings.residentBias, 1.0f, 4.0f, "%.2f"); },
+      "Priority factor of resident BLASes, higher values evict less often");
+  PropertyEditor::end();
+
+  uint32_t     counts[4] = {};
+  VkDeviceSize resident  = 0;
+  for(const Mesh& mesh : m_meshes)
+  {
+    counts[int(mesh.state)]++;
+    if(mesh.state == State::eLoading || mesh.state == State::eResident)
+    {
+      resident += mesh.blasSize;
+    }
+  }
+  ImGui::Text("Render primitives: %u fixed, %u proxy, %u loading, %u resident", counts[int(State::eFixed)],
+              counts[int(State::eProxy)], counts[int(State::eLoading)], counts[int(State::eResident)]);
+  ImGui::Text("Resident: %.1f / %.1f MB, proxies %.1f MB", double(resident) / (1 << 20), double(settings.budget) / (1 << 20),
+              double(m_proxies.bytes()) / (1 << 20));
+  ImGui::Text("Loads: %llu, evictions: %llu, update %.3f ms", (unsigned long long)m_loadCount,
+              (unsigned long long)m_evictCount, m_lastUpdateMs);
+}
+
+nlohmann::json GeometryStreamer::toJson() const
+{
+  if(!isActive())
+  {
+    return {{"active", false}};
+  }
+
+  uint32_t     residentCount = 0;
+  VkDeviceSize resident      = 0;
+  for(const Mesh& mesh : m_meshes)
+  {
+    if(mesh.state == State::eResident)
+    {
+      residentCount++;
+      resident += mesh.blasSize;
+    }
+  }
+  return {{"active", true},
+          {"budget_bytes", settings.budget},
+          {"resident_primitives", residentCount},
+          {"resident_bytes", resident},
+          {"proxy_bytes", m_proxies.bytes()},
+          {"loads", m_loadCount},
+          {"evictions", m_evictCount}};
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <nvvk/resource_allocator.hpp>
+#include <nvvkgltf/scene.hpp>
+#include <tinygltf/json.hpp>
+
+#include "instance_gen.hpp"
+#include "residency.hpp"
+#include "simplified_blas.hpp"
+
+#include <vector>
+
+namespace nvapp {
+class Application;
+}
+
+
+// GeometryStreamer keeps the full resolution BLASes within a device memory budget.
+// At load, the BLASes built by SceneRtx are serialized to host memory and released; every render primitive
+// gets a small proxy BLAS from a vertex clustered copy of its triangles (simplifyMesh()), which stays
+// resident. Each frame decideResidency() picks the BLASes to have by distance and direction from the
+// camera. Loads upload the serialized BLAS on the transfer queue, the rendering queue deserializes it once
+// the upload is done; evicted BLASes are destroyed when the frames in flight are done with them.
+// Render primitives are switched through InstanceGenerator::setBlasAddress(), which needs a per-frame mode.
+// The vertex and index buffers of SceneVk stay resident: shading proxies uses them.
+class GeometryStreamer
+{
+public:
+  GeometryStreamer() = default;
+  ~GeometryStreamer();
+
+  // 'transferQueue' of 'transferFamily' does the uploads, it may be the rendering queue
+  void init(nvapp::Application* app, nvvk::ResourceAllocator* alloc, VkQueue transferQueue, uint32_t transferFamily);
+  void deinit();
+
+  // Takes over the BLASes of 'sceneRtx' and switches 'instances' to the proxies. Render primitives that
+  // can't be read, or whose proxy wouldn't be much smaller, keep their BLAS. Waits for the GPU.
+  void setScene(const nvvkgltf::Scene& scene, SceneRtxBlas& sceneRtx, InstanceGenerator& instances);
+  void destroyScene();
+
+  bool isActive() const { return !m_meshes.empty(); }
+
+  // Completes finished uploads, evicts and starts new uploads for the camera at 'eye'. To be recorded
+  // before InstanceGenerator::cmdGenerate(), which picks up the changed BLASes.
+  void cmdUpdate(VkCommandBuffer cmd, InstanceGenerator& instances, const glm::vec3& eye, const glm::vec3& forward, uint32_t cycleIndex);
+
+  // SimplifiedPrimitive per render primitive, for RtxPushConstant::proxies; 0 when not active
+  VkDeviceAddress proxyTable() const { return m_proxies.table(); }
+
+  void           onUI();
+  nlohmann::json toJson() const;
+
+  ResidencySettings settings;
+
+private:
+  enum class State
+  {
+    eFixed,     // not streamed, the BLAS stays
+    eProxy,     // traced with the proxy
+    eLoading,   // upload in flight
+    eResident,  // traced with the full BLAS
+  };
+
+  struct Mesh
+  {
+    State                       state = State::eFixed;
+    std::vector<uint8_t>        serialized;  // the out-of-core copy of the BLAS
+    VkDeviceSize                blasSize = 0;
+    nvvk::AccelerationStructure blas;
+    float                       priority = 0.0f;
+  };
+
+  struct Instance
+  {
+    uint32_t  renderPrimID = 0;
+    glm::vec3 center{};  // world space bounding sphere
+    float     radius = -1.0f;
+  };
+
+  // Serialized BLAS on its way to the device
+  struct Upload
+  {
+    uint32_t        renderPrimID = 0;
+    nvvk::Buffer    staging;
+    nvvk::Buffer    device;
+    VkCommandBuffer cmd   = VK_NULL_HANDLE;  // shared by the uploads of one batch, they complete together
+    uint64_t        value = 0;               // timeline value signaled when done
+  };
+
+  // Released when the frame cycle index comes around again
+  struct Garbage
+  {
+    std::vector<nvvk::AccelerationStructure> accels;
+    std::vector<nvvk::Buffer>                buffers;
+  };
+
+  void serializeBlas();
+  void buildProxies(const nvvkgltf::Scene& scene);
+  void startUploads(const std::vector<uint32_t>& renderPrimIDs);
+  void releaseGarbage(Garbage& garbage);
+
+  nvapp::Application*      m_app            = nullptr;
+  nvvk::ResourceAllocator* m_alloc          = nullptr;
+  VkDevice                 m_device         = VK_NULL_HANDLE;
+  VkQueue                  m_transferQueue  = VK_NULL_HANDLE;
+  uint32_t                 m_transferFamily = 0;
+  uint32_t                 m_mainFamily     = 0;
+  VkCommandPool            m_transferPool   = VK_NULL_HANDLE;
+  VkSemaphore              m_timeline       = VK_NULL_HANDLE;
+  uint64_t                 m_timelineValue  = 0;
+
+  std::vector<Mesh>     m_meshes;  // per render primitive
+  std::vector<Instance> m_instances;
+  std::vector<Upload>   m_uploads;
+  std::vector<Garbage>  m_garbage;  // per frame cycle index
+
+  SimplifiedBlasSet m_proxies;  // slot per render primitive, empty when not streamed
+
+  uint64_t m_loadCount    = 0;
+  uint64_t m_evictCount   = 0;
+  float    m_lastUpdateMs = 0.0f;
+};
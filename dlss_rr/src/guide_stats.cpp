@@ -0,0 +1,507 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "guide_stats.hpp"
+
+#include "image_readback.hpp"
+
+#include <imgui/imgui.h>
+
+#include <nvutils/logger.hpp>
+#include <nvvk/check_error.hpp>
+#include <nvvk/debug_util.hpp>
+#include <nvvk/descriptors.hpp>
+#include <nvvk/pipeline.hpp>
+#include <nvvk/shaders.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <random>
+
+
+GuideStats::~GuideStats()
+{
+  assert(m_pipeline == VK_NULL_HANDLE && "Must call deinit");
+}
+
+void GuideStats::init(nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv, const std::vector<Check>& checks, uint32_t frameCycleSize)
+{
+  assert(m_pipeline == VK_NULL_HANDLE && "Init already called");
+
+  m_alloc  = alloc;
+  m_device = alloc->getDevice();
+  m_checks = checks;
+  m_stats.assign(m_checks.size(), {});
+
+  const VkDeviceSize size = sizeof(shaderio::GuideStatsPartial) * GUIDE_STATS_GROUPS * m_checks.size();
+  NVVK_CHECK(m_alloc->createBuffer(m_partials, size, VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_2_TRANSFER_SRC_BIT));
+  NVVK_DBG_NAME(m_partials.buffer);
+  m_readback.init(m_alloc, size, frameCycleSize);
+
+  // Image and partials are pushed per buffer
+  nvvk::DescriptorBindings bindings;
+  bindings.addBinding(shaderio::GuideStatsBindings::eGuideImage, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+  bindings.addBinding(shaderio::GuideStatsBindings::eGuidePartials, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+  NVVK_CHECK(bindings.createDescriptorSetLayout(m_device, VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR, &m_dsetLayout));
+  NVVK_DBG_NAME(m_dsetLayout);
+
+  const VkPushConstantRange pushConstant{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(shaderio::GuideStatsPushConstant)};
+  NVVK_CHECK(nvvk::createPipelineLayout(m_device, &m_pipelineLayout, {m_dsetLayout}, {pushConstant}));
+  NVVK_DBG_NAME(m_pipelineLayout);
+
+  VkShaderModule module = VK_NULL_HANDLE;
+  NVVK_CHECK(nvvk::createShaderModule(module, m_device, spirv));
+
+  const VkComputePipelineCreateInfo pipelineInfo{
+      .sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+      .stage  = {.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, .stage = VK_SHADER_STAGE_COMPUTE_BIT, .module = module, .pName = "main"},
+      .layout = m_pipelineLayout,
+  };
+  NVVK_CHECK(vkCreateComputePipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipeline));
+  NVVK_DBG_NAME(m_pipeline);
+
+  vkDestroyShaderModule(m_device, module, nullptr);
+}
+
+void GuideStats::deinit()
+{
+  vkDestroyPipeline(m_device, m_pipeline, nullptr);
+  vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
+  vkDestroyDescriptorSetLayout(m_device, m_dsetLayout, nullptr);
+  m_pipeline       = VK_NULL_HANDLE;
+  m_pipelineLayout = VK_NULL_HANDLE;
+  m_dsetLayout     = VK_NULL_HANDLE;
+
+  m_readback.deinit();
+  m_alloc->destroyBuffer(m_partials);
+}
+
+void GuideStats::setEnabled(bool enabled)
+{
+  if(enabled != m_enabled)
+  {
+    // Don't pick up statistics of a previous run
+    m_readback.invalidate();
+    m_hasStats = false;
+  }
+  m_enabled = enabled;
+}
+
+void GuideStats::readResults(uint32_t cycleIndex)
+{
+  const auto* partials = m_readback.map<shaderio::GuideStatsPartial>(cycleIndex);
+  if(partials == nullptr || !m_enabled)
+  {
+    return;
+  }
+
+  for(size_t i = 0; i < m_checks.size(); ++i)
+  {
+    m_stats[i] = reducePartials({partials + i * GUIDE_STATS_GROUPS, GUIDE_STATS_GROUPS});
+  }
+  m_hasStats = true;
+}
+
+void GuideStats::cmdReduce(VkCommandBuffer cmd, std::span<const VkDescriptorImageInfo> images, VkExtent2D size, uint32_t cycleIndex)
+{
+  assert(images.size() == m_checks.size());
+
+  // The readback copy of the previous frame may still read the partials
+  const VkMemoryBarrier2 copyBarrier{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                     .srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                     .srcAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT,
+                                     .dstStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                     .dstAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT};
+  const VkDependencyInfo copyDepInfo{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &copyBarrier};
+  vkCmdPipelineBarrier2(cmd, &copyDepInfo);
+
+  vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+
+  const VkDescriptorBufferInfo partialsInfo{m_partials.buffer, 0, VK_WHOLE_SIZE};
+  for(uint32_t i = 0; i < uint32_t(m_checks.size()); ++i)
+  {
+    const VkWriteDescriptorSet writes[] = {
+        {.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+         .dstBinding      = shaderio::GuideStatsBindings::eGuideImage,
+         .descriptorCount = 1,
+         .descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+         .pImageInfo      = &images[i]},
+        {.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+         .dstBinding      = shaderio::GuideStatsBindings::eGuidePartials,
+         .descriptorCount = 1,
+         .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+         .pBufferInfo     = &partialsInfo},
+    };
+    vkCmdPushDescriptorSetKHR(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, 2, writes);
+
+    const shaderio::GuideStatsPushConstant pushConst = makePushConstant(m_checks[i], size, i * GUIDE_STATS_GROUPS);
+    vkCmdPushConstants(cmd, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConst), &pushConst);
+    vkCmdDispatch(cmd, GUIDE_STATS_GROUPS, 1, 1);
+  }
+
+  const VkMemoryBarrier2 barrier{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                 .srcStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                 .srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT,
+                                 .dstStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                 .dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT};
+  const VkDependencyInfo depInfo{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &barrier};
+  vkCmdPipelineBarrier2(cmd, &depInfo);
+
+  m_readback.cmdCopy(cmd, m_partials.buffer, cycleIndex);
+  if(cycleIndex != ReadbackRing::kReplaySlot)
+  {
+    m_lastSize  = size;
+    m_lastCycle = cycleIndex;
+  }
+}
+
+shaderio::GuideStatsPushConstant GuideStats::makePushConstant(const Check& check, VkExtent2D size, uint32_t partialOffset)
+{
+  return {.rangeMin        = check.rangeMin,
+          .rangeMax        = check.rangeMax,
+          .size            = {int32_t(size.width), int32_t(size.height)},
+          .channels        = check.channels,
+          .checks          = check.checks,
+          .partialOffset   = partialOffset,
+          .saturateValue   = check.saturateValue,
+          .normalTolerance = check.normalTolerance};
+}
+
+GuideStats::Stats GuideStats::reducePartials(std::span<const shaderio::GuideStatsPartial> partials)
+{
+  Stats      stats;
+  glm::vec4  minValue(FLT_MAX);
+  glm::vec4  maxValue(-FLT_MAX);
+  glm::dvec4 sum(0.0);
+  for(const shaderio::GuideStatsPartial& p : partials)
+  {
+    stats.finite += p.finite;
+    stats.nan += p.nan;
+    stats.inf += p.inf;
+    stats.outOfRange += p.outOfRange;
+    stats.special += p.special;
+    if(p.finite > 0)
+    {
+      minValue = glm::min(minValue, p.minValue);
+      maxValue = glm::max(maxValue, p.maxValue);
+      sum += glm::dvec4(p.sum);
+    }
+  }
+
+  stats.pixels = stats.finite + stats.nan + stats.inf;
+  if(stats.finite > 0)
+  {
+    stats.minValue = minValue;
+    stats.maxValue = maxValue;
+    stats.mean     = glm::vec4(sum / double(stats.finite));
+  }
+  return stats;
+}
+
+// Mirrors accumulatePixel() in guide_stats.slang
+static void classifyGuidePixel(shaderio::GuideStatsPartial& acc, glm::vec4 v, const GuideStats::Check& check)
+{
+  for(uint32_t c = check.channels; c < 4; ++c)
+  {
+    v[c] = 0.0f;
+  }
+
+  bool isNan = false;
+  bool isInf = false;
+  for(int c = 0; c < 4; ++c)
+  {
+    isNan = isNan || std::isnan(v[c]);
+    isInf = isInf || std::isinf(v[c]);
+  }
+  if(isNan)
+  {
+    acc.nan++;
+    return;
+  }
+  if(isInf)
+  {
+    acc.inf++;
+    return;
+  }
+
+  acc.finite++;
+  acc.minValue = glm::min(acc.minValue, v);
+  acc.maxValue = glm::max(acc.maxValue, v);
+  acc.sum += v;
+
+  bool outOfRange = false;
+  for(uint32_t c = 0; c < check.channels; ++c)
+  {
+    outOfRange = outOfRange || v[c] < check.rangeMin[c] || v[c] > check.rangeMax[c];
+  }
+  if(check.checks & GUIDE_CHECK_UNIT_NORMAL)
+  {
+    const glm::vec3 n = glm::vec3(v);
+    outOfRange        = outOfRange || (n != glm::vec3(0.0f) && std::abs(glm::length(n) - 1.0f) > check.normalTolerance);
+  }
+  acc.outOfRange += outOfRange ? 1 : 0;
+
+  bool special = false;
+  if(check.checks & GUIDE_CHECK_ZERO_RGB)
+  {
+    special = v.x == 0.0f && v.y == 0.0f && v.z == 0.0f;
+  }
+  if(check.checks & GUIDE_CHECK_SATURATED)
+  {
+    special = special || std::abs(v.x) >= check.saturateValue;
+  }
+  acc.special += special ? 1 : 0;
+}
+
+GuideStats::Stats GuideStats::computeReference(std::span<const glm::vec4> pixels, uint32_t width, uint32_t height, const Check& check)
+{
+  assert(pixels.size() >= size_t(width) * height);
+
+  shaderio::GuideStatsPartial acc{};
+  acc.minValue = glm::vec4(FLT_MAX);
+  acc.maxValue = glm::vec4(-FLT_MAX);
+  for(size_t i = 0; i < size_t(width) * height; ++i)
+  {
+    classifyGuidePixel(acc, pixels[i], check);
+  }
+  return reducePartials({&acc, 1});
+}
+
+void GuideStats::statsUI(uint32_t buffer) const
+{
+  if(!m_enabled || !m_hasStats)
+  {
+    return;
+  }
+
+  const Check& check = m_checks[buffer];
+  const Stats& s     = m_stats[buffer];
+
+  const bool bad = s.nan > 0 || s.inf > 0 || s.outOfRange > 0;
+  ImGui::TextColored(bad ? ImVec4(1.0f, 0.3f, 0.3f, 1.0f) : ImVec4(0.5f, 0.9f, 0.5f, 1.0f), "NaN %llu Inf %llu OOR %llu",
+                     (unsigned long long)s.nan, (unsigned long long)s.inf, (unsigned long long)s.outOfRange);
+  if(ImGui::BeginItemTooltip())
+  {
+    ImGui::Text("%s, %llu pixels", check.name.c_str(), (unsigned long long)s.pixels);
+    for(uint32_t c = 0; c < check.channels; ++c)
+    {
+      ImGui::Text("%c: min %.4g max %.4g mean %.4g", "xyzw"[c], s.minValue[c], s.maxValue[c], s.mean[c]);
+    }
+    if(!check.specialLabel.empty())
+    {
+      const double percent = s.pixels ? 100.0 * double(s.special) / double(s.pixels) : 0.0;
+      ImGui::Text("%s: %llu (%.2f%%)", check.specialLabel.c_str(), (unsigned long long)s.special, percent);
+    }
+    ImGui::EndTooltip();
+  }
+}
+
+bool GuideStats::onUI()
+{
+  const bool verify = ImGui::Button("Verify on CPU");
+  ImGui::SetItemTooltip("Recompute the statistics of the last frame on the CPU from downloaded buffers and compare");
+  if(!m_verifyReport.empty())
+  {
+    ImGui::TextUnformatted(m_verifyReport.c_str());
+  }
+  return verify;
+}
+
+void GuideStats::verifyOnCpu(nvapp::Application* app, std::span<const VkImage> images, std::span<const VkFormat> formats)
+{
+  assert(images.size() == m_checks.size() && formats.size() == m_checks.size());
+  if(m_lastSize.width == 0)
+  {
+    m_verifyReport = "Needs a validated frame";
+    return;
+  }
+
+  vkDeviceWaitIdle(m_device);
+
+  // The partials of the last frame are in its readback slot, complete after the wait
+  const auto* partials = m_readback.map<shaderio::GuideStatsPartial>(m_lastCycle);
+  if(partials == nullptr)
+  {
+    m_verifyReport = "Needs a validated frame";
+    return;
+  }
+
+  std::string report;
+  uint32_t    matching = 0, verified = 0;
+  for(size_t i = 0; i < m_checks.size(); ++i)
+  {
+    const std::vector<glm::vec4> pixels = downloadImage(app, m_alloc, images[i], formats[i], m_lastSize);
+    if(pixels.empty())
+    {
+      report += m_checks[i].name + ": format not supported\n";
+      continue;
+    }
+    const Stats gpu = reducePartials({partials + i * GUIDE_STATS_GROUPS, GUIDE_STATS_GROUPS});
+    const Stats cpu = computeReference(pixels, m_lastSize.width, m_lastSize.height, m_checks[i]);
+    verified++;
+    if(sameStats(gpu, cpu))
+    {
+      matching++;
+      continue;
+    }
+    std::array<char, 256> line;
+    snprintf(line.data(), line.size(), "%s: GPU NaN %llu Inf %llu OOR %llu special %llu, CPU %llu %llu %llu %llu\n",
+             m_checks[i].name.c_str(), (unsigned long long)gpu.nan, (unsigned long long)gpu.inf,
+             (unsigned long long)gpu.outOfRange, (unsigned long long)gpu.special, (unsigned long long)cpu.nan,
+             (unsigned long long)cpu.inf, (unsigned long long)cpu.outOfRange, (unsigned long long)cpu.special);
+    report += line.data();
+  }
+  m_verifyReport = std::to_string(matching) + " of " + std::to_string(verified) + " buffers match the CPU reference\n" + report;
+  LOGI("Guide buffer CPU verification\n%s", m_verifyReport.c_str());
+}
+
+bool GuideStats::sameStats(const Stats& a, const Stats& b)
+{
+  bool same = a.pixels == b.pixels && a.finite == b.finite && a.nan == b.nan && a.inf == b.inf
+              && a.outOfRange == b.outOfRange && a.special == b.special && a.minValue == b.minValue && a.maxValue == b.maxValue;
+  for(int c = 0; c < 4; ++c)
+  {
+    const float scale = std::max({1.0f, std::abs(a.mean[c]), std::abs(b.mean[c])});
+    same              = same && std::abs(a.mean[c] - b.mean[c]) <= 1e-3f * scale;
+  }
+  return same;
+}
+
+bool GuideStats::selfTest()
+{
+  const float kSaturated = 65504.0f;
+  const float kNan       = std::numeric_limits<float>::quiet_NaN();
+  const float kInf       = std::numeric_limits<float>::infinity();
+
+  // Pixel kinds and how often they occur; 160 x 128 pixels spread over several grid strides of the shader
+  struct Kind
+  {
+    glm::vec4 value;
+    uint32_t  count;
+  };
+  const std::vector<Kind> kinds = {
+      {{0.6f, 0.8f, 0.0f, 0.5f}, 20446},      // regular: unit xyz in [0, 1]
+      {{0.0f, 0.0f, 0.0f, 1.0f}, 6},          // zero RGB
+      {{0.6f, kNan, 0.0f, 0.0f}, 5},          // NaN, unused by one channel checks
+      {{0.6f, 0.8f, kInf, 0.0f}, 3},          // Inf, unused by one channel checks
+      {{1.5f, 0.0f, 0.0f, 0.0f}, 4},          // out of [0, 1] and [-1, 1], non-unit
+      {{0.5f, 0.0f, 0.0f, 0.0f}, 2},          // non-unit normal, otherwise in range
+      {{kSaturated, 0.0f, 0.0f, 0.0f}, 7},    // saturated
+      {{0.6f, 0.8f, 0.0f, kNan}, 4},          // NaN in the channel three channel checks ignore
+      {{-1.0f, 0.0f, 0.0f, 0.0f}, 3},         // negative, a unit normal
+  };
+  const uint32_t         width = 160, height = 128;
+  std::vector<glm::vec4> pixels;
+  for(const Kind& kind : kinds)
+  {
+    pixels.insert(pixels.end(), kind.count, kind.value);
+  }
+  std::shuffle(pixels.begin(), pixels.end(), std::mt19937(104));
+  if(pixels.size() != size_t(width) * height)
+  {
+    LOGI("Guide stats self test FAILED: %zu synthetic pixels\n", pixels.size());
+    return false;
+  }
+
+  const Check albedo{.name = "albedo", .rangeMin = glm::vec4(0.0f), .rangeMax = glm::vec4(1.0f), .channels = 3, .checks = GUIDE_CHECK_ZERO_RGB};
+  const Check normal{.name = "normal", .rangeMin = glm::vec4(-1.0f), .rangeMax = glm::vec4(1.0f), .channels = 3, .checks = GUIDE_CHECK_UNIT_NORMAL};
+  const Check viewZ{.name          = "viewZ",
+                    .rangeMin      = glm::vec4(0.0f),
+                    .rangeMax      = glm::vec4(kSaturated),
+                    .channels      = 1,
+                    .checks        = GUIDE_CHECK_SATURATED,
+                    .saturateValue = kSaturated};
+
+  struct Expected
+  {
+    const Check*         check;
+    uint64_t             nan, inf, outOfRange, special;
+    std::vector<uint8_t> finiteKinds;  // 1 for the kinds in the mean and bounds
+  };
+  const std::vector<Expected> expected = {
+      {&albedo, 5, 3, 4 + 7 + 3, 6, {1, 1, 0, 0, 1, 1, 1, 1, 1}},
+      {&normal, 5, 3, 4 + 2 + 7, 0, {1, 1, 0, 0, 1, 1, 1, 1, 1}},
+      {&viewZ, 0, 0, 3, 7, {1, 1, 1, 1, 1, 1, 1, 1, 1}},
+  };
+
+  bool     reference = true, partial = true;
+  uint32_t nonEmptyPartials = 0;
+  for(const Expected& e : expected)
+  {
+    const Stats cpu = computeReference(pixels, width, height, *e.check);
+
+    // Mean and bounds of the finite kinds, unused channels read as 0
+    glm::dvec4 sum(0.0);
+    glm::vec4  lo(FLT_MAX), hi(-FLT_MAX);
+    uint64_t   finite = 0;
+    for(size_t k = 0; k < kinds.size(); ++k)
+    {
+      if(!e.finiteKinds[k])
+      {
+        continue;
+      }
+      glm::vec4 v = kinds[k].value;
+      for(uint32_t c = e.check->channels; c < 4; ++c)
+      {
+        v[c] = 0.0f;
+      }
+      sum += glm::dvec4(v) * double(kinds[k].count);
+      lo = glm::min(lo, v);
+      hi = glm::max(hi, v);
+      finite += kinds[k].count;
+    }
+    Stats want;
+    want.pixels     = pixels.size();
+    want.finite     = finite;
+    want.nan        = e.nan;
+    want.inf        = e.inf;
+    want.outOfRange = e.outOfRange;
+    want.special    = e.special;
+    want.minValue   = lo;
+    want.maxValue   = hi;
+    want.mean       = glm::vec4(sum / double(finite));
+    reference       = reference && sameStats(cpu, want);
+
+    // The shader's split: group g, thread t reduce pixels g * GROUP_SIZE + t + k * GROUPS * GROUP_SIZE
+    std::vector<shaderio::GuideStatsPartial> partials(GUIDE_STATS_GROUPS);
+    for(uint32_t g = 0; g < GUIDE_STATS_GROUPS; ++g)
+    {
+      shaderio::GuideStatsPartial& p = partials[g];
+      p                              = {};
+      p.minValue                     = glm::vec4(FLT_MAX);
+      p.maxValue                     = glm::vec4(-FLT_MAX);
+      for(uint32_t t = 0; t < GUIDE_STATS_GROUP_SIZE; ++t)
+      {
+        for(size_t i = g * GUIDE_STATS_GROUP_SIZE + t; i < pixels.size(); i += GUIDE_STATS_GROUPS * GUIDE_STATS_GROUP_SIZE)
+        {
+          classifyGuidePixel(p, pixels[i], *e.check);
+        }
+      }
+      nonEmptyPartials += p.finite > 0 ? 1 : 0;
+    }
+    partial = partial && sameStats(reducePartials(partials), cpu);
+  }
+
+  const bool passed = reference && partial;
+  LOGI("Guide stats self test %s: reference %s, partials %s (%u non-empty)\n", passed ? "passed" : "FAILED",
+       reference ? "ok" : "FAILED", partial ? "ok" : "FAILED", nonEmptyPartials);
+  return passed;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <nvvk/resource_allocator.hpp>
+
+#include "readback_ring.hpp"
+#include "shaders/host_device.h"
+
+#include <cfloat>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace nvapp {
+class Application;
+}
+
+
+// GuideStats validates the DLSS_RR guide buffers every frame: min/max/mean per channel, NaN/Inf counts,
+// out-of-range counts and a buffer specific 'special' count (zero albedo, ViewZ at infinity, ...).
+// Each buffer is reduced by guide_stats.slang into partials, which are read back through a ReadbackRing
+// and summed on the host. computeReference() is the CPU equivalent: verifyOnCpu() compares it with the shader on the
+// last frame's buffers, selfTest() checks it and reducePartials() on synthetic pixels.
+class GuideStats
+{
+public:
+  // How one guide buffer is validated
+  struct Check
+  {
+    std::string name;
+    glm::vec4   rangeMin{-FLT_MAX};
+    glm::vec4   rangeMax{FLT_MAX};
+    uint32_t    channels        = 4;
+    uint32_t    checks          = 0;  // GUIDE_CHECK_*
+    float       saturateValue   = 0.0f;
+    float       normalTolerance = 0.01f;
+    std::string specialLabel;  // meaning of Stats::special, empty if unused
+  };
+
+  struct Stats
+  {
+    glm::vec4 minValue{0.0f};  // over finite pixels
+    glm::vec4 maxValue{0.0f};
+    glm::vec4 mean{0.0f};
+    uint64_t  pixels     = 0;
+    uint64_t  finite     = 0;
+    uint64_t  nan        = 0;
+    uint64_t  inf        = 0;
+    uint64_t  outOfRange = 0;
+    uint64_t  special    = 0;
+  };
+
+  GuideStats() = default;
+  ~GuideStats();
+
+  void init(nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv, const std::vector<Check>& checks, uint32_t frameCycleSize);
+  void deinit();
+
+  bool isEnabled() const { return m_enabled; }
+  void setEnabled(bool enabled);
+
+  // Fetches the statistics of the frame that last used 'cycleIndex'
+  void readResults(uint32_t cycleIndex);
+
+  // 'images' has one entry per check, readable by compute shaders. 'size' is the rendered region. A replay with
+  // ReadbackRing::kReplaySlot leaves the results of the last frame for verifyOnCpu().
+  void cmdReduce(VkCommandBuffer cmd, std::span<const VkDescriptorImageInfo> images, VkExtent2D size, uint32_t cycleIndex);
+
+  const Check& check(uint32_t buffer) const { return m_checks[buffer]; }
+  const Stats& stats(uint32_t buffer) const { return m_stats[buffer]; }
+  bool         hasStats() const { return m_hasStats; }
+
+  // Compact problem summary of one buffer with the details as tooltip, for use next to a thumbnail
+  void statsUI(uint32_t buffer) const;
+
+  // Returns true when the CPU verification was requested
+  bool onUI();
+  // Downloads the buffers of the last reduced frame, one per check, and compares computeReference() on them with
+  // the statistics of guide_stats.slang. Waits for the GPU.
+  void verifyOnCpu(nvapp::Application* app, std::span<const VkImage> images, std::span<const VkFormat> formats);
+
+  static shaderio::GuideStatsPushConstant makePushConstant(const Check& check, VkExtent2D size, uint32_t partialOffset);
+
+  // Sums GUIDE_STATS_GROUPS partials of one buffer
+  static Stats reducePartials(std::span<const shaderio::GuideStatsPartial> partials);
+
+  // CPU reference over 'width' x 'height' RGBA pixels
+  static Stats computeReference(std::span<const glm::vec4> pixels, uint32_t width, uint32_t height, const Check& check);
+
+  // Same counts, bounds and (within float summation order) mean
+  static bool sameStats(const Stats& a, const Stats& b);
+
+  // Checks computeReference() and reducePartials() over the shader's split of the pixels into partials, on synthetic
+  // pixels with known NaN/Inf, out-of-range, non-unit normal, zero RGB and saturated counts
+  static bool selfTest();
+
+private:
+  nvvk::ResourceAllocator* m_alloc          = nullptr;
+  VkDevice                 m_device         = VK_NULL_HANDLE;
+  VkDescriptorSetLayout    m_dsetLayout     = VK_NULL_HANDLE;
+  VkPipelineLayout         m_pipelineLayout = VK_NULL_HANDLE;
+  VkPipeline               m_pipeline       = VK_NULL_HANDLE;
+  nvvk::Buffer             m_partials;
+  ReadbackRing             m_readback;
+
+  std::vector<Check> m_checks;
+  std::vector<Stats> m_stats;
+  bool               m_enabled  = false;
+  bool               m_hasStats = false;
+  VkExtent2D         m_lastSize{};  // of the last cmdReduce()
+  uint32_t           m_lastCycle = 0;
+  std::string        m_verifyReport;
+};
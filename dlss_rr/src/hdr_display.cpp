@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "hdr_display.hpp"
+
+#include <imgui/imgui.h>
+
+#include <nvapp/application.hpp>
+#include <nvgui/property_editor.hpp>
+#include <nvutils/logger.hpp>
+#include <nvutils/parameter_registry.hpp>
+#include <nvvk/check_error.hpp>
+#include <nvvk/debug_util.hpp>
+#include <nvvk/descriptors.hpp>
+#include <nvvk/pipeline.hpp>
+#include <nvvk/shaders.hpp>
+
+#include "image_readback.hpp"
+#include "shaders/host_device.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+
+void HdrDisplay::registerParameters(nvutils::ParameterRegistry& registry, Settings& settings)
+{
+  registry.add({"hdrDisplay", "Display output: 0 SDR, 1 HDR10 PQ, 2 scRGB FP16. The HDR modes run headless and write the "
+                              "encoded last frame to --hdrOutput on exit"},
+               &settings.mode);
+  registry.add({"hdrPaperWhite", "Luminance in nits of a scene value of 1.0 in the HDR modes"}, &settings.paperWhiteNits);
+  registry.add({"hdrPeakNits", "Display's peak luminance in nits in the HDR modes"}, &settings.peakNits);
+  registry.add({"hdrFrames", "Frames the HDR modes render before writing the last one"}, &settings.frames);
+  registry.add({"hdrOutput", "Image the HDR modes write: 16 bit PPM of the PQ codes for HDR10, PFM for scRGB"}, &settings.output);
+}
+
+HdrDisplay::~HdrDisplay()
+{
+  assert(m_pipeline == VK_NULL_HANDLE && "Must call deinit");
+}
+
+void HdrDisplay::init(nvapp::Application* app, nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv, const Settings& settings)
+{
+  assert(m_pipeline == VK_NULL_HANDLE && "Init already called");
+
+  m_app    = app;
+  m_alloc  = alloc;
+  m_device = alloc->getDevice();
+
+  // R16G16B16A16_SFLOAT storage is required by Vulkan, the 10 bit format is not
+  VkFormatProperties props{};
+  vkGetPhysicalDeviceFormatProperties(app->getPhysicalDevice(), VK_FORMAT_A2B10G10R10_UNORM_PACK32, &props);
+  m_storageHdr10 = (props.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT) != 0;
+
+  paperWhiteNits = settings.paperWhiteNits;
+  peakNits       = settings.peakNits;
+  setMode(Mode(std::clamp(settings.mode, 0, 2)));
+  m_output = settings.output;
+  if(m_output.empty())
+  {
+    m_output = m_mode == Mode::eHdr10 ? "hdr_display.ppm" : "hdr_display.pfm";
+  }
+
+  nvvk::DescriptorBindings bindings;
+  bindings.addBinding(shaderio::HdrDisplayBindings::eHdrInput, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+  bindings.addBinding(shaderio::HdrDisplayBindings::eHdrOutput, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+  NVVK_CHECK(bindings.createDescriptorSetLayout(m_device, VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR, &m_dsetLayout));
+  NVVK_DBG_NAME(m_dsetLayout);
+
+  const VkPushConstantRange pushConstant{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(shaderio::HdrDisplayPushConstant)};
+  NVVK_CHECK(nvvk::createPipelineLayout(m_device, &m_pipelineLayout, {m_dsetLayout}, {pushConstant}));
+  NVVK_DBG_NAME(m_pipelineLayout);
+
+  VkShaderModule module = VK_NULL_HANDLE;
+  NVVK_CHECK(nvvk::createShaderModule(module, m_device, spirv));
+
+  const VkComputePipelineCreateInfo pipelineInfo{
+      .sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+      .stage  = {.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, .stage = VK_SHADER_STAGE_COMPUTE_BIT, .module = module, .pName = "main"},
+      .layout = m_pipelineLayout,
+  };
+  NVVK_CHECK(vkCreateComputePipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipeline));
+  NVVK_DBG_NAME(m_pipeline);
+
+  vkDestroyShaderModule(m_device, module, nullptr);
+}
+
+void HdrDisplay::deinit()
+{
+  vkDestroyPipeline(m_device, m_pipeline, nullptr);
+  vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
+  vkDestroyDescriptorSetLayout(m_device, m_dsetLayout, nullptr);
+  m_pipeline       = VK_NULL_HANDLE;
+  m_pipelineLayout = VK_NULL_HANDLE;
+  m_dsetLayout     = VK_NULL_HANDLE;
+}
+
+void HdrDisplay::setMode(Mode mode)
+{
+  if(mode == Mode::eHdr10 && !m_storageHdr10)
+  {
+    LOGW("HDR10 output unavailable: A2B10G10R10_UNORM storage images aren't supported\n");
+    mode = Mode::eSdr;
+  }
+  m_mode = mode;
+}
+
+VkFormat HdrDisplay::modeFormat(Mode mode)
+{
+  switch(mode)
+  {
+    case Mode::eHdr10:
+      return VK_FORMAT_A2B10G10R10_UNORM_PACK32;
+    case Mode::eScRgb:
+      return VK_FORMAT_R16G16B16A16_SFLOAT;
+    default:
+      return VK_FORMAT_R8G8B8A8_UNORM;
+  }
+}
+
+VkFormat HdrDisplay::format() const
+{
+  return modeFormat(m_mode);
+}
+
+void HdrDisplay::cmdApply(VkCommandBuffer cmd, VkExtent2D size, float exposure, const VkDescriptorImageInfo& input, const VkDescriptorImageInfo& output)
+{
+  assert(isHdr());
+  vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+
+  const VkWriteDescriptorSet writes[] = {
+      {.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+       .dstBinding      = shaderio::HdrDisplayBindings::eHdrInput,
+       .descriptorCount = 1,
+       .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+       .pImageInfo      = &input},
+      {.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+       .dstBinding      = shaderio::HdrDisplayBindings::eHdrOutput,
+       .descriptorCount = 1,
+       .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+       .pImageInfo      = &output},
+  };
+  vkCmdPushDescriptorSetKHR(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, uint32_t(std::size(writes)), writes);
+
+  // The roll off starts at paper white, but leaves at least a quarter of the range to the peak for the shoulder
+  const float peak = std::max(peakNits, 1.0f);
+  const shaderio::HdrDisplayPushConstant pushConst{.size           = {int32_t(size.width), int32_t(size.height)},
+                                                   .mode           = m_mode == Mode::eHdr10 ? HDR_DISPLAY_HDR10 : HDR_DISPLAY_SCRGB,
+                                                   .exposure       = exposure,
+                                                   .paperWhiteNits = paperWhiteNits,
+                                                   .peakNits       = peak,
+                                                   .kneeNits       = std::min(paperWhiteNits, 0.75f * peak)};
+  vkCmdPushConstants(cmd, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConst), &pushConst);
+
+  const VkExtent2D groups = getGridSize(size);
+  vkCmdDispatch(cmd, groups.width, groups.height, 1);
+}
+
+bool HdrDisplay::writeImage(VkImage image, VkExtent2D size) const
+{
+  assert(isHdr());
+  std::ofstream file(m_output, std::ios::binary);
+  if(!file)
+  {
+    LOGE("Could not write %s\n", m_output.string().c_str());
+    return false;
+  }
+
+  if(m_mode == Mode::eHdr10)
+  {
+    // The 10 bit codes as they are, not rescaled: a 16 bit PPM with maxval 1023, big endian, rows from the top
+    const std::vector<uint8_t> texels = downloadImageTexels(m_app, m_alloc, image, format(), size);
+    if(texels.empty())
+    {
+      return false;
+    }
+    file << "P6\n" << size.width << " " << size.height << "\n1023\n";
+    std::vector<uint8_t> row(size_t(size.width) * 6);
+    for(uint32_t y = 0; y < size.height; ++y)
+    {
+      for(uint32_t x = 0; x < size.width; ++x)
+      {
+        uint32_t packed;
+        std::memcpy(&packed, &texels[(size_t(y) * size.width + x) * sizeof(uint32_t)], sizeof(packed));
+        for(uint32_t c = 0; c < 3; ++c)
+        {
+          const uint32_t code            = (packed >> (10 * c)) & 0x3ff;
+          row[size_t(x) * 6 + c * 2]     = uint8_t(code >> 8);
+          row[size_t(x) * 6 + c * 2 + 1] = uint8_t(code & 0xff);
+        }
+      }
+      file.write(reinterpret_cast<const char*>(row.data()), row.size());
+    }
+  }
+  else
+  {
+    const std::vector<glm::vec4> texels = downloadImage(m_app, m_alloc, image, format(), size);
+    if(texels.empty())
+    {
+      return false;
+    }
+    // Negative scale: little endian. Rows go from the bottom to the top.
+    file << "PF\n" << size.width << " " << size.height << "\n-1.0\n";
+    std::vector<glm::vec3> row(size.width);
+    for(uint32_t y = size.height; y-- > 0;)
+    {
+      for(uint32_t x = 0; x < size.width; ++x)
+      {
+        row[x] = glm::vec3(texels[size_t(y) * size.width + x]);
+      }
+      file.write(reinterpret_cast<const char*>(row.data()), row.size() * sizeof(glm::vec3));
+    }
+  }
+
+  if(!file)
+  {
+    LOGE("Could not write %s\n", m_output.string().c_str());
+    return false;
+  }
+  LOGI("HDR display: wrote %s (%ux%u)\n", m_output.string().c_str(), size.width, size.height);
+  return true;
+}
+
+void HdrDisplay::onUI() const
+{
+  using namespace nvgui;
+
+  // The windowed sample presents on nvapp's SDR swapchain, the HDR modes are set on the command line
+  static const char* names[] = {"SDR", "HDR10 PQ", "scRGB FP16"};
+  PropertyEditor::begin();
+  PropertyEditor::entry(
+      "Display Output",
+      [&] {
+        ImGui::TextUnformatted(names[int(m_mode)]);
+        return false;
+      },
+      "HDR10 and scRGB map to the display's luminance range and write the encoded image to a file. They run headless, "
+      "set with --hdrDisplay");
+  PropertyEditor::end();
+  if(isHdr())
+  {
+    ImGui::TextDisabled("Paper white %.0f nits, peak %.0f nits", paperWhiteNits, peakNits);
+    ImGui::TextDisabled("Output: %s", m_output.string().c_str());
+  }
+  else
+  {
+    ImGui::TextDisabled("HDR output is headless: the swapchain is SDR");
+  }
+}
+
+nlohmann::json HdrDisplay::toJson() const
+{
+  static const char* names[] = {"sdr", "hdr10", "scrgb"};
+  return {{"mode", names[int(m_mode)]},
+          {"paper_white_nits", paperWhiteNits},
+          {"peak_nits", peakNits},
+          {"storage_hdr10", m_storageHdr10},
+          {"output", isHdr() ? m_output.string() : std::string()}};
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <nvvk/resource_allocator.hpp>
+#include <tinygltf/json.hpp>
+
+#include <filesystem>
+#include <span>
+
+namespace nvapp {
+class Application;
+}
+namespace nvutils {
+class ParameterRegistry;
+}
+
+
+// HdrDisplay maps the denoised image for an HDR display in place of the SDR tonemapper (hdr_display.slang): scene
+// values are scaled to paper white, highlights roll off towards the display's peak and the result is encoded as
+// HDR10 (PQ, BT.2020, 10 bits) or scRGB (linear FP16). The sample's 8 bit output image takes the encoded format,
+// so the path skips both the SDR tonemap and the quantization. nvapp's swapchain is SDR and can't be given an HDR
+// color space, so the HDR modes run headless and write the encoded image of the last frame to a file.
+class HdrDisplay
+{
+public:
+  enum class Mode
+  {
+    eSdr,  // the SDR tonemapper, HdrDisplay is unused
+    eHdr10,
+    eScRgb,
+  };
+
+  struct Settings
+  {
+    int                   mode           = 0;        // Mode
+    float                 paperWhiteNits = 203.0f;   // ITU-R BT.2408 reference white
+    float                 peakNits       = 1000.0f;  // display's peak luminance
+    int                   frames         = 60;       // frames rendered headless before the last one is written
+    std::filesystem::path output;                    // empty: "hdr_display.ppm" for HDR10, "hdr_display.pfm" for scRGB
+
+    bool isHdr() const { return mode != int(Mode::eSdr); }
+  };
+
+  // Registers the --hdr* options
+  static void registerParameters(nvutils::ParameterRegistry& registry, Settings& settings);
+
+  HdrDisplay() = default;
+  ~HdrDisplay();
+
+  void init(nvapp::Application* app, nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv, const Settings& settings);
+  void deinit();
+
+  Mode mode() const { return m_mode; }
+  bool isHdr() const { return m_mode != Mode::eSdr; }
+  // Falls back to SDR when the mode's format can't be written by compute shaders
+  void setMode(Mode mode);
+
+  // Format of the displayed image in the current mode
+  VkFormat format() const;
+
+  // 'input' is the denoised image, 'output' an image of format(); both in VK_IMAGE_LAYOUT_GENERAL
+  void cmdApply(VkCommandBuffer cmd, VkExtent2D size, float exposure, const VkDescriptorImageInfo& input, const VkDescriptorImageInfo& output);
+
+  // Writes 'image' of format(), in VK_IMAGE_LAYOUT_GENERAL, to the output file: HDR10 as a 16 bit binary PPM holding
+  // the 10 bit PQ codes, scRGB as a PFM of the linear values
+  bool writeImage(VkImage image, VkExtent2D size) const;
+
+  // Mode and luminance settings, read-only: they are command line options of the headless HDR output
+  void onUI() const;
+
+  nlohmann::json toJson() const;
+
+  float paperWhiteNits = 203.0f;
+  float peakNits       = 1000.0f;
+
+private:
+  static VkFormat modeFormat(Mode mode);
+
+  nvapp::Application*      m_app            = nullptr;
+  nvvk::ResourceAllocator* m_alloc          = nullptr;
+  VkDevice                 m_device         = VK_NULL_HANDLE;
+  VkDescriptorSetLayout    m_dsetLayout     = VK_NULL_HANDLE;
+  VkPipelineLayout         m_pipelineLayout = VK_NULL_HANDLE;
+  VkPipeline               m_pipeline       = VK_NULL_HANDLE;
+
+  Mode                  m_mode         = Mode::eSdr;
+  bool                  m_storageHdr10 = false;  // A2B10G10R10_UNORM can be a storage image
+  std::filesystem::path m_output;
+};
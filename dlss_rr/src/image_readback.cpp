@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "image_readback.hpp"
+
+#include <nvapp/application.hpp>
+#include <nvutils/logger.hpp>
+#include <nvvk/check_error.hpp>
+#include <nvvk/resource_allocator.hpp>
+
+#include <glm/gtc/packing.hpp>
+
+#include <cstring>
+
+
+uint32_t texelSize(VkFormat format)
+{
+  switch(format)
+  {
+    case VK_FORMAT_R8G8B8A8_UNORM:
+    case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+    case VK_FORMAT_R16G16_SFLOAT:
+    case VK_FORMAT_R32_SFLOAT:
+      return 4;
+    case VK_FORMAT_R16_SFLOAT:
+      return 2;
+    case VK_FORMAT_R16G16B16A16_SFLOAT:
+      return 8;
+    case VK_FORMAT_R32G32B32A32_SFLOAT:
+      return 16;
+    default:
+      return 0;
+  }
+}
+
+bool unpackTexels(std::span<const uint8_t> data, VkFormat format, std::vector<glm::vec4>& rgba)
+{
+  const uint32_t stride = texelSize(format);
+  if(stride == 0)
+  {
+    return false;
+  }
+
+  const size_t count = data.size() / stride;
+  rgba.assign(count, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+  for(size_t i = 0; i < count; ++i)
+  {
+    const uint8_t* texel = data.data() + i * stride;
+    glm::vec4&     out   = rgba[i];
+    switch(format)
+    {
+      case VK_FORMAT_R8G8B8A8_UNORM:
+        out = glm::vec4(texel[0], texel[1], texel[2], texel[3]) / 255.0f;
+        break;
+      case VK_FORMAT_A2B10G10R10_UNORM_PACK32: {
+        uint32_t p;
+        memcpy(&p, texel, sizeof(p));
+        out = glm::unpackUnorm3x10_1x2(p);
+        break;
+      }
+      case VK_FORMAT_R16_SFLOAT: {
+        uint16_t h;
+        memcpy(&h, texel, sizeof(h));
+        out.x = glm::unpackHalf1x16(h);
+        break;
+      }
+      case VK_FORMAT_R16G16_SFLOAT: {
+        uint32_t h;
+        memcpy(&h, texel, sizeof(h));
+        const glm::vec2 v = glm::unpackHalf2x16(h);
+        out.x             = v.x;
+        out.y             = v.y;
+        break;
+      }
+      case VK_FORMAT_R16G16B16A16_SFLOAT: {
+        uint64_t h;
+        memcpy(&h, texel, sizeof(h));
+        out = glm::unpackHalf4x16(h);
+        break;
+      }
+      case VK_FORMAT_R32_SFLOAT:
+        memcpy(&out.x, texel, sizeof(float));
+        break;
+      case VK_FORMAT_R32G32B32A32_SFLOAT:
+        memcpy(&out, texel, sizeof(glm::vec4));
+        break;
+      default:
+        break;
+    }
+  }
+  return true;
+}
+
+std::vector<uint8_t> downloadImageTexels(nvapp::Application* app, nvvk::ResourceAllocator* alloc, VkImage image, VkFormat format, VkExtent2D size)
+{
+  std::vector<uint8_t> result;
+
+  const VkDeviceSize bytes = VkDeviceSize(texelSize(format)) * size.width * size.height;
+  if(bytes == 0)
+  {
+    LOGW("downloadImage: unsupported format %d\n", int(format));
+    return result;
+  }
+
+  nvvk::Buffer staging;
+  NVVK_CHECK(alloc->createBuffer(staging, bytes, VK_BUFFER_USAGE_2_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+                                 VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT));
+
+  VkCommandBuffer cmd = app->createTempCmdBuffer();
+
+  // Whatever wrote the image last
+  const VkMemoryBarrier2 before{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                .srcStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                                .srcAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT,
+                                .dstStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                .dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT};
+  const VkDependencyInfo depBefore{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &before};
+  vkCmdPipelineBarrier2(cmd, &depBefore);
+
+  const VkBufferImageCopy region{.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1}, .imageExtent = {size.width, size.height, 1}};
+  vkCmdCopyImageToBuffer(cmd, image, VK_IMAGE_LAYOUT_GENERAL, staging.buffer, 1, &region);
+
+  const VkMemoryBarrier2 after{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                               .srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                               .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                               .dstStageMask  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                               .dstAccessMask = VK_ACCESS_2_HOST_READ_BIT};
+  const VkDependencyInfo depAfter{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &after};
+  vkCmdPipelineBarrier2(cmd, &depAfter);
+
+  app->submitAndWaitTempCmdBuffer(cmd);
+
+  NVVK_CHECK(vmaInvalidateAllocation(*alloc, staging.allocation, 0, VK_WHOLE_SIZE));
+  const uint8_t* texels = static_cast<const uint8_t*>(staging.mapping);
+  result.assign(texels, texels + bytes);
+
+  alloc->destroyBuffer(staging);
+  return result;
+}
+
+std::vector<glm::vec4> downloadImage(nvapp::Application* app, nvvk::ResourceAllocator* alloc, VkImage image, VkFormat format, VkExtent2D size)
+{
+  std::vector<glm::vec4> result;
+  unpackTexels(downloadImageTexels(app, alloc, image, format, size), format, result);
+  return result;
+}
+
+std::vector<uint8_t> downloadBuffer(nvapp::Application* app, nvvk::ResourceAllocator* alloc, VkBuffer buffer, VkDeviceSize bytes)
+{
+  nvvk::Buffer staging;
+  NVVK_CHECK(alloc->createBuffer(staging, bytes, VK_BUFFER_USAGE_2_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+                                 VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT));
+
+  VkCommandBuffer cmd = app->createTempCmdBuffer();
+
+  // Whatever wrote the buffer last, including earlier submissions
+  const VkMemoryBarrier2 before{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                .srcStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                                .srcAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT,
+                                .dstStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                .dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT};
+  const VkDependencyInfo depBefore{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &before};
+  vkCmdPipelineBarrier2(cmd, &depBefore);
+
+  const VkBufferCopy region{.size = bytes};
+  vkCmdCopyBuffer(cmd, buffer, staging.buffer, 1, &region);
+
+  const VkMemoryBarrier2 after{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                               .srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                               .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                               .dstStageMask  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                               .dstAccessMask = VK_ACCESS_2_HOST_READ_BIT};
+  const VkDependencyInfo depAfter{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &after};
+  vkCmdPipelineBarrier2(cmd, &depAfter);
+
+  app->submitAndWaitTempCmdBuffer(cmd);
+
+  NVVK_CHECK(vmaInvalidateAllocation(*alloc, staging.allocation, 0, VK_WHOLE_SIZE));
+  const uint8_t*       mapping = static_cast<const uint8_t*>(staging.mapping);
+  std::vector<uint8_t> result(mapping, mapping + bytes);
+
+  alloc->destroyBuffer(staging);
+  return result;
+}
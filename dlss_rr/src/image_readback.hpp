@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <glm/glm.hpp>
+
+#include <span>
+#include <vector>
+
+namespace nvapp {
+class Application;
+}
+namespace nvvk {
+class ResourceAllocator;
+}
+
+
+// Synchronous download of render buffers for CPU side analysis and verification. Not meant for per-frame use.
+
+// Size in bytes of one texel, 0 for formats unpackTexels() doesn't handle
+uint32_t texelSize(VkFormat format);
+
+// Converts tightly packed texels of 'format' to RGBA floats. Missing components read as (0, 0, 0, 1), like in shaders.
+// Returns false for unsupported formats.
+bool unpackTexels(std::span<const uint8_t> data, VkFormat format, std::vector<glm::vec4>& rgba);
+
+// Copies the top left 'size' region of a color image in VK_IMAGE_LAYOUT_GENERAL to the host, waiting for the GPU.
+// Returns the texels as stored, tightly packed, or an empty vector for unsupported formats.
+std::vector<uint8_t> downloadImageTexels(nvapp::Application* app, nvvk::ResourceAllocator* alloc, VkImage image, VkFormat format, VkExtent2D size);
+// Same, unpacked to RGBA floats
+std::vector<glm::vec4> downloadImage(nvapp::Application* app, nvvk::ResourceAllocator* alloc, VkImage image, VkFormat format, VkExtent2D size);
+
+// Copies the first 'bytes' of a device buffer to the host, waiting for the GPU
+std::vector<uint8_t> downloadBuffer(nvapp::Application* app, nvvk::ResourceAllocator* alloc, VkBuffer buffer, VkDeviceSize bytes);
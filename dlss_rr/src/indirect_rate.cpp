@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "indirect_rate.hpp"
+
+#include <imgui/imgui.h>
+
+#include <nvgui/property_editor.hpp>
+#include <nvvk/check_error.hpp>
+#include <nvvk/debug_util.hpp>
+#include <nvvk/descriptors.hpp>
+#include <nvvk/pipeline.hpp>
+#include <nvvk/shaders.hpp>
+
+#include "shaders/host_device.h"
+
+#include <cassert>
+#include <iterator>
+
+
+static VkExtent2D tileCount(VkExtent2D size)
+{
+  return {(size.width + INDIRECT_RATE_TILE - 1) / INDIRECT_RATE_TILE, (size.height + INDIRECT_RATE_TILE - 1) / INDIRECT_RATE_TILE};
+}
+
+
+IndirectRate::~IndirectRate()
+{
+  assert(m_ratePipeline == VK_NULL_HANDLE && "Must call deinit");
+}
+
+void IndirectRate::init(nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv, uint32_t frameCycleSize)
+{
+  assert(m_ratePipeline == VK_NULL_HANDLE && "Init already called");
+
+  m_alloc  = alloc;
+  m_device = alloc->getDevice();
+
+  NVVK_CHECK(m_alloc->createBuffer(m_stats, sizeof(shaderio::IndirectRateStats),
+                                   VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_2_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_2_TRANSFER_DST_BIT));
+  NVVK_DBG_NAME(m_stats.buffer);
+  m_readback.init(m_alloc, sizeof(shaderio::IndirectRateStats), frameCycleSize);
+
+  nvvk::DescriptorBindings bindings;
+  for(uint32_t binding : {shaderio::IndirectRateBindings::eRateDenoised, shaderio::IndirectRateBindings::eRateViewZ,
+                          shaderio::IndirectRateBindings::eRateNormal})
+  {
+    bindings.addBinding(binding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+  }
+  for(uint32_t binding : {shaderio::IndirectRateBindings::eRateColor, shaderio::IndirectRateBindings::eRateSpecHitDist})
+  {
+    bindings.addBinding(binding, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+  }
+  for(uint32_t binding : {shaderio::IndirectRateBindings::eRateTiles, shaderio::IndirectRateBindings::eRateIndirect,
+                          shaderio::IndirectRateBindings::eRateStats})
+  {
+    bindings.addBinding(binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+  }
+  NVVK_CHECK(bindings.createDescriptorSetLayout(m_device, VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR, &m_dsetLayout));
+  NVVK_DBG_NAME(m_dsetLayout);
+
+  const VkPushConstantRange pushConstant{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(shaderio::IndirectRatePushConstant)};
+  NVVK_CHECK(nvvk::createPipelineLayout(m_device, &m_pipelineLayout, {m_dsetLayout}, {pushConstant}));
+  NVVK_DBG_NAME(m_pipelineLayout);
+
+  VkShaderModule module = VK_NULL_HANDLE;
+  NVVK_CHECK(nvvk::createShaderModule(module, m_device, spirv));
+
+  VkComputePipelineCreateInfo pipelineInfo{
+      .sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+      .stage  = {.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, .stage = VK_SHADER_STAGE_COMPUTE_BIT, .module = module, .pName = "rateMain"},
+      .layout = m_pipelineLayout,
+  };
+  NVVK_CHECK(vkCreateComputePipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_ratePipeline));
+  NVVK_DBG_NAME(m_ratePipeline);
+  pipelineInfo.stage.pName = "reconstructMain";
+  NVVK_CHECK(vkCreateComputePipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_reconstructPipeline));
+  NVVK_DBG_NAME(m_reconstructPipeline);
+
+  vkDestroyShaderModule(m_device, module, nullptr);
+}
+
+void IndirectRate::deinit()
+{
+  vkDestroyPipeline(m_device, m_ratePipeline, nullptr);
+  vkDestroyPipeline(m_device, m_reconstructPipeline, nullptr);
+  vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
+  vkDestroyDescriptorSetLayout(m_device, m_dsetLayout, nullptr);
+  m_ratePipeline        = VK_NULL_HANDLE;
+  m_reconstructPipeline = VK_NULL_HANDLE;
+  m_pipelineLayout      = VK_NULL_HANDLE;
+  m_dsetLayout          = VK_NULL_HANDLE;
+
+  m_readback.deinit();
+  m_alloc->destroyBuffer(m_stats);
+  m_alloc->destroyBuffer(m_tiles);
+  m_alloc->destroyBuffer(m_indirect);
+}
+
+void IndirectRate::setEnabled(bool enabled)
+{
+  if(enabled != m_enabled)
+  {
+    m_readback.invalidate();
+    m_result  = {};
+    m_enabled = enabled;
+  }
+}
+
+void IndirectRate::setFoveated(bool foveated, glm::uvec3 tiles)
+{
+  m_foveatedTiles = foveated ? tiles : glm::uvec3(0);
+  if(foveated != m_foveated)
+  {
+    m_readback.invalidate();
+    m_result   = {};
+    m_foveated = foveated;
+  }
+}
+
+void IndirectRate::resize(VkCommandBuffer cmd, VkExtent2D maxSize)
+{
+  m_alloc->destroyBuffer(m_tiles);
+  m_alloc->destroyBuffer(m_indirect);
+
+  const VkExtent2D             tiles   = tileCount(maxSize);
+  const VkBufferUsageFlags2KHR storage = VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_2_SHADER_DEVICE_ADDRESS_BIT;
+  NVVK_CHECK(m_alloc->createBuffer(m_tiles, VkDeviceSize(tiles.width) * tiles.height * sizeof(uint32_t), storage | VK_BUFFER_USAGE_2_TRANSFER_DST_BIT));
+  NVVK_DBG_NAME(m_tiles.buffer);
+  NVVK_CHECK(m_alloc->createBuffer(m_indirect, VkDeviceSize(maxSize.width) * maxSize.height * sizeof(glm::vec4), storage));
+  NVVK_DBG_NAME(m_indirect.buffer);
+
+  // INDIRECT_RATE_FULL everywhere until the first rates are computed
+  vkCmdFillBuffer(cmd, m_tiles.buffer, 0, VK_WHOLE_SIZE, INDIRECT_RATE_FULL);
+  m_readback.invalidate();
+  m_result = {};
+}
+
+void IndirectRate::readResults(uint32_t cycleIndex)
+{
+  const auto* stats = m_readback.map<shaderio::IndirectRateStats>(cycleIndex);
+  if(stats == nullptr || !isActive())
+  {
+    return;
+  }
+
+  const uint32_t tiles = stats->fullTiles + stats->halfTiles + stats->quarterTiles;
+  m_result = {.fullTiles          = stats->fullTiles,
+              .halfTiles          = stats->halfTiles,
+              .quarterTiles       = stats->quarterTiles,
+              .skippedFraction    = tiles ? double(stats->skippedPixels) / (double(tiles) * INDIRECT_RATE_TILE * INDIRECT_RATE_TILE) : 0.0,
+              .reconstructError   = stats->errorSamples ? double(stats->errorSum) / INDIRECT_RATE_FIXED_POINT / stats->errorSamples : 0.0,
+              .reconstructSamples = stats->errorSamples};
+  // Without the rate pass the statistics hold no tiles, the foveation's rates are known on the host
+  if(!m_enabled)
+  {
+    const glm::uvec3 fovea   = m_foveatedTiles;
+    const uint32_t   count   = fovea.x + fovea.y + fovea.z;
+    m_result.fullTiles       = fovea[INDIRECT_RATE_FULL];
+    m_result.halfTiles       = fovea[INDIRECT_RATE_HALF];
+    m_result.quarterTiles    = fovea[INDIRECT_RATE_QUARTER];
+    m_result.skippedFraction = count ? (0.5 * m_result.halfTiles + 0.75 * m_result.quarterTiles) / double(count) : 0.0;
+  }
+}
+
+void IndirectRate::pushDescriptors(VkCommandBuffer cmd, const Inputs& inputs)
+{
+  auto imageWrite = [](uint32_t binding, VkDescriptorType type, const VkDescriptorImageInfo& info) {
+    return VkWriteDescriptorSet{.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                                .dstBinding      = binding,
+                                .descriptorCount = 1,
+                                .descriptorType  = type,
+                                .pImageInfo      = &info};
+  };
+  auto bufferWrite = [](uint32_t binding, const VkDescriptorBufferInfo& info) {
+    return VkWriteDescriptorSet{.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                                .dstBinding      = binding,
+                                .descriptorCount = 1,
+                                .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                .pBufferInfo     = &info};
+  };
+  const VkDescriptorType       sampled = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+  const VkDescriptorType       storage = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+  const VkDescriptorBufferInfo tilesInfo{m_tiles.buffer, 0, VK_WHOLE_SIZE};
+  const VkDescriptorBufferInfo indirectInfo{m_indirect.buffer, 0, VK_WHOLE_SIZE};
+  const VkDescriptorBufferInfo statsInfo{m_stats.buffer, 0, VK_WHOLE_SIZE};
+
+  const VkWriteDescriptorSet writes[] = {
+      imageWrite(shaderio::IndirectRateBindings::eRateDenoised, sampled, inputs.denoised),
+      imageWrite(shaderio::IndirectRateBindings::eRateViewZ, sampled, inputs.viewZ),
+      imageWrite(shaderio::IndirectRateBindings::eRateNormal, sampled, inputs.normal),
+      imageWrite(shaderio::IndirectRateBindings::eRateColor, storage, inputs.color),
+      imageWrite(shaderio::IndirectRateBindings::eRateSpecHitDist, storage, inputs.specHitDist),
+      bufferWrite(shaderio::IndirectRateBindings::eRateTiles, tilesInfo),
+      bufferWrite(shaderio::IndirectRateBindings::eRateIndirect, indirectInfo),
+      bufferWrite(shaderio::IndirectRateBindings::eRateStats, statsInfo),
+  };
+  vkCmdPushDescriptorSetKHR(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, uint32_t(std::size(writes)), writes);
+}
+
+void IndirectRate::pushConstants(VkCommandBuffer cmd, VkExtent2D size)
+{
+  const VkExtent2D                         tiles = tileCount(size);
+  const shaderio::IndirectRatePushConstant pushConst{.size      = {int32_t(size.width), int32_t(size.height)},
+                                                     .tiles     = {int32_t(tiles.width), int32_t(tiles.height)},
+                                                     .threshold = threshold,
+                                                     .frame     = m_frame};
+  vkCmdPushConstants(cmd, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConst), &pushConst);
+}
+
+void IndirectRate::cmdComputeRates(VkCommandBuffer cmd, const Inputs& inputs, VkExtent2D size)
+{
+  vkCmdFillBuffer(cmd, m_stats.buffer, 0, VK_WHOLE_SIZE, 0);
+
+  // Clear done, last frame's ray generation done reading the rates, its denoised output written
+  const VkMemoryBarrier2 before{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                .srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR
+                                                | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT,
+                                .dstStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                .dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT};
+  const VkDependencyInfo depBefore{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &before};
+  vkCmdPipelineBarrier2(cmd, &depBefore);
+  if(!m_enabled)
+  {
+    return;
+  }
+
+  vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_ratePipeline);
+  pushDescriptors(cmd, inputs);
+  pushConstants(cmd, size);
+  const VkExtent2D tiles = tileCount(size);
+  vkCmdDispatch(cmd, (tiles.width + 7) / 8, (tiles.height + 7) / 8, 1);
+
+  // Rates read by the ray generation
+  const VkMemoryBarrier2 after{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                               .srcStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                               .srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT,
+                               .dstStageMask  = VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
+                               .dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT};
+  const VkDependencyInfo depAfter{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &after};
+  vkCmdPipelineBarrier2(cmd, &depAfter);
+}
+
+void IndirectRate::cmdReconstruct(VkCommandBuffer cmd, const Inputs& inputs, VkExtent2D size, uint32_t cycleIndex)
+{
+  // Color, hit distance and indirect radiance written by the ray generation
+  const VkMemoryBarrier2 before{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                .srcStageMask  = VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
+                                .srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT,
+                                .dstStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                .dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT};
+  const VkDependencyInfo depBefore{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &before};
+  vkCmdPipelineBarrier2(cmd, &depBefore);
+
+  vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_reconstructPipeline);
+  pushDescriptors(cmd, inputs);
+  pushConstants(cmd, size);
+  const VkExtent2D groups = getGridSize(size);
+  vkCmdDispatch(cmd, groups.width, groups.height, 1);
+
+  // Filled pixels read by DLSS_RR, the statistics by the copy
+  const VkMemoryBarrier2 after{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                               .srcStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                               .srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT,
+                               .dstStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                               .dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_TRANSFER_READ_BIT};
+  const VkDependencyInfo depAfter{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &after};
+  vkCmdPipelineBarrier2(cmd, &depAfter);
+
+  m_readback.cmdCopy(cmd, m_stats.buffer, cycleIndex);
+  if(cycleIndex != ReadbackRing::kReplaySlot)
+  {
+    m_frame++;
+  }
+}
+
+void IndirectRate::onUI()
+{
+  using namespace nvgui;
+
+  PropertyEditor::begin();
+  PropertyEditor::entry(
+      "Rate Threshold",
+      [&] { return ImGui::SliderFloat("##threshold", &threshold, 0.001f, 0.5f, "%.3f", ImGuiSliderFlags_Logarithmic); },
+      "Tile complexity (relative luminance, depth or normal change) below which a tile traces half of its indirect "
+      "paths, below a quarter of it a quarter of them");
+  PropertyEditor::end();
+
+  const IndirectRateResult& r     = m_result;
+  const uint32_t            tiles = r.fullTiles + r.halfTiles + r.quarterTiles;
+  if(tiles > 0)
+  {
+    ImGui::Text("Tiles: %u full, %u half, %u quarter rate", r.fullTiles, r.halfTiles, r.quarterTiles);
+    ImGui::Text("Indirect paths skipped: %.1f%%", r.skippedFraction * 100.0);
+    ImGui::Text("Reconstruction error: %.3f (%u samples)", r.reconstructError, r.reconstructSamples);
+    ImGui::SetItemTooltip("Mean relative luminance difference between traced pixels and their prediction from the traced "
+                          "neighbors; includes the path tracing noise");
+  }
+}
+
+nlohmann::json IndirectRate::toJson() const
+{
+  return {{"enabled", m_enabled},
+          {"threshold", threshold},
+          {"full_tiles", m_result.fullTiles},
+          {"half_tiles", m_result.halfTiles},
+          {"quarter_tiles", m_result.quarterTiles},
+          {"skipped_fraction", m_result.skippedFraction},
+          {"reconstruct_error", m_result.reconstructError},
+          {"reconstruct_samples", m_result.reconstructSamples}};
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <glm/glm.hpp>
+#include <nvvk/resource_allocator.hpp>
+#include <tinygltf/json.hpp>
+
+#include "readback_ring.hpp"
+
+#include <span>
+
+
+struct IndirectRateResult
+{
+  uint32_t fullTiles          = 0;
+  uint32_t halfTiles          = 0;
+  uint32_t quarterTiles       = 0;
+  double   skippedFraction    = 0.0;  // of the rendered pixels, skipping their indirect path
+  double   reconstructError   = 0.0;  // mean relative luminance error of predicting a traced pixel from its neighbors
+  uint32_t reconstructSamples = 0;
+};
+
+
+// IndirectRate lets flat, low-frequency regions trace fewer indirect paths (indirect_rate.slang). Before the trace,
+// the last frame's denoised output and guide buffers give every 8x8 tile a rate: full, half or quarter. The ray
+// generation reprojects its primary hit with the motion vector to pick the rate and skips the indirect path outside
+// of the rate's pattern, writing its indirect radiance to a buffer either way. After the trace, skipped pixels are
+// reconstructed from that buffer before DLSS_RR. Both passes are in the ray tracing pass, so its time is the net.
+// Foveation (FLAGS_FOVEATION) lowers the rate away from the gaze in the ray generation and only needs the
+// reconstruction, see Foveation.
+class IndirectRate
+{
+public:
+  // Render buffers, in VK_IMAGE_LAYOUT_GENERAL
+  struct Inputs
+  {
+    VkDescriptorImageInfo denoised;  // last frame's output, sampled at the output resolution
+    VkDescriptorImageInfo viewZ;
+    VkDescriptorImageInfo normal;
+    VkDescriptorImageInfo color;
+    VkDescriptorImageInfo specHitDist;
+  };
+
+  IndirectRate() = default;
+  ~IndirectRate();
+
+  void init(nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv, uint32_t frameCycleSize);
+  void deinit();
+
+  // Adaptive rates from the image complexity
+  bool isEnabled() const { return m_enabled; }
+  void setEnabled(bool enabled);
+  // Foveated rates, decided by the ray generation alone. 'tiles' are the foveation's full, half and quarter rate
+  // tiles, reported in place of the adaptive ones when those are off, see Foveation::tileRates().
+  void setFoveated(bool foveated, glm::uvec3 tiles = glm::uvec3(0));
+  // Either of them: the passes must run
+  bool isActive() const { return m_enabled || m_foveated; }
+
+  // (Re)creates the tile and radiance buffers for the maximum render size; all tiles restart at full rate
+  void resize(VkCommandBuffer cmd, VkExtent2D maxSize);
+
+  // Fetches the result of the frame that last used 'cycleIndex'
+  void readResults(uint32_t cycleIndex);
+
+  // Before the trace: rates of the tiles of the rendered region 'size', from the last frame's buffers. Only resets
+  // the statistics without adaptive rates.
+  void cmdComputeRates(VkCommandBuffer cmd, const Inputs& inputs, VkExtent2D size);
+  // After the trace: fills the skipped pixels of the color and specular hit distance. A replay with
+  // ReadbackRing::kReplaySlot keeps the frame index.
+  void cmdReconstruct(VkCommandBuffer cmd, const Inputs& inputs, VkExtent2D size, uint32_t cycleIndex);
+
+  // For the ray generation's push constants
+  VkDeviceAddress tileRates() const { return m_tiles.address; }
+  VkDeviceAddress indirectRadiance() const { return m_indirect.address; }
+
+  const IndirectRateResult& result() const { return m_result; }
+
+  // Threshold and the last result
+  void           onUI();
+  nlohmann::json toJson() const;
+
+  float threshold = 0.05f;  // tile complexity below which the rate drops, see indirect_rate.slang
+
+private:
+  void pushDescriptors(VkCommandBuffer cmd, const Inputs& inputs);
+  void pushConstants(VkCommandBuffer cmd, VkExtent2D size);
+
+  nvvk::ResourceAllocator* m_alloc               = nullptr;
+  VkDevice                 m_device              = VK_NULL_HANDLE;
+  VkDescriptorSetLayout    m_dsetLayout          = VK_NULL_HANDLE;
+  VkPipelineLayout         m_pipelineLayout      = VK_NULL_HANDLE;
+  VkPipeline               m_ratePipeline        = VK_NULL_HANDLE;
+  VkPipeline               m_reconstructPipeline = VK_NULL_HANDLE;
+  nvvk::Buffer             m_tiles;
+  nvvk::Buffer             m_indirect;
+  nvvk::Buffer             m_stats;
+  ReadbackRing             m_readback;
+
+  IndirectRateResult m_result;
+  uint32_t           m_frame   = 0;
+  bool               m_enabled  = false;
+  bool               m_foveated = false;
+  glm::uvec3         m_foveatedTiles{0};
+};
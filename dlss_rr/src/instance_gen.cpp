@@ -0,0 +1,533 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "instance_gen.hpp"
+
+#include <imgui/imgui.h>
+
+#include <nvgui/property_editor.hpp>
+#include <nvvk/check_error.hpp>
+#include <nvvk/debug_util.hpp>
+#include <nvvk/pipeline.hpp>
+#include <nvvk/shaders.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+
+static_assert(sizeof(shaderio::TlasInstance) == sizeof(VkAccelerationStructureInstanceKHR));
+
+static const VkBuildAccelerationStructureFlagsKHR kTlasBuildFlags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
+
+std::vector<VkDeviceAddress> SceneRtxBlas::blasAddresses() const
+{
+  std::vector<VkDeviceAddress> addresses;
+  addresses.reserve(m_blasAccel.size());
+  for(const nvvk::AccelerationStructure& blas : m_blasAccel)
+  {
+    addresses.push_back(blas.address);
+  }
+  return addresses;
+}
+
+VkDeviceSize SceneRtxBlas::blasBytes() const
+{
+  VkDeviceSize bytes = 0;
+  for(const nvvk::AccelerationStructure& blas : m_blasAccel)
+  {
+    bytes += blas.buffer.bufferSize;
+  }
+  return bytes;
+}
+
+std::vector<nvvk::AccelerationStructure> SceneRtxBlas::releaseBlas()
+{
+  std::vector<nvvk::AccelerationStructure> blas(m_blasAccel.size());
+  std::swap(blas, m_blasAccel);
+  m_blasAccel.resize(blas.size());  // empty ones, SceneRtx::destroy() skips them
+  return blas;
+}
+
+
+InstanceGenerator::~InstanceGenerator()
+{
+  assert(m_pipeline == VK_NULL_HANDLE && "Must call deinit");
+}
+
+void InstanceGenerator::init(nvvk::ResourceAllocator* alloc, VkPhysicalDevice physicalDevice, std::span<const uint32_t> spirv, uint32_t frameCycleSize)
+{
+  assert(m_pipeline == VK_NULL_HANDLE && "Init already called");
+
+  m_alloc          = alloc;
+  m_device         = alloc->getDevice();
+  m_frameCycleSize = frameCycleSize;
+
+  VkPhysicalDeviceAccelerationStructurePropertiesKHR asProps{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR};
+  VkPhysicalDeviceProperties2 props{.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2, .pNext = &asProps};
+  vkGetPhysicalDeviceProperties2(physicalDevice, &props);
+  m_scratchAlignment = asProps.minAccelerationStructureScratchOffsetAlignment;
+
+  // Everything is passed by device address
+  const VkPushConstantRange pushConstant{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(shaderio::InstanceGenPushConstant)};
+  NVVK_CHECK(nvvk::createPipelineLayout(m_device, &m_pipelineLayout, {}, {pushConstant}));
+  NVVK_DBG_NAME(m_pipelineLayout);
+
+  VkShaderModule module = VK_NULL_HANDLE;
+  NVVK_CHECK(nvvk::createShaderModule(module, m_device, spirv));
+
+  const VkComputePipelineCreateInfo pipelineInfo{
+      .sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+      .stage  = {.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, .stage = VK_SHADER_STAGE_COMPUTE_BIT, .module = module, .pName = "main"},
+      .layout = m_pipelineLayout,
+  };
+  NVVK_CHECK(vkCreateComputePipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipeline));
+  NVVK_DBG_NAME(m_pipeline);
+
+  vkDestroyShaderModule(m_device, module, nullptr);
+}
+
+void InstanceGenerator::deinit()
+{
+  destroyScene();
+
+  vkDestroyPipeline(m_device, m_pipeline, nullptr);
+  vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
+  m_pipeline       = VK_NULL_HANDLE;
+  m_pipelineLayout = VK_NULL_HANDLE;
+}
+
+std::vector<glm::vec4> computePrimitiveBounds(const nvvkgltf::Scene& scene, size_t numRenderPrims)
+{
+  std::vector<glm::vec4> bounds(numRenderPrims, glm::vec4(0.0f, 0.0f, 0.0f, -1.0f));
+
+  const tinygltf::Model& model = scene.getModel();
+  for(const nvvkgltf::RenderNode& renderNode : scene.getRenderNodes())
+  {
+    glm::vec4& sphere = bounds[renderNode.renderPrimID];
+    if(sphere.w >= 0.0f)
+    {
+      continue;
+    }
+
+    const tinygltf::Node& node = model.nodes[renderNode.refNodeID];
+    if(node.mesh < 0)
+    {
+      continue;
+    }
+
+    glm::vec3 bbMin(FLT_MAX);
+    glm::vec3 bbMax(-FLT_MAX);
+    bool      known = true;
+    for(const tinygltf::Primitive& primitive : model.meshes[node.mesh].primitives)
+    {
+      const auto position = primitive.attributes.find("POSITION");
+      if(position == primitive.attributes.end())
+      {
+        continue;
+      }
+      const tinygltf::Accessor& accessor = model.accessors[position->second];
+      if(accessor.minValues.size() < 3 || accessor.maxValues.size() < 3)
+      {
+        known = false;
+        break;
+      }
+      bbMin = glm::min(bbMin, glm::vec3(accessor.minValues[0], accessor.minValues[1], accessor.minValues[2]));
+      bbMax = glm::max(bbMax, glm::vec3(accessor.maxValues[0], accessor.maxValues[1], accessor.maxValues[2]));
+    }
+
+    if(known && bbMin.x <= bbMax.x)
+    {
+      sphere = glm::vec4((bbMin + bbMax) * 0.5f, glm::length(bbMax - bbMin) * 0.5f);
+    }
+  }
+  return bounds;
+}
+
+void InstanceGenerator::setScene(nvvk::StagingUploader&           staging,
+                                 const nvvkgltf::Scene&           scene,
+                                 std::span<const VkDeviceAddress> blasAddresses,
+                                 std::span<const VkDeviceAddress> lodBlasAddresses)
+{
+  destroyScene();
+
+  // Each render node selects its pair of hit groups, when the ray tracing pipeline has them
+  const tinygltf::Model& model      = scene.getModel();
+  const bool             hitRecords = scene.getRenderNodes().size() <= HIT_RECORD_MAX_NODES;
+  for(const nvvkgltf::RenderNode& renderNode : scene.getRenderNodes())
+  {
+    // Same flags as SceneRtx
+    VkGeometryInstanceFlagsKHR flags = 0;
+    if(renderNode.materialID >= 0)
+    {
+      const tinygltf::Material& material = model.materials[renderNode.materialID];
+      if(material.alphaMode == "OPAQUE")
+      {
+        flags |= VK_GEOMETRY_INSTANCE_FORCE_OPAQUE_BIT_KHR;
+      }
+      if(material.doubleSided)
+      {
+        flags |= VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR;
+      }
+    }
+    const uint32_t sbtOffset = hitRecords ? uint32_t(m_descs.size()) * HIT_RECORD_GROUPS : 0;
+    m_descs.push_back(makeInstanceDesc(renderNode.worldMatrix, uint32_t(renderNode.renderPrimID), 0xFF, flags, sbtOffset));
+  }
+  m_primBounds = computePrimitiveBounds(scene, blasAddresses.size());
+  m_blasAddresses.assign(blasAddresses.begin(), blasAddresses.end());
+  m_blasAddresses.insert(m_blasAddresses.end(), lodBlasAddresses.begin(), lodBlasAddresses.end());
+  m_lodLevels = blasAddresses.empty() ? 1 : uint32_t(m_blasAddresses.size() / blasAddresses.size());
+
+  if(m_descs.empty())
+  {
+    return;
+  }
+
+  const VkDeviceSize           instancesSize = sizeof(VkAccelerationStructureInstanceKHR) * instanceCount();
+  const VkBufferUsageFlags2KHR storage = VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_2_SHADER_DEVICE_ADDRESS_BIT;
+  const VkBufferUsageFlags2KHR buildInput =
+      VK_BUFFER_USAGE_2_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR | VK_BUFFER_USAGE_2_SHADER_DEVICE_ADDRESS_BIT;
+
+  NVVK_CHECK(m_alloc->createBuffer(m_bDescs, std::span(m_descs).size_bytes(), storage));
+  NVVK_CHECK(m_alloc->createBuffer(m_bPrimBounds, std::span(m_primBounds).size_bytes(), storage));
+  NVVK_CHECK(m_alloc->createBuffer(m_bBlasAddresses, std::span(m_blasAddresses).size_bytes(), storage | VK_BUFFER_USAGE_2_TRANSFER_DST_BIT));
+  NVVK_CHECK(m_alloc->createBuffer(m_bInstances, instancesSize, storage | buildInput));
+  NVVK_DBG_NAME(m_bDescs.buffer);
+  NVVK_DBG_NAME(m_bPrimBounds.buffer);
+  NVVK_DBG_NAME(m_bBlasAddresses.buffer);
+  NVVK_DBG_NAME(m_bInstances.buffer);
+  NVVK_CHECK(staging.appendBuffer(m_bDescs, 0, std::span(m_descs)));
+  NVVK_CHECK(staging.appendBuffer(m_bPrimBounds, 0, std::span(m_primBounds)));
+  NVVK_CHECK(staging.appendBuffer(m_bBlasAddresses, 0, std::span(m_blasAddresses)));
+
+  m_bHostInstances.resize(m_frameCycleSize);
+  for(nvvk::Buffer& buffer : m_bHostInstances)
+  {
+    NVVK_CHECK(m_alloc->createBuffer(buffer, instancesSize, buildInput, VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+                                     VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT));
+    NVVK_DBG_NAME(buffer.buffer);
+  }
+
+  // The instance count never changes, the TLAS is rebuilt in place
+  const VkAccelerationStructureGeometryKHR geometry{
+      .sType        = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR,
+      .geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR,
+      .geometry     = {.instances = {.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR}},
+  };
+  const VkAccelerationStructureBuildGeometryInfoKHR buildInfo{.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR,
+                                                              .type  = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR,
+                                                              .flags = kTlasBuildFlags,
+                                                              .mode  = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR,
+                                                              .geometryCount = 1,
+                                                              .pGeometries   = &geometry};
+  const uint32_t count = instanceCount();
+  VkAccelerationStructureBuildSizesInfoKHR sizeInfo{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR};
+  vkGetAccelerationStructureBuildSizesKHR(m_device, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfo, &count, &sizeInfo);
+
+  const VkAccelerationStructureCreateInfoKHR createInfo{.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR,
+                                                        .size  = sizeInfo.accelerationStructureSize,
+                                                        .type  = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR};
+  NVVK_CHECK(m_alloc->createAcceleration(m_tlas, createInfo));
+  NVVK_DBG_NAME(m_tlas.accel);
+  NVVK_CHECK(m_alloc->createBuffer(m_bScratch, sizeInfo.buildScratchSize, storage, VMA_MEMORY_USAGE_AUTO, {}, m_scratchAlignment));
+  NVVK_DBG_NAME(m_bScratch.buffer);
+}
+
+void InstanceGenerator::destroyScene()
+{
+  m_alloc->destroyAcceleration(m_tlas);
+  m_alloc->destroyBuffer(m_bScratch);
+  m_alloc->destroyBuffer(m_bDescs);
+  m_alloc->destroyBuffer(m_bPrimBounds);
+  m_alloc->destroyBuffer(m_bBlasAddresses);
+  m_alloc->destroyBuffer(m_bInstances);
+  for(nvvk::Buffer& buffer : m_bHostInstances)
+  {
+    m_alloc->destroyBuffer(buffer);
+  }
+  m_bHostInstances.clear();
+
+  m_descs.clear();
+  m_primBounds.clear();
+  m_blasAddresses.clear();
+  m_dirtyBlasAddresses.clear();
+  m_lodLevels = 1;
+}
+
+void InstanceGenerator::setMode(Mode mode)
+{
+  m_mode = (mode == Mode::eStatic && !m_staticAllowed) ? Mode::eGpu : mode;
+  resetStatistics();
+}
+
+void InstanceGenerator::setStaticAllowed(bool allowed)
+{
+  m_staticAllowed = allowed;
+  setMode(m_mode);
+}
+
+void InstanceGenerator::setBlasAddress(uint32_t renderPrimID, VkDeviceAddress address)
+{
+  if(m_blasAddresses[renderPrimID] != address)
+  {
+    m_blasAddresses[renderPrimID] = address;
+    m_dirtyBlasAddresses.push_back(renderPrimID);
+  }
+}
+
+void InstanceGenerator::resetStatistics()
+{
+  m_hostTimeSum = 0.0;
+  m_hostSamples = 0;
+}
+
+void InstanceGenerator::cmdGenerate(VkCommandBuffer cmd, const glm::vec3& cameraPos, uint32_t cycleIndex)
+{
+  if(m_mode == Mode::eStatic || m_descs.empty())
+  {
+    return;
+  }
+
+  // The previous frame's trace and build are done with the TLAS, scratch and instances
+  const VkMemoryBarrier2 before{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                .srcStageMask  = VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR
+                                                | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                .srcAccessMask = VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+                                .dstStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR
+                                                | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                .dstAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR
+                                                 | VK_ACCESS_2_TRANSFER_WRITE_BIT};
+  const VkDependencyInfo depBefore{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &before};
+  vkCmdPipelineBarrier2(cmd, &depBefore);
+
+  // BLASes replaced since the last frame, few at a time
+  if(!m_dirtyBlasAddresses.empty())
+  {
+    for(uint32_t renderPrimID : m_dirtyBlasAddresses)
+    {
+      vkCmdUpdateBuffer(cmd, m_bBlasAddresses.buffer, renderPrimID * sizeof(VkDeviceAddress), sizeof(VkDeviceAddress),
+                        &m_blasAddresses[renderPrimID]);
+    }
+    m_dirtyBlasAddresses.clear();
+
+    const VkMemoryBarrier2 update{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                  .srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                  .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                  .dstStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                  .dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT};
+    const VkDependencyInfo depUpdate{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &update};
+    vkCmdPipelineBarrier2(cmd, &depUpdate);
+  }
+
+  // All levels are written, disabled LODs get mask 0
+  const FrameParams frame{.cameraPos    = cameraPos,
+                          .cullDistance = cullDistance,
+                          .lodLevels    = m_lodLevels,
+                          .lodThreshold = lodEnabled ? lodThreshold : 0.0f};
+  const uint32_t    numRenderPrims = uint32_t(m_primBounds.size());
+
+  VkDeviceAddress instances = 0;
+  if(m_mode == Mode::eGpu)
+  {
+    const shaderio::InstanceGenPushConstant pushConst{.descs          = (shaderio::InstanceDesc*)m_bDescs.address,
+                                                      .primBounds     = (glm::vec4*)m_bPrimBounds.address,
+                                                      .blasAddresses  = (glm::uvec2*)m_bBlasAddresses.address,
+                                                      .instances      = (shaderio::TlasInstance*)m_bInstances.address,
+                                                      .cameraCull     = glm::vec4(frame.cameraPos, frame.cullDistance),
+                                                      .count          = nodeCount(),
+                                                      .numRenderPrims = numRenderPrims,
+                                                      .lodLevels      = frame.lodLevels,
+                                                      .lodThreshold   = frame.lodThreshold};
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+    vkCmdPushConstants(cmd, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConst), &pushConst);
+    vkCmdDispatch(cmd, (nodeCount() + INSTANCE_GEN_GROUP_SIZE - 1) / INSTANCE_GEN_GROUP_SIZE, 1, 1);
+
+    const VkMemoryBarrier2 barrier{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                   .srcStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                   .srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT,
+                                   .dstStageMask  = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                                   .dstAccessMask = VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_2_SHADER_READ_BIT};
+    const VkDependencyInfo depInfo{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &barrier};
+    vkCmdPipelineBarrier2(cmd, &depInfo);
+
+    instances = m_bInstances.address;
+  }
+  else
+  {
+    // The frame that used this cycle index before has completed; host writes are visible at submit
+    const auto start = std::chrono::steady_clock::now();
+
+    const nvvk::Buffer& buffer = m_bHostInstances[cycleIndex];
+    auto*               out    = static_cast<VkAccelerationStructureInstanceKHR*>(buffer.mapping);
+    for(uint32_t lod = 0; lod < m_lodLevels; ++lod)
+    {
+      for(size_t i = 0; i < m_descs.size(); ++i)
+      {
+        const shaderio::InstanceDesc& desc    = m_descs[i];
+        VkDeviceAddress               address = m_blasAddresses[lod * numRenderPrims + desc.renderPrimID];
+        if(address == 0)
+        {
+          address = m_blasAddresses[desc.renderPrimID];
+        }
+        out[lod * m_descs.size() + i] = makeTlasInstance(desc, m_primBounds[desc.renderPrimID], address, lod, frame);
+      }
+    }
+    NVVK_CHECK(vmaFlushAllocation(*m_alloc, buffer.allocation, 0, VK_WHOLE_SIZE));
+
+    m_hostTimeSum += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    m_hostSamples++;
+
+    instances = buffer.address;
+  }
+
+  const VkAccelerationStructureGeometryKHR geometry{
+      .sType        = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR,
+      .geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR,
+      .geometry     = {.instances = {.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR,
+                                     .data  = {.deviceAddress = instances}}},
+  };
+  const VkAccelerationStructureBuildGeometryInfoKHR buildInfo{.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR,
+                                                              .type  = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR,
+                                                              .flags = kTlasBuildFlags,
+                                                              .mode  = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR,
+                                                              .dstAccelerationStructure = m_tlas.accel,
+                                                              .geometryCount            = 1,
+                                                              .pGeometries              = &geometry,
+                                                              .scratchData = {.deviceAddress = m_bScratch.address}};
+  const VkAccelerationStructureBuildRangeInfoKHR  range{.primitiveCount = instanceCount()};
+  const VkAccelerationStructureBuildRangeInfoKHR* ranges[] = {&range};
+  vkCmdBuildAccelerationStructuresKHR(cmd, 1, &buildInfo, ranges);
+
+  const VkMemoryBarrier2 after{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                               .srcStageMask  = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                               .srcAccessMask = VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+                               .dstStageMask  = VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
+                               .dstAccessMask = VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR};
+  const VkDependencyInfo depAfter{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &after};
+  vkCmdPipelineBarrier2(cmd, &depAfter);
+}
+
+shaderio::InstanceDesc InstanceGenerator::makeInstanceDesc(const glm::mat4&           world,
+                                                           uint32_t                   renderPrimID,
+                                                           uint32_t                   mask,
+                                                           VkGeometryInstanceFlagsKHR flags,
+                                                           uint32_t                   sbtOffset)
+{
+  // glm is column major, the rows of the 3x4 part are gathered across columns
+  const glm::mat4 rows = glm::transpose(world);
+  return {.row0 = rows[0], .row1 = rows[1], .row2 = rows[2], .renderPrimID = renderPrimID, .mask = mask, .flags = flags, .sbtOffset = sbtOffset};
+}
+
+// Mirror worldSphere() and lodMask() in instance_gen.slang
+static glm::vec4 worldSphere(const shaderio::InstanceDesc& desc, const glm::vec4& bounds)
+{
+  const glm::vec4 center(glm::vec3(bounds), 1.0f);
+  const glm::vec3 worldCenter(glm::dot(desc.row0, center), glm::dot(desc.row1, center), glm::dot(desc.row2, center));
+  const glm::vec3 axisScale(glm::length(glm::vec3(desc.row0.x, desc.row1.x, desc.row2.x)),
+                            glm::length(glm::vec3(desc.row0.y, desc.row1.y, desc.row2.y)),
+                            glm::length(glm::vec3(desc.row0.z, desc.row1.z, desc.row2.z)));
+  return glm::vec4(worldCenter, bounds.w * std::max(std::max(axisScale.x, axisScale.y), axisScale.z));
+}
+
+static uint32_t lodMask(const glm::vec4& sphere, float distanceToCenter, uint32_t lod, const InstanceGenerator::FrameParams& frame)
+{
+  if(frame.lodLevels <= 1 || frame.lodThreshold <= 0.0f || sphere.w < 0.0f)
+  {
+    return lod == 0 ? 0xFF : 0;
+  }
+
+  const float    size      = sphere.w / std::max(distanceToCenter, sphere.w);
+  const float    level     = std::clamp(std::log2(frame.lodThreshold / std::max(size, 1e-8f)), 0.0f, float(frame.lodLevels - 1));
+  const uint32_t lower     = uint32_t(level);
+  const uint32_t upper     = std::min(uint32_t(std::round((level - float(lower)) * 8.0f)), 8u);  // bits of level lower + 1
+  const uint32_t lowerBits = (1u << (8 - upper)) - 1;
+  if(lod == lower)
+  {
+    return lowerBits;
+  }
+  return lod == lower + 1 ? (0xFF & ~lowerBits) : 0;
+}
+
+// Mirrors the loop body of main() in instance_gen.slang
+VkAccelerationStructureInstanceKHR InstanceGenerator::makeTlasInstance(const shaderio::InstanceDesc& desc,
+                                                                       const glm::vec4&              bounds,
+                                                                       VkDeviceAddress               blasAddress,
+                                                                       uint32_t                      lod,
+                                                                       const FrameParams&            frame)
+{
+  const glm::vec4 sphere           = worldSphere(desc, bounds);
+  const float     distanceToCenter = glm::distance(glm::vec3(sphere), frame.cameraPos);
+  const bool      culled = frame.cullDistance > 0.0f && bounds.w >= 0.0f && distanceToCenter - sphere.w > frame.cullDistance;
+  const bool      proxy  = (blasAddress & BLAS_ADDRESS_PROXY_BIT) != 0;
+
+  VkAccelerationStructureInstanceKHR instance{};
+  memcpy(&instance.transform.matrix[0], &desc.row0, sizeof(glm::vec4));
+  memcpy(&instance.transform.matrix[1], &desc.row1, sizeof(glm::vec4));
+  memcpy(&instance.transform.matrix[2], &desc.row2, sizeof(glm::vec4));
+  instance.instanceCustomIndex = (desc.renderPrimID & INSTANCE_PRIM_MASK) | (lod << INSTANCE_LOD_SHIFT);
+  instance.instanceCustomIndex |= proxy ? INSTANCE_PROXY_BIT : 0;
+  instance.mask                                   = culled ? 0 : (desc.mask & lodMask(sphere, distanceToCenter, lod, frame));
+  instance.instanceShaderBindingTableRecordOffset = desc.sbtOffset;
+  instance.flags                                  = desc.flags;
+  instance.accelerationStructureReference         = blasAddress & ~VkDeviceAddress(BLAS_ADDRESS_PROXY_BIT);
+  return instance;
+}
+
+bool InstanceGenerator::onUI()
+{
+  using namespace nvgui;
+
+  const Mode previous = m_mode;
+  int        mode     = int(m_mode);
+
+  PropertyEditor::begin();
+  PropertyEditor::entry(
+      "Instance Generation", [&] { return ImGui::Combo("##mode", &mode, "Static (SceneRtx)\0Host, per frame\0GPU, per frame\0"); },
+      "Static: TLAS built once at load, not available with geometry streaming. Host/GPU: instances written every "
+      "frame, then the TLAS is rebuilt");
+  PropertyEditor::entry(
+      "Cull Distance", [&] { return ImGui::DragFloat("##cull", &cullDistance, 1.0f, 0.0f, FLT_MAX, "%.1f"); },
+      "Instances whose bounding sphere is farther away are masked out. 0 disables culling");
+  PropertyEditor::end();
+
+  ImGui::Text("%u instances (%u render nodes, %u LOD levels)", instanceCount(), nodeCount(), m_lodLevels);
+  if(m_mode == Mode::eHost)
+  {
+    ImGui::Text("Host generation: %.3f ms", hostMilliseconds());
+  }
+
+  if(Mode(mode) != previous)
+  {
+    setMode(Mode(mode));
+  }
+  return m_mode != previous;
+}
+
+nlohmann::json InstanceGenerator::toJson() const
+{
+  const char* modeNames[] = {"static", "host", "gpu"};
+  return {{"mode", modeNames[int(m_mode)]},
+          {"instances", instanceCount()},
+          {"cull_distance", cullDistance},
+          {"lod_levels", activeLodLevels()},
+          {"lod_threshold", lodThreshold},
+          {"host_ms", hostMilliseconds()}};
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <nvvk/resource_allocator.hpp>
+#include <nvvk/staging.hpp>
+#include <nvvkgltf/scene.hpp>
+#include <nvvkgltf/scene_rtx.hpp>
+#include <tinygltf/json.hpp>
+
+#include "shaders/host_device.h"
+
+#include <span>
+#include <vector>
+
+
+// SceneRtx with access to the BLAS of each render primitive, which the instance generation references
+class SceneRtxBlas : public nvvkgltf::SceneRtx
+{
+public:
+  std::vector<VkDeviceAddress> blasAddresses() const;
+  VkDeviceSize                 blasBytes() const;
+
+  // Hands the BLASes over to the caller, e.g. the geometry streaming. tlas() must not be traced anymore.
+  std::vector<nvvk::AccelerationStructure> releaseBlas();
+};
+
+// Local bounding sphere of each render primitive, from the POSITION bounds of the glTF mesh it belongs to;
+// radius < 0 when unknown
+std::vector<glm::vec4> computePrimitiveBounds(const nvvkgltf::Scene& scene, size_t numRenderPrims);
+
+// InstanceGenerator rebuilds the TLAS every frame from a compact InstanceDesc buffer, either with a compute
+// pass (instance_gen.slang) or on the host, for comparison. Both can cull instances by distance: culled
+// instances keep their slot with mask 0, so InstanceIndex() keeps addressing the render nodes.
+// With LODs (MeshLods), every render node has one instance per level, level k after level k - 1; the mask
+// bits are split between the levels by projected size, see lodMask() in instance_gen.slang.
+// In eStatic mode nothing is done and the TLAS built once by SceneRtx is used, LOD 0 only.
+class InstanceGenerator
+{
+public:
+  enum class Mode
+  {
+    eStatic,
+    eHost,
+    eGpu,
+  };
+
+  InstanceGenerator() = default;
+  ~InstanceGenerator();
+
+  void init(nvvk::ResourceAllocator* alloc, VkPhysicalDevice physicalDevice, std::span<const uint32_t> spirv, uint32_t frameCycleSize);
+  void deinit();
+
+  // Per-frame inputs of makeTlasInstance()
+  struct FrameParams
+  {
+    glm::vec3 cameraPos{};
+    float     cullDistance = 0.0f;  // 0: no culling
+    uint32_t  lodLevels    = 1;
+    float     lodThreshold = 0.0f;  // 0: LOD 0 only
+  };
+
+  // Creates the instance descriptions and the TLAS of 'scene'. The data is appended to 'staging',
+  // the TLAS is built by the first cmdGenerate(). 'lodBlasAddresses' has the BLASes of the LOD levels > 0,
+  // level-major like MeshLods::blasAddresses(), 0 for levels that trace level 0. Up to HIT_RECORD_MAX_NODES
+  // render nodes, the instances select the hit groups of their render node, see HitRecord.
+  void setScene(nvvk::StagingUploader&           staging,
+                const nvvkgltf::Scene&           scene,
+                std::span<const VkDeviceAddress> blasAddresses,
+                std::span<const VkDeviceAddress> lodBlasAddresses = {});
+  void destroyScene();
+
+  Mode mode() const { return m_mode; }
+  void setMode(Mode mode);
+
+  // Without the static TLAS (its BLASes may be gone), setMode(eStatic) selects eGpu
+  void setStaticAllowed(bool allowed);
+
+  // Replaces the LOD 0 BLAS of a render primitive from the next cmdGenerate() on; 'address' may carry
+  // BLAS_ADDRESS_PROXY_BIT
+  void setBlasAddress(uint32_t renderPrimID, VkDeviceAddress address);
+
+  // Writes this frame's instances and rebuilds tlas(); does nothing in eStatic mode
+  void cmdGenerate(VkCommandBuffer cmd, const glm::vec3& cameraPos, uint32_t cycleIndex);
+
+  VkAccelerationStructureKHR tlas() const { return m_tlas.accel; }
+  uint32_t                   nodeCount() const { return uint32_t(m_descs.size()); }
+  uint32_t                   instanceCount() const { return nodeCount() * m_lodLevels; }
+
+  // LOD levels in the TLAS, and those the rays should select from (1 when disabled or in eStatic mode)
+  uint32_t lodLevels() const { return m_lodLevels; }
+  uint32_t activeLodLevels() const { return (lodEnabled && m_mode != Mode::eStatic) ? m_lodLevels : 1; }
+
+  // Average CPU time of the host path since the last reset
+  double hostMilliseconds() const { return m_hostSamples ? m_hostTimeSum / double(m_hostSamples) : 0.0; }
+  void   resetStatistics();
+
+  // Returns true when the mode changed, and with it the TLAS to trace
+  bool           onUI();
+  nlohmann::json toJson() const;
+
+  static shaderio::InstanceDesc makeInstanceDesc(const glm::mat4&           world,
+                                                 uint32_t                   renderPrimID,
+                                                 uint32_t                   mask,
+                                                 VkGeometryInstanceFlagsKHR flags,
+                                                 uint32_t                   sbtOffset = 0);
+
+  // Host equivalent of instance_gen.slang for LOD level 'lod'; 'bounds' is the local bounding sphere,
+  // radius < 0 for unknown
+  static VkAccelerationStructureInstanceKHR makeTlasInstance(const shaderio::InstanceDesc& desc,
+                                                             const glm::vec4&              bounds,
+                                                             VkDeviceAddress               blasAddress,
+                                                             uint32_t                      lod,
+                                                             const FrameParams&            frame);
+
+  float cullDistance = 0.0f;   // 0: no culling
+  bool  lodEnabled   = true;   // off: LOD 0 only, the other levels are masked out
+  float lodThreshold = 0.05f;  // bounding sphere radius / distance below which LOD 1 fades in
+
+private:
+  nvvk::ResourceAllocator* m_alloc            = nullptr;
+  VkDevice                 m_device           = VK_NULL_HANDLE;
+  VkPipelineLayout         m_pipelineLayout   = VK_NULL_HANDLE;
+  VkPipeline               m_pipeline         = VK_NULL_HANDLE;
+  VkDeviceSize             m_scratchAlignment = 0;
+
+  // Host copies, used by the host path
+  std::vector<shaderio::InstanceDesc> m_descs;
+  std::vector<glm::vec4>              m_primBounds;
+  std::vector<VkDeviceAddress>        m_blasAddresses;       // per LOD level and render primitive
+  std::vector<uint32_t>               m_dirtyBlasAddresses;  // not yet in m_bBlasAddresses
+
+  nvvk::Buffer                m_bDescs;
+  nvvk::Buffer                m_bPrimBounds;
+  nvvk::Buffer                m_bBlasAddresses;
+  nvvk::Buffer                m_bInstances;      // written by the compute pass
+  std::vector<nvvk::Buffer>   m_bHostInstances;  // written by the host, one per frame in flight
+  nvvk::Buffer                m_bScratch;
+  nvvk::AccelerationStructure m_tlas;
+
+  Mode     m_mode           = Mode::eStatic;
+  bool     m_staticAllowed  = true;
+  uint32_t m_frameCycleSize = 0;
+  uint32_t m_lodLevels      = 1;
+  double   m_hostTimeSum    = 0.0;
+  uint64_t m_hostSamples    = 0;
+};
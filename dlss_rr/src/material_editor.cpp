@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "material_editor.hpp"
+
+#include <imgui/imgui.h>
+
+#include <nvapp/application.hpp>
+#include <nvgui/file_dialog.hpp>
+#include <nvgui/property_editor.hpp>
+#include <nvutils/logger.hpp>
+#include <nvvk/check_error.hpp>
+#include <nvvk/debug_util.hpp>
+#include <tinygltf/tiny_gltf.h>  // stb_image
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <span>
+#include <utility>
+
+
+MaterialEditor::~MaterialEditor()
+{
+  assert(m_alloc == nullptr && "Must call deinit");
+}
+
+void MaterialEditor::init(nvapp::Application* app, nvvk::ResourceAllocator* alloc)
+{
+  assert(m_alloc == nullptr && "Init already called");
+  m_app   = app;
+  m_alloc = alloc;
+}
+
+void MaterialEditor::deinit()
+{
+  if(m_alloc)
+  {
+    destroyScene();
+  }
+  m_alloc = nullptr;
+}
+
+void MaterialEditor::setScene(const nvvkgltf::Scene& scene, const nvvkgltf::SceneVk& sceneVk)
+{
+  destroyScene();
+
+  const tinygltf::Model& model = scene.getModel();
+
+  // There is always at least one (default) material in the shading material buffer
+  const size_t numMaterials = std::max<size_t>(1, model.materials.size());
+  m_materialBuffer          = sceneVk.material().buffer;
+  m_materials.resize(numMaterials);
+  m_names.resize(numMaterials);
+  m_baseColorTexture.assign(numMaterials, -1);
+  for(size_t i = 0; i < model.materials.size(); ++i)
+  {
+    m_names[i]            = model.materials[i].name.empty() ? "Material " + std::to_string(i) : model.materials[i].name;
+    m_baseColorTexture[i] = model.materials[i].pbrMetallicRoughness.baseColorTexture.index;
+  }
+  if(model.materials.empty())
+  {
+    m_names[0] = "Default";
+  }
+
+  for(const nvvk::Image& texture : sceneVk.textures())
+  {
+    m_originalTextures.push_back(texture.descriptor);
+  }
+
+  // The host keeps the converted GltfShadeMaterial values, so an edit only needs to patch fields
+  const VkDeviceSize bytes = numMaterials * sizeof(shaderio::GltfShadeMaterial);
+  nvvk::Buffer       readback;
+  NVVK_CHECK(m_alloc->createBuffer(readback, bytes, VK_BUFFER_USAGE_2_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+                                   VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT));
+  VkCommandBuffer    cmd = m_app->createTempCmdBuffer();
+  const VkBufferCopy region{.srcOffset = 0, .dstOffset = 0, .size = bytes};
+  vkCmdCopyBuffer(cmd, m_materialBuffer, readback.buffer, 1, &region);
+  m_app->submitAndWaitTempCmdBuffer(cmd);
+
+  NVVK_CHECK(vmaInvalidateAllocation(*m_alloc, readback.allocation, 0, VK_WHOLE_SIZE));
+  memcpy(m_materials.data(), readback.mapping, bytes);
+  m_alloc->destroyBuffer(readback);
+
+  m_selected = 0;
+}
+
+void MaterialEditor::destroyScene()
+{
+  for(auto& [slot, image] : m_replacedTextures)
+  {
+    m_alloc->destroyImage(image);
+  }
+  m_replacedTextures.clear();
+  m_pendingTextures.clear();
+  m_pendingMaterials.clear();
+  m_originalTextures.clear();
+  m_materials.clear();
+  m_names.clear();
+  m_baseColorTexture.clear();
+  m_materialBuffer = VK_NULL_HANDLE;
+  m_batches.clear();
+  m_batchOpen    = false;
+  m_resetHistory = false;
+}
+
+void MaterialEditor::startBatch()
+{
+  if(!m_batchOpen)
+  {
+    m_batchOpen  = true;
+    m_batchStart = Clock::now();
+  }
+}
+
+void MaterialEditor::onApplied(bool resetHistory)
+{
+  m_resetHistory |= resetHistory;
+  m_historyResets += resetHistory ? 1 : 0;
+  if(m_batchOpen)
+  {
+    m_batches.push_back({m_batchStart, m_frame});
+    m_batchOpen = false;
+  }
+}
+
+void MaterialEditor::editMaterial(uint32_t index, const shaderio::GltfShadeMaterial& material)
+{
+  assert(index < m_materials.size());
+
+  shaderio::GltfShadeMaterial& current = m_materials[index];
+  const bool visibility = material.alphaMode != AlphaMode::eAlphaModeOpaque && material.alphaCutoff != current.alphaCutoff;
+
+  current = material;
+  m_pendingMaterials[index] |= visibility;
+  startBatch();
+}
+
+bool MaterialEditor::replaceTexture(uint32_t slot, const std::filesystem::path& filename)
+{
+  assert(slot < m_originalTextures.size());
+
+  int            width = 0, height = 0, components = 0;
+  unsigned char* pixels = stbi_load(filename.string().c_str(), &width, &height, &components, STBI_rgb_alpha);
+  if(pixels == nullptr)
+  {
+    LOGW("Could not load %s: %s\n", filename.string().c_str(), stbi_failure_reason());
+    return false;
+  }
+
+  PendingTexture texture{.slot = slot, .extent = {uint32_t(width), uint32_t(height)}};
+  texture.pixels.assign(pixels, pixels + size_t(width) * height * 4);
+  stbi_image_free(pixels);
+
+  // A later replacement of the same slot wins
+  std::erase_if(m_pendingTextures, [slot](const PendingTexture& t) { return t.slot == slot; });
+  m_pendingTextures.push_back(std::move(texture));
+  startBatch();
+  return true;
+}
+
+void MaterialEditor::applyTextures(nvvk::StagingUploader& staging, VkDescriptorSet set, uint32_t binding)
+{
+  if(m_pendingTextures.empty())
+  {
+    return;
+  }
+
+  // The previous replacement of a slot may still be sampled, and the descriptor set is in use
+  vkDeviceWaitIdle(m_alloc->getDevice());
+
+  VkCommandBuffer cmd = m_app->createTempCmdBuffer();
+  for(PendingTexture& pending : m_pendingTextures)
+  {
+    // Base color textures are the ones the editor replaces: sRGB, no mip chain
+    const VkImageCreateInfo imageInfo{.sType       = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+                                      .imageType   = VK_IMAGE_TYPE_2D,
+                                      .format      = VK_FORMAT_R8G8B8A8_SRGB,
+                                      .extent      = {pending.extent.width, pending.extent.height, 1},
+                                      .mipLevels   = 1,
+                                      .arrayLayers = 1,
+                                      .samples     = VK_SAMPLE_COUNT_1_BIT,
+                                      .usage       = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT};
+    VkImageViewCreateInfo   viewInfo{.sType            = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+                                     .viewType         = VK_IMAGE_VIEW_TYPE_2D,
+                                     .format           = imageInfo.format,
+                                     .subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1}};
+
+    nvvk::Image& image = m_replacedTextures[pending.slot];
+    if(image.image != VK_NULL_HANDLE)
+    {
+      m_alloc->destroyImage(image);
+    }
+    NVVK_CHECK(m_alloc->createImage(image, imageInfo, viewInfo));
+    NVVK_DBG_NAME(image.image);
+    NVVK_CHECK(staging.appendImage(image, std::span(pending.pixels), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL));
+    image.descriptor.sampler = m_originalTextures[pending.slot].sampler;
+  }
+  staging.cmdUploadAppended(cmd);
+  m_app->submitAndWaitTempCmdBuffer(cmd);
+  staging.releaseStaging();
+
+  // Only the replaced array elements are written
+  bool resetHistory = false;
+  for(const PendingTexture& pending : m_pendingTextures)
+  {
+    const VkDescriptorImageInfo imageInfo = m_replacedTextures[pending.slot].descriptor;
+    const VkWriteDescriptorSet  write{.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                                      .dstSet          = set,
+                                      .dstBinding      = binding,
+                                      .dstArrayElement = pending.slot,
+                                      .descriptorCount = 1,
+                                      .descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                      .pImageInfo      = &imageInfo};
+    vkUpdateDescriptorSets(m_alloc->getDevice(), 1, &write, 0, nullptr);
+
+    // The alpha of the texture decides the visibility of alpha tested materials
+    for(size_t i = 0; i < m_materials.size(); ++i)
+    {
+      resetHistory |= m_baseColorTexture[i] == int(pending.slot) && m_materials[i].alphaMode != AlphaMode::eAlphaModeOpaque;
+    }
+  }
+  m_edits += uint32_t(m_pendingTextures.size());
+  m_pendingTextures.clear();
+  onApplied(resetHistory);
+}
+
+void MaterialEditor::cmdApplyMaterials(VkCommandBuffer cmd)
+{
+  if(m_pendingMaterials.empty())
+  {
+    return;
+  }
+
+  // The previous frame may still read the materials
+  VkMemoryBarrier2 barrier{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                           .srcStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                           .srcAccessMask = VK_ACCESS_2_SHADER_READ_BIT,
+                           .dstStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                           .dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT};
+  VkDependencyInfo depInfo{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &barrier};
+  vkCmdPipelineBarrier2(cmd, &depInfo);
+
+  bool resetHistory = false;
+  for(const auto& [index, visibility] : m_pendingMaterials)
+  {
+    vkCmdUpdateBuffer(cmd, m_materialBuffer, index * sizeof(shaderio::GltfShadeMaterial), sizeof(shaderio::GltfShadeMaterial),
+                      &m_materials[index]);
+    resetHistory |= visibility;
+  }
+
+  barrier.srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+  barrier.dstStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+  barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
+  vkCmdPipelineBarrier2(cmd, &depInfo);
+
+  m_edits += uint32_t(m_pendingMaterials.size());
+  m_pendingMaterials.clear();
+  onApplied(resetHistory);
+}
+
+bool MaterialEditor::consumeHistoryReset()
+{
+  return std::exchange(m_resetHistory, false);
+}
+
+void MaterialEditor::beginFrame()
+{
+  ++m_frame;
+
+  // onRender() of frame F runs once the fence of frame F - cycle size was waited on
+  const uint64_t cycleSize = m_app->getFrameCycleSize();
+  const auto     now       = Clock::now();
+  std::erase_if(m_batches, [&](const Batch& batch) {
+    if(batch.frame + cycleSize > m_frame)
+    {
+      return false;
+    }
+    m_lastLatencyMs = std::chrono::duration<double, std::milli>(now - batch.start).count();
+    m_sumLatencyMs += m_lastLatencyMs;
+    m_maxLatencyMs = std::max(m_maxLatencyMs, m_lastLatencyMs);
+    m_latencySamples++;
+    return true;
+  });
+}
+
+VkDescriptorImageInfo MaterialEditor::textureDescriptor(uint32_t slot, const VkDescriptorImageInfo& original) const
+{
+  auto it = m_replacedTextures.find(slot);
+  return it != m_replacedTextures.end() ? it->second.descriptor : original;
+}
+
+void MaterialEditor::onUI(GLFWwindow* window)
+{
+  namespace PE = nvgui::PropertyEditor;
+
+  if(m_materials.empty())
+  {
+    ImGui::TextDisabled("No scene");
+    return;
+  }
+
+  m_selected = std::min(m_selected, materialCount() - 1);
+  if(ImGui::BeginCombo("Material", m_names[m_selected].c_str()))
+  {
+    for(uint32_t i = 0; i < materialCount(); ++i)
+    {
+      ImGui::PushID(int(i));
+      if(ImGui::Selectable(m_names[i].c_str(), i == m_selected))
+      {
+        m_selected = i;
+      }
+      ImGui::PopID();
+    }
+    ImGui::EndCombo();
+  }
+
+  shaderio::GltfShadeMaterial material = m_materials[m_selected];
+
+  bool changed = false;
+  PE::begin();
+  changed |= PE::entry("Base Color", [&] { return ImGui::ColorEdit4("##BaseColor", &material.pbrBaseColorFactor.x); });
+  changed |= PE::entry("Roughness", [&] { return ImGui::SliderFloat("##Roughness", &material.pbrRoughnessFactor, 0.0f, 1.0f); });
+  changed |= PE::entry("Metallic", [&] { return ImGui::SliderFloat("##Metallic", &material.pbrMetallicFactor, 0.0f, 1.0f); });
+  changed |= PE::entry("Emissive", [&] {
+    return ImGui::ColorEdit3("##Emissive", &material.emissiveFactor.x, ImGuiColorEditFlags_HDR | ImGuiColorEditFlags_Float);
+  });
+  if(material.alphaMode == AlphaMode::eAlphaModeMask)
+  {
+    changed |= PE::entry(
+        "Alpha Cutoff", [&] { return ImGui::SliderFloat("##AlphaCutoff", &material.alphaCutoff, 0.0f, 1.0f); },
+        "Changes the visibility: resets the denoiser history");
+  }
+  PE::end();
+  if(changed)
+  {
+    editMaterial(m_selected, material);
+  }
+
+  const int slot = m_baseColorTexture[m_selected];
+  if(slot >= 0 && slot < int(m_originalTextures.size()))
+  {
+    ImGui::Text("Base color texture %d%s", slot, m_replacedTextures.count(uint32_t(slot)) ? " (replaced)" : "");
+    if(ImGui::Button("Replace Texture..."))
+    {
+      const std::filesystem::path filename =
+          nvgui::windowOpenFileDialog(window, "Load Texture", "Images(.png, .jpg, .tga, .bmp)|*.png;*.jpg;*.jpeg;*.tga;*.bmp");
+      if(!filename.empty())
+      {
+        replaceTexture(uint32_t(slot), filename);
+      }
+    }
+  }
+
+  ImGui::Text("Edits applied: %u, history resets: %u", m_edits, m_historyResets);
+  if(m_latencySamples)
+  {
+    ImGui::Text("Edit to frame: %.2f ms (avg %.2f, max %.2f)", m_lastLatencyMs, m_sumLatencyMs / m_latencySamples, m_maxLatencyMs);
+  }
+}
+
+nlohmann::json MaterialEditor::toJson() const
+{
+  return {{"edits", m_edits},
+          {"history_resets", m_historyResets},
+          {"latency_samples", m_latencySamples},
+          {"latency_last_ms", m_lastLatencyMs},
+          {"latency_avg_ms", m_latencySamples ? m_sumLatencyMs / m_latencySamples : 0.0},
+          {"latency_max_ms", m_maxLatencyMs},
+          {"replaced_textures", m_replacedTextures.size()}};
+}
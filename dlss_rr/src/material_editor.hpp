@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <nvvk/resource_allocator.hpp>
+#include <nvvk/staging.hpp>
+#include <nvvkgltf/scene.hpp>
+#include <nvvkgltf/scene_vk.hpp>
+#include <tinygltf/json.hpp>
+
+#include "shaders/host_device.h"
+#include "nvshaders/gltf_scene_io.h.slang"
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace nvapp {
+class Application;
+}
+struct GLFWwindow;
+
+
+// MaterialEditor changes the shading materials and textures of the loaded scene in place, without createScene().
+// Edits are batched per frame: the last value of each edited material is written into the SceneVk material buffer
+// with one vkCmdUpdateBuffer per entry. A replaced texture gets its own image, only its slot of the texture array
+// descriptor is rewritten. Shading edits keep the DLSS history; alpha cutoff changes and textures of alpha tested
+// materials change the visibility and reset it. The latency is measured from the first edit of a batch to the
+// completion of the first frame rendered with it.
+class MaterialEditor
+{
+public:
+  MaterialEditor() = default;
+  ~MaterialEditor();
+
+  void init(nvapp::Application* app, nvvk::ResourceAllocator* alloc);
+  void deinit();
+
+  // Reads the shading materials of 'sceneVk' back as the base of the edits. Waits for the GPU.
+  void setScene(const nvvkgltf::Scene& scene, const nvvkgltf::SceneVk& sceneVk);
+  void destroyScene();
+
+  uint32_t materialCount() const { return uint32_t(m_materials.size()); }
+  // All materials, including the edits not applied yet
+  std::span<const shaderio::GltfShadeMaterial> materials() const { return m_materials; }
+
+  // Including the edits not applied yet
+  const shaderio::GltfShadeMaterial& material(uint32_t index) const { return m_materials[index]; }
+
+  // Queued until the next cmdApplyMaterials(); a later edit of the same material replaces the queued one
+  void editMaterial(uint32_t index, const shaderio::GltfShadeMaterial& material);
+
+  // Decodes an image file for 'slot' of SceneBindings::eTextures; uploaded by the next applyTextures()
+  bool replaceTexture(uint32_t slot, const std::filesystem::path& filename);
+
+  bool hasPendingTextures() const { return !m_pendingTextures.empty(); }
+
+  // Uploads the replaced textures and writes their array elements of 'binding' in 'set'. Waits for the device
+  // to idle: the set is not update-after-bind.
+  void applyTextures(nvvk::StagingUploader& staging, VkDescriptorSet set, uint32_t binding);
+
+  // Writes the queued material entries; record before the passes that read the materials
+  void cmdApplyMaterials(VkCommandBuffer cmd);
+
+  // Returns true once after an applied edit that invalidates the denoiser history
+  bool consumeHistoryReset();
+
+  // Materials and textures applied so far, to notice edits
+  uint32_t editCount() const { return m_edits; }
+
+  // Call at the start of every frame: completes the latency of the batches whose frame is done
+  void beginFrame();
+
+  // 'original' unless the texture was replaced, for writing the whole texture array
+  VkDescriptorImageInfo textureDescriptor(uint32_t slot, const VkDescriptorImageInfo& original) const;
+
+  // 'window' is the parent of the texture file dialog
+  void           onUI(GLFWwindow* window);
+  nlohmann::json toJson() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct PendingTexture
+  {
+    uint32_t                   slot = 0;
+    VkExtent2D                 extent{};
+    std::vector<unsigned char> pixels;  // RGBA8
+  };
+
+  struct Batch
+  {
+    Clock::time_point start;
+    uint64_t          frame = 0;  // first frame rendered with the batch
+  };
+
+  void startBatch();
+  void onApplied(bool resetHistory);
+
+  nvapp::Application*      m_app   = nullptr;
+  nvvk::ResourceAllocator* m_alloc = nullptr;
+
+  VkBuffer                                 m_materialBuffer = VK_NULL_HANDLE;  // owned by SceneVk
+  std::vector<shaderio::GltfShadeMaterial> m_materials;
+  std::vector<std::string>                 m_names;
+  std::vector<int>                         m_baseColorTexture;  // slot per material, -1 without
+  std::vector<VkDescriptorImageInfo>       m_originalTextures;  // per slot, the replacements keep the sampler
+  std::map<uint32_t, bool>                 m_pendingMaterials;  // index, changes visibility
+  std::vector<PendingTexture>              m_pendingTextures;
+  std::map<uint32_t, nvvk::Image>          m_replacedTextures;  // by slot
+
+  std::vector<Batch> m_batches;  // applied, frame not completed yet
+  bool               m_batchOpen    = false;
+  Clock::time_point  m_batchStart   = {};
+  bool               m_resetHistory = false;
+  uint64_t           m_frame        = 0;
+
+  uint32_t m_selected       = 0;
+  uint32_t m_edits          = 0;  // materials and textures applied
+  uint32_t m_historyResets  = 0;
+  uint32_t m_latencySamples = 0;
+  double   m_lastLatencyMs  = 0.0;
+  double   m_sumLatencyMs   = 0.0;
+  double   m_maxLatencyMs   = 0.0;
+};
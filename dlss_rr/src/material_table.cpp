@@ -0,0 +1,440 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "material_table.hpp"
+
+#include <imgui/imgui.h>
+
+#include <nvgui/property_editor.hpp>
+#include <nvutils/logger.hpp>
+#include <nvutils/parameter_registry.hpp>
+#include <nvvk/check_error.hpp>
+#include <nvvk/debug_util.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <utility>
+
+
+static_assert(sizeof(shaderio::CompactMaterial) == 64, "A compact material is one cache line");
+
+namespace {
+
+uint32_t packTexture(int32_t index)
+{
+  // Indices that don't fit make the round trip fail, which marks the material as a fallback
+  return (index >= 0 && index < COMPACT_MATERIAL_NO_TEXTURE) ? uint32_t(index) : uint32_t(COMPACT_MATERIAL_NO_TEXTURE);
+}
+
+int32_t unpackTexture(uint32_t bits)
+{
+  return bits == COMPACT_MATERIAL_NO_TEXTURE ? -1 : int32_t(bits);
+}
+
+bool sameMaterial(const shaderio::GltfShadeMaterial& a, const shaderio::GltfShadeMaterial& b)
+{
+  return std::memcmp(&a, &b, sizeof(shaderio::GltfShadeMaterial)) == 0;
+}
+
+bool isFallback(const shaderio::CompactMaterial& compact)
+{
+  return (compact.flags & COMPACT_MATERIAL_FALLBACK) != 0;
+}
+
+}  // namespace
+
+
+shaderio::GltfShadeMaterial neutralMaterial()
+{
+  shaderio::GltfShadeMaterial material{};
+
+  // Core glTF defaults, decodeMaterial() overwrites them
+  material.pbrBaseColorFactor = glm::vec4(1.0f);
+  material.pbrRoughnessFactor = 1.0f;
+  material.pbrMetallicFactor  = 1.0f;
+  material.normalTextureScale = 1.0f;
+  material.ior                = 1.5f;
+  material.alphaCutoff        = 0.5f;
+  material.occlusionStrength  = 1.0f;
+
+  // Neutral extensions, the others are zero
+  material.attenuationColor            = glm::vec3(1.0f);
+  material.attenuationDistance         = 3.402823466e+38f;
+  material.specularColorFactor         = glm::vec3(1.0f);
+  material.specularFactor              = 1.0f;
+  material.iridescenceIor              = 1.3f;
+  material.iridescenceThicknessMinimum = 100.0f;
+  material.iridescenceThicknessMaximum = 400.0f;
+  material.anisotropyRotation          = glm::vec2(1.0f, 0.0f);
+  material.pbrDiffuseFactor            = glm::vec4(1.0f);
+  material.pbrSpecularFactor           = glm::vec3(1.0f);
+  material.pbrGlossinessFactor         = 1.0f;
+  material.diffuseTransmissionColor    = glm::vec3(1.0f);
+
+  material.pbrBaseColorTexture             = -1;
+  material.pbrMetallicRoughnessTexture     = -1;
+  material.normalTexture                   = -1;
+  material.emissiveTexture                 = -1;
+  material.occlusionTexture                = -1;
+  material.transmissionTexture             = -1;
+  material.thicknessTexture                = -1;
+  material.clearcoatTexture                = -1;
+  material.clearcoatRoughnessTexture       = -1;
+  material.clearcoatNormalTexture          = -1;
+  material.specularTexture                 = -1;
+  material.specularColorTexture            = -1;
+  material.iridescenceTexture              = -1;
+  material.iridescenceThicknessTexture     = -1;
+  material.anisotropyTexture               = -1;
+  material.sheenColorTexture               = -1;
+  material.sheenRoughnessTexture           = -1;
+  material.pbrDiffuseTexture               = -1;
+  material.pbrSpecularGlossinessTexture    = -1;
+  material.diffuseTransmissionTexture      = -1;
+  material.diffuseTransmissionColorTexture = -1;
+  return material;
+}
+
+shaderio::GltfShadeMaterial canonicalMaterial(const shaderio::GltfShadeMaterial& material)
+{
+  const shaderio::GltfShadeMaterial neutral   = neutralMaterial();
+  shaderio::GltfShadeMaterial       canonical = material;
+
+  if(canonical.usePbrSpecularGlossiness == 0)
+  {
+    canonical.pbrDiffuseFactor             = neutral.pbrDiffuseFactor;
+    canonical.pbrSpecularFactor            = neutral.pbrSpecularFactor;
+    canonical.pbrGlossinessFactor          = neutral.pbrGlossinessFactor;
+    canonical.pbrDiffuseTexture            = neutral.pbrDiffuseTexture;
+    canonical.pbrSpecularGlossinessTexture = neutral.pbrSpecularGlossinessTexture;
+  }
+  if(canonical.transmissionFactor == 0.0f)
+  {
+    canonical.transmissionTexture = neutral.transmissionTexture;
+  }
+  // Thin walled: there is no volume to attenuate
+  if(canonical.thicknessFactor == 0.0f)
+  {
+    canonical.thicknessFactor     = neutral.thicknessFactor;
+    canonical.thicknessTexture    = neutral.thicknessTexture;
+    canonical.attenuationColor    = neutral.attenuationColor;
+    canonical.attenuationDistance = neutral.attenuationDistance;
+  }
+  if(canonical.clearcoatFactor == 0.0f)
+  {
+    canonical.clearcoatFactor           = neutral.clearcoatFactor;
+    canonical.clearcoatRoughness        = neutral.clearcoatRoughness;
+    canonical.clearcoatTexture          = neutral.clearcoatTexture;
+    canonical.clearcoatRoughnessTexture = neutral.clearcoatRoughnessTexture;
+    canonical.clearcoatNormalTexture    = neutral.clearcoatNormalTexture;
+  }
+  if(canonical.iridescenceFactor == 0.0f)
+  {
+    canonical.iridescenceFactor           = neutral.iridescenceFactor;
+    canonical.iridescenceIor              = neutral.iridescenceIor;
+    canonical.iridescenceThicknessMinimum = neutral.iridescenceThicknessMinimum;
+    canonical.iridescenceThicknessMaximum = neutral.iridescenceThicknessMaximum;
+    canonical.iridescenceTexture          = neutral.iridescenceTexture;
+    canonical.iridescenceThicknessTexture = neutral.iridescenceThicknessTexture;
+  }
+  if(canonical.anisotropyStrength == 0.0f)
+  {
+    canonical.anisotropyStrength = neutral.anisotropyStrength;
+    canonical.anisotropyRotation = neutral.anisotropyRotation;
+    canonical.anisotropyTexture  = neutral.anisotropyTexture;
+  }
+  if(canonical.sheenColorFactor == glm::vec3(0.0f))
+  {
+    canonical.sheenColorFactor      = neutral.sheenColorFactor;
+    canonical.sheenRoughnessFactor  = neutral.sheenRoughnessFactor;
+    canonical.sheenColorTexture     = neutral.sheenColorTexture;
+    canonical.sheenRoughnessTexture = neutral.sheenRoughnessTexture;
+  }
+  if(canonical.diffuseTransmissionFactor == 0.0f)
+  {
+    canonical.diffuseTransmissionFactor       = neutral.diffuseTransmissionFactor;
+    canonical.diffuseTransmissionColor        = neutral.diffuseTransmissionColor;
+    canonical.diffuseTransmissionTexture      = neutral.diffuseTransmissionTexture;
+    canonical.diffuseTransmissionColorTexture = neutral.diffuseTransmissionColorTexture;
+  }
+  return canonical;
+}
+
+shaderio::CompactMaterial compileMaterial(const shaderio::GltfShadeMaterial& material)
+{
+  shaderio::CompactMaterial compact{};
+  compact.baseColorFactor    = material.pbrBaseColorFactor;
+  compact.emissiveFactor     = material.emissiveFactor;
+  compact.roughnessFactor    = material.pbrRoughnessFactor;
+  compact.metallicFactor     = material.pbrMetallicFactor;
+  compact.normalTextureScale = material.normalTextureScale;
+  compact.ior                = material.ior;
+  compact.alphaCutoff        = material.alphaCutoff;
+  compact.occlusionStrength  = material.occlusionStrength;
+  compact.flags = ((uint32_t(material.alphaMode) & 3u) << COMPACT_MATERIAL_ALPHA_SHIFT) | (packTexture(material.occlusionTexture) << 16);
+  compact.baseColorTextures = packTexture(material.pbrBaseColorTexture) | (packTexture(material.pbrMetallicRoughnessTexture) << 16);
+  compact.normalEmissiveTextures = packTexture(material.normalTexture) | (packTexture(material.emissiveTexture) << 16);
+
+  // Whatever the record can't hold (an active extension, specular-glossiness, a texture index beyond 16 bits, a
+  // field added to GltfShadeMaterial later) doesn't survive the round trip
+  if(!sameMaterial(decodeMaterial(compact), canonicalMaterial(material)))
+  {
+    compact.flags |= COMPACT_MATERIAL_FALLBACK;
+  }
+  return compact;
+}
+
+shaderio::GltfShadeMaterial decodeMaterial(const shaderio::CompactMaterial& compact)
+{
+  shaderio::GltfShadeMaterial material = neutralMaterial();
+  material.pbrBaseColorFactor          = compact.baseColorFactor;
+  material.emissiveFactor              = compact.emissiveFactor;
+  material.pbrRoughnessFactor          = compact.roughnessFactor;
+  material.pbrMetallicFactor           = compact.metallicFactor;
+  material.normalTextureScale          = compact.normalTextureScale;
+  material.ior                         = compact.ior;
+  material.alphaCutoff                 = compact.alphaCutoff;
+  material.occlusionStrength           = compact.occlusionStrength;
+  material.alphaMode                   = decltype(material.alphaMode)((compact.flags >> COMPACT_MATERIAL_ALPHA_SHIFT) & 3u);
+  material.occlusionTexture            = unpackTexture(compact.flags >> 16);
+  material.pbrBaseColorTexture         = unpackTexture(compact.baseColorTextures & 0xFFFF);
+  material.pbrMetallicRoughnessTexture = unpackTexture(compact.baseColorTextures >> 16);
+  material.normalTexture               = unpackTexture(compact.normalEmissiveTextures & 0xFFFF);
+  material.emissiveTexture             = unpackTexture(compact.normalEmissiveTextures >> 16);
+  return material;
+}
+
+
+void MaterialTable::registerParameters(nvutils::ParameterRegistry& registry, Settings& settings)
+{
+  registry.add({"compactMaterials", "Evaluate the materials from compact one cache line records, see MaterialTable"},
+               &settings.enabled);
+  registry.add({"materialSelfTest", "Check the compact material compiler on the CPU and exit"}, &settings.selfTest);
+}
+
+MaterialTable::~MaterialTable()
+{
+  assert(m_buffer.buffer == VK_NULL_HANDLE && "Must call deinit");
+}
+
+void MaterialTable::init(nvvk::ResourceAllocator* alloc, const Settings& initSettings)
+{
+  m_alloc  = alloc;
+  settings = initSettings;
+}
+
+void MaterialTable::deinit()
+{
+  destroyScene();
+  m_alloc = nullptr;
+}
+
+void MaterialTable::setScene(nvvk::StagingUploader& staging, std::span<const shaderio::GltfShadeMaterial> materials)
+{
+  destroyScene();
+
+  m_records.reserve(materials.size());
+  for(const shaderio::GltfShadeMaterial& material : materials)
+  {
+    m_records.push_back(compileMaterial(material));
+  }
+  if(m_records.empty())
+  {
+    return;
+  }
+
+  NVVK_CHECK(m_alloc->createBuffer(m_buffer, std::span(m_records).size_bytes(),
+                                   VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_2_SHADER_DEVICE_ADDRESS_BIT
+                                       | VK_BUFFER_USAGE_2_TRANSFER_DST_BIT));
+  NVVK_DBG_NAME(m_buffer.buffer);
+  NVVK_CHECK(staging.appendBuffer(m_buffer, 0, std::span(m_records)));
+}
+
+void MaterialTable::destroyScene()
+{
+  if(m_alloc)
+  {
+    m_alloc->destroyBuffer(m_buffer);
+  }
+  m_records.clear();
+  m_updates = 0;
+}
+
+void MaterialTable::cmdUpdate(VkCommandBuffer cmd, std::span<const shaderio::GltfShadeMaterial> materials)
+{
+  if(m_buffer.buffer == VK_NULL_HANDLE || materials.size() != m_records.size())
+  {
+    return;
+  }
+
+  std::vector<uint32_t> changed;
+  for(uint32_t i = 0; i < uint32_t(materials.size()); ++i)
+  {
+    const shaderio::CompactMaterial record = compileMaterial(materials[i]);
+    if(std::memcmp(&record, &m_records[i], sizeof(record)) != 0)
+    {
+      m_records[i] = record;
+      changed.push_back(i);
+    }
+  }
+  if(changed.empty())
+  {
+    return;
+  }
+
+  // The previous frame may still read the records
+  VkMemoryBarrier2 barrier{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                           .srcStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                           .srcAccessMask = VK_ACCESS_2_SHADER_READ_BIT,
+                           .dstStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                           .dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT};
+  VkDependencyInfo depInfo{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &barrier};
+  vkCmdPipelineBarrier2(cmd, &depInfo);
+
+  for(uint32_t index : changed)
+  {
+    vkCmdUpdateBuffer(cmd, m_buffer.buffer, index * sizeof(shaderio::CompactMaterial), sizeof(shaderio::CompactMaterial),
+                      &m_records[index]);
+  }
+
+  barrier.srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+  barrier.dstStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+  barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
+  vkCmdPipelineBarrier2(cmd, &depInfo);
+
+  m_updates += uint32_t(changed.size());
+}
+
+uint32_t MaterialTable::compactCount() const
+{
+  return uint32_t(std::count_if(m_records.begin(), m_records.end(), [](const shaderio::CompactMaterial& c) { return !isFallback(c); }));
+}
+
+bool MaterialTable::onUI()
+{
+  using namespace nvgui;
+
+  bool changed = false;
+  PropertyEditor::begin();
+  changed |= PropertyEditor::entry("Enable", [&] { return ImGui::Checkbox("##compactMaterials", &settings.enabled); },
+                                   "Evaluate the materials from their compact record; the others, and all of them "
+                                   "when off, from the full shading material");
+  PropertyEditor::end();
+  ImGui::Text("%u of %u materials compact, %u updates", compactCount(), materialCount(), m_updates);
+  return changed;
+}
+
+nlohmann::json MaterialTable::toJson() const
+{
+  return {{"enabled", settings.enabled},
+          {"materials", materialCount()},
+          {"compact", compactCount()},
+          {"updates", m_updates}};
+}
+
+bool MaterialTable::selfTest()
+{
+  std::mt19937                          rng(125);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  std::uniform_int_distribution<int>    texture(-1, 2000);
+
+  auto randomCore = [&] {
+    shaderio::GltfShadeMaterial material = neutralMaterial();
+    material.pbrBaseColorFactor          = glm::vec4(unit(rng), unit(rng), unit(rng), unit(rng));
+    material.emissiveFactor              = glm::vec3(unit(rng), unit(rng), unit(rng)) * 10.0f;
+    material.pbrRoughnessFactor          = unit(rng);
+    material.pbrMetallicFactor           = unit(rng);
+    material.normalTextureScale          = unit(rng) * 2.0f;
+    material.ior                         = 1.0f + unit(rng) * 1.5f;
+    material.alphaCutoff                 = unit(rng);
+    material.occlusionStrength           = unit(rng);
+    material.alphaMode                   = decltype(material.alphaMode)(rng() % 3);
+    material.pbrBaseColorTexture         = texture(rng);
+    material.pbrMetallicRoughnessTexture = texture(rng);
+    material.normalTexture               = texture(rng);
+    material.emissiveTexture             = texture(rng);
+    material.occlusionTexture            = texture(rng);
+    return material;
+  };
+
+  // Core materials are compact and decode bit for bit, the default material included
+  const uint32_t coreCount = 1000;
+  uint32_t       coreOk    = 0;
+  for(uint32_t i = 0; i < coreCount; ++i)
+  {
+    const shaderio::GltfShadeMaterial material = i == 0 ? neutralMaterial() : randomCore();
+    const shaderio::CompactMaterial   compact  = compileMaterial(material);
+    coreOk += (!isFallback(compact) && sameMaterial(decodeMaterial(compact), material)) ? 1 : 0;
+  }
+
+  // Parameters of extensions that are off don't prevent the record
+  const std::vector<std::function<void(shaderio::GltfShadeMaterial&)>> dontCare = {
+      [](auto& m) { m.pbrDiffuseFactor = glm::vec4(0.2f), m.pbrGlossinessFactor = 0.3f, m.pbrDiffuseTexture = 4; },
+      [](auto& m) { m.attenuationColor = glm::vec3(0.5f), m.attenuationDistance = 2.0f, m.thicknessTexture = 5; },
+      [](auto& m) { m.iridescenceIor = 1.8f, m.iridescenceThicknessMaximum = 900.0f, m.iridescenceTexture = 6; },
+      [](auto& m) { m.anisotropyRotation = glm::vec2(0.0f, 1.0f), m.anisotropyTexture = 7; },
+      [](auto& m) { m.sheenRoughnessFactor = 0.7f, m.sheenRoughnessTexture = 8; },
+      [](auto& m) { m.clearcoatRoughness = 0.4f, m.clearcoatNormalTexture = 9; },
+      [](auto& m) { m.transmissionTexture = 10; },
+      [](auto& m) { m.diffuseTransmissionColor = glm::vec3(0.1f), m.diffuseTransmissionTexture = 11; },
+  };
+  uint32_t dontCareOk = 0;
+  for(const auto& vary : dontCare)
+  {
+    shaderio::GltfShadeMaterial material = randomCore();
+    vary(material);
+    const shaderio::CompactMaterial compact = compileMaterial(material);
+    dontCareOk += (!isFallback(compact) && sameMaterial(decodeMaterial(compact), canonicalMaterial(material))) ? 1 : 0;
+  }
+
+  // Anything that changes the shading beyond the core material falls back to the full material
+  const std::vector<std::function<void(shaderio::GltfShadeMaterial&)>> active = {
+      [](auto& m) { m.transmissionFactor = 0.5f; },
+      [](auto& m) { m.thicknessFactor = 0.1f; },
+      [](auto& m) { m.clearcoatFactor = 1.0f; },
+      [](auto& m) { m.sheenColorFactor = glm::vec3(0.5f); },
+      [](auto& m) { m.iridescenceFactor = 1.0f; },
+      [](auto& m) { m.anisotropyStrength = 0.5f; },
+      [](auto& m) { m.dispersion = 0.1f; },
+      [](auto& m) { m.diffuseTransmissionFactor = 0.5f; },
+      [](auto& m) { m.specularFactor = 0.5f; },
+      [](auto& m) { m.specularColorFactor = glm::vec3(0.5f); },
+      [](auto& m) { m.specularTexture = 3; },
+      [](auto& m) { m.unlit = 1; },
+      [](auto& m) { m.usePbrSpecularGlossiness = 1; },
+      [](auto& m) { m.pbrBaseColorTexture = 70000; },
+      [](auto& m) { m.alphaMode = decltype(m.alphaMode)(7); },
+  };
+  uint32_t fallbackOk = 0;
+  for(const auto& activate : active)
+  {
+    shaderio::GltfShadeMaterial material = randomCore();
+    activate(material);
+    fallbackOk += isFallback(compileMaterial(material)) ? 1 : 0;
+  }
+
+  const bool passed = coreOk == coreCount && dontCareOk == dontCare.size() && fallbackOk == active.size();
+  LOGI("Material table self test %s: %u/%u core materials compact, %u/%zu inactive extensions compact, %u/%zu active "
+       "extensions fall back\n",
+       passed ? "passed" : "FAILED", coreOk, coreCount, dontCareOk, dontCare.size(), fallbackOk, active.size());
+  return passed;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <nvvk/resource_allocator.hpp>
+#include <nvvk/staging.hpp>
+#include <tinygltf/json.hpp>
+
+#include "shaders/host_device.h"
+#include "nvshaders/gltf_scene_io.h.slang"
+
+#include <span>
+#include <vector>
+
+namespace nvutils {
+class ParameterRegistry;
+}
+
+
+// The material decodeMaterial() starts from: every extension at the value that turns it off
+shaderio::GltfShadeMaterial neutralMaterial();
+
+// 'material' with the parameters that can't change the shading reset to their neutral value, e.g. the volume
+// attenuation without thickness or the specular-glossiness factors of a metallic-roughness material
+shaderio::GltfShadeMaterial canonicalMaterial(const shaderio::GltfShadeMaterial& material);
+
+// Compact record of 'material'. It is only used when decodeMaterial() gives back canonicalMaterial(material) bit for
+// bit, otherwise it is marked COMPACT_MATERIAL_FALLBACK.
+shaderio::CompactMaterial compileMaterial(const shaderio::GltfShadeMaterial& material);
+// Mirrors decodeCompactMaterial() in material_table.slang
+shaderio::GltfShadeMaterial decodeMaterial(const shaderio::CompactMaterial& compact);
+
+
+// MaterialTable compiles the shading materials of the scene into CompactMaterial records at load, one cache line
+// each, which the hit shaders evaluate instead of the GltfShadeMaterial with FLAGS_COMPACT_MATERIALS. The records
+// follow the edits of the MaterialEditor.
+class MaterialTable
+{
+public:
+  struct Settings
+  {
+    bool enabled  = true;
+    bool selfTest = false;
+  };
+
+  // Registers the --compactMaterials and --materialSelfTest options
+  static void registerParameters(nvutils::ParameterRegistry& registry, Settings& settings);
+
+  Settings settings;
+
+  ~MaterialTable();
+
+  void init(nvvk::ResourceAllocator* alloc, const Settings& initSettings);
+  void deinit();
+
+  // Compiles 'materials' and appends the table to 'staging'
+  void setScene(nvvk::StagingUploader& staging, std::span<const shaderio::GltfShadeMaterial> materials);
+  void destroyScene();
+
+  // Recompiles 'materials' and writes the records that changed; record before the passes that read them
+  void cmdUpdate(VkCommandBuffer cmd, std::span<const shaderio::GltfShadeMaterial> materials);
+
+  bool            isEnabled() const { return settings.enabled && m_buffer.buffer != VK_NULL_HANDLE; }
+  VkDeviceAddress address() const { return m_buffer.address; }
+  uint32_t        materialCount() const { return uint32_t(m_records.size()); }
+  uint32_t        compactCount() const;  // without COMPACT_MATERIAL_FALLBACK
+
+  // Returns true when the table was toggled
+  bool           onUI();
+  nlohmann::json toJson() const;
+
+  // Checks that compiled materials decode to the same shading and that the ones that can't are marked as fallbacks
+  static bool selfTest();
+
+private:
+  nvvk::ResourceAllocator*               m_alloc = nullptr;
+  nvvk::Buffer                           m_buffer;
+  std::vector<shaderio::CompactMaterial> m_records;  // as in m_buffer
+  uint32_t                               m_updates = 0;  // records rewritten after edits
+};
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "mesh_lod.hpp"
+
+#include <imgui/imgui.h>
+
+#include <nvapp/application.hpp>
+#include <nvutils/logger.hpp>
+
+#include "mesh_simplify.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+
+
+static const uint32_t kLodBaseGrid  = 64;          // cells along the largest extent for level 1, halved per level
+static const uint32_t kCacheMagic   = 0x444f4c44;  // "DLOD"
+static const uint32_t kCacheVersion = 1;
+
+// FNV-1a, 64 bit
+static uint64_t hashBytes(uint64_t hash, const void* data, size_t size)
+{
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for(size_t i = 0; i < size; ++i)
+  {
+    hash = (hash ^ bytes[i]) * 1099511628211ull;
+  }
+  return hash;
+}
+
+// Identifies the mesh and how it is simplified
+static uint64_t cacheKey(const MeshData& mesh, uint32_t levels)
+{
+  const uint32_t header[] = {kCacheVersion, kLodBaseGrid, levels};
+  uint64_t       hash     = hashBytes(14695981039346656037ull, header, sizeof(header));
+  hash                    = hashBytes(hash, mesh.positions.data(), mesh.positions.size() * sizeof(glm::vec3));
+  return hashBytes(hash, mesh.triangles.data(), mesh.triangles.size() * sizeof(glm::uvec3));
+}
+
+static std::filesystem::path cacheFile(uint64_t key)
+{
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx.lod", (unsigned long long)key);
+  return MeshLods::cacheDirectory() / name;
+}
+
+// Levels 1..levels-1 of one mesh. A level that doesn't reduce the previous one enough repeats it; when that is
+// the original, the level stays empty and traces the original BLAS.
+static std::vector<SimplifiedMesh> simplifyLevels(const MeshData& mesh, uint32_t levels)
+{
+  std::vector<SimplifiedMesh> result(levels - 1);
+  size_t                      previous = mesh.triangles.size();
+  for(uint32_t k = 1; k < levels; ++k)
+  {
+    SimplifiedMesh level = simplifyMesh(mesh.positions, mesh.triangles, std::max(kLodBaseGrid >> (k - 1), 1u));
+    if(!level.triangles.empty() && level.triangles.size() * 4 <= previous * 3)
+    {
+      previous      = level.triangles.size();
+      result[k - 1] = std::move(level);
+    }
+    else if(k > 1)
+    {
+      result[k - 1] = result[k - 2];
+    }
+  }
+  return result;
+}
+
+// Vertex indices and triangles per level; the positions are gathered from 'mesh'
+static bool readCache(const std::filesystem::path& file, const MeshData& mesh, uint32_t levels, std::vector<SimplifiedMesh>& result)
+{
+  std::ifstream in(file, std::ios::binary);
+  if(!in)
+  {
+    return false;
+  }
+
+  uint32_t header[3] = {};
+  in.read(reinterpret_cast<char*>(header), sizeof(header));
+  if(!in || header[0] != kCacheMagic || header[1] != kCacheVersion || header[2] != levels - 1)
+  {
+    return false;
+  }
+
+  result.assign(levels - 1, {});
+  for(SimplifiedMesh& level : result)
+  {
+    uint32_t counts[2] = {};
+    in.read(reinterpret_cast<char*>(counts), sizeof(counts));
+    if(!in || counts[0] > mesh.positions.size() || counts[1] > mesh.triangles.size())
+    {
+      return false;
+    }
+    level.vertices.resize(counts[0]);
+    level.triangles.resize(counts[1]);
+    in.read(reinterpret_cast<char*>(level.vertices.data()), counts[0] * sizeof(uint32_t));
+    in.read(reinterpret_cast<char*>(level.triangles.data()), counts[1] * sizeof(glm::uvec3));
+    if(!in)
+    {
+      return false;
+    }
+
+    for(uint32_t vertex : level.vertices)
+    {
+      if(vertex >= mesh.positions.size())
+      {
+        return false;
+      }
+      level.positions.push_back(mesh.positions[vertex]);
+    }
+    for(const glm::uvec3& t : level.triangles)
+    {
+      if(std::max(std::max(t.x, t.y), t.z) >= counts[0])
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Written under a unique name and renamed, so concurrent writers of the same mesh don't interleave
+static void writeCache(const std::filesystem::path& file, const std::vector<SimplifiedMesh>& levels, size_t writer)
+{
+  const std::filesystem::path temp = file.string() + "." + std::to_string(writer) + ".tmp";
+  {
+    std::ofstream out(temp, std::ios::binary);
+    if(!out)
+    {
+      return;
+    }
+    const uint32_t header[3] = {kCacheMagic, kCacheVersion, uint32_t(levels.size())};
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    for(const SimplifiedMesh& level : levels)
+    {
+      const uint32_t counts[2] = {uint32_t(level.vertices.size()), uint32_t(level.triangles.size())};
+      out.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+      out.write(reinterpret_cast<const char*>(level.vertices.data()), level.vertices.size() * sizeof(uint32_t));
+      out.write(reinterpret_cast<const char*>(level.triangles.data()), level.triangles.size() * sizeof(glm::uvec3));
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(temp, file, ec);
+  if(ec)
+  {
+    std::filesystem::remove(temp, ec);
+  }
+}
+
+
+std::filesystem::path MeshLods::cacheDirectory()
+{
+  std::error_code ec;
+  return std::filesystem::temp_directory_path(ec) / "dlss_rr_lod_cache";
+}
+
+void MeshLods::create(nvapp::Application* app, nvvk::ResourceAllocator* alloc, const nvvkgltf::Scene& scene, uint32_t levels)
+{
+  destroy();
+
+  m_levels = std::clamp(levels, 1u, uint32_t(MAX_LOD_LEVELS));
+  if(m_levels == 1)
+  {
+    return;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  std::error_code ec;
+  std::filesystem::create_directories(cacheDirectory(), ec);
+  if(ec)
+  {
+    LOGW("LOD cache not available: %s\n", ec.message().c_str());
+  }
+
+  // Slot (level - 1) * numRenderPrims + renderPrimID, filled by the workers
+  const size_t                numRenderPrims = scene.getRenderPrimitives().size();
+  const tinygltf::Model&      model          = scene.getModel();
+  std::vector<SimplifiedMesh> slots((m_levels - 1) * numRenderPrims);
+  std::vector<uint64_t>       originalTriangles(numRenderPrims, 0);
+  std::atomic<size_t>         next{0};
+  std::atomic<uint32_t>       hits{0};
+  std::atomic<uint32_t>       misses{0};
+
+  auto worker = [&] {
+    for(size_t i = next++; i < numRenderPrims; i = next++)
+    {
+      const tinygltf::Primitive* primitive = scene.getRenderPrimitive(i).pPrimitive;
+      MeshData                   mesh;
+      if(primitive == nullptr || !readMeshData(model, *primitive, mesh))
+      {
+        continue;  // all levels trace the original
+      }
+      originalTriangles[i] = mesh.triangles.size();
+
+      const std::filesystem::path file = cacheFile(cacheKey(mesh, m_levels));
+      std::vector<SimplifiedMesh> meshLevels;
+      if(readCache(file, mesh, m_levels, meshLevels))
+      {
+        hits++;
+      }
+      else
+      {
+        meshLevels = simplifyLevels(mesh, m_levels);
+        writeCache(file, meshLevels, i);
+        misses++;
+      }
+
+      for(uint32_t k = 1; k < m_levels; ++k)
+      {
+        slots[(k - 1) * numRenderPrims + i] = std::move(meshLevels[k - 1]);
+      }
+    }
+  };
+
+  const uint32_t           threadCount = std::clamp(std::thread::hardware_concurrency(), 1u, 16u);
+  std::vector<std::thread> threads;
+  for(uint32_t t = 1; t < threadCount; ++t)
+  {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for(std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  m_blas.create(app, alloc, slots);
+
+  m_triangles.assign(m_levels, 0);
+  for(size_t i = 0; i < numRenderPrims; ++i)
+  {
+    m_triangles[0] += originalTriangles[i];
+    for(uint32_t k = 1; k < m_levels; ++k)
+    {
+      const uint32_t count = m_blas.triangleCount((k - 1) * numRenderPrims + i);
+      m_triangles[k] += count > 0 ? count : originalTriangles[i];
+    }
+  }
+  m_cacheHits   = hits;
+  m_cacheMisses = misses;
+  m_buildMs     = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  LOGI("LODs: %u levels of %zu render primitives in %.1f ms, %u from cache, %.1f MB\n", m_levels, numRenderPrims,
+       m_buildMs, m_cacheHits, double(m_blas.bytes()) / (1 << 20));
+}
+
+void MeshLods::destroy()
+{
+  m_blas.destroy();
+  m_levels = 1;
+  m_triangles.clear();
+  m_cacheHits   = 0;
+  m_cacheMisses = 0;
+  m_buildMs     = 0.0f;
+}
+
+std::vector<VkDeviceAddress> MeshLods::blasAddresses() const
+{
+  std::vector<VkDeviceAddress> addresses(m_blas.size());
+  for(size_t i = 0; i < addresses.size(); ++i)
+  {
+    addresses[i] = m_blas.blasAddress(i);
+  }
+  return addresses;
+}
+
+void MeshLods::onUI()
+{
+  if(m_levels <= 1)
+  {
+    ImGui::TextDisabled("Not active, see --lodLevels");
+    return;
+  }
+
+  for(uint32_t k = 0; k < m_levels; ++k)
+  {
+    ImGui::Text("Level %u: %llu triangles", k, (unsigned long long)m_triangles[k]);
+  }
+  ImGui::Text("Built in %.1f ms, %u cached, %u simplified, %.1f MB", m_buildMs, m_cacheHits, m_cacheMisses,
+              double(m_blas.bytes()) / (1 << 20));
+}
+
+nlohmann::json MeshLods::toJson() const
+{
+  return {{"levels", m_levels},
+          {"triangles", m_triangles},
+          {"cache_hits", m_cacheHits},
+          {"cache_misses", m_cacheMisses},
+          {"build_ms", m_buildMs},
+          {"bytes", m_blas.bytes()}};
+}
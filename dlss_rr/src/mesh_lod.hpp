@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <nvvk/resource_allocator.hpp>
+#include <nvvkgltf/scene.hpp>
+#include <tinygltf/json.hpp>
+
+#include "shaders/host_device.h"
+#include "simplified_blas.hpp"
+
+#include <filesystem>
+#include <vector>
+
+namespace nvapp {
+class Application;
+}
+
+
+// MeshLods holds the coarser levels of detail of every render primitive, level 0 being the original BLAS.
+// Level k is vertex clustered (simplifyMesh()) on a grid of 64 >> (k - 1) cells, on worker threads at
+// load. The results are cached on disk by mesh content, so loading the scene again skips the simplification.
+// InstanceGenerator instantiates every level and distributes the 8 instance mask bits between the two levels
+// closest to the projected size, each ray tests one random bit: the transition between levels is stochastic.
+class MeshLods
+{
+public:
+  // Simplifies the render primitives of 'scene' into 'levels' - 1 coarser levels (at most MAX_LOD_LEVELS - 1)
+  // and builds their BLASes. Waits for the GPU.
+  void create(nvapp::Application* app, nvvk::ResourceAllocator* alloc, const nvvkgltf::Scene& scene, uint32_t levels);
+  void destroy();
+
+  // Including the original, 1 when not created
+  uint32_t levels() const { return m_levels; }
+
+  // BLAS per render primitive of the levels > 0, level-major; 0 where the level traces the original BLAS
+  std::vector<VkDeviceAddress> blasAddresses() const;
+
+  // SimplifiedPrimitive of the levels > 0 in the order of blasAddresses(), for RtxPushConstant::lods
+  VkDeviceAddress table() const { return m_blas.table(); }
+
+  void           onUI();
+  nlohmann::json toJson() const;
+
+  static std::filesystem::path cacheDirectory();
+
+private:
+  SimplifiedBlasSet     m_blas;
+  uint32_t              m_levels = 1;
+  std::vector<uint64_t> m_triangles;  // per level, over all render primitives
+  uint32_t              m_cacheHits   = 0;
+  uint32_t              m_cacheMisses = 0;
+  float                 m_buildMs     = 0.0f;
+};
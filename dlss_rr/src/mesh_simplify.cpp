@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "mesh_simplify.hpp"
+
+#include <tinygltf/tiny_gltf.h>
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+
+
+// Start of the accessor's data and the distance between elements, nullptr if it can't be read directly
+static const uint8_t* accessorData(const tinygltf::Model& model, const tinygltf::Accessor& accessor, size_t elementSize, size_t& stride)
+{
+  if(accessor.sparse.isSparse || accessor.bufferView < 0)
+  {
+    return nullptr;
+  }
+
+  const tinygltf::BufferView& view   = model.bufferViews[accessor.bufferView];
+  const tinygltf::Buffer&     buffer = model.buffers[view.buffer];
+  stride                             = view.byteStride ? view.byteStride : elementSize;
+
+  const size_t offset = view.byteOffset + accessor.byteOffset;
+  if(accessor.count > 0 && offset + stride * (accessor.count - 1) + elementSize > buffer.data.size())
+  {
+    return nullptr;
+  }
+  return buffer.data.data() + offset;
+}
+
+bool readMeshData(const tinygltf::Model& model, const tinygltf::Primitive& primitive, MeshData& mesh)
+{
+  mesh = {};
+
+  // -1 is the glTF default, triangles
+  if(primitive.mode != TINYGLTF_MODE_TRIANGLES && primitive.mode != -1)
+  {
+    return false;
+  }
+
+  const auto position = primitive.attributes.find("POSITION");
+  if(position == primitive.attributes.end())
+  {
+    return false;
+  }
+  const tinygltf::Accessor& posAccessor = model.accessors[position->second];
+  if(posAccessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT || posAccessor.type != TINYGLTF_TYPE_VEC3)
+  {
+    return false;
+  }
+
+  size_t         posStride = 0;
+  const uint8_t* posData   = accessorData(model, posAccessor, sizeof(glm::vec3), posStride);
+  if(posData == nullptr)
+  {
+    return false;
+  }
+  mesh.positions.resize(posAccessor.count);
+  for(size_t i = 0; i < posAccessor.count; ++i)
+  {
+    memcpy(&mesh.positions[i], posData + i * posStride, sizeof(glm::vec3));
+  }
+
+  std::vector<uint32_t> indices;
+  if(primitive.indices < 0)
+  {
+    indices.resize(mesh.positions.size());
+    for(uint32_t i = 0; i < uint32_t(indices.size()); ++i)
+    {
+      indices[i] = i;
+    }
+  }
+  else
+  {
+    const tinygltf::Accessor& idxAccessor = model.accessors[primitive.indices];
+    const int componentSize = tinygltf::GetComponentSizeInBytes(uint32_t(idxAccessor.componentType));
+    if(idxAccessor.type != TINYGLTF_TYPE_SCALAR || componentSize <= 0)
+    {
+      return false;
+    }
+
+    size_t         idxStride = 0;
+    const uint8_t* idxData   = accessorData(model, idxAccessor, size_t(componentSize), idxStride);
+    if(idxData == nullptr)
+    {
+      return false;
+    }
+    indices.resize(idxAccessor.count);
+    for(size_t i = 0; i < idxAccessor.count; ++i)
+    {
+      const uint8_t* element = idxData + i * idxStride;
+      switch(idxAccessor.componentType)
+      {
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+          indices[i] = *element;
+          break;
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: {
+          uint16_t value;
+          memcpy(&value, element, sizeof(value));
+          indices[i] = value;
+          break;
+        }
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+          memcpy(&indices[i], element, sizeof(uint32_t));
+          break;
+        default:
+          return false;
+      }
+    }
+  }
+
+  mesh.triangles.reserve(indices.size() / 3);
+  for(size_t i = 0; i + 2 < indices.size(); i += 3)
+  {
+    const glm::uvec3 triangle(indices[i], indices[i + 1], indices[i + 2]);
+    if(std::max(std::max(triangle.x, triangle.y), triangle.z) >= mesh.positions.size())
+    {
+      return false;
+    }
+    mesh.triangles.push_back(triangle);
+  }
+  return true;
+}
+
+SimplifiedMesh simplifyMesh(std::span<const glm::vec3> positions, std::span<const glm::uvec3> triangles, uint32_t gridResolution)
+{
+  SimplifiedMesh result;
+  if(positions.empty() || triangles.empty())
+  {
+    return result;
+  }
+
+  glm::vec3 bbMin = positions[0];
+  glm::vec3 bbMax = positions[0];
+  for(const glm::vec3& p : positions)
+  {
+    bbMin = glm::min(bbMin, p);
+    bbMax = glm::max(bbMax, p);
+  }
+  const glm::vec3 extent = bbMax - bbMin;
+  const uint32_t  grid   = std::max(gridResolution, 1u);
+  float           cell   = std::max(std::max(extent.x, extent.y), extent.z) / float(grid);
+  if(cell <= 0.0f)
+  {
+    cell = 1.0f;
+  }
+
+  // Representative (lowest index) vertex of every occupied cell
+  std::vector<uint32_t>                  representative(positions.size());
+  std::unordered_map<uint64_t, uint32_t> cellVertex;
+  for(uint32_t i = 0; i < uint32_t(positions.size()); ++i)
+  {
+    const glm::uvec3 c   = glm::min(glm::uvec3((positions[i] - bbMin) / cell), glm::uvec3(grid - 1));
+    const uint64_t   key = (uint64_t(c.x) * grid + c.y) * grid + c.z;
+    representative[i]    = cellVertex.try_emplace(key, i).first->second;
+  }
+
+  // Remapped triangles in input order, rotated so the smallest index comes first to find duplicates
+  std::vector<glm::uvec3>                            remapped;
+  std::set<std::tuple<uint32_t, uint32_t, uint32_t>> seen;
+  for(const glm::uvec3& t : triangles)
+  {
+    glm::uvec3 r(representative[t.x], representative[t.y], representative[t.z]);
+    if(r.x == r.y || r.y == r.z || r.x == r.z)
+    {
+      continue;
+    }
+    while(r.x > r.y || r.x > r.z)
+    {
+      r = glm::uvec3(r.y, r.z, r.x);
+    }
+    if(seen.emplace(r.x, r.y, r.z).second)
+    {
+      remapped.push_back(r);
+    }
+  }
+
+  // Compact the vertices that are still referenced
+  std::vector<bool> used(positions.size(), false);
+  for(const glm::uvec3& t : remapped)
+  {
+    used[t.x] = used[t.y] = used[t.z] = true;
+  }
+  std::vector<uint32_t> local(positions.size(), ~0u);
+  for(uint32_t i = 0; i < uint32_t(positions.size()); ++i)
+  {
+    if(used[i])
+    {
+      local[i] = uint32_t(result.vertices.size());
+      result.vertices.push_back(i);
+      result.positions.push_back(positions[i]);
+    }
+  }
+
+  result.triangles.reserve(remapped.size());
+  for(const glm::uvec3& t : remapped)
+  {
+    result.triangles.emplace_back(local[t.x], local[t.y], local[t.z]);
+  }
+  return result;
+}
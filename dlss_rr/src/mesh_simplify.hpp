@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <span>
+#include <vector>
+
+namespace tinygltf {
+class Model;
+struct Primitive;
+}  // namespace tinygltf
+
+
+// Host copy of the geometry of one glTF primitive
+struct MeshData
+{
+  std::vector<glm::vec3>  positions;
+  std::vector<glm::uvec3> triangles;
+};
+
+// Reads POSITION (float VEC3) and the indices of a triangle list primitive, non-indexed primitives get
+// sequential indices. Returns false for other modes, formats and sparse accessors.
+bool readMeshData(const tinygltf::Model& model, const tinygltf::Primitive& primitive, MeshData& mesh);
+
+struct SimplifiedMesh
+{
+  std::vector<uint32_t>   vertices;   // original index of every kept vertex, ascending
+  std::vector<glm::vec3>  positions;  // of 'vertices'
+  std::vector<glm::uvec3> triangles;  // into 'vertices'
+};
+
+// Vertex clustering: the bounding box is divided into cells of 1 / 'gridResolution' of its largest extent,
+// every cell keeps its lowest indexed vertex and triangles are remapped to them. Degenerate and duplicate
+// triangles are dropped. Kept vertices are original ones, so the result can be shaded with the original
+// vertex attributes. Deterministic.
+SimplifiedMesh simplifyMesh(std::span<const glm::vec3> positions, std::span<const glm::uvec3> triangles, uint32_t gridResolution);
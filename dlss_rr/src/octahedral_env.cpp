@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "octahedral_env.hpp"
+
+#include <nvutils/logger.hpp>
+#include <nvvk/check_error.hpp>
+#include <nvvk/debug_util.hpp>
+#include <nvvk/mipmaps.hpp>
+#include <tinygltf/tiny_gltf.h>  // stb_image
+
+#include "shaders/host_device.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+
+// octEncode()/octDecode() of env_octahedral.slang; only the decode is needed to resample
+static glm::vec3 octDecode(glm::vec2 uv)
+{
+  const glm::vec2 p   = uv * 2.0f - 1.0f;
+  const glm::vec2 a   = glm::abs(p);
+  const float     sd  = 1.0f - (a.x + a.y);
+  const float     r   = 1.0f - std::abs(sd);
+  const float     phi = (r == 0.0f ? 1.0f : (a.y - a.x) / r + 1.0f) * glm::quarter_pi<float>();
+  const float     z   = sd < 0.0f ? -(1.0f - r * r) : (1.0f - r * r);
+  const float     s   = r * std::sqrt(std::max(2.0f - r * r, 0.0f));
+  const float     x   = std::copysign(std::cos(phi), p.x) * s;
+  const float     y   = std::copysign(std::sin(phi), p.y) * s;
+  return glm::normalize(glm::vec3(x, z, y));
+}
+
+// Bilinear lookup of the equirectangular image in the getSphericalUv() convention
+static glm::vec3 sampleEquirect(const float* pixels, int width, int height, const glm::vec3& dir)
+{
+  const float u = std::atan2(dir.z, dir.x) * glm::one_over_two_pi<float>() + 0.5f;
+  const float v = std::asin(std::clamp(-dir.y, -1.0f, 1.0f)) * glm::one_over_pi<float>() + 0.5f;
+
+  const float x  = u * float(width) - 0.5f;
+  const float y  = v * float(height) - 0.5f;
+  const float fx = x - std::floor(x);
+  const float fy = y - std::floor(y);
+  const int   x0 = (int(std::floor(x)) % width + width) % width;
+  const int   x1 = (x0 + 1) % width;
+  const int   y0 = std::clamp(int(std::floor(y)), 0, height - 1);
+  const int   y1 = std::min(y0 + 1, height - 1);
+
+  auto texel = [&](int px, int py) { return glm::make_vec3(&pixels[(size_t(py) * width + px) * 4]); };
+  return glm::mix(glm::mix(texel(x0, y0), texel(x1, y0), fx), glm::mix(texel(x0, y1), texel(x1, y1), fx), fy);
+}
+
+
+OctahedralEnv::~OctahedralEnv()
+{
+  assert(m_alloc == nullptr && "Must call deinit");
+}
+
+void OctahedralEnv::init(nvvk::ResourceAllocator* alloc, nvvk::SamplerPool* samplerPool)
+{
+  assert(m_alloc == nullptr && "Init already called");
+  m_alloc       = alloc;
+  m_samplerPool = samplerPool;
+
+  // Clamped: the texels across the edge of the octahedron are not the neighbors in direction
+  const VkSamplerCreateInfo samplerInfo{.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+                                        .magFilter    = VK_FILTER_LINEAR,
+                                        .minFilter    = VK_FILTER_LINEAR,
+                                        .mipmapMode   = VK_SAMPLER_MIPMAP_MODE_LINEAR,
+                                        .addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+                                        .addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+                                        .addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+                                        .maxLod       = VK_LOD_CLAMP_NONE};
+  NVVK_CHECK(m_samplerPool->acquireSampler(m_sampler, samplerInfo));
+
+  nvvk::DescriptorBindings bindings;
+  bindings.addBinding(shaderio::EnvOctBindings::eOctahedral, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_ALL);
+  NVVK_CHECK(m_bindings.init(bindings, m_alloc->getDevice()));
+  NVVK_DBG_NAME(m_bindings.getLayout());
+
+}
+
+void OctahedralEnv::deinit()
+{
+  if(m_alloc == nullptr)
+  {
+    return;
+  }
+  m_alloc->destroyImage(m_image);
+  m_alloc->destroyBuffer(m_aliasTable);
+  m_bindings.deinit();
+  m_samplerPool->releaseSampler(m_sampler);
+  m_sampler = VK_NULL_HANDLE;
+  m_alloc   = nullptr;
+}
+
+bool OctahedralEnv::load(VkCommandBuffer cmd, nvvk::StagingUploader& staging, const std::filesystem::path& filename, bool convert)
+{
+  m_alloc->destroyImage(m_image);
+  m_alloc->destroyBuffer(m_aliasTable);
+  m_size          = 1;
+  m_bytes         = 0;
+  m_equirectBytes = 0;
+  m_convertMs     = 0.0;
+
+  int    width = 0, height = 0, components = 0;
+  float* pixels = convert ? stbi_loadf(filename.string().c_str(), &width, &height, &components, STBI_rgb_alpha) : nullptr;
+  if(pixels == nullptr)
+  {
+    if(convert)
+    {
+      LOGW("Octahedral environment: can't read %s\n", filename.string().c_str());
+    }
+    const std::array<uint16_t, 4> black{};
+    createImage(cmd, staging, 1, black);
+    return false;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  // Half the texels of the equirectangular image: equal-area, no rows are spent on the poles
+  const uint32_t size   = std::clamp(std::bit_ceil(uint32_t(height)), 16U, 4096U);
+  const uint32_t texels = size * size;
+
+  // 2x2 supersampled resampling; the luminance is the importance
+  std::vector<uint16_t> halves(size_t(texels) * 4);
+  std::vector<float>    importance(texels);
+  double                total = 0.0;
+  for(uint32_t y = 0; y < size; ++y)
+  {
+    for(uint32_t x = 0; x < size; ++x)
+    {
+      glm::vec3 radiance(0.0f);
+      for(int s = 0; s < 4; ++s)
+      {
+        const glm::vec2 uv = (glm::vec2(x, y) + glm::vec2(0.25f + 0.5f * (s & 1), 0.25f + 0.5f * (s >> 1))) / float(size);
+        radiance += sampleEquirect(pixels, width, height, octDecode(uv));
+      }
+      radiance = glm::min(radiance * 0.25f, glm::vec3(65504.0f));  // largest half
+
+      const uint32_t texel = y * size + x;
+      importance[texel]    = glm::dot(radiance, glm::vec3(0.2126f, 0.7152f, 0.0722f));
+      total += importance[texel];
+      for(int c = 0; c < 3; ++c)
+      {
+        halves[size_t(texel) * 4 + c] = glm::packHalf1x16(radiance[c]);
+      }
+    }
+  }
+  stbi_image_free(pixels);
+
+  // Equal-area texels: the pdf per solid angle is the texel's share of the total times texels / 4 pi
+  const float                          toPdf = float(texels) * glm::one_over_pi<float>() * 0.25f;
+  std::vector<shaderio::EnvAliasEntry> aliases(texels);
+  std::vector<float>                   scaled(texels);
+  std::vector<uint32_t>                small, large;
+  for(uint32_t i = 0; i < texels; ++i)
+  {
+    const float share         = total > 0.0 ? float(importance[i] / total) : 1.0f / float(texels);
+    halves[size_t(i) * 4 + 3] = glm::packHalf1x16(std::min(share * toPdf, 65504.0f));
+    scaled[i]                 = share * float(texels);
+    (scaled[i] < 1.0f ? small : large).push_back(i);
+  }
+
+  // Vose: each small texel is topped up by a large one
+  while(!small.empty() && !large.empty())
+  {
+    const uint32_t s = small.back();
+    const uint32_t l = large.back();
+    small.pop_back();
+    aliases[s] = {.alias = l, .q = scaled[s]};
+    scaled[l] -= 1.0f - scaled[s];
+    if(scaled[l] < 1.0f)
+    {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  for(uint32_t i : large)
+  {
+    aliases[i] = {.alias = i, .q = 1.0f};
+  }
+  for(uint32_t i : small)  // rounding leftovers
+  {
+    aliases[i] = {.alias = i, .q = 1.0f};
+  }
+
+  NVVK_CHECK(m_alloc->createBuffer(m_aliasTable, std::span(aliases).size_bytes(),
+                                   VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_2_SHADER_DEVICE_ADDRESS_BIT));
+  NVVK_DBG_NAME(m_aliasTable.buffer);
+  NVVK_CHECK(staging.appendBuffer(m_aliasTable, 0, std::span(aliases)));
+  createImage(cmd, staging, size, halves);
+
+  m_size      = size;
+  m_convertMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  // A mip chain adds a third to the texture
+  m_bytes         = VkDeviceSize(texels) * 8 * 4 / 3 + m_aliasTable.bufferSize;
+  m_equirectBytes = VkDeviceSize(width) * height * (16 + sizeof(shaderio::EnvAliasEntry));
+  LOGI("Octahedral environment %ux%u (%u mips) in %.1f ms: %.1f MB, equirectangular %.1f MB\n", size, size,
+       m_mipLevels, m_convertMs, double(m_bytes) / (1 << 20), double(m_equirectBytes) / (1 << 20));
+  return true;
+}
+
+void OctahedralEnv::createImage(VkCommandBuffer cmd, nvvk::StagingUploader& staging, uint32_t size, std::span<const uint16_t> pixels)
+{
+  const uint32_t mipLevels = std::bit_width(size);
+  m_mipLevels              = mipLevels;
+
+  const VkImageCreateInfo imageInfo{.sType       = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+                                    .imageType   = VK_IMAGE_TYPE_2D,
+                                    .format      = VK_FORMAT_R16G16B16A16_SFLOAT,
+                                    .extent      = {size, size, 1},
+                                    .mipLevels   = mipLevels,
+                                    .arrayLayers = 1,
+                                    .samples     = VK_SAMPLE_COUNT_1_BIT,
+                                    .usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT};
+  const VkImageViewCreateInfo viewInfo{.sType            = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+                                       .viewType         = VK_IMAGE_VIEW_TYPE_2D,
+                                       .format           = imageInfo.format,
+                                       .subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, mipLevels, 0, 1}};
+  NVVK_CHECK(m_alloc->createImage(m_image, imageInfo, viewInfo));
+  NVVK_DBG_NAME(m_image.image);
+  m_image.descriptor.sampler = m_sampler;
+
+  // Mip 0 is uploaded now, the blits read it
+  NVVK_CHECK(staging.appendImage(m_image, pixels, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL));
+  staging.cmdUploadAppended(cmd);
+  if(mipLevels > 1)
+  {
+    nvvk::cmdGenerateMipmaps(cmd, m_image.image, {size, size}, mipLevels, 1, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+  }
+
+  nvvk::WriteSetContainer writes;
+  writes.append(m_bindings.makeWrite(shaderio::EnvOctBindings::eOctahedral), &m_image.descriptor);
+  vkUpdateDescriptorSets(m_alloc->getDevice(), writes.size(), writes.data(), 0, nullptr);
+}
+
+nlohmann::json OctahedralEnv::toJson() const
+{
+  return {{"size", m_size},
+          {"mip_levels", mipLevels()},
+          {"convert_ms", m_convertMs},
+          {"bytes", m_bytes},
+          {"equirect_bytes", m_equirectBytes}};
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <nvvk/descriptors.hpp>
+#include <nvvk/resource_allocator.hpp>
+#include <nvvk/sampler_pool.hpp>
+#include <nvvk/staging.hpp>
+#include <tinygltf/json.hpp>
+
+#include <filesystem>
+#include <span>
+
+
+// OctahedralEnv is a cache friendly copy of an equirectangular HDR environment: equal-area octahedral layout
+// (env_octahedral.slang) in RGBA16F with a full mip chain, and an alias table over its texels for the importance
+// sampling. Like nvvk::HdrIbl owns descriptor set 3, it owns set 4, so both are swapped together. Without
+// conversion it holds a black 1x1 texture: set 4 is valid as soon as load() was recorded.
+class OctahedralEnv
+{
+public:
+  OctahedralEnv() = default;
+  ~OctahedralEnv();
+
+  void init(nvvk::ResourceAllocator* alloc, nvvk::SamplerPool* samplerPool);
+  void deinit();
+
+  // Converts 'filename' on the calling thread and records the upload and mip generation in 'cmd'.
+  // Records the 1x1 texture instead when 'convert' is false, and returns false when the file can't be read.
+  bool load(VkCommandBuffer cmd, nvvk::StagingUploader& staging, const std::filesystem::path& filename, bool convert);
+
+  bool            isValid() const { return m_aliasTable.buffer != VK_NULL_HANDLE; }
+  uint32_t        size() const { return m_size; }
+  uint32_t        mipLevels() const { return m_mipLevels; }
+  VkDeviceAddress aliasTable() const { return m_aliasTable.address; }
+
+  VkDescriptorSetLayout getDescriptorSetLayout() const { return m_bindings.getLayout(); }
+  VkDescriptorSet       getDescriptorSet() const { return m_bindings.getSet(0); }
+
+  nlohmann::json toJson() const;
+
+  // Texture with mips and alias table
+  VkDeviceSize bytes() const { return m_bytes; }
+  // nvvk::HdrIbl's RGBA32F image and per pixel alias table for the same file
+  VkDeviceSize equirectBytes() const { return m_equirectBytes; }
+  double       convertMs() const { return m_convertMs; }
+
+private:
+  void createImage(VkCommandBuffer cmd, nvvk::StagingUploader& staging, uint32_t size, std::span<const uint16_t> pixels);
+
+  nvvk::ResourceAllocator* m_alloc       = nullptr;
+  nvvk::SamplerPool*       m_samplerPool = nullptr;
+  VkSampler                m_sampler     = VK_NULL_HANDLE;
+  nvvk::DescriptorPack     m_bindings;
+
+  nvvk::Image  m_image;
+  nvvk::Buffer m_aliasTable;
+  uint32_t     m_size          = 1;
+  uint32_t     m_mipLevels     = 1;
+  VkDeviceSize m_bytes         = 0;
+  VkDeviceSize m_equirectBytes = 0;
+  double       m_convertMs     = 0.0;
+};
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "pass_profiler.hpp"
+
+#include <imgui/imgui.h>
+
+#include <nvvk/check_error.hpp>
+#include <nvvk/debug_util.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+
+PassProfiler::~PassProfiler()
+{
+  assert(m_queryPool == VK_NULL_HANDLE && "Must call deinit");
+}
+
+void PassProfiler::init(VkDevice device, VkPhysicalDevice physicalDevice, const std::vector<std::string>& passNames, uint32_t frameCycleSize)
+{
+  assert(m_queryPool == VK_NULL_HANDLE && "Init already called");
+
+  m_device    = device;
+  m_passNames = passNames;
+  m_numPasses = uint32_t(passNames.size());
+  m_cycleSize = frameCycleSize;
+
+  VkPhysicalDeviceProperties props;
+  vkGetPhysicalDeviceProperties(physicalDevice, &props);
+  m_nsPerTick = double(props.limits.timestampPeriod);
+
+  // Graphics queue is always family 0 in this sample
+  uint32_t numFamilies = 0;
+  vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &numFamilies, nullptr);
+  std::vector<VkQueueFamilyProperties> families(numFamilies);
+  vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &numFamilies, families.data());
+  const uint32_t validBits = families.empty() ? 64 : families[0].timestampValidBits;
+  m_validMask              = validBits >= 64 ? ~0ULL : ((1ULL << validBits) - 1);
+
+  const VkQueryPoolCreateInfo createInfo{.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+                                         .queryType  = VK_QUERY_TYPE_TIMESTAMP,
+                                         .queryCount = 2 * m_numPasses * m_cycleSize};
+  NVVK_CHECK(vkCreateQueryPool(m_device, &createInfo, nullptr, &m_queryPool));
+  NVVK_DBG_NAME(m_queryPool);
+
+  m_stats.assign(m_numPasses, {});
+  m_history.assign(m_numPasses * kWindow, 0.0);
+  m_written.assign(m_numPasses * m_cycleSize, false);
+}
+
+void PassProfiler::deinit()
+{
+  vkDestroyQueryPool(m_device, m_queryPool, nullptr);
+  m_queryPool = VK_NULL_HANDLE;
+}
+
+void PassProfiler::cmdBeginFrame(VkCommandBuffer cmd, uint32_t cycleIndex)
+{
+  assert(cycleIndex < m_cycleSize);
+  m_cycleIndex = cycleIndex;
+
+  const uint32_t firstQuery = 2 * m_numPasses * cycleIndex;
+
+  // The frame that used this cycle index before has completed; its results are available
+  for(uint32_t pass = 0; pass < m_numPasses; ++pass)
+  {
+    if(!m_written[cycleIndex * m_numPasses + pass])
+    {
+      continue;
+    }
+
+    // Two timestamps, each with an availability word
+    std::array<uint64_t, 4> data{};
+    VkResult result = vkGetQueryPoolResults(m_device, m_queryPool, firstQuery + 2 * pass, 2, sizeof(data), data.data(),
+                                            2 * sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+    if(result == VK_SUCCESS && data[1] != 0 && data[3] != 0)
+    {
+      const uint64_t ticks = (data[2] - data[0]) & m_validMask;
+      addSample(pass, double(ticks) * m_nsPerTick * 1e-6);
+    }
+    m_written[cycleIndex * m_numPasses + pass] = false;
+  }
+
+  vkCmdResetQueryPool(cmd, m_queryPool, firstQuery, 2 * m_numPasses);
+}
+
+void PassProfiler::cmdBeginPass(VkCommandBuffer cmd, uint32_t pass)
+{
+  assert(pass < m_numPasses);
+  vkCmdWriteTimestamp2(cmd, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, m_queryPool, 2 * (m_numPasses * m_cycleIndex + pass));
+}
+
+void PassProfiler::cmdEndPass(VkCommandBuffer cmd, uint32_t pass)
+{
+  assert(pass < m_numPasses);
+  vkCmdWriteTimestamp2(cmd, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, m_queryPool, 2 * (m_numPasses * m_cycleIndex + pass) + 1);
+  m_written[m_cycleIndex * m_numPasses + pass] = true;
+}
+
+void PassProfiler::addSample(uint32_t pass, double ms)
+{
+  Statistics& stats = m_stats[pass];
+
+  m_history[pass * kWindow + stats.samples % kWindow] = ms;
+  stats.samples++;
+
+  const uint32_t count = uint32_t(std::min<uint64_t>(stats.samples, kWindow));
+  double         sum   = 0.0;
+  for(uint32_t i = 0; i < count; ++i)
+  {
+    sum += m_history[pass * kWindow + i];
+  }
+
+  stats.averageMs = sum / double(count);
+  stats.minMs     = stats.samples == 1 ? ms : std::min(stats.minMs, ms);
+  stats.maxMs     = stats.samples == 1 ? ms : std::max(stats.maxMs, ms);
+  stats.lastMs    = ms;
+}
+
+void PassProfiler::resetStatistics()
+{
+  m_stats.assign(m_numPasses, {});
+}
+
+void PassProfiler::onUI()
+{
+  if(ImGui::BeginTable("PassTimes", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+  {
+    ImGui::TableSetupColumn("Pass");
+    ImGui::TableSetupColumn("Avg [ms]");
+    ImGui::TableSetupColumn("Min [ms]");
+    ImGui::TableSetupColumn("Max [ms]");
+    ImGui::TableHeadersRow();
+
+    double total = 0.0;
+    for(uint32_t pass = 0; pass < m_numPasses; ++pass)
+    {
+      const Statistics& s = m_stats[pass];
+      total += s.averageMs;
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(m_passNames[pass].c_str());
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", s.averageMs);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", s.minMs);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", s.maxMs);
+    }
+
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted("Total");
+    ImGui::TableNextColumn();
+    ImGui::Text("%.3f", total);
+    ImGui::EndTable();
+  }
+}
+
+nlohmann::json PassProfiler::toJson() const
+{
+  nlohmann::json j = nlohmann::json::object();
+  for(uint32_t pass = 0; pass < m_numPasses; ++pass)
+  {
+    const Statistics& s = m_stats[pass];
+    j[m_passNames[pass]] = {{"avg_ms", s.averageMs}, {"min_ms", s.minMs}, {"max_ms", s.maxMs}, {"samples", s.samples}};
+  }
+  return j;
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <tinygltf/json.hpp>
+
+#include <string>
+#include <vector>
+
+
+// PassProfiler measures the GPU duration of the frame's passes (raytrace, denoise, ...) with timestamp queries.
+// There is one set of queries per frame in flight; the results of a frame are fetched when its query
+// range is reused, so fetching never waits on the GPU.
+class PassProfiler
+{
+public:
+  struct Statistics
+  {
+    double   averageMs = 0.0;  // over the last 'kWindow' frames
+    double   minMs     = 0.0;
+    double   maxMs     = 0.0;
+    double   lastMs    = 0.0;
+    uint64_t samples   = 0;  // since the last reset
+  };
+
+  PassProfiler() = default;
+  ~PassProfiler();
+
+  void init(VkDevice device, VkPhysicalDevice physicalDevice, const std::vector<std::string>& passNames, uint32_t frameCycleSize);
+  void deinit();
+
+  // Collects the timings of the frame that last used 'cycleIndex' and resets its queries
+  void cmdBeginFrame(VkCommandBuffer cmd, uint32_t cycleIndex);
+  void cmdBeginPass(VkCommandBuffer cmd, uint32_t pass);
+  void cmdEndPass(VkCommandBuffer cmd, uint32_t pass);
+
+  // Helper for scoped sections
+  struct Section
+  {
+    Section(PassProfiler& profiler, VkCommandBuffer cmd, uint32_t pass)
+        : m_profiler(profiler)
+        , m_cmd(cmd)
+        , m_pass(pass)
+    {
+      m_profiler.cmdBeginPass(m_cmd, m_pass);
+    }
+    ~Section() { m_profiler.cmdEndPass(m_cmd, m_pass); }
+
+  private:
+    PassProfiler&   m_profiler;
+    VkCommandBuffer m_cmd;
+    uint32_t        m_pass;
+  };
+
+  const Statistics&               statistics(uint32_t pass) const { return m_stats[pass]; }
+  const std::vector<std::string>& passNames() const { return m_passNames; }
+
+  void resetStatistics();
+
+  void onUI();
+
+  // {"<pass name>": {"avg_ms": .., "min_ms": .., "max_ms": .., "samples": ..}, ...}
+  nlohmann::json toJson() const;
+
+private:
+  static constexpr uint32_t kWindow = 64;
+
+  void addSample(uint32_t pass, double ms);
+
+  VkDevice    m_device     = VK_NULL_HANDLE;
+  VkQueryPool m_queryPool  = VK_NULL_HANDLE;
+  double      m_nsPerTick  = 1.0;
+  uint64_t    m_validMask  = ~0ULL;
+  uint32_t    m_cycleIndex = 0;
+  uint32_t    m_cycleSize  = 1;
+  uint32_t    m_numPasses  = 0;
+
+  std::vector<std::string> m_passNames;
+  std::vector<Statistics>  m_stats;
+  std::vector<double>      m_history;  // kWindow samples per pass
+  std::vector<bool>        m_written;  // per cycle and pass: timestamps were recorded
+};
@@ -0,0 +1,603 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "perf_counters.hpp"
+
+#include <imgui/imgui.h>
+
+#include <nvutils/logger.hpp>
+#include <nvvk/check_error.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cmath>
+#include <limits>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Helpers
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static std::string toLower(std::string s)
+{
+  std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+  return s;
+}
+
+static const char* unitString(VkPerformanceCounterUnitKHR unit)
+{
+  switch(unit)
+  {
+    case VK_PERFORMANCE_COUNTER_UNIT_PERCENTAGE_KHR:
+      return "%";
+    case VK_PERFORMANCE_COUNTER_UNIT_NANOSECONDS_KHR:
+      return "ns";
+    case VK_PERFORMANCE_COUNTER_UNIT_BYTES_KHR:
+      return "bytes";
+    case VK_PERFORMANCE_COUNTER_UNIT_BYTES_PER_SECOND_KHR:
+      return "bytes/s";
+    case VK_PERFORMANCE_COUNTER_UNIT_KELVIN_KHR:
+      return "K";
+    case VK_PERFORMANCE_COUNTER_UNIT_WATTS_KHR:
+      return "W";
+    case VK_PERFORMANCE_COUNTER_UNIT_VOLTS_KHR:
+      return "V";
+    case VK_PERFORMANCE_COUNTER_UNIT_AMPS_KHR:
+      return "A";
+    case VK_PERFORMANCE_COUNTER_UNIT_HERTZ_KHR:
+      return "Hz";
+    case VK_PERFORMANCE_COUNTER_UNIT_CYCLES_KHR:
+      return "cycles";
+    default:
+      return "";
+  }
+}
+
+std::vector<uint32_t> selectPerfCounters(const std::vector<PerfCounterDesc>& counters, const std::vector<std::string>& patterns)
+{
+  std::vector<uint32_t> selection;
+  for(const PerfCounterDesc& counter : counters)
+  {
+    if(!counter.commandScope)
+    {
+      continue;
+    }
+
+    const std::string name     = toLower(counter.name);
+    const std::string category = toLower(counter.category);
+    for(const std::string& pattern : patterns)
+    {
+      const std::string p = toLower(pattern);
+      if(name.find(p) != std::string::npos || category.find(p) != std::string::npos)
+      {
+        selection.push_back(counter.index);
+        break;
+      }
+    }
+  }
+  return selection;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// PerfCounterCapture
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const std::vector<std::string>& PerfCounterCapture::defaultPatterns()
+{
+  static const std::vector<std::string> patterns = {"occupancy", "l1", "l2", "hit rate", "rt core", "raytracing", "ray tracing"};
+  return patterns;
+}
+
+void PerfCounterCapture::init(PerfCounterProvider* provider, const std::vector<std::string>& scopeNames)
+{
+  m_provider   = provider;
+  m_scopeNames = scopeNames;
+  m_selection  = selectPerfCounters(m_provider->counters(), defaultPatterns());
+  m_results.clear();
+}
+
+void PerfCounterCapture::deinit()
+{
+  m_provider = nullptr;
+  m_selection.clear();
+  m_results.clear();
+}
+
+void PerfCounterCapture::setSelection(const std::vector<uint32_t>& selection)
+{
+  m_selection = selection;
+}
+
+uint32_t PerfCounterCapture::requiredPasses() const
+{
+  return m_selection.empty() ? 0 : m_provider->requiredPasses(m_selection);
+}
+
+PerfCounterCapture::Results PerfCounterCapture::aggregate(const std::vector<PerfCounterValues>& runs)
+{
+  Results results;
+  if(runs.empty())
+  {
+    return results;
+  }
+
+  const size_t numScopes = runs[0].size();
+  results.resize(numScopes);
+  for(size_t scope = 0; scope < numScopes; ++scope)
+  {
+    const size_t numCounters = runs[0][scope].size();
+    results[scope].resize(numCounters);
+    for(size_t counter = 0; counter < numCounters; ++counter)
+    {
+      Result& r = results[scope][counter];
+      r.min     = std::numeric_limits<double>::max();
+      r.max     = std::numeric_limits<double>::lowest();
+      for(const PerfCounterValues& run : runs)
+      {
+        const double v = run[scope][counter];
+        r.mean += v;
+        r.min = std::min(r.min, v);
+        r.max = std::max(r.max, v);
+      }
+      r.mean /= double(runs.size());
+    }
+  }
+  return results;
+}
+
+bool PerfCounterCapture::capture(uint32_t repeats, const PerfCounterRecordFunc& recordScope)
+{
+  assert(m_provider);
+  if(m_selection.empty() || repeats == 0)
+  {
+    return false;
+  }
+
+  std::vector<PerfCounterValues> runs(repeats);
+  for(PerfCounterValues& run : runs)
+  {
+    if(!m_provider->collect(m_selection, uint32_t(m_scopeNames.size()), recordScope, run))
+    {
+      LOGW("Performance counter collection failed\n");
+      return false;
+    }
+  }
+
+  m_results         = aggregate(runs);
+  m_resultSelection = m_selection;
+  return true;
+}
+
+bool PerfCounterCapture::onUI()
+{
+  const std::vector<PerfCounterDesc>& counters = m_provider->counters();
+
+  bool requested = ImGui::Button("Capture Counters");
+  ImGui::SameLine();
+  ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6);
+  ImGui::InputInt("Repeats", &m_repeats);
+  m_repeats = std::clamp(m_repeats, 1, 100);
+  ImGui::Text("%zu of %zu counters selected, %u replay passes", m_selection.size(), counters.size(), requiredPasses());
+
+  if(ImGui::TreeNode("Selection"))
+  {
+    char buf[128]{};
+    m_filter.copy(buf, sizeof(buf) - 1);
+    if(ImGui::InputText("Filter", buf, sizeof(buf)))
+    {
+      m_filter = buf;
+    }
+    if(ImGui::Button("Default"))
+    {
+      m_selection = selectPerfCounters(counters, defaultPatterns());
+    }
+    ImGui::SameLine();
+    if(ImGui::Button("None"))
+    {
+      m_selection.clear();
+    }
+
+    if(ImGui::BeginChild("Counters", ImVec2(0, ImGui::GetTextLineHeightWithSpacing() * 10), ImGuiChildFlags_Borders))
+    {
+      const std::string filter = toLower(m_filter);
+      for(const PerfCounterDesc& counter : counters)
+      {
+        if(!filter.empty() && toLower(counter.name).find(filter) == std::string::npos)
+        {
+          continue;
+        }
+        auto it       = std::find(m_selection.begin(), m_selection.end(), counter.index);
+        bool selected = it != m_selection.end();
+        ImGui::BeginDisabled(!counter.commandScope);
+        if(ImGui::Checkbox(counter.name.c_str(), &selected))
+        {
+          selected ? m_selection.push_back(counter.index) : (void)m_selection.erase(it);
+        }
+        ImGui::EndDisabled();
+        ImGui::SetItemTooltip("%s\n%s", counter.category.c_str(), counter.description.c_str());
+      }
+    }
+    ImGui::EndChild();
+    ImGui::TreePop();
+  }
+
+  if(!m_results.empty() && ImGui::BeginTable("CounterResults", 1 + int(m_scopeNames.size()), ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+  {
+    ImGui::TableSetupColumn("Counter");
+    for(const std::string& scope : m_scopeNames)
+    {
+      ImGui::TableSetupColumn(scope.c_str());
+    }
+    ImGui::TableHeadersRow();
+
+    for(size_t c = 0; c < m_resultSelection.size(); ++c)
+    {
+      const PerfCounterDesc& counter = counters[m_resultSelection[c]];
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::Text("%s [%s]", counter.name.c_str(), counter.unit.c_str());
+      for(size_t scope = 0; scope < m_results.size(); ++scope)
+      {
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3g", m_results[scope][c].mean);
+      }
+    }
+    ImGui::EndTable();
+  }
+
+  return requested;
+}
+
+nlohmann::json PerfCounterCapture::toJson() const
+{
+  nlohmann::json j = nlohmann::json::object();
+  if(!m_provider)
+  {
+    return j;
+  }
+
+  const std::vector<PerfCounterDesc>& counters = m_provider->counters();
+  for(size_t scope = 0; scope < m_results.size(); ++scope)
+  {
+    nlohmann::json& scopeJson = j[m_scopeNames[scope]];
+    for(size_t c = 0; c < m_resultSelection.size(); ++c)
+    {
+      const PerfCounterDesc& counter = counters[m_resultSelection[c]];
+      const Result&          r       = m_results[scope][c];
+      scopeJson[counter.name] = {{"mean", r.mean}, {"min", r.min}, {"max", r.max}, {"unit", counter.unit}};
+    }
+  }
+  return j;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// VkPerfCounterProvider
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VkPerfCounterProvider::~VkPerfCounterProvider()
+{
+  assert(m_cmdPool == VK_NULL_HANDLE && "Must call deinit");
+}
+
+bool VkPerfCounterProvider::init(VkDevice device, VkPhysicalDevice physicalDevice, VkQueue queue, uint32_t queueFamilyIndex)
+{
+  m_device           = device;
+  m_physicalDevice   = physicalDevice;
+  m_queue            = queue;
+  m_queueFamilyIndex = queueFamilyIndex;
+
+  uint32_t count = 0;
+  NVVK_CHECK(vkEnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR(physicalDevice, queueFamilyIndex, &count, nullptr, nullptr));
+  if(count == 0)
+  {
+    return false;
+  }
+
+  std::vector<VkPerformanceCounterKHR> counters(count, {VK_STRUCTURE_TYPE_PERFORMANCE_COUNTER_KHR});
+  std::vector<VkPerformanceCounterDescriptionKHR> descriptions(count, {VK_STRUCTURE_TYPE_PERFORMANCE_COUNTER_DESCRIPTION_KHR});
+  NVVK_CHECK(vkEnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR(physicalDevice, queueFamilyIndex, &count,
+                                                                              counters.data(), descriptions.data()));
+
+  m_counters.resize(count);
+  m_storage.resize(count);
+  for(uint32_t i = 0; i < count; ++i)
+  {
+    m_counters[i] = {.index        = i,
+                     .name         = descriptions[i].name,
+                     .category     = descriptions[i].category,
+                     .description  = descriptions[i].description,
+                     .unit         = unitString(counters[i].unit),
+                     .commandScope = counters[i].scope != VK_PERFORMANCE_COUNTER_SCOPE_RENDER_PASS_KHR};
+    m_storage[i]  = counters[i].storage;
+  }
+
+  const VkCommandPoolCreateInfo poolInfo{.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+                                         .flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+                                         .queueFamilyIndex = queueFamilyIndex};
+  NVVK_CHECK(vkCreateCommandPool(m_device, &poolInfo, nullptr, &m_cmdPool));
+
+  LOGI("%u performance counters available\n", count);
+  return true;
+}
+
+void VkPerfCounterProvider::deinit()
+{
+  vkDestroyCommandPool(m_device, m_cmdPool, nullptr);
+  m_cmdPool = VK_NULL_HANDLE;
+  m_counters.clear();
+  m_storage.clear();
+}
+
+uint32_t VkPerfCounterProvider::requiredPasses(const std::vector<uint32_t>& selection) const
+{
+  const VkQueryPoolPerformanceCreateInfoKHR perfInfo{.sType             = VK_STRUCTURE_TYPE_QUERY_POOL_PERFORMANCE_CREATE_INFO_KHR,
+                                                     .queueFamilyIndex  = m_queueFamilyIndex,
+                                                     .counterIndexCount = uint32_t(selection.size()),
+                                                     .pCounterIndices   = selection.data()};
+  uint32_t numPasses = 0;
+  vkGetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR(m_physicalDevice, &perfInfo, &numPasses);
+  return numPasses;
+}
+
+bool VkPerfCounterProvider::collect(const std::vector<uint32_t>& selection,
+                                    uint32_t                     numScopes,
+                                    const PerfCounterRecordFunc& recordScope,
+                                    PerfCounterValues&           values)
+{
+  const uint32_t numCounters = uint32_t(selection.size());
+  const uint32_t numPasses   = requiredPasses(selection);
+
+  // Command buffers using performance queries must be recorded while holding the lock
+  const VkAcquireProfilingLockInfoKHR lockInfo{.sType = VK_STRUCTURE_TYPE_ACQUIRE_PROFILING_LOCK_INFO_KHR, .timeout = UINT64_MAX};
+  if(vkAcquireProfilingLockKHR(m_device, &lockInfo) != VK_SUCCESS)
+  {
+    LOGW("Could not acquire the profiling lock\n");
+    return false;
+  }
+
+  VkQueryPoolPerformanceCreateInfoKHR perfInfo{.sType             = VK_STRUCTURE_TYPE_QUERY_POOL_PERFORMANCE_CREATE_INFO_KHR,
+                                               .queueFamilyIndex  = m_queueFamilyIndex,
+                                               .counterIndexCount = numCounters,
+                                               .pCounterIndices   = selection.data()};
+  const VkQueryPoolCreateInfo poolInfo{.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+                                       .pNext      = &perfInfo,
+                                       .queryType  = VK_QUERY_TYPE_PERFORMANCE_QUERY_KHR,
+                                       .queryCount = numScopes};
+  VkQueryPool queryPool = VK_NULL_HANDLE;
+  NVVK_CHECK(vkCreateQueryPool(m_device, &poolInfo, nullptr, &queryPool));
+
+  // One command buffer to reset the queries, one per scope
+  std::vector<VkCommandBuffer>       cmds(numScopes + 1);
+  const VkCommandBufferAllocateInfo allocInfo{.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+                                              .commandPool        = m_cmdPool,
+                                              .level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+                                              .commandBufferCount = uint32_t(cmds.size())};
+  NVVK_CHECK(vkAllocateCommandBuffers(m_device, &allocInfo, cmds.data()));
+
+  const VkCommandBufferBeginInfo beginInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+  NVVK_CHECK(vkBeginCommandBuffer(cmds[0], &beginInfo));
+  vkCmdResetQueryPool(cmds[0], queryPool, 0, numScopes);
+  NVVK_CHECK(vkEndCommandBuffer(cmds[0]));
+
+  // Command buffer scoped counters require the query to enclose the whole command buffer
+  for(uint32_t scope = 0; scope < numScopes; ++scope)
+  {
+    VkCommandBuffer cmd = cmds[scope + 1];
+    NVVK_CHECK(vkBeginCommandBuffer(cmd, &beginInfo));
+    vkCmdBeginQuery(cmd, queryPool, scope, 0);
+    recordScope(cmd, scope);
+    vkCmdEndQuery(cmd, queryPool, scope);
+    NVVK_CHECK(vkEndCommandBuffer(cmd));
+  }
+
+  // Replay once per counter pass
+  bool success = true;
+  for(uint32_t pass = 0; pass < numPasses && success; ++pass)
+  {
+    std::vector<VkCommandBufferSubmitInfo> cmdInfos;
+    for(uint32_t i = (pass == 0 ? 0 : 1); i < cmds.size(); ++i)
+    {
+      cmdInfos.push_back({.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO, .commandBuffer = cmds[i]});
+    }
+
+    const VkPerformanceQuerySubmitInfoKHR passInfo{.sType = VK_STRUCTURE_TYPE_PERFORMANCE_QUERY_SUBMIT_INFO_KHR, .counterPassIndex = pass};
+    const VkSubmitInfo2 submitInfo{.sType                  = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+                                   .pNext                  = &passInfo,
+                                   .commandBufferInfoCount = uint32_t(cmdInfos.size()),
+                                   .pCommandBufferInfos    = cmdInfos.data()};
+    success = vkQueueSubmit2(m_queue, 1, &submitInfo, VK_NULL_HANDLE) == VK_SUCCESS;
+    success = success && vkQueueWaitIdle(m_queue) == VK_SUCCESS;
+  }
+
+  std::vector<VkPerformanceCounterResultKHR> results(numScopes * numCounters);
+  if(success)
+  {
+    success = vkGetQueryPoolResults(m_device, queryPool, 0, numScopes, results.size() * sizeof(VkPerformanceCounterResultKHR),
+                                    results.data(), numCounters * sizeof(VkPerformanceCounterResultKHR), VK_QUERY_RESULT_WAIT_BIT)
+              == VK_SUCCESS;
+  }
+
+  vkFreeCommandBuffers(m_device, m_cmdPool, uint32_t(cmds.size()), cmds.data());
+  vkDestroyQueryPool(m_device, queryPool, nullptr);
+  vkReleaseProfilingLockKHR(m_device);
+
+  if(!success)
+  {
+    return false;
+  }
+
+  values.assign(numScopes, std::vector<double>(numCounters));
+  for(uint32_t scope = 0; scope < numScopes; ++scope)
+  {
+    for(uint32_t c = 0; c < numCounters; ++c)
+    {
+      const VkPerformanceCounterResultKHR& r = results[scope * numCounters + c];
+      double&                              v = values[scope][c];
+      switch(m_storage[selection[c]])
+      {
+        case VK_PERFORMANCE_COUNTER_STORAGE_INT32_KHR:
+          v = double(r.int32);
+          break;
+        case VK_PERFORMANCE_COUNTER_STORAGE_INT64_KHR:
+          v = double(r.int64);
+          break;
+        case VK_PERFORMANCE_COUNTER_STORAGE_UINT32_KHR:
+          v = double(r.uint32);
+          break;
+        case VK_PERFORMANCE_COUNTER_STORAGE_UINT64_KHR:
+          v = double(r.uint64);
+          break;
+        case VK_PERFORMANCE_COUNTER_STORAGE_FLOAT32_KHR:
+          v = double(r.float32);
+          break;
+        case VK_PERFORMANCE_COUNTER_STORAGE_FLOAT64_KHR:
+          v = r.float64;
+          break;
+        default:
+          v = 0.0;
+          break;
+      }
+    }
+  }
+
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FakePerfCounterProvider
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+FakePerfCounterProvider::FakePerfCounterProvider(std::vector<PerfCounterDesc> counters, uint32_t countersPerPass, ValueFunc valueFunc)
+    : m_counters(std::move(counters))
+    , m_countersPerPass(std::max(1u, countersPerPass))
+    , m_valueFunc(std::move(valueFunc))
+{
+  for(uint32_t i = 0; i < m_counters.size(); ++i)
+  {
+    m_counters[i].index = i;
+  }
+  if(!m_valueFunc)
+  {
+    m_valueFunc = [](uint32_t counter, uint32_t scope, uint32_t) { return double(1000 * scope + counter); };
+  }
+}
+
+uint32_t FakePerfCounterProvider::requiredPasses(const std::vector<uint32_t>& selection) const
+{
+  return (uint32_t(selection.size()) + m_countersPerPass - 1) / m_countersPerPass;
+}
+
+bool FakePerfCounterProvider::collect(const std::vector<uint32_t>& selection,
+                                      uint32_t                     numScopes,
+                                      const PerfCounterRecordFunc& recordScope,
+                                      PerfCounterValues&           values)
+{
+  for(uint32_t pass = 0; pass < requiredPasses(selection); ++pass)
+  {
+    for(uint32_t scope = 0; scope < numScopes; ++scope)
+    {
+      recordScope(VK_NULL_HANDLE, scope);
+    }
+    m_replays++;
+  }
+
+  values.assign(numScopes, std::vector<double>(selection.size()));
+  for(uint32_t scope = 0; scope < numScopes; ++scope)
+  {
+    for(size_t c = 0; c < selection.size(); ++c)
+    {
+      values[scope][c] = m_valueFunc(selection[c], scope, m_collections);
+    }
+  }
+  m_collections++;
+  return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Self test
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool PerfCounterCapture::selfTest()
+{
+  auto counter = [](const char* name, const char* category, bool commandScope = true) {
+    return PerfCounterDesc{.name = name, .category = category, .unit = "%", .commandScope = commandScope};
+  };
+  const std::vector<PerfCounterDesc> counters = {
+      counter("SM Occupancy", "SM"),
+      counter("L1 Hit Rate", "Memory"),
+      counter("L2 Hit Rate", "Memory", false),  // render pass scope only
+      counter("RT Core Utilization", "Raytracing"),
+      counter("DRAM Bandwidth", "Memory"),
+      counter("Warps Launched", "SM OCCUPANCY"),
+      counter("Texture Fetches", "Texture"),
+  };
+
+  // Patterns match the name or the category, case insensitive; counters without command scope are never selected
+  const uint32_t countersPerPass = 3;
+  auto           valueFunc       = [](uint32_t c, uint32_t scope, uint32_t replay) { return 100.0 * scope + 10.0 * c + replay; };
+  FakePerfCounterProvider provider(counters, countersPerPass, valueFunc);
+  const std::vector<PerfCounterDesc>& indexed = provider.counters();
+  const bool selected = selectPerfCounters(indexed, defaultPatterns()) == std::vector<uint32_t>{0, 1, 3, 5}
+                        && selectPerfCounters(indexed, {"MEMORY"}) == std::vector<uint32_t>{1, 4}
+                        && selectPerfCounters(indexed, {"l2"}).empty() && selectPerfCounters(indexed, {}).empty();
+
+  // A selection takes ceil(counters / countersPerPass) replays of every scope, per repeat
+  bool passes = true;
+  for(uint32_t n = 0; n <= uint32_t(indexed.size()); ++n)
+  {
+    std::vector<uint32_t> selection(n);
+    for(uint32_t i = 0; i < n; ++i)
+    {
+      selection[i] = i;
+    }
+    passes = passes && provider.requiredPasses(selection) == (n + countersPerPass - 1) / countersPerPass;
+  }
+
+  const std::vector<std::string> scopes = {"Raytrace", "Denoise", "Tonemap"};
+  const uint32_t                 repeats = 5;
+  PerfCounterCapture             capture;
+  capture.init(&provider, scopes);
+  uint32_t recorded = 0;
+  const bool captured = capture.capture(repeats, [&](VkCommandBuffer, uint32_t) { recorded++; });
+  passes = passes && captured && capture.requiredPasses() == 2 && provider.replays() == repeats * 2
+           && recorded == provider.replays() * uint32_t(scopes.size()) && provider.collections() == repeats;
+
+  // The value of repeat r is base + r: mean base + 2, min base, max base + 4
+  bool aggregated = captured && capture.results().size() == scopes.size();
+  for(uint32_t scope = 0; aggregated && scope < scopes.size(); ++scope)
+  {
+    const std::vector<Result>& results = capture.results()[scope];
+    aggregated = aggregated && results.size() == capture.selection().size();
+    for(size_t c = 0; aggregated && c < results.size(); ++c)
+    {
+      const double base = valueFunc(capture.selection()[c], scope, 0);
+      aggregated = aggregated && std::abs(results[c].mean - (base + 2.0)) < 1e-9 && results[c].min == base
+                   && results[c].max == base + 4.0;
+    }
+  }
+  aggregated = aggregated && aggregate({}).empty();
+  capture.deinit();
+
+  const bool passed = selected && passes && aggregated;
+  LOGI("Performance counter self test %s: selection %s, replays %s (%u for %u repeats), aggregation %s\n",
+       passed ? "passed" : "FAILED", selected ? "ok" : "FAILED", passes ? "ok" : "FAILED", provider.replays(), repeats,
+       aggregated ? "ok" : "FAILED");
+  return passed;
+}
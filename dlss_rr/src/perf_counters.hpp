@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <tinygltf/json.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Hardware performance counters, collected per pass ('scope') of a frame.
+//
+// PerfCounterProvider abstracts the counter source: VkPerfCounterProvider uses VK_KHR_performance_query,
+// FakePerfCounterProvider produces deterministic values without a GPU, for testing the selection and
+// aggregation in PerfCounterCapture.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct PerfCounterDesc
+{
+  uint32_t    index = 0;  // index into the provider's counter list
+  std::string name;
+  std::string category;
+  std::string description;
+  std::string unit;
+  bool        commandScope = true;  // false if the counter can only be sampled over whole render passes
+};
+
+// Counter values, indexed [scope][selected counter]
+using PerfCounterValues = std::vector<std::vector<double>>;
+
+// Records scope 'scope' of the workload into 'cmd'
+using PerfCounterRecordFunc = std::function<void(VkCommandBuffer cmd, uint32_t scope)>;
+
+class PerfCounterProvider
+{
+public:
+  virtual ~PerfCounterProvider() = default;
+
+  virtual const std::vector<PerfCounterDesc>& counters() const = 0;
+
+  // Number of times the workload must be replayed to collect all counters in 'selection'
+  virtual uint32_t requiredPasses(const std::vector<uint32_t>& selection) const = 0;
+
+  // Replays the workload requiredPasses() times and returns one value per scope and selected counter
+  virtual bool collect(const std::vector<uint32_t>& selection, uint32_t numScopes, const PerfCounterRecordFunc& recordScope, PerfCounterValues& values) = 0;
+};
+
+// Returns the indices of the counters whose name or category contains one of 'patterns' (case insensitive).
+// Counters which can't be sampled around individual commands are skipped.
+std::vector<uint32_t> selectPerfCounters(const std::vector<PerfCounterDesc>& counters, const std::vector<std::string>& patterns);
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Selects counters, runs repeated captures and aggregates the results per scope
+class PerfCounterCapture
+{
+public:
+  struct Result
+  {
+    double mean = 0.0;
+    double min  = 0.0;
+    double max  = 0.0;
+  };
+  // [scope][selected counter]
+  using Results = std::vector<std::vector<Result>>;
+
+  // Default selection: SM occupancy, L1/L2 hit rates and RT core utilization, where exposed
+  static const std::vector<std::string>& defaultPatterns();
+
+  void init(PerfCounterProvider* provider, const std::vector<std::string>& scopeNames);
+  void deinit();
+
+  bool isValid() const { return m_provider != nullptr; }
+
+  void                         setSelection(const std::vector<uint32_t>& selection);
+  const std::vector<uint32_t>& selection() const { return m_selection; }
+  uint32_t                     requiredPasses() const;
+
+  // Collects the selected counters 'repeats' times and aggregates them
+  bool capture(uint32_t repeats, const PerfCounterRecordFunc& recordScope);
+
+  const Results& results() const { return m_results; }
+
+  // Returns true if a capture was requested
+  bool onUI();
+
+  // {"<scope>": {"<counter>": {"mean": .., "min": .., "max": .., "unit": ..}, ...}, ...}
+  nlohmann::json toJson() const;
+
+  uint32_t repeats() const { return m_repeats; }
+
+  // Aggregates repeated captures: runs[repeat][scope][counter]
+  static Results aggregate(const std::vector<PerfCounterValues>& runs);
+
+  // Checks the selection, the replay count and the aggregation with a FakePerfCounterProvider
+  static bool selfTest();
+
+private:
+  PerfCounterProvider*     m_provider = nullptr;
+  std::vector<std::string> m_scopeNames;
+  std::vector<uint32_t>    m_selection;
+  Results                  m_results;
+  std::vector<uint32_t>    m_resultSelection;  // selection m_results was captured with
+  int                      m_repeats = 3;
+  std::string              m_filter;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// VK_KHR_performance_query based counters.
+// Each scope is recorded into its own command buffer with the query as first and last command, this satisfies
+// all counter scopes. The command buffers are submitted once per counter pass.
+class VkPerfCounterProvider : public PerfCounterProvider
+{
+public:
+  VkPerfCounterProvider() = default;
+  ~VkPerfCounterProvider() override;
+
+  // Returns false if the queue family doesn't expose counters
+  bool init(VkDevice device, VkPhysicalDevice physicalDevice, VkQueue queue, uint32_t queueFamilyIndex);
+  void deinit();
+
+  const std::vector<PerfCounterDesc>& counters() const override { return m_counters; }
+  uint32_t                            requiredPasses(const std::vector<uint32_t>& selection) const override;
+  bool collect(const std::vector<uint32_t>& selection, uint32_t numScopes, const PerfCounterRecordFunc& recordScope, PerfCounterValues& values) override;
+
+private:
+  VkDevice         m_device           = VK_NULL_HANDLE;
+  VkPhysicalDevice m_physicalDevice   = VK_NULL_HANDLE;
+  VkQueue          m_queue            = VK_NULL_HANDLE;
+  uint32_t         m_queueFamilyIndex = 0;
+  VkCommandPool    m_cmdPool          = VK_NULL_HANDLE;
+
+  std::vector<PerfCounterDesc>                m_counters;
+  std::vector<VkPerformanceCounterStorageKHR> m_storage;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Counter provider without a GPU. 'countersPerPass' counters fit into one replay.
+// The recording callback is invoked with a null command buffer.
+class FakePerfCounterProvider : public PerfCounterProvider
+{
+public:
+  // Returns the value of 'counter' for 'scope' in replay 'replay'
+  using ValueFunc = std::function<double(uint32_t counter, uint32_t scope, uint32_t replay)>;
+
+  FakePerfCounterProvider(std::vector<PerfCounterDesc> counters, uint32_t countersPerPass, ValueFunc valueFunc = {});
+
+  const std::vector<PerfCounterDesc>& counters() const override { return m_counters; }
+  uint32_t                            requiredPasses(const std::vector<uint32_t>& selection) const override;
+  bool collect(const std::vector<uint32_t>& selection, uint32_t numScopes, const PerfCounterRecordFunc& recordScope, PerfCounterValues& values) override;
+
+  // Number of workload replays so far
+  uint32_t replays() const { return m_replays; }
+  uint32_t collections() const { return m_collections; }
+
+private:
+  std::vector<PerfCounterDesc> m_counters;
+  uint32_t                     m_countersPerPass = 1;
+  ValueFunc                    m_valueFunc;
+  uint32_t                     m_replays     = 0;
+  uint32_t                     m_collections = 0;
+};
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "pipeline_stats.hpp"
+
+#include <imgui/imgui.h>
+
+#include <nvutils/logger.hpp>
+
+#include <string>
+
+
+static std::vector<std::string> stageNames(VkShaderStageFlags stages)
+{
+  static const std::pair<VkShaderStageFlagBits, const char*> names[] = {
+      {VK_SHADER_STAGE_VERTEX_BIT, "vertex"},
+      {VK_SHADER_STAGE_FRAGMENT_BIT, "fragment"},
+      {VK_SHADER_STAGE_COMPUTE_BIT, "compute"},
+      {VK_SHADER_STAGE_RAYGEN_BIT_KHR, "raygen"},
+      {VK_SHADER_STAGE_ANY_HIT_BIT_KHR, "anyhit"},
+      {VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR, "closesthit"},
+      {VK_SHADER_STAGE_MISS_BIT_KHR, "miss"},
+      {VK_SHADER_STAGE_INTERSECTION_BIT_KHR, "intersection"},
+      {VK_SHADER_STAGE_CALLABLE_BIT_KHR, "callable"},
+  };
+
+  std::vector<std::string> result;
+  for(const auto& [bit, name] : names)
+  {
+    if(stages & bit)
+    {
+      result.emplace_back(name);
+    }
+  }
+  return result;
+}
+
+std::vector<PipelineExecutableStats> getPipelineExecutableStats(VkDevice device, VkPipeline pipeline)
+{
+  std::vector<PipelineExecutableStats> result;
+
+  const VkPipelineInfoKHR pipelineInfo{.sType = VK_STRUCTURE_TYPE_PIPELINE_INFO_KHR, .pipeline = pipeline};
+  uint32_t                numExecutables = 0;
+  if(vkGetPipelineExecutablePropertiesKHR(device, &pipelineInfo, &numExecutables, nullptr) != VK_SUCCESS)
+  {
+    return result;
+  }
+  std::vector<VkPipelineExecutablePropertiesKHR> properties(numExecutables, {VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_PROPERTIES_KHR});
+  vkGetPipelineExecutablePropertiesKHR(device, &pipelineInfo, &numExecutables, properties.data());
+
+  result.resize(numExecutables);
+  for(uint32_t i = 0; i < numExecutables; ++i)
+  {
+    PipelineExecutableStats& exe = result[i];
+    exe.name                     = properties[i].name;
+    exe.description              = properties[i].description;
+    exe.stages                   = properties[i].stages;
+    exe.subgroupSize             = properties[i].subgroupSize;
+
+    const VkPipelineExecutableInfoKHR exeInfo{.sType = VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_INFO_KHR, .pipeline = pipeline, .executableIndex = i};
+    uint32_t numStats = 0;
+    vkGetPipelineExecutableStatisticsKHR(device, &exeInfo, &numStats, nullptr);
+    std::vector<VkPipelineExecutableStatisticKHR> stats(numStats, {VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_STATISTIC_KHR});
+    vkGetPipelineExecutableStatisticsKHR(device, &exeInfo, &numStats, stats.data());
+
+    for(const VkPipelineExecutableStatisticKHR& s : stats)
+    {
+      PipelineExecutableStats::Statistic& stat = exe.statistics.emplace_back();
+      stat.name                                = s.name;
+      stat.description                         = s.description;
+      switch(s.format)
+      {
+        case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_BOOL32_KHR:
+          stat.value = s.value.b32 ? 1.0 : 0.0;
+          break;
+        case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_INT64_KHR:
+          stat.value = double(s.value.i64);
+          break;
+        case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_UINT64_KHR:
+          stat.value = double(s.value.u64);
+          break;
+        case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_FLOAT64_KHR:
+          stat.value = s.value.f64;
+          break;
+        default:
+          break;
+      }
+    }
+  }
+
+  return result;
+}
+
+void logPipelineExecutableStats(const char* pipelineName, const std::vector<PipelineExecutableStats>& executables)
+{
+  LOGI("Pipeline statistics of %s:\n", pipelineName);
+  for(const PipelineExecutableStats& exe : executables)
+  {
+    std::string stages;
+    for(const std::string& s : stageNames(exe.stages))
+    {
+      stages += (stages.empty() ? "" : "|") + s;
+    }
+    LOGI(" - %s [%s], subgroup size %u\n", exe.name.c_str(), stages.c_str(), exe.subgroupSize);
+    for(const PipelineExecutableStats::Statistic& stat : exe.statistics)
+    {
+      LOGI("     %-32s %g\n", stat.name.c_str(), stat.value);
+    }
+  }
+}
+
+nlohmann::json pipelineExecutableStatsToJson(const std::vector<PipelineExecutableStats>& executables)
+{
+  nlohmann::json array = nlohmann::json::array();
+  for(const PipelineExecutableStats& exe : executables)
+  {
+    nlohmann::json stats = nlohmann::json::object();
+    for(const PipelineExecutableStats::Statistic& stat : exe.statistics)
+    {
+      stats[stat.name] = stat.value;
+    }
+    array.push_back({{"name", exe.name}, {"stages", stageNames(exe.stages)}, {"subgroup_size", exe.subgroupSize}, {"statistics", stats}});
+  }
+  return array;
+}
+
+void pipelineExecutableStatsUI(const char* tableId, const std::vector<PipelineExecutableStats>& executables)
+{
+  if(executables.empty())
+  {
+    ImGui::TextDisabled("No pipeline statistics (VK_KHR_pipeline_executable_properties)");
+    return;
+  }
+
+  ImGui::PushID(tableId);
+  for(size_t i = 0; i < executables.size(); ++i)
+  {
+    const PipelineExecutableStats& exe = executables[i];
+    if(!ImGui::TreeNode((void*)i, "%s", exe.name.c_str()))
+    {
+      continue;
+    }
+    ImGui::SetItemTooltip("%s", exe.description.c_str());
+
+    if(ImGui::BeginTable(tableId, 2, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+    {
+      for(const PipelineExecutableStats::Statistic& stat : exe.statistics)
+      {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(stat.name.c_str());
+        ImGui::SetItemTooltip("%s", stat.description.c_str());
+        ImGui::TableNextColumn();
+        ImGui::Text("%g", stat.value);
+      }
+      ImGui::EndTable();
+    }
+    ImGui::TreePop();
+  }
+  ImGui::PopID();
+}
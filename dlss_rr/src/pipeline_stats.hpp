@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <tinygltf/json.hpp>
+
+#include <string>
+#include <vector>
+
+
+// Per-stage compiler statistics (registers, stack size, spills, ...) of a pipeline, queried through
+// VK_KHR_pipeline_executable_properties. The pipeline must be created with
+// VK_PIPELINE_CREATE_CAPTURE_STATISTICS_BIT_KHR. The statistic names are driver specific.
+struct PipelineExecutableStats
+{
+  struct Statistic
+  {
+    std::string name;
+    std::string description;
+    double      value = 0.0;  // booleans are 0 or 1
+  };
+
+  std::string            name;  // driver provided, e.g. the entry point and stage
+  std::string            description;
+  VkShaderStageFlags     stages       = 0;
+  uint32_t               subgroupSize = 0;
+  std::vector<Statistic> statistics;
+};
+
+// Returns an empty vector if the pipeline wasn't created with statistics capture
+std::vector<PipelineExecutableStats> getPipelineExecutableStats(VkDevice device, VkPipeline pipeline);
+
+void logPipelineExecutableStats(const char* pipelineName, const std::vector<PipelineExecutableStats>& executables);
+
+// [{"name": .., "stages": [..], "subgroup_size": .., "statistics": {"<statistic>": value, ...}}, ...]
+nlohmann::json pipelineExecutableStatsToJson(const std::vector<PipelineExecutableStats>& executables);
+
+// Table of the statistics, one row per executable
+void pipelineExecutableStatsUI(const char* tableId, const std::vector<PipelineExecutableStats>& executables);
@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "profile_database.hpp"
+
+#include <nvutils/logger.hpp>
+#include <nvutils/parameter_registry.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+
+namespace {
+
+constexpr int kVersion = 1;
+
+// NGX values: DLAA, MaxQuality, Balanced, MaxPerf, UltraPerformance, from the best image to the cheapest
+constexpr int kQualities[] = {5, 2, 1, 0, 3};
+// NGX values: Default, D, E
+constexpr int kPresets[] = {0, 4, 5};
+// Depths choose() considers, the largest is the shipped default
+constexpr int kMinDepth = 2;
+constexpr int kMaxDepth = 5;
+
+// (x, y) samples sorted by x: linear between the samples; beyond them 'proportional' scales the nearest sample,
+// otherwise the nearest two are extrapolated
+std::optional<double> interpolate(std::vector<std::pair<double, double>> samples, double x, bool proportional)
+{
+  if(samples.empty())
+  {
+    return {};
+  }
+  std::sort(samples.begin(), samples.end());
+  if(samples.size() == 1 || (proportional && (x <= samples.front().first || x >= samples.back().first)))
+  {
+    const auto& nearest = x <= samples.front().first ? samples.front() : samples.back();
+    if(proportional)
+    {
+      return nearest.second * x / nearest.first;
+    }
+    return x == nearest.first ? std::optional<double>(nearest.second) : std::nullopt;
+  }
+
+  // Bracketing pair, or the nearest two beyond the ends
+  auto upper = std::upper_bound(samples.begin(), samples.end(), x, [](double v, const auto& s) { return v < s.first; });
+  upper      = std::clamp(upper, samples.begin() + 1, samples.end() - 1);
+  const auto& a = *(upper - 1);
+  const auto& b = *upper;
+  if(a.first == b.first)
+  {
+    return a.second;
+  }
+  const double t = (x - a.first) / (b.first - a.first);
+  return std::max(a.second + (b.second - a.second) * t, 0.0);
+}
+
+nlohmann::json pointToJson(const ProfilePoint& point)
+{
+  return {{"quality", point.config.quality},
+          {"preset", point.config.preset},
+          {"max_depth", point.config.maxDepth},
+          {"output_size", {point.config.outputSize.x, point.config.outputSize.y}},
+          {"frame_ms", point.frameMs},
+          {"passes", point.passMs}};
+}
+
+bool pointFromJson(const nlohmann::json& json, ProfilePoint& point)
+{
+  if(!json.is_object() || !json.contains("output_size") || !json["output_size"].is_array() || json["output_size"].size() != 2)
+  {
+    return false;
+  }
+  point.config.quality    = json.value("quality", 2);
+  point.config.preset     = json.value("preset", 0);
+  point.config.maxDepth   = json.value("max_depth", 5);
+  point.config.outputSize = {json["output_size"][0].get<uint32_t>(), json["output_size"][1].get<uint32_t>()};
+  point.frameMs           = json.value("frame_ms", 0.0);
+  point.passMs            = json.value("passes", std::map<std::string, double>());
+  return point.config.outputSize.x > 0 && point.config.outputSize.y > 0;
+}
+
+}  // namespace
+
+
+void ProfileDatabase::registerParameters(nvutils::ParameterRegistry& registry, Settings& settings)
+{
+  registry.add({"profileDatabase", "Per GPU database of measured costs: benchmarks add to it, --profileTargetMs reads it"},
+               &settings.file);
+  registry.add({"profileTargetMs", "Choose the DLSS quality, preset and path depth estimated to meet this frame time"},
+               &settings.targetMs);
+  registry.add({"profileSweep", "Benchmark every quality, preset, resolution and depth into the profile database and exit"},
+               &settings.sweep);
+  registry.add({"profileSelfTest", "Check the profile database lookup, interpolation and choice on the CPU and exit"},
+               &settings.selfTest);
+}
+
+bool ProfileDatabase::load(const std::filesystem::path& filename)
+{
+  m_devices.clear();
+  std::ifstream file(filename);
+  if(!file)
+  {
+    return true;
+  }
+  const nlohmann::json json = nlohmann::json::parse(file, nullptr, false);
+  if(json.is_discarded() || !fromJson(json))
+  {
+    LOGE("Could not parse the profile database %s\n", filename.string().c_str());
+    return false;
+  }
+  return true;
+}
+
+bool ProfileDatabase::save(const std::filesystem::path& filename) const
+{
+  std::ofstream file(filename);
+  if(!file)
+  {
+    LOGE("Could not write %s\n", filename.string().c_str());
+    return false;
+  }
+  file << toJson().dump(2);
+  return bool(file);
+}
+
+void ProfileDatabase::record(const std::string& device, const std::string& driver, const ProfilePoint& point)
+{
+  auto entry = std::find_if(m_devices.begin(), m_devices.end(),
+                            [&](const ProfileDevice& d) { return d.device == device && d.driver == driver; });
+  if(entry == m_devices.end())
+  {
+    entry = m_devices.insert(m_devices.end(), ProfileDevice{.device = device, .driver = driver});
+  }
+  auto existing = std::find_if(entry->points.begin(), entry->points.end(),
+                               [&](const ProfilePoint& p) { return p.config == point.config; });
+  if(existing != entry->points.end())
+  {
+    *existing = point;
+  }
+  else
+  {
+    entry->points.push_back(point);
+  }
+}
+
+const ProfileDevice* ProfileDatabase::find(const std::string& device, const std::string& driver) const
+{
+  const ProfileDevice* fallback = nullptr;
+  for(const ProfileDevice& entry : m_devices)
+  {
+    if(entry.device != device)
+    {
+      continue;
+    }
+    if(entry.driver == driver)
+    {
+      return &entry;
+    }
+    fallback = &entry;
+  }
+  return fallback;
+}
+
+nlohmann::json ProfileDatabase::toJson() const
+{
+  nlohmann::json devices = nlohmann::json::array();
+  for(const ProfileDevice& entry : m_devices)
+  {
+    nlohmann::json points = nlohmann::json::array();
+    for(const ProfilePoint& point : entry.points)
+    {
+      points.push_back(pointToJson(point));
+    }
+    devices.push_back({{"device", entry.device}, {"driver", entry.driver}, {"points", points}});
+  }
+  return {{"version", kVersion}, {"devices", devices}};
+}
+
+bool ProfileDatabase::fromJson(const nlohmann::json& json)
+{
+  m_devices.clear();
+  if(!json.is_object() || json.value("version", 0) != kVersion || !json.contains("devices") || !json["devices"].is_array())
+  {
+    return false;
+  }
+  for(const nlohmann::json& device : json["devices"])
+  {
+    if(!device.is_object() || !device.contains("points") || !device["points"].is_array())
+    {
+      return false;
+    }
+    ProfileDevice& entry = m_devices.emplace_back();
+    entry.device         = device.value("device", "");
+    entry.driver         = device.value("driver", "");
+    for(const nlohmann::json& point : device["points"])
+    {
+      if(!pointFromJson(point, entry.points.emplace_back()))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+std::optional<double> ProfileDatabase::estimateMs(std::span<const ProfilePoint> points, int quality, int preset, int maxDepth, glm::uvec2 outputSize)
+{
+  // Along the resolution for every measured depth, then along the depth
+  std::map<int, std::vector<std::pair<double, double>>> byDepth;
+  for(const ProfilePoint& point : points)
+  {
+    if(point.config.quality == quality && point.config.preset == preset)
+    {
+      const glm::uvec2 size = point.config.outputSize;
+      byDepth[point.config.maxDepth].emplace_back(double(size.x) * size.y, point.frameMs);
+    }
+  }
+
+  const double                           pixels = double(outputSize.x) * outputSize.y;
+  std::vector<std::pair<double, double>> depths;
+  for(auto& [depth, samples] : byDepth)
+  {
+    if(std::optional<double> ms = interpolate(std::move(samples), pixels, true))
+    {
+      depths.emplace_back(double(depth), *ms);
+    }
+  }
+  return interpolate(std::move(depths), double(maxDepth), false);
+}
+
+std::optional<ProfileConfig> ProfileDatabase::choose(std::span<const ProfilePoint> points, glm::uvec2 outputSize, double targetMs)
+{
+  std::optional<ProfileConfig> best, cheapest;
+  int                          bestScore = 0;
+  double                       bestMs = 0.0, cheapestMs = 0.0;
+  for(int rank = 0; rank < int(std::size(kQualities)); ++rank)
+  {
+    for(int depth = kMinDepth; depth <= kMaxDepth; ++depth)
+    {
+      for(int preset : kPresets)
+      {
+        const std::optional<double> ms = estimateMs(points, kQualities[rank], preset, depth, outputSize);
+        if(!ms)
+        {
+          continue;
+        }
+        const ProfileConfig config{.quality = kQualities[rank], .preset = preset, .maxDepth = depth, .outputSize = outputSize};
+        if(!cheapest || *ms < cheapestMs)
+        {
+          cheapest   = config;
+          cheapestMs = *ms;
+        }
+        // A quality mode is worth two bounces
+        const int score = rank * 2 + (kMaxDepth - depth);
+        if(*ms <= targetMs && (!best || score < bestScore || (score == bestScore && *ms < bestMs)))
+        {
+          best      = config;
+          bestScore = score;
+          bestMs    = *ms;
+        }
+      }
+    }
+  }
+  return best ? best : cheapest;
+}
+
+std::vector<ProfileConfig> ProfileDatabase::sweepConfigs()
+{
+  const glm::uvec2 sizes[]  = {{1280, 720}, {1920, 1080}, {2560, 1440}, {3840, 2160}};
+  const int        depths[] = {kMinDepth, kMaxDepth};
+
+  std::vector<ProfileConfig> configs;
+  for(glm::uvec2 size : sizes)
+  {
+    for(int quality : kQualities)
+    {
+      for(int preset : kPresets)
+      {
+        for(int depth : depths)
+        {
+          configs.push_back({.quality = quality, .preset = preset, .maxDepth = depth, .outputSize = size});
+        }
+      }
+    }
+  }
+  return configs;
+}
+
+bool ProfileDatabase::selfTest()
+{
+  // Synthetic costs: a fixed part plus the render pixels (a fraction of the output per quality) times the depth.
+  // Linear in the pixels and in the depth, so the interpolation must be exact between the measured points.
+  auto renderScale = [](int quality) {
+    switch(quality)
+    {
+      case 5:
+        return 1.0;
+      case 2:
+        return 0.44;
+      case 1:
+        return 0.34;
+      case 0:
+        return 0.25;
+      default:
+        return 0.11;
+    }
+  };
+  auto model = [&](int quality, int preset, int depth, glm::uvec2 size) {
+    return 0.3 + 0.1 * (preset == 0 ? 0 : 1) + double(size.x) * size.y * 1e-6 * (0.5 + renderScale(quality) * (0.4 + 0.3 * depth));
+  };
+
+  const glm::uvec2 measured[] = {{1280, 720}, {2560, 1440}, {3840, 2160}};
+  ProfileDatabase  database;
+  for(glm::uvec2 size : measured)
+  {
+    for(int quality : kQualities)
+    {
+      for(int preset : kPresets)
+      {
+        for(int depth : {kMinDepth, kMaxDepth})
+        {
+          ProfilePoint point{.config = {.quality = quality, .preset = preset, .maxDepth = depth, .outputSize = size}};
+          point.frameMs = model(quality, preset, depth, size);
+          point.passMs  = {{"raytrace", point.frameMs * 0.8}, {"denoise", point.frameMs * 0.2}};
+          database.record("Synthetic GPU", "1.0", point);
+        }
+      }
+    }
+  }
+  database.record("Synthetic GPU", "2.0", {.config = {.outputSize = {1920, 1080}}, .frameMs = 1.0});
+  database.record("Synthetic GPU", "1.0", {.config = {.outputSize = {1280, 720}}, .frameMs = model(2, 0, 5, {1280, 720})});
+
+  // Save and load, and the driver fallback
+  const std::filesystem::path file = std::filesystem::temp_directory_path() / "dlss_rr_profile_selftest.json";
+  ProfileDatabase             loaded;
+  const bool roundTrip = database.save(file) && loaded.load(file) && loaded.toJson() == database.toJson();
+  const ProfileDevice* exact    = loaded.find("Synthetic GPU", "1.0");
+  const ProfileDevice* fallback = loaded.find("Synthetic GPU", "3.0");
+  const bool lookup = exact && exact->driver == "1.0" && exact->points.size() == std::size(measured) * 5 * 3 * 2 && fallback
+                      && fallback->driver == "2.0" && loaded.find("Other GPU", "1.0") == nullptr;
+  if(!exact)
+  {
+    return false;
+  }
+
+  // Between measured resolutions and depths, and beyond them
+  double maxError = 0.0;
+  for(glm::uvec2 size : {glm::uvec2(1920, 1080), glm::uvec2(3000, 2000), glm::uvec2(1280, 720)})
+  {
+    for(int quality : kQualities)
+    {
+      for(int depth = 1; depth <= 8; ++depth)
+      {
+        const double expected = model(quality, 4, depth, size);
+        const double estimate = estimateMs(exact->points, quality, 4, depth, size).value_or(-1.0);
+        maxError              = std::max(maxError, std::abs(estimate - expected) / expected);
+      }
+    }
+  }
+  const double beyond       = estimateMs(exact->points, 2, 0, 5, {7680, 4320}).value_or(-1.0);
+  const bool   proportional = std::abs(beyond - model(2, 0, 5, {3840, 2160}) * 4.0) < 1e-9;
+  const bool   unknown      = !estimateMs(exact->points, 4, 0, 5, {1920, 1080});  // UltraQuality was never measured
+
+  // The best configuration within the target, the cheapest one when nothing meets it
+  const glm::uvec2 size = {1920, 1080};
+  const double     dlaa = model(5, 0, 5, size);
+  auto chosen = [&](double targetMs, int quality, int preset, int depth) {
+    const std::optional<ProfileConfig> config = choose(exact->points, size, targetMs);
+    return config && *config == ProfileConfig{.quality = quality, .preset = preset, .maxDepth = depth, .outputSize = size};
+  };
+  const bool choice = chosen(100.0, 5, 0, 5) && chosen(dlaa - 1e-6, 5, 0, 4) && chosen(model(2, 0, 5, size) + 1e-9, 2, 0, 5)
+                      && chosen(0.0, 3, 0, kMinDepth);
+
+  const bool passed = roundTrip && lookup && maxError < 1e-9 && proportional && unknown && choice;
+  LOGI("Profile database self test %s: save and load %s, lookup %s, max relative interpolation error %.2e, "
+       "extrapolation %s, unmeasured quality %s, choice %s\n",
+       passed ? "passed" : "FAILED", roundTrip ? "identical" : "differs", lookup ? "correct" : "wrong", maxError,
+       proportional ? "proportional" : "wrong", unknown ? "refused" : "estimated", choice ? "correct" : "wrong");
+  return passed;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <glm/glm.hpp>
+#include <tinygltf/json.hpp>
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace nvutils {
+class ParameterRegistry;
+}
+
+
+// Settings the defaults are chosen among. Quality and preset hold the NGX enum values
+// (NVSDK_NGX_PerfQuality_Value, NVSDK_NGX_RayReconstruction_Hint_Render_Preset), so that this stays free of NGX.
+struct ProfileConfig
+{
+  int        quality  = 2;  // MaxQuality
+  int        preset   = 0;  // Default
+  int        maxDepth = 5;
+  glm::uvec2 outputSize{0};
+
+  bool operator==(const ProfileConfig&) const = default;
+};
+
+// GPU costs measured by a benchmark run of one configuration
+struct ProfilePoint
+{
+  ProfileConfig                 config;
+  double                        frameMs = 0.0;  // sum of the passes
+  std::map<std::string, double> passMs;         // average per pass
+};
+
+// Points measured on one device with one driver
+struct ProfileDevice
+{
+  std::string               device;
+  std::string               driver;
+  std::vector<ProfilePoint> points;
+};
+
+
+// ProfileDatabase keeps the measured costs per GPU and driver in a JSON file. The benchmark adds the point of the
+// configuration it ran, the sweep runs it for every quality, preset, resolution and depth in sweepConfigs(). At
+// startup, choose() picks the best configuration estimated to render the output size within a target frame time.
+class ProfileDatabase
+{
+public:
+  struct Settings
+  {
+    std::filesystem::path file;              // empty: disabled
+    float                 targetMs = 0.0f;   // > 0: choose the defaults meeting it at startup
+    bool                  sweep    = false;  // benchmark all sweepConfigs() into 'file'
+    bool                  selfTest = false;
+  };
+
+  // Registers the --profile* options
+  static void registerParameters(nvutils::ParameterRegistry& registry, Settings& settings);
+
+  // A missing file is an empty database; false when the file can't be parsed
+  bool load(const std::filesystem::path& filename);
+  bool save(const std::filesystem::path& filename) const;
+
+  // Adds 'point', replacing one with the same configuration
+  void record(const std::string& device, const std::string& driver, const ProfilePoint& point);
+
+  // Points of 'device' with 'driver'; without those, the ones of the last driver recorded for the device, since
+  // costs barely move between drivers. nullptr for an unknown device.
+  const ProfileDevice* find(const std::string& device, const std::string& driver) const;
+
+  nlohmann::json toJson() const;
+  bool           fromJson(const nlohmann::json& json);
+
+  // Frame time of 'quality' and 'preset' at 'maxDepth' and 'outputSize', interpolated linearly in the pixel count
+  // between the measured resolutions (proportionally beyond them), then linearly between the measured depths
+  // (extrapolated from the nearest two). Empty without measurements to estimate from.
+  static std::optional<double> estimateMs(std::span<const ProfilePoint> points, int quality, int preset, int maxDepth, glm::uvec2 outputSize);
+
+  // The best configuration for 'outputSize' estimated within 'targetMs': a quality mode counts as much as two bounces
+  // of path depth, up to the shipped depth of 5; ties go to the cheaper one. The cheapest configuration when none
+  // meets the target, empty without measurements.
+  static std::optional<ProfileConfig> choose(std::span<const ProfilePoint> points, glm::uvec2 outputSize, double targetMs);
+
+  // Configurations the sweep measures
+  static std::vector<ProfileConfig> sweepConfigs();
+
+  // Checks save and load, the driver fallback, the interpolation against a synthetic cost model and the choice
+  static bool selfTest();
+
+private:
+  std::vector<ProfileDevice> m_devices;
+};
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "readback_ring.hpp"
+
+#include <nvvk/check_error.hpp>
+#include <nvvk/debug_util.hpp>
+
+#include <cassert>
+
+
+ReadbackRing::~ReadbackRing()
+{
+  assert(m_buffers.empty() && "Must call deinit");
+}
+
+void ReadbackRing::init(nvvk::ResourceAllocator* alloc, VkDeviceSize size, uint32_t ringSize)
+{
+  assert(m_buffers.empty() && "Init already called");
+  assert(size > 0 && ringSize > 0);
+
+  m_alloc = alloc;
+  m_size  = size;
+  m_buffers.resize(ringSize);
+  m_written.assign(ringSize, false);
+
+  for(nvvk::Buffer& buffer : m_buffers)
+  {
+    NVVK_CHECK(m_alloc->createBuffer(buffer, m_size, VK_BUFFER_USAGE_2_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+                                     VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT));
+    NVVK_DBG_NAME(buffer.buffer);
+  }
+}
+
+void ReadbackRing::deinit()
+{
+  for(nvvk::Buffer& buffer : m_buffers)
+  {
+    m_alloc->destroyBuffer(buffer);
+  }
+  m_buffers.clear();
+  m_written.clear();
+  m_size = 0;
+}
+
+void ReadbackRing::cmdCopy(VkCommandBuffer cmd, VkBuffer src, uint32_t slot, VkDeviceSize srcOffset)
+{
+  // The slot of the frame still holds the results of the frame that used it before
+  if(slot == kReplaySlot)
+  {
+    return;
+  }
+  assert(slot < m_buffers.size());
+
+  const VkBufferCopy region{.srcOffset = srcOffset, .dstOffset = 0, .size = m_size};
+  vkCmdCopyBuffer(cmd, src, m_buffers[slot].buffer, 1, &region);
+
+  // Make the copy visible to the host once the frame's fence is signaled
+  const VkMemoryBarrier2 barrier{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                 .srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                 .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                 .dstStageMask  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                 .dstAccessMask = VK_ACCESS_2_HOST_READ_BIT};
+  const VkDependencyInfo depInfo{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &barrier};
+  vkCmdPipelineBarrier2(cmd, &depInfo);
+
+  m_written[slot] = true;
+}
+
+const void* ReadbackRing::map(uint32_t slot) const
+{
+  assert(slot < m_buffers.size());
+  if(!m_written[slot])
+  {
+    return nullptr;
+  }
+
+  // HOST_ACCESS_RANDOM may end up in non-coherent memory
+  NVVK_CHECK(vmaInvalidateAllocation(*m_alloc, m_buffers[slot].allocation, 0, VK_WHOLE_SIZE));
+  return m_buffers[slot].mapping;
+}
+
+void ReadbackRing::consume(uint32_t slot)
+{
+  assert(slot < m_buffers.size());
+  m_written[slot] = false;
+}
+
+void ReadbackRing::invalidate()
+{
+  m_written.assign(m_written.size(), false);
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <nvvk/resource_allocator.hpp>
+
+#include <vector>
+
+
+// ReadbackRing copies a device buffer into one of several host visible buffers, one per frame in flight.
+// The copy recorded in frame N is read back when the same ring slot comes around again, at which point
+// the application has already waited for the frame's fence. Reading back never stalls the GPU.
+class ReadbackRing
+{
+public:
+  ReadbackRing() = default;
+  ~ReadbackRing();
+
+  // 'ringSize' should be the number of frames in flight (nvapp::Application::getFrameCycleSize())
+  void init(nvvk::ResourceAllocator* alloc, VkDeviceSize size, uint32_t ringSize);
+  void deinit();
+
+  // Slot of recordings whose results are never read, such as the replays of a frame for its counters
+  static constexpr uint32_t kReplaySlot = ~0u;
+
+  // Copies 'size()' bytes of 'src' into the ring slot 'slot'. Records nothing for kReplaySlot.
+  void cmdCopy(VkCommandBuffer cmd, VkBuffer src, uint32_t slot, VkDeviceSize srcOffset = 0);
+
+  // Returns the data copied into 'slot' the last time, or nullptr if nothing was copied into it yet.
+  // Must be called before cmdCopy() on the same slot in the current frame.
+  const void* map(uint32_t slot) const;
+
+  template <typename T>
+  const T* map(uint32_t slot) const
+  {
+    return reinterpret_cast<const T*>(map(slot));
+  }
+
+  // Marks the copy in 'slot' as read: map() returns nullptr until the next cmdCopy() into it. For results that are
+  // accumulated, so that a slot is never added twice.
+  void consume(uint32_t slot);
+
+  // Forget all pending copies, e.g. after the layout of the source changed
+  void invalidate();
+
+  VkDeviceSize size() const { return m_size; }
+  uint32_t     ringSize() const { return uint32_t(m_buffers.size()); }
+
+private:
+  nvvk::ResourceAllocator*  m_alloc = nullptr;
+  VkDeviceSize              m_size  = 0;
+  std::vector<nvvk::Buffer> m_buffers;
+  std::vector<bool>         m_written;
+};
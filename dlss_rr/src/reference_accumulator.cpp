@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "reference_accumulator.hpp"
+
+#include <nvutils/logger.hpp>
+#include <nvvk/check_error.hpp>
+#include <nvvk/debug_util.hpp>
+#include <nvvk/descriptors.hpp>
+#include <nvvk/pipeline.hpp>
+#include <nvvk/shaders.hpp>
+
+#include "image_readback.hpp"
+#include "shaders/host_device.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iterator>
+
+
+ReferenceAccumulator::~ReferenceAccumulator()
+{
+  assert(m_pipeline == VK_NULL_HANDLE && "Must call deinit");
+}
+
+void ReferenceAccumulator::init(nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv, const ReferenceCoordinator::Settings& settings)
+{
+  assert(m_pipeline == VK_NULL_HANDLE && "Init already called");
+
+  m_alloc  = alloc;
+  m_device = alloc->getDevice();
+  if(settings.isWorker())
+  {
+    m_range = {uint32_t(settings.firstFrame), uint32_t(settings.firstFrame + settings.frames)};
+  }
+  m_output           = settings.output;
+  m_checkpointFile   = std::filesystem::path(settings.output).replace_extension(".ckpt");
+  m_checkpointFrames = uint32_t(std::max(settings.checkpointFrames, 0));
+  m_resume           = settings.resume;
+
+  nvvk::DescriptorBindings bindings;
+  bindings.addBinding(shaderio::ReferenceBindings::eReferenceColor, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+  bindings.addBinding(shaderio::ReferenceBindings::eReferenceSum, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+  NVVK_CHECK(bindings.createDescriptorSetLayout(m_device, VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR, &m_dsetLayout));
+  NVVK_DBG_NAME(m_dsetLayout);
+
+  const VkPushConstantRange pushConstant{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(shaderio::ReferencePushConstant)};
+  NVVK_CHECK(nvvk::createPipelineLayout(m_device, &m_pipelineLayout, {m_dsetLayout}, {pushConstant}));
+  NVVK_DBG_NAME(m_pipelineLayout);
+
+  VkShaderModule module = VK_NULL_HANDLE;
+  NVVK_CHECK(nvvk::createShaderModule(module, m_device, spirv));
+
+  const VkComputePipelineCreateInfo pipelineInfo{
+      .sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+      .stage  = {.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, .stage = VK_SHADER_STAGE_COMPUTE_BIT, .module = module, .pName = "accumulateMain"},
+      .layout = m_pipelineLayout,
+  };
+  NVVK_CHECK(vkCreateComputePipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipeline));
+  NVVK_DBG_NAME(m_pipeline);
+
+  vkDestroyShaderModule(m_device, module, nullptr);
+}
+
+void ReferenceAccumulator::deinit()
+{
+  // The writer reads from the staging buffer
+  m_writer.wait();
+
+  vkDestroyPipeline(m_device, m_pipeline, nullptr);
+  vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
+  vkDestroyDescriptorSetLayout(m_device, m_dsetLayout, nullptr);
+  m_pipeline       = VK_NULL_HANDLE;
+  m_pipelineLayout = VK_NULL_HANDLE;
+  m_dsetLayout     = VK_NULL_HANDLE;
+
+  m_alloc->destroyBuffer(m_sum);
+  m_alloc->destroyBuffer(m_staging);
+}
+
+void ReferenceAccumulator::resize(VkExtent2D maxSize)
+{
+  m_writer.wait();
+  m_alloc->destroyBuffer(m_sum);
+  m_alloc->destroyBuffer(m_staging);
+  m_copyPending = false;
+
+  // Cleared, or filled from the checkpoint, by the first accumulation
+  const VkDeviceSize bytes = VkDeviceSize(maxSize.width) * maxSize.height * sizeof(glm::vec4);
+  NVVK_CHECK(m_alloc->createBuffer(m_sum, bytes,
+                                   VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_2_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_2_TRANSFER_DST_BIT));
+  NVVK_DBG_NAME(m_sum.buffer);
+  if(m_checkpointFrames > 0 || m_resume)
+  {
+    NVVK_CHECK(m_alloc->createBuffer(m_staging, bytes, VK_BUFFER_USAGE_2_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_2_TRANSFER_DST_BIT,
+                                     VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+                                     VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT));
+    NVVK_DBG_NAME(m_staging.buffer);
+  }
+
+  // The frame index to continue from is needed before the first accumulation, which checks the rest of the checkpoint
+  m_accumulated   = 0;
+  m_resumePending = false;
+  if(m_resume && readCheckpoint(m_checkpointFile, m_resumeCheckpoint, m_resumeSums))
+  {
+    if(m_resumeCheckpoint.range.begin == m_range.begin && m_resumeCheckpoint.range.end == m_range.end
+       && m_resumeCheckpoint.accumulated < m_range.count() && m_resumeSums.size() * sizeof(glm::vec4) <= bytes)
+    {
+      m_accumulated   = m_resumeCheckpoint.accumulated;
+      m_resumePending = true;
+    }
+    else
+    {
+      LOGW("%s is of another range, starting over\n", m_checkpointFile.string().c_str());
+    }
+  }
+}
+
+void ReferenceAccumulator::collectCheckpoint(uint32_t cycleIndex)
+{
+  if(!m_copyPending || cycleIndex != m_copyCycle)
+  {
+    return;
+  }
+  m_copyPending = false;
+
+  // The fence of the frame that copied the sums was waited for
+  NVVK_CHECK(vmaInvalidateAllocation(*m_alloc, m_staging.allocation, 0, VK_WHOLE_SIZE));
+  const size_t pixels = size_t(m_copyCheckpoint.width) * m_copyCheckpoint.height;
+  m_writer.write(m_checkpointFile, m_copyCheckpoint, {static_cast<const glm::vec4*>(m_staging.mapping), pixels});
+  LOGI("Reference checkpoint at frame %u (last write %.1f ms)\n", m_copyCheckpoint.nextFrame(), m_writer.lastWriteMs());
+}
+
+void ReferenceAccumulator::cmdAccumulate(VkCommandBuffer cmd, const VkDescriptorImageInfo& color, VkExtent2D size,
+                                         const std::string& key, uint32_t cycleIndex)
+{
+  assert(!isComplete());
+
+  const VkDeviceSize bytes = VkDeviceSize(size.width) * size.height * sizeof(glm::vec4);
+  if(m_resumePending)
+  {
+    m_resumePending = false;
+    if(m_resumeCheckpoint.key != key || m_resumeCheckpoint.width != size.width || m_resumeCheckpoint.height != size.height)
+    {
+      // This frame rendered the checkpoint's frame index; the range starts over with the next one
+      LOGW("%s was rendered with other settings (%s), starting over\n", m_checkpointFile.string().c_str(),
+           m_resumeCheckpoint.key.c_str());
+      m_accumulated = 0;
+      m_resumeSums  = {};
+      return;
+    }
+    memcpy(m_staging.mapping, m_resumeSums.data(), bytes);
+    NVVK_CHECK(vmaFlushAllocation(*m_alloc, m_staging.allocation, 0, VK_WHOLE_SIZE));
+    const VkBufferCopy region{.size = bytes};
+    vkCmdCopyBuffer(cmd, m_staging.buffer, m_sum.buffer, 1, &region);
+    m_resumeSums = {};
+    m_size       = size;
+    m_key        = key;
+    LOGI("Reference resumed at frame %u of %u..%u\n", frameIndex(), m_range.begin, m_range.end);
+  }
+  else if(m_accumulated == 0)
+  {
+    vkCmdFillBuffer(cmd, m_sum.buffer, 0, VK_WHOLE_SIZE, 0);
+    m_size = size;
+    m_key  = key;
+  }
+  assert(size.width == m_size.width && size.height == m_size.height && "Render size changed during the range");
+
+  // Clear, upload or previous accumulation done
+  const VkMemoryBarrier2 before{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                .srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_WRITE_BIT,
+                                .dstStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                .dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT};
+  const VkDependencyInfo depBefore{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &before};
+  vkCmdPipelineBarrier2(cmd, &depBefore);
+
+  const VkDescriptorBufferInfo sumInfo{m_sum.buffer, 0, VK_WHOLE_SIZE};
+  const VkWriteDescriptorSet   writes[] = {
+      {.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+         .dstBinding      = shaderio::ReferenceBindings::eReferenceColor,
+         .descriptorCount = 1,
+         .descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+         .pImageInfo      = &color},
+      {.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+         .dstBinding      = shaderio::ReferenceBindings::eReferenceSum,
+         .descriptorCount = 1,
+         .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+         .pBufferInfo     = &sumInfo},
+  };
+  vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+  vkCmdPushDescriptorSetKHR(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, uint32_t(std::size(writes)), writes);
+  const shaderio::ReferencePushConstant pushConst{.size = {int32_t(size.width), int32_t(size.height)}};
+  vkCmdPushConstants(cmd, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConst), &pushConst);
+  const VkExtent2D groups = getGridSize(size);
+  vkCmdDispatch(cmd, groups.width, groups.height, 1);
+
+  m_accumulated++;
+
+  // Checkpoint: copy within the frame, written once the frame is done. Skipped while the last one is being written.
+  if(m_checkpointFrames == 0 || m_accumulated % m_checkpointFrames != 0 || isComplete() || m_copyPending || m_writer.busy())
+  {
+    return;
+  }
+  const VkMemoryBarrier2 toCopy{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                .srcStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                .srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT,
+                                .dstStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                .dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT};
+  const VkDependencyInfo depToCopy{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &toCopy};
+  vkCmdPipelineBarrier2(cmd, &depToCopy);
+
+  const VkBufferCopy region{.size = bytes};
+  vkCmdCopyBuffer(cmd, m_sum.buffer, m_staging.buffer, 1, &region);
+
+  const VkMemoryBarrier2 toHost{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                .srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                .dstStageMask  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                .dstAccessMask = VK_ACCESS_2_HOST_READ_BIT};
+  const VkDependencyInfo depToHost{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &toHost};
+  vkCmdPipelineBarrier2(cmd, &depToHost);
+
+  m_copyPending    = true;
+  m_copyCycle      = cycleIndex;
+  m_copyCheckpoint = {.range = m_range, .accumulated = m_accumulated, .width = size.width, .height = size.height, .key = key};
+}
+
+bool ReferenceAccumulator::writePartial(nvapp::Application* app)
+{
+  assert(isComplete());
+
+  const size_t               pixels = size_t(m_size.width) * m_size.height;
+  const std::vector<uint8_t> data   = downloadBuffer(app, m_alloc, m_sum.buffer, pixels * sizeof(glm::vec4));
+
+  ReferencePartial partial{.width = m_size.width, .height = m_size.height, .frames = m_range, .key = m_key};
+  partial.sum.resize(pixels);
+  for(size_t i = 0; i < pixels; ++i)
+  {
+    glm::vec4 sum;
+    memcpy(&sum, data.data() + i * sizeof(glm::vec4), sizeof(sum));
+    partial.sum[i] = glm::dvec4(sum);
+  }
+  if(!partial.write(m_output))
+  {
+    return false;
+  }
+  LOGI("Reference frames %u..%u of %ux%u written to %s\n", m_range.begin, m_range.end, m_size.width, m_size.height,
+       m_output.string().c_str());
+
+  // The partial supersedes the checkpoint
+  m_writer.wait();
+  std::filesystem::remove(m_checkpointFile);
+  return true;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <nvvk/resource_allocator.hpp>
+
+#include "reference_checkpoint.hpp"
+#include "reference_coordinator.hpp"
+
+#include <span>
+#include <string>
+
+namespace nvapp {
+class Application;
+}
+
+
+// ReferenceAccumulator is the worker side of ReferenceCoordinator: the sample renders the frame indices of its range,
+// one per frame, and reference_accum.slang adds each frame's noisy color to a per pixel sum. After the last frame the
+// sums are downloaded and written as a ReferencePartial, and the sample exits.
+// Every 'checkpointFrames' the sums are copied to a host visible buffer within the frame's commands; once the frame's
+// fence was waited for, a CheckpointWriter writes them from there on its own thread, so checkpoints never stall a
+// frame. A resumed worker uploads the sums of its checkpoint and continues with the next frame index.
+class ReferenceAccumulator
+{
+public:
+  ReferenceAccumulator() = default;
+  ~ReferenceAccumulator();
+
+  // Active with the range of a worker in 'settings'
+  void init(nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv, const ReferenceCoordinator::Settings& settings);
+  void deinit();
+
+  // (Re)creates the sums for the maximum render size and restarts the range, from the checkpoint when resuming
+  void resize(VkExtent2D maxSize);
+
+  bool isActive() const { return m_range.count() > 0; }
+  // Frame index of the next accumulated frame
+  uint32_t frameIndex() const { return m_range.begin + m_accumulated; }
+  // All frames accumulated; the last one's commands are submitted by the next frame
+  bool isComplete() const { return isActive() && m_accumulated == m_range.count(); }
+
+  // Call at the start of a frame: hands a checkpoint copied when 'cycleIndex' was last used to the writer
+  void collectCheckpoint(uint32_t cycleIndex);
+
+  // Adds the frame's noisy 'color' (in VK_IMAGE_LAYOUT_GENERAL, readable by compute) of 'size' pixels.
+  // 'key' identifies the scene and settings; a checkpoint with another one isn't resumed.
+  void cmdAccumulate(VkCommandBuffer cmd, const VkDescriptorImageInfo& color, VkExtent2D size, const std::string& key, uint32_t cycleIndex);
+
+  // Downloads the sums, waiting for the GPU, and writes them; the checkpoint is removed then
+  bool writePartial(nvapp::Application* app);
+
+private:
+  nvvk::ResourceAllocator* m_alloc          = nullptr;
+  VkDevice                 m_device         = VK_NULL_HANDLE;
+  VkDescriptorSetLayout    m_dsetLayout     = VK_NULL_HANDLE;
+  VkPipelineLayout         m_pipelineLayout = VK_NULL_HANDLE;
+  VkPipeline               m_pipeline       = VK_NULL_HANDLE;
+  nvvk::Buffer             m_sum;      // float4 per pixel: rgb sum, samples
+  nvvk::Buffer             m_staging;  // host visible copy of m_sum, for checkpoints and resuming
+
+  FrameRange            m_range;
+  std::filesystem::path m_output;
+  std::filesystem::path m_checkpointFile;
+  uint32_t              m_checkpointFrames = 0;
+  bool                  m_resume           = false;
+  VkExtent2D            m_size{};  // rendered region, the same for the whole range
+  std::string           m_key;
+  uint32_t              m_accumulated = 0;
+
+  // Checkpoint of the sums in m_staging, until the frame that copied them is done
+  bool                m_copyPending = false;
+  uint32_t            m_copyCycle   = 0;
+  ReferenceCheckpoint m_copyCheckpoint;
+  CheckpointWriter    m_writer;
+
+  // Loaded by resize(), uploaded by the first accumulation
+  bool                   m_resumePending = false;
+  ReferenceCheckpoint    m_resumeCheckpoint;
+  std::vector<glm::vec4> m_resumeSums;
+};
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "reference_checkpoint.hpp"
+
+#include <nvutils/logger.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+
+namespace {
+
+struct FileHeader
+{
+  char     magic[8]    = {'R', 'E', 'F', 'C', 'K', 'P', 'T', '\0'};
+  uint32_t version     = 1;
+  uint32_t rangeBegin  = 0;
+  uint32_t rangeEnd    = 0;
+  uint32_t accumulated = 0;
+  uint32_t width       = 0;
+  uint32_t height      = 0;
+  uint32_t keyLength   = 0;
+  uint32_t pad0        = 0;
+  uint64_t checksum    = 0;  // FNV-1a of the key and the sums
+};
+
+uint64_t fnv1a(uint64_t hash, const void* data, size_t size)
+{
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for(size_t i = 0; i < size; ++i)
+  {
+    hash = (hash ^ bytes[i]) * 1099511628211ull;
+  }
+  return hash;
+}
+
+uint64_t checksum(const std::string& key, std::span<const glm::vec4> sums)
+{
+  const uint64_t hash = fnv1a(14695981039346656037ull, key.data(), key.size());
+  return fnv1a(hash, sums.data(), sums.size_bytes());
+}
+
+}  // namespace
+
+
+bool writeCheckpoint(const std::filesystem::path& filename, const ReferenceCheckpoint& checkpoint, std::span<const glm::vec4> sums)
+{
+  FileHeader header;
+  header.rangeBegin  = checkpoint.range.begin;
+  header.rangeEnd    = checkpoint.range.end;
+  header.accumulated = checkpoint.accumulated;
+  header.width       = checkpoint.width;
+  header.height      = checkpoint.height;
+  header.keyLength   = uint32_t(checkpoint.key.size());
+  header.checksum    = checksum(checkpoint.key, sums);
+
+  std::filesystem::path temporary = filename;
+  temporary += ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(checkpoint.key.data(), checkpoint.key.size());
+    file.write(reinterpret_cast<const char*>(sums.data()), sums.size_bytes());
+    if(!file)
+    {
+      LOGE("Could not write %s\n", temporary.string().c_str());
+      return false;
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temporary, filename, error);
+  if(error)
+  {
+    LOGE("Could not replace %s: %s\n", filename.string().c_str(), error.message().c_str());
+    return false;
+  }
+  return true;
+}
+
+bool readCheckpoint(const std::filesystem::path& filename, ReferenceCheckpoint& checkpoint, std::vector<glm::vec4>& sums)
+{
+  std::ifstream file(filename, std::ios::binary);
+  FileHeader    header;
+  file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if(!file || memcmp(header.magic, FileHeader().magic, sizeof(header.magic)) != 0 || header.version != FileHeader().version)
+  {
+    return false;
+  }
+  checkpoint.range       = {header.rangeBegin, header.rangeEnd};
+  checkpoint.accumulated = header.accumulated;
+  checkpoint.width       = header.width;
+  checkpoint.height      = header.height;
+  checkpoint.key.resize(header.keyLength);
+  file.read(checkpoint.key.data(), checkpoint.key.size());
+  sums.resize(size_t(header.width) * header.height);
+  file.read(reinterpret_cast<char*>(sums.data()), sums.size() * sizeof(glm::vec4));
+  if(!file || checksum(checkpoint.key, sums) != header.checksum)
+  {
+    LOGW("%s is truncated or corrupted\n", filename.string().c_str());
+    return false;
+  }
+  return true;
+}
+
+bool CheckpointWriter::write(const std::filesystem::path& filename, const ReferenceCheckpoint& checkpoint, std::span<const glm::vec4> sums)
+{
+  if(m_busy)
+  {
+    return false;
+  }
+  wait();  // joins the finished thread
+
+  m_busy   = true;
+  m_thread = std::thread([this, filename, checkpoint, sums] {
+    const auto start = std::chrono::steady_clock::now();
+    if(writeCheckpoint(filename, checkpoint, sums))
+    {
+      m_written++;
+    }
+    else
+    {
+      m_failed++;
+    }
+    m_lastWriteMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    m_busy        = false;
+  });
+  return true;
+}
+
+void CheckpointWriter::wait()
+{
+  if(m_thread.joinable())
+  {
+    m_thread.join();
+  }
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "reference_coordinator.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// State of a reference worker after 'accumulated' frames of its range. The ray generation draws its random numbers
+// from xxhash32(pixel, frame), so the next frame index is the whole RNG state. The sums are kept in the floats the GPU
+// accumulates in, so a resumed worker continues bit-identically.
+struct ReferenceCheckpoint
+{
+  FrameRange  range;
+  uint32_t    accumulated = 0;
+  uint32_t    width       = 0;
+  uint32_t    height      = 0;
+  std::string key;  // scene and render settings, as in ReferencePartial
+
+  uint32_t nextFrame() const { return range.begin + accumulated; }
+};
+
+// Writes 'checkpoint' with the 'sums' (rgb, samples per pixel) to a temporary file renamed over 'filename', so that a
+// process dying while writing leaves the previous checkpoint intact
+bool writeCheckpoint(const std::filesystem::path& filename, const ReferenceCheckpoint& checkpoint, std::span<const glm::vec4> sums);
+// Fails on a missing, truncated or corrupted file; the payload is checksummed
+bool readCheckpoint(const std::filesystem::path& filename, ReferenceCheckpoint& checkpoint, std::vector<glm::vec4>& sums);
+
+
+// CheckpointWriter writes one checkpoint at a time on a background thread, so the render loop never waits on the disk
+class CheckpointWriter
+{
+public:
+  CheckpointWriter() = default;
+  ~CheckpointWriter() { wait(); }
+
+  // Starts writing; 'sums' must stay valid until busy() returns false. Returns false while the previous write runs.
+  bool write(const std::filesystem::path& filename, const ReferenceCheckpoint& checkpoint, std::span<const glm::vec4> sums);
+  bool busy() const { return m_busy; }
+  void wait();
+
+  uint32_t written() const { return m_written; }
+  uint32_t failed() const { return m_failed; }
+  double   lastWriteMs() const { return m_lastWriteMs; }
+
+private:
+  std::thread           m_thread;
+  std::atomic<bool>     m_busy        = false;
+  std::atomic<uint32_t> m_written     = 0;
+  std::atomic<uint32_t> m_failed      = 0;
+  std::atomic<double>   m_lastWriteMs = 0.0;
+};
@@ -0,0 +1,551 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "reference_coordinator.hpp"
+
+#include <nvutils/file_operations.hpp>
+#include <nvutils/logger.hpp>
+#include <nvutils/parameter_registry.hpp>
+
+#include "reference_checkpoint.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <thread>
+#include <utility>
+
+
+namespace {
+
+constexpr uint32_t kChunkAttempts = 2;  // a worker that crashed or lost its device gets a second try
+
+struct FileHeader
+{
+  char     magic[8]   = {'R', 'E', 'F', 'P', 'A', 'R', 'T', '\0'};
+  uint32_t version    = 1;
+  uint32_t width      = 0;
+  uint32_t height     = 0;
+  uint32_t frameBegin = 0;
+  uint32_t frameEnd   = 0;
+  uint32_t keyLength  = 0;
+};
+
+// Same as xxhash32() and rand() of nvshaders, which seed and draw the samples of the ray generation
+uint32_t xxhash32(glm::uvec3 p)
+{
+  const uint32_t primes[4] = {2246822519u, 3266489917u, 668265263u, 374761393u};
+  uint32_t       h32       = p.z + primes[3] + p.x * primes[2];
+  h32                      = primes[3] * ((h32 << 17) | (h32 >> (32 - 17)));
+  h32 += p.y * primes[2];
+  h32 = primes[3] * ((h32 << 17) | (h32 >> (32 - 17)));
+  h32 = primes[0] * (h32 ^ (h32 >> 15));
+  h32 = primes[1] * (h32 ^ (h32 >> 13));
+  return h32 ^ (h32 >> 16);
+}
+
+float rand(uint32_t& seed)
+{
+  const uint32_t state = seed * 747796405u + 2891336453u;
+  const uint32_t word  = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+  seed                 = state;
+  return float((word >> 22u) ^ word) / float(0xffffffffu);
+}
+
+// Coordinator options, not forwarded to the workers, with whether they take a value
+const std::pair<const char*, bool> kCoordinatorOptions[] = {
+    {"referenceFirstFrame", true}, {"referenceFrames", true}, {"referenceWorkers", true}, {"referenceChunks", true},
+    {"referenceOutput", true},     {"referenceMerge", true},  {"referenceSelfTest", false},
+};
+
+std::string quoted(const std::string& argument)
+{
+  return '"' + argument + '"';
+}
+
+// CPU stand-in of the ray generation and reference_accum.slang: a smooth image with noise, rare fireflies and rare
+// non-finite samples, which are dropped. Summed in floats like on the GPU; partials are merged in doubles.
+void accumulateCpu(uint32_t width, uint32_t height, FrameRange range, std::vector<glm::vec4>& sum)
+{
+  for(uint32_t frame = range.begin; frame < range.end; ++frame)
+  {
+    for(uint32_t y = 0; y < height; ++y)
+    {
+      for(uint32_t x = 0; x < width; ++x)
+      {
+        uint32_t        seed  = xxhash32({x, y, frame});
+        const float     r0    = rand(seed);
+        const float     r1    = rand(seed);
+        const float     r2    = rand(seed);
+        const glm::vec3 image = {float(x) / float(width), float(y) / float(height), 0.5f};
+        glm::vec3       color = image * 2.0f * r0 * (r1 < 1.0f / 256.0f ? 100.0f : 1.0f);
+        if(r2 < 1.0f / 64.0f)
+        {
+          color.x = std::numeric_limits<float>::quiet_NaN();
+        }
+        if(std::isfinite(color.x))
+        {
+          sum[size_t(y) * width + x] += glm::vec4(color, 1.0f);
+        }
+      }
+    }
+  }
+}
+
+bool writeMerged(const ReferencePartial& merged, const std::filesystem::path& output)
+{
+  if(!merged.write(output))
+  {
+    return false;
+  }
+  std::filesystem::path image = output;
+  image.replace_extension(".pfm");
+  if(!merged.writeImage(image))
+  {
+    return false;
+  }
+  LOGI("Reference of frames %u..%u written to %s and %s\n", merged.frames.begin, merged.frames.end,
+       output.string().c_str(), image.string().c_str());
+  return true;
+}
+
+}  // namespace
+
+
+bool ReferencePartial::write(const std::filesystem::path& filename) const
+{
+  std::ofstream file(filename, std::ios::binary);
+  if(!file)
+  {
+    LOGE("Could not write %s\n", filename.string().c_str());
+    return false;
+  }
+  FileHeader header;
+  header.width      = width;
+  header.height     = height;
+  header.frameBegin = frames.begin;
+  header.frameEnd   = frames.end;
+  header.keyLength  = uint32_t(key.size());
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(key.data(), key.size());
+  file.write(reinterpret_cast<const char*>(sum.data()), sum.size() * sizeof(glm::dvec4));
+  return bool(file);
+}
+
+bool ReferencePartial::read(const std::filesystem::path& filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  FileHeader    header;
+  file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if(!file || memcmp(header.magic, FileHeader().magic, sizeof(header.magic)) != 0 || header.version != FileHeader().version)
+  {
+    LOGE("%s is not a reference partial\n", filename.string().c_str());
+    return false;
+  }
+  width  = header.width;
+  height = header.height;
+  frames = {header.frameBegin, header.frameEnd};
+  key.resize(header.keyLength);
+  file.read(key.data(), key.size());
+  sum.resize(size_t(width) * height);
+  file.read(reinterpret_cast<char*>(sum.data()), sum.size() * sizeof(glm::dvec4));
+  if(!file)
+  {
+    LOGE("%s is truncated\n", filename.string().c_str());
+    return false;
+  }
+  return true;
+}
+
+std::vector<glm::vec4> ReferencePartial::resolve() const
+{
+  std::vector<glm::vec4> mean(sum.size(), glm::vec4(0.0f));
+  for(size_t i = 0; i < sum.size(); ++i)
+  {
+    const glm::dvec4& s = sum[i];
+    if(s.w > 0.0)
+    {
+      mean[i] = glm::vec4(glm::dvec3(s) / s.w, s.w);
+    }
+  }
+  return mean;
+}
+
+bool ReferencePartial::writeImage(const std::filesystem::path& filename) const
+{
+  std::ofstream file(filename, std::ios::binary);
+  if(!file)
+  {
+    LOGE("Could not write %s\n", filename.string().c_str());
+    return false;
+  }
+  // Negative scale: little endian. Rows go from the bottom to the top.
+  file << "PF\n" << width << " " << height << "\n-1.0\n";
+  const std::vector<glm::vec4> mean = resolve();
+  for(uint32_t y = height; y-- > 0;)
+  {
+    for(uint32_t x = 0; x < width; ++x)
+    {
+      file.write(reinterpret_cast<const char*>(&mean[size_t(y) * width + x]), sizeof(glm::vec3));
+    }
+  }
+  return bool(file);
+}
+
+std::vector<FrameRange> splitFrames(FrameRange total, uint32_t chunks)
+{
+  chunks = std::clamp(chunks, 1u, std::max(total.count(), 1u));
+  std::vector<FrameRange> ranges(chunks);
+  for(uint32_t i = 0; i < chunks; ++i)
+  {
+    ranges[i].begin = total.begin + uint32_t(uint64_t(total.count()) * i / chunks);
+    ranges[i].end   = total.begin + uint32_t(uint64_t(total.count()) * (i + 1) / chunks);
+  }
+  return ranges;
+}
+
+bool mergePartials(std::span<const ReferencePartial> partials, ReferencePartial& merged, std::string& error)
+{
+  if(partials.empty())
+  {
+    error = "no partials";
+    return false;
+  }
+
+  std::vector<const ReferencePartial*> sorted;
+  for(const ReferencePartial& p : partials)
+  {
+    sorted.push_back(&p);
+  }
+  std::sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) { return a->frames.begin < b->frames.begin; });
+
+  const ReferencePartial& first = *sorted.front();
+  merged.width                  = first.width;
+  merged.height                 = first.height;
+  merged.key                    = first.key;
+  merged.frames                 = {first.frames.begin, first.frames.begin};
+  merged.sum.assign(size_t(first.width) * first.height, glm::dvec4(0.0));
+  for(const ReferencePartial* p : sorted)
+  {
+    if(p->width != merged.width || p->height != merged.height || p->key != merged.key)
+    {
+      error = "frames " + std::to_string(p->frames.begin) + ".." + std::to_string(p->frames.end)
+              + " were rendered with other settings (" + p->key + ")";
+      return false;
+    }
+    if(p->frames.begin != merged.frames.end)
+    {
+      error = std::string(p->frames.begin < merged.frames.end ? "overlap" : "gap") + " at frame "
+              + std::to_string(std::min(p->frames.begin, merged.frames.end));
+      return false;
+    }
+    // The sample counts in w are summed with the colors, pixels weigh by the samples they got
+    for(size_t i = 0; i < merged.sum.size(); ++i)
+    {
+      merged.sum[i] += p->sum[i];
+    }
+    merged.frames.end = p->frames.end;
+  }
+  return true;
+}
+
+
+void ReferenceCoordinator::registerParameters(nvutils::ParameterRegistry& registry, Settings& settings)
+{
+  registry.add({"referenceFrames", "Accumulate a reference over this many frames, write the partial sums and exit"},
+               &settings.frames);
+  registry.add({"referenceFirstFrame", "First frame index of the reference accumulation"}, &settings.firstFrame);
+  registry.add({"referenceWorkers", "Split the reference accumulation across this many local worker processes"},
+               &settings.workers);
+  registry.add({"referenceChunks", "Frame ranges the reference accumulation is split into, 0: four per worker"}, &settings.chunks);
+  registry.add({"referenceOutput", "Partial sums of a worker, or the merged reference of the coordinator"}, &settings.output);
+  registry.add({"referenceMerge", "Merge the reference partials in this directory, e.g. rendered on other nodes"}, &settings.merge);
+  registry.add({"referenceCheckpoint", "Worker: checkpoint the accumulation every this many frames, 0 disables"},
+               &settings.checkpointFrames);
+  registry.add({"referenceResume", "Continue from the checkpoints and finished partials of an interrupted run"}, &settings.resume);
+  registry.add({"referenceSelfTest", "Check the reference splitting, merging and checkpoints with CPU stand-in workers"},
+               &settings.selfTest);
+}
+
+int ReferenceCoordinator::run(const Settings& settings, int argc, char** argv)
+{
+  if(settings.selfTest)
+  {
+    return selfTest(std::filesystem::temp_directory_path() / "dlss_rr_reference_selftest") ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  ReferencePartial merged;
+  if(!settings.merge.empty())
+  {
+    std::vector<std::filesystem::path> files;
+    for(const auto& entry : std::filesystem::directory_iterator(settings.merge))
+    {
+      if(entry.path().extension() == ".refpart")
+      {
+        files.push_back(entry.path());
+      }
+    }
+    std::vector<ReferencePartial> partials(files.size());
+    for(size_t i = 0; i < files.size(); ++i)
+    {
+      if(!partials[i].read(files[i]))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+    std::string error;
+    if(!mergePartials(partials, merged, error))
+    {
+      LOGE("Could not merge the partials in %s: %s\n", settings.merge.string().c_str(), error.c_str());
+      return EXIT_FAILURE;
+    }
+  }
+  else
+  {
+    // The workers get the sample's options, without the coordinator's
+    std::vector<std::string> arguments;
+    for(int i = 1; i < argc; ++i)
+    {
+      const std::string name(argv[i] + strspn(argv[i], "-"));
+      const auto*       option = std::find_if(std::begin(kCoordinatorOptions), std::end(kCoordinatorOptions),
+                                              [&](const auto& o) { return name == o.first; });
+      if(option == std::end(kCoordinatorOptions))
+      {
+        arguments.push_back(argv[i]);
+      }
+      else if(option->second)
+      {
+        ++i;
+      }
+    }
+
+    if(settings.frames <= 0)
+    {
+      LOGE("--referenceWorkers needs --referenceFrames\n");
+      return EXIT_FAILURE;
+    }
+    const uint32_t   workers = uint32_t(settings.workers);
+    const uint32_t   chunks  = settings.chunks > 0 ? uint32_t(settings.chunks) : 4 * workers;
+    const FrameRange total{uint32_t(settings.firstFrame), uint32_t(settings.firstFrame + settings.frames)};
+    std::filesystem::path directory = settings.output;
+    directory.replace_extension(".parts");
+    merged = render(total, chunks, workers, processWorker(nvutils::getExecutablePath(), arguments), directory, settings.resume);
+    if(merged.sum.empty())
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  return writeMerged(merged, settings.output) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+ReferencePartial ReferenceCoordinator::render(FrameRange total, uint32_t chunks, uint32_t workerCount, const Worker& worker,
+                                              const std::filesystem::path& directory, bool resume)
+{
+  std::filesystem::create_directories(directory);
+
+  const std::vector<FrameRange>      ranges = splitFrames(total, chunks);
+  std::vector<std::filesystem::path> files(ranges.size());
+  std::vector<ReferencePartial>      partials(ranges.size());
+  std::vector<char>                  done(ranges.size(), 0);  // written by one thread each
+  std::atomic<uint32_t>              next = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+  auto       loop  = [&] {
+    for(uint32_t i = next++; i < ranges.size(); i = next++)
+    {
+      const FrameRange range = ranges[i];
+      files[i] = directory / ("frames_" + std::to_string(range.begin) + "_" + std::to_string(range.end) + ".refpart");
+      // A partial that is truncated or holds other frames counts as a failed attempt
+      auto readChunk = [&] {
+        return partials[i].read(files[i]) && partials[i].frames.begin == range.begin && partials[i].frames.end == range.end;
+      };
+      // Ranges finished by an earlier run; the workers resume the others from their checkpoints
+      if(resume && std::filesystem::exists(files[i]) && readChunk())
+      {
+        done[i] = true;
+        continue;
+      }
+      const auto chunkStart = std::chrono::steady_clock::now();
+      for(uint32_t attempt = 1; attempt <= kChunkAttempts && !done[i]; ++attempt)
+      {
+        done[i] = worker(range, files[i]) && readChunk();
+        if(!done[i] && attempt < kChunkAttempts)
+        {
+          LOGW("Reference frames %u..%u failed, retrying (attempt %u of %u)\n", range.begin, range.end, attempt + 1,
+               kChunkAttempts);
+        }
+      }
+      LOGI("Reference frames %u..%u %s in %.1f s\n", range.begin, range.end, done[i] ? "done" : "failed",
+           std::chrono::duration<double>(std::chrono::steady_clock::now() - chunkStart).count());
+    }
+  };
+  std::vector<std::thread> threads;
+  for(uint32_t i = 0; i < std::max(workerCount, 1u); ++i)
+  {
+    threads.emplace_back(loop);
+  }
+  for(std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  for(size_t i = 0; i < ranges.size(); ++i)
+  {
+    if(!done[i])
+    {
+      LOGE("Reference frames %u..%u are missing\n", ranges[i].begin, ranges[i].end);
+      return {};
+    }
+  }
+  ReferencePartial merged;
+  std::string      error;
+  if(!mergePartials(partials, merged, error))
+  {
+    LOGE("Could not merge the reference partials: %s\n", error.c_str());
+    return {};
+  }
+  LOGI("Reference of %u frames in %zu chunks on %u workers: %.1f s\n", total.count(), ranges.size(), workerCount,
+       std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  return merged;
+}
+
+ReferenceCoordinator::Worker ReferenceCoordinator::processWorker(const std::filesystem::path& executable, std::vector<std::string> arguments)
+{
+  return [executable, arguments = std::move(arguments)](FrameRange range, const std::filesystem::path& filename) {
+    std::string command = quoted(executable.string());
+    for(const std::string& argument : arguments)
+    {
+      command += " " + quoted(argument);
+    }
+    command += " --headless 1 --referenceFirstFrame " + std::to_string(range.begin) + " --referenceFrames "
+               + std::to_string(range.count()) + " --referenceOutput " + quoted(filename.string());
+#ifdef _WIN32
+    // cmd.exe strips the outer quotes
+    command = quoted(command);
+#endif
+    std::filesystem::remove(filename);
+    return std::system(command.c_str()) == 0 && std::filesystem::exists(filename);
+  };
+}
+
+ReferenceCoordinator::Worker ReferenceCoordinator::cpuWorker(uint32_t width, uint32_t height)
+{
+  return [width, height](FrameRange range, const std::filesystem::path& filename) {
+    std::vector<glm::vec4> sum(size_t(width) * height, glm::vec4(0.0f));
+    accumulateCpu(width, height, range, sum);
+
+    ReferencePartial partial{.width = width, .height = height, .frames = range, .key = "cpu stand-in"};
+    partial.sum.resize(sum.size());
+    for(size_t i = 0; i < sum.size(); ++i)
+    {
+      partial.sum[i] = glm::dvec4(sum[i]);
+    }
+    return partial.write(filename);
+  };
+}
+
+bool ReferenceCoordinator::selfTest(const std::filesystem::path& directory)
+{
+  constexpr uint32_t width = 64, height = 48;
+  const FrameRange   total{100, 356};
+  const Worker       worker = cpuWorker(width, height);
+
+  std::filesystem::remove_all(directory);
+  const ReferencePartial single = render(total, 1, 1, worker, directory / "single");
+  const ReferencePartial split  = render(total, 13, 4, worker, directory / "split");
+  if(single.sum.empty() || split.sum.empty())
+  {
+    return false;
+  }
+
+  // A worker that exits successfully but leaves a truncated partial must be retried
+  std::atomic<uint32_t> calls    = 0;
+  const Worker          truncate = [&](FrameRange range, const std::filesystem::path& filename) {
+    const bool written = worker(range, filename);
+    if(written && calls++ == 0)
+    {
+      std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 4);
+    }
+    return written;
+  };
+  const ReferencePartial retried        = render(total, 1, 1, truncate, directory / "retried");
+  const bool             truncatedRetry = calls == kChunkAttempts && retried.sum == single.sum;
+
+  // The sample counts must match exactly; the colors within the float precision of the per-chunk sums
+  double maxError   = 0.0;
+  bool   sameCounts = true;
+  for(size_t i = 0; i < single.sum.size(); ++i)
+  {
+    sameCounts = sameCounts && single.sum[i].w == split.sum[i].w;
+    for(int c = 0; c < 3; ++c)
+    {
+      maxError = std::max(maxError, std::abs(split.sum[i][c] - single.sum[i][c]) / std::max(single.sum[i][c], 1.0));
+    }
+  }
+
+  // Merging the same partials in another order, or with one missing, must be caught or give the same result
+  std::vector<ReferencePartial> partials;
+  for(FrameRange range : splitFrames(total, 13))
+  {
+    partials.emplace_back().read(directory / "split" / ("frames_" + std::to_string(range.begin) + "_" + std::to_string(range.end) + ".refpart"));
+  }
+  std::reverse(partials.begin(), partials.end());
+  ReferencePartial reordered;
+  std::string      error;
+  const bool       sameOrderFree = mergePartials(partials, reordered, error) && reordered.sum == split.sum;
+  partials.erase(partials.begin() + 5);
+  const bool gapCaught = !mergePartials(partials, reordered, error);
+
+  // Interrupted after some frames and resumed from the checkpoint, the sums must be bit-identical to an uninterrupted run
+  const size_t           pixels = size_t(width) * height;
+  std::vector<glm::vec4> uninterrupted(pixels, glm::vec4(0.0f));
+  accumulateCpu(width, height, total, uninterrupted);
+
+  const ReferenceCheckpoint checkpoint{.range = total, .accumulated = 100, .width = width, .height = height, .key = "cpu stand-in"};
+  std::vector<glm::vec4>    interrupted(pixels, glm::vec4(0.0f));
+  accumulateCpu(width, height, {total.begin, checkpoint.nextFrame()}, interrupted);
+  const std::filesystem::path checkpointFile = directory / "selftest.ckpt";
+  CheckpointWriter            writer;
+  writer.write(checkpointFile, checkpoint, interrupted);
+  writer.wait();
+
+  ReferenceCheckpoint    resumed;
+  std::vector<glm::vec4> sums;
+  bool bitIdentical = readCheckpoint(checkpointFile, resumed, sums) && resumed.nextFrame() == checkpoint.nextFrame();
+  if(bitIdentical)
+  {
+    accumulateCpu(width, height, {resumed.nextFrame(), total.end}, sums);
+    bitIdentical = memcmp(sums.data(), uninterrupted.data(), pixels * sizeof(glm::vec4)) == 0;
+  }
+  std::filesystem::resize_file(checkpointFile, std::filesystem::file_size(checkpointFile) - 4);
+  const bool truncationCaught = !readCheckpoint(checkpointFile, resumed, sums);
+
+  const bool passed =
+      sameCounts && maxError < 1e-4 && sameOrderFree && gapCaught && bitIdentical && truncationCaught && truncatedRetry;
+  LOGI("Reference self test %s: sample counts %s, max relative color error %.2e, merge order %s, gap %s, resume %s, "
+       "truncated checkpoint %s, truncated partial %s\n",
+       passed ? "passed" : "FAILED", sameCounts ? "equal" : "differ", maxError, sameOrderFree ? "irrelevant" : "matters",
+       gapCaught ? "caught" : "missed", bitIdentical ? "bit-identical" : "differs", truncationCaught ? "caught" : "missed",
+       truncatedRetry ? "retried" : "missed");
+  return passed;
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace nvutils {
+class ParameterRegistry;
+}
+
+
+// Frame indices [begin, end). The ray generation seeds its random numbers with xxhash32(pixel, frame), so a range of
+// frame indices determines the samples rendered for it, whichever process renders it.
+struct FrameRange
+{
+  uint32_t begin = 0;
+  uint32_t end   = 0;
+
+  uint32_t count() const { return end - begin; }
+};
+
+
+// Per pixel sums of the noisy color over a range of frames, with the number of finite samples in w. Partials of
+// disjoint ranges add up to the partial of their union; the reference is the sum divided by the sample count.
+struct ReferencePartial
+{
+  uint32_t                width  = 0;
+  uint32_t                height = 0;
+  FrameRange              frames;
+  std::string             key;  // scene and render settings, partials only merge with an identical key
+  std::vector<glm::dvec4> sum;
+
+  bool write(const std::filesystem::path& filename) const;
+  bool read(const std::filesystem::path& filename);
+
+  // Mean color per pixel, with the sample count in w
+  std::vector<glm::vec4> resolve() const;
+  // Writes resolve() as a PFM (portable float map) image
+  bool writeImage(const std::filesystem::path& filename) const;
+};
+
+// Splits 'total' into 'chunks' contiguous ranges of nearly equal size
+std::vector<FrameRange> splitFrames(FrameRange total, uint32_t chunks);
+
+// Sums 'partials', in the order of their frame ranges so that the result doesn't depend on the order they arrived in.
+// Fails when the sizes or keys differ, or when the ranges overlap or leave a gap.
+bool mergePartials(std::span<const ReferencePartial> partials, ReferencePartial& merged, std::string& error);
+
+
+// ReferenceCoordinator renders a converged reference for the quality metrics on several workers. It splits the frame
+// range into more chunks than workers, hands the chunks to the workers as they become free, and merges the partial
+// sums the workers write. A worker is another headless instance of the sample started with the chunk's range
+// (ReferenceAccumulator is its side), or the CPU stand-in, which draws its samples with the same seeding and lets the
+// splitting and merging be checked without a GPU. Workers on other nodes render their ranges with the same command
+// line; --referenceMerge merges the partials they produced.
+class ReferenceCoordinator
+{
+public:
+  struct Settings
+  {
+    int                   firstFrame       = 0;                    // worker: its range
+    int                   frames           = 0;                    // 0: disabled; coordinator: the whole range, from 'firstFrame'
+    int                   workers          = 0;                    // > 0: coordinate this many local worker processes
+    int                   chunks           = 0;                    // ranges handed out; 0: four per worker
+    std::filesystem::path output           = "reference.refpart";  // worker: its partial; otherwise the merged one
+    std::filesystem::path merge;                                   // directory of partials to merge
+    int                   checkpointFrames = 0;                    // worker: frames between checkpoints, 0: none
+    bool                  resume           = false;                // continue an interrupted run
+    bool                  selfTest         = false;
+
+    bool isWorker() const { return frames > 0 && workers == 0 && merge.empty() && !selfTest; }
+    bool isCoordinator() const { return workers > 0 || !merge.empty() || selfTest; }
+  };
+
+  // Renders 'range' and writes its partial to 'filename'; false on failure
+  using Worker = std::function<bool(FrameRange range, const std::filesystem::path& filename)>;
+
+  // Registers the --reference* options
+  static void registerParameters(nvutils::ParameterRegistry& registry, Settings& settings);
+
+  // Runs the coordinator, self test or merge of 'settings' instead of the sample; returns the exit code.
+  // 'argc'/'argv' are the sample's, forwarded to the worker processes.
+  static int run(const Settings& settings, int argc, char** argv);
+
+  // Hands 'chunks' of 'total' to 'workerCount' concurrent calls of 'worker', each chunk's partial goes to
+  // 'directory'. A chunk whose worker fails, or whose partial doesn't read back with its range, is retried once, with
+  // a warning. With 'resume', chunks whose partial exists are kept.
+  // Returns the merged partial, empty on failure.
+  static ReferencePartial render(FrameRange total, uint32_t chunks, uint32_t workerCount, const Worker& worker,
+                                 const std::filesystem::path& directory, bool resume = false);
+
+  // Worker starting the sample executable with 'arguments' and the chunk's range
+  static Worker processWorker(const std::filesystem::path& executable, std::vector<std::string> arguments);
+  // Worker drawing samples of a synthetic 'width' x 'height' image on the CPU, seeded like the ray generation
+  static Worker cpuWorker(uint32_t width, uint32_t height);
+
+  // Renders with the CPU stand-in once in one chunk and once split across several workers, and compares.
+  // Also interrupts a CPU accumulation, resumes it from a checkpoint and compares with an uninterrupted one.
+  static bool selfTest(const std::filesystem::path& directory);
+};
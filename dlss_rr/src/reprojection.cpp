@@ -0,0 +1,463 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "reprojection.hpp"
+
+#include <imgui/imgui.h>
+
+#include <nvapp/application.hpp>
+#include <nvgui/property_editor.hpp>
+#include <nvutils/logger.hpp>
+#include <nvvk/check_error.hpp>
+#include <nvvk/debug_util.hpp>
+#include <nvvk/descriptors.hpp>
+#include <nvvk/pipeline.hpp>
+#include <nvvk/shaders.hpp>
+
+#include "image_readback.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+
+static const float kInfDistance = 65504.0f;  // DLSS_INF_DISTANCE, ViewZ of sky pixels
+
+static bool isSky(float viewZ, const glm::vec3& normal)
+{
+  return viewZ >= kInfDistance || normal == glm::vec3(0.0f);
+}
+
+static float maxComponent(const glm::vec3& v)
+{
+  return std::max(std::max(v.x, v.y), v.z);
+}
+
+static uint64_t combineWords(uint32_t lo, uint32_t hi)
+{
+  return (uint64_t(hi) << 32) | lo;
+}
+
+// Mirrors main() in reprojection.slang
+ReprojectionResult computeReprojectionErrors(const ReprojectionFrame&      prev,
+                                             const ReprojectionFrame&      cur,
+                                             const shaderio::FrameInfo&    frameInfo,
+                                             const ReprojectionTolerances& tolerances,
+                                             std::vector<glm::vec4>*       errorImage)
+{
+  assert(prev.width == cur.width && prev.height == cur.height);
+
+  const glm::ivec2 size(int(cur.width), int(cur.height));
+  const glm::vec3  tolerance(tolerances.depth, tolerances.normal, tolerances.albedo);
+
+  if(errorImage)
+  {
+    errorImage->assign(size_t(size.x) * size.y, glm::vec4(0.0f));
+  }
+
+  ReprojectionResult result;
+  glm::u64vec3       errorFixed(0);
+  for(int y = 0; y < size.y; ++y)
+  {
+    for(int x = 0; x < size.x; ++x)
+    {
+      const size_t    index = size_t(y) * size.x + x;
+      const float     z     = cur.viewZ[index].x;
+      const glm::vec3 n     = glm::vec3(cur.normal[index]);
+      const glm::vec3 a     = glm::vec3(cur.albedo[index]);
+      const glm::vec2 mv    = glm::vec2(cur.motion[index]);
+
+      const glm::vec2  pixelCenter = glm::vec2(x, y) + 0.5f + frameInfo.jitter;
+      const glm::vec2  prevPos     = pixelCenter + mv;
+      const glm::ivec2 prevPixel   = glm::ivec2(glm::floor(prevPos));
+
+      glm::vec3 error(0.0f);
+      if(isSky(z, n))
+      {
+        result.sky++;
+      }
+      else if(prevPixel.x < 0 || prevPixel.y < 0 || prevPixel.x >= size.x || prevPixel.y >= size.y)
+      {
+        result.offscreen++;
+      }
+      else
+      {
+        const size_t    prevIndex = size_t(prevPixel.y) * size.x + prevPixel.x;
+        const float     pz        = prev.viewZ[prevIndex].x;
+        const glm::vec3 pn        = glm::vec3(prev.normal[prevIndex]);
+        const glm::vec3 pa        = glm::vec3(prev.albedo[prevIndex]);
+
+        if(isSky(pz, pn))
+        {
+          result.sky++;
+        }
+        else
+        {
+          const glm::vec2 d         = pixelCenter / glm::vec2(size) * 2.0f - 1.0f;
+          const glm::vec4 target    = frameInfo.projInv * glm::vec4(d.x, d.y, 0.01f, 1.0f);
+          const glm::vec3 viewDir   = glm::vec3(target) / target.w;
+          const glm::vec3 viewPos   = viewDir * (z / -viewDir.z);
+          const glm::vec4 worldPos  = frameInfo.viewInv * glm::vec4(viewPos, 1.0f);
+          const glm::vec4 prevClip  = frameInfo.prevMVP * glm::vec4(glm::vec3(worldPos), 1.0f);
+          const float     expectedZ = prevClip.w;
+
+          error.x = std::abs(pz - expectedZ) / std::max(expectedZ, 1e-4f);
+          error.y = 1.0f - glm::dot(glm::normalize(n), glm::normalize(pn));
+          error.z = maxComponent(glm::abs(a - pa));
+          error   = glm::clamp(error, glm::vec3(0.0f), glm::vec3(1.0f));
+
+          result.valid++;
+          if(glm::any(glm::greaterThan(error, tolerance)))
+          {
+            result.bad++;
+          }
+        }
+      }
+
+      errorFixed += glm::u64vec3(glm::uvec3(error * float(REPROJECTION_FIXED_POINT) + 0.5f));
+      if(errorImage)
+      {
+        (*errorImage)[index] = glm::vec4(glm::min(error / tolerance, glm::vec3(1.0f)), 1.0f);
+      }
+    }
+  }
+
+  if(result.valid > 0)
+  {
+    const glm::dvec3 mean = glm::dvec3(errorFixed) / REPROJECTION_FIXED_POINT / double(result.valid);
+    result.meanDepthError  = mean.x;
+    result.meanNormalError = mean.y;
+    result.meanAlbedoError = mean.z;
+  }
+  return result;
+}
+
+ReprojectionResult reprojectionResultFromStats(const shaderio::ReprojectionStats& stats)
+{
+  ReprojectionResult result{.valid = stats.valid, .offscreen = stats.offscreen, .sky = stats.sky, .bad = stats.bad};
+  if(stats.valid > 0)
+  {
+    const double scale     = 1.0 / (REPROJECTION_FIXED_POINT * double(stats.valid));
+    result.meanDepthError  = double(combineWords(stats.depthLo, stats.depthHi)) * scale;
+    result.meanNormalError = double(combineWords(stats.normalLo, stats.normalHi)) * scale;
+    result.meanAlbedoError = double(combineWords(stats.albedoLo, stats.albedoHi)) * scale;
+  }
+  return result;
+}
+
+
+ReprojectionAnalyzer::~ReprojectionAnalyzer()
+{
+  assert(m_pipeline == VK_NULL_HANDLE && "Must call deinit");
+}
+
+void ReprojectionAnalyzer::init(nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv, VkSampler sampler, VkDescriptorPool imguiPool, uint32_t frameCycleSize)
+{
+  assert(m_pipeline == VK_NULL_HANDLE && "Init already called");
+
+  m_alloc  = alloc;
+  m_device = alloc->getDevice();
+
+  // History sets are copies of the guide buffers, the error image is displayed
+  std::vector<VkFormat> formats(eNumHistoryImages);
+  formats[eViewZ0] = formats[eViewZ1] = VK_FORMAT_R16_SFLOAT;
+  formats[eNormal0] = formats[eNormal1] = VK_FORMAT_R16G16B16A16_SFLOAT;
+  formats[eAlbedo0] = formats[eAlbedo1] = VK_FORMAT_R8G8B8A8_UNORM;
+  formats[eError]                       = VK_FORMAT_R16G16B16A16_SFLOAT;
+  m_history.init({.allocator = m_alloc, .colorFormats = formats, .imageSampler = sampler, .descriptorPool = imguiPool});
+
+  NVVK_CHECK(m_alloc->createBuffer(m_stats, sizeof(shaderio::ReprojectionStats),
+                                   VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_2_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_2_TRANSFER_DST_BIT));
+  NVVK_DBG_NAME(m_stats.buffer);
+  m_readback.init(m_alloc, sizeof(shaderio::ReprojectionStats), frameCycleSize);
+
+  nvvk::DescriptorBindings bindings;
+  for(uint32_t binding : {shaderio::ReprojectionBindings::eCurViewZ, shaderio::ReprojectionBindings::eCurNormal,
+                          shaderio::ReprojectionBindings::eCurAlbedo, shaderio::ReprojectionBindings::eCurMotion,
+                          shaderio::ReprojectionBindings::ePrevViewZ, shaderio::ReprojectionBindings::ePrevNormal,
+                          shaderio::ReprojectionBindings::ePrevAlbedo})
+  {
+    bindings.addBinding(binding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+  }
+  for(uint32_t binding : {shaderio::ReprojectionBindings::eNextViewZ, shaderio::ReprojectionBindings::eNextNormal,
+                          shaderio::ReprojectionBindings::eNextAlbedo, shaderio::ReprojectionBindings::eReprojError})
+  {
+    bindings.addBinding(binding, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+  }
+  bindings.addBinding(shaderio::ReprojectionBindings::eReprojStats, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+  NVVK_CHECK(bindings.createDescriptorSetLayout(m_device, VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR, &m_dsetLayout));
+  NVVK_DBG_NAME(m_dsetLayout);
+
+  const VkPushConstantRange pushConstant{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(shaderio::ReprojectionPushConstant)};
+  NVVK_CHECK(nvvk::createPipelineLayout(m_device, &m_pipelineLayout, {m_dsetLayout}, {pushConstant}));
+  NVVK_DBG_NAME(m_pipelineLayout);
+
+  VkShaderModule module = VK_NULL_HANDLE;
+  NVVK_CHECK(nvvk::createShaderModule(module, m_device, spirv));
+
+  const VkComputePipelineCreateInfo pipelineInfo{
+      .sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+      .stage  = {.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, .stage = VK_SHADER_STAGE_COMPUTE_BIT, .module = module, .pName = "main"},
+      .layout = m_pipelineLayout,
+  };
+  NVVK_CHECK(vkCreateComputePipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipeline));
+  NVVK_DBG_NAME(m_pipeline);
+
+  vkDestroyShaderModule(m_device, module, nullptr);
+}
+
+void ReprojectionAnalyzer::deinit()
+{
+  vkDestroyPipeline(m_device, m_pipeline, nullptr);
+  vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
+  vkDestroyDescriptorSetLayout(m_device, m_dsetLayout, nullptr);
+  m_pipeline       = VK_NULL_HANDLE;
+  m_pipelineLayout = VK_NULL_HANDLE;
+  m_dsetLayout     = VK_NULL_HANDLE;
+
+  m_readback.deinit();
+  m_alloc->destroyBuffer(m_stats);
+  m_history.deinit();
+}
+
+void ReprojectionAnalyzer::setEnabled(bool enabled)
+{
+  if(enabled != m_enabled)
+  {
+    // The history is stale, and so are pending results
+    m_readback.invalidate();
+    m_hasResult      = false;
+    m_analyzedFrames = 0;
+  }
+  m_enabled = enabled;
+}
+
+void ReprojectionAnalyzer::resize(VkCommandBuffer cmd, VkExtent2D maxSize)
+{
+  NVVK_CHECK(m_history.update(cmd, maxSize));
+  m_readback.invalidate();
+  m_hasResult      = false;
+  m_analyzedFrames = 0;
+}
+
+void ReprojectionAnalyzer::readResults(uint32_t cycleIndex)
+{
+  const auto* stats = m_readback.map<shaderio::ReprojectionStats>(cycleIndex);
+  if(stats == nullptr || !m_enabled)
+  {
+    return;
+  }
+
+  m_result    = reprojectionResultFromStats(*stats);
+  m_hasResult = true;
+}
+
+void ReprojectionAnalyzer::cmdAnalyze(VkCommandBuffer cmd, const Inputs& inputs, VkDeviceAddress frameInfo, VkExtent2D size, uint32_t cycleIndex)
+{
+  const uint32_t prevBase = historySet(m_lastSet);
+  const uint32_t nextBase = historySet(m_lastSet ^ 1);
+
+  vkCmdFillBuffer(cmd, m_stats.buffer, 0, VK_WHOLE_SIZE, 0);
+
+  // Clear done, last frame's history writes done and the error image no longer displayed
+  const VkMemoryBarrier2 before{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                .srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT
+                                                | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                                .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_SHADER_READ_BIT,
+                                .dstStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                .dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT};
+  const VkDependencyInfo depBefore{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &before};
+  vkCmdPipelineBarrier2(cmd, &depBefore);
+
+  vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+
+  const VkDescriptorImageInfo prevViewZ  = m_history.getDescriptorImageInfo(prevBase + 0);
+  const VkDescriptorImageInfo prevNormal = m_history.getDescriptorImageInfo(prevBase + 1);
+  const VkDescriptorImageInfo prevAlbedo = m_history.getDescriptorImageInfo(prevBase + 2);
+  const VkDescriptorImageInfo nextViewZ  = m_history.getDescriptorImageInfo(nextBase + 0);
+  const VkDescriptorImageInfo nextNormal = m_history.getDescriptorImageInfo(nextBase + 1);
+  const VkDescriptorImageInfo nextAlbedo = m_history.getDescriptorImageInfo(nextBase + 2);
+  const VkDescriptorImageInfo error      = m_history.getDescriptorImageInfo(eError);
+  const VkDescriptorBufferInfo statsInfo{m_stats.buffer, 0, VK_WHOLE_SIZE};
+
+  auto imageWrite = [](uint32_t binding, VkDescriptorType type, const VkDescriptorImageInfo& info) {
+    return VkWriteDescriptorSet{.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                                .dstBinding      = binding,
+                                .descriptorCount = 1,
+                                .descriptorType  = type,
+                                .pImageInfo      = &info};
+  };
+  const VkDescriptorType sampled = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+  const VkDescriptorType storage = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+
+  const VkWriteDescriptorSet writes[] = {
+      imageWrite(shaderio::ReprojectionBindings::eCurViewZ, sampled, inputs.viewZ),
+      imageWrite(shaderio::ReprojectionBindings::eCurNormal, sampled, inputs.normal),
+      imageWrite(shaderio::ReprojectionBindings::eCurAlbedo, sampled, inputs.albedo),
+      imageWrite(shaderio::ReprojectionBindings::eCurMotion, sampled, inputs.motion),
+      imageWrite(shaderio::ReprojectionBindings::ePrevViewZ, sampled, prevViewZ),
+      imageWrite(shaderio::ReprojectionBindings::ePrevNormal, sampled, prevNormal),
+      imageWrite(shaderio::ReprojectionBindings::ePrevAlbedo, sampled, prevAlbedo),
+      imageWrite(shaderio::ReprojectionBindings::eNextViewZ, storage, nextViewZ),
+      imageWrite(shaderio::ReprojectionBindings::eNextNormal, storage, nextNormal),
+      imageWrite(shaderio::ReprojectionBindings::eNextAlbedo, storage, nextAlbedo),
+      imageWrite(shaderio::ReprojectionBindings::eReprojError, storage, error),
+      {.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+       .dstBinding      = shaderio::ReprojectionBindings::eReprojStats,
+       .descriptorCount = 1,
+       .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+       .pBufferInfo     = &statsInfo},
+  };
+  vkCmdPushDescriptorSetKHR(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, uint32_t(std::size(writes)), writes);
+
+  const shaderio::ReprojectionPushConstant pushConst{.frameInfo       = (shaderio::FrameInfo*)frameInfo,
+                                                     .size            = {int32_t(size.width), int32_t(size.height)},
+                                                     .depthTolerance  = tolerances.depth,
+                                                     .normalTolerance = tolerances.normal,
+                                                     .albedoTolerance = tolerances.albedo};
+  vkCmdPushConstants(cmd, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConst), &pushConst);
+
+  const VkExtent2D groups = getGridSize(size);
+  vkCmdDispatch(cmd, groups.width, groups.height, 1);
+
+  const VkMemoryBarrier2 after{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                               .srcStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                               .srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT,
+                               .dstStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                               .dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_SHADER_READ_BIT};
+  const VkDependencyInfo depAfter{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &after};
+  vkCmdPipelineBarrier2(cmd, &depAfter);
+
+  // Without history the first frame compared against uninitialized images
+  if(m_analyzedFrames > 0)
+  {
+    m_readback.cmdCopy(cmd, m_stats.buffer, cycleIndex);
+  }
+
+  // A replay rewrites the same next history; the frame itself swaps the sets
+  if(cycleIndex == ReadbackRing::kReplaySlot)
+  {
+    return;
+  }
+  m_lastSet ^= 1;
+  m_lastSize  = size;
+  m_lastCycle = cycleIndex;
+  m_analyzedFrames++;
+}
+
+void ReprojectionAnalyzer::verifyOnCpu(nvapp::Application* app, const InputImages& inputs, const shaderio::FrameInfo& frameInfo)
+{
+  if(m_analyzedFrames < 2)
+  {
+    m_verifyReport = "Needs two analyzed frames";
+    return;
+  }
+
+  vkDeviceWaitIdle(m_device);
+
+  auto download = [&](VkImage image, VkFormat format) { return downloadImage(app, m_alloc, image, format, m_lastSize); };
+  auto downloadHistory = [&](uint32_t image) {
+    return downloadImage(app, m_alloc, m_history.getColorImage(image), m_history.getColorFormat(image), m_lastSize);
+  };
+
+  // The set not written by the last frame still holds the frame before it
+  const uint32_t    prevBase = historySet(m_lastSet ^ 1);
+  ReprojectionFrame prev{.width  = m_lastSize.width,
+                         .height = m_lastSize.height,
+                         .viewZ  = downloadHistory(prevBase + 0),
+                         .normal = downloadHistory(prevBase + 1),
+                         .albedo = downloadHistory(prevBase + 2)};
+  ReprojectionFrame cur{.width  = m_lastSize.width,
+                        .height = m_lastSize.height,
+                        .viewZ  = download(inputs.viewZ, inputs.viewZFormat),
+                        .normal = download(inputs.normal, inputs.normalFormat),
+                        .albedo = download(inputs.albedo, inputs.albedoFormat),
+                        .motion = download(inputs.motion, inputs.motionFormat)};
+  const std::vector<glm::vec4> gpuError = downloadHistory(eError);
+
+  std::vector<glm::vec4>   cpuError;
+  const ReprojectionResult cpu = computeReprojectionErrors(prev, cur, frameInfo, tolerances, &cpuError);
+
+  // Error images are stored in half precision
+  float    maxDifference = 0.0f;
+  uint64_t mismatches    = 0;
+  for(size_t i = 0; i < cpuError.size(); ++i)
+  {
+    const float difference = maxComponent(glm::abs(glm::vec3(cpuError[i] - gpuError[i])));
+    maxDifference          = std::max(maxDifference, difference);
+    mismatches += difference > 1.0f / 64.0f ? 1 : 0;
+  }
+
+  // The stats of the last frame are in its readback slot, complete after the wait
+  const auto*              stats = m_readback.map<shaderio::ReprojectionStats>(m_lastCycle);
+  const ReprojectionResult gpu   = stats ? reprojectionResultFromStats(*stats) : ReprojectionResult{};
+
+  std::array<char, 512> report;
+  snprintf(report.data(), report.size(),
+           "CPU: valid %llu offscreen %llu sky %llu bad %llu, mean error %.4f/%.4f/%.4f\n"
+           "GPU: valid %llu offscreen %llu sky %llu bad %llu, mean error %.4f/%.4f/%.4f\n"
+           "Error image: max difference %.4f, %llu pixels differ",
+           (unsigned long long)cpu.valid, (unsigned long long)cpu.offscreen, (unsigned long long)cpu.sky,
+           (unsigned long long)cpu.bad, cpu.meanDepthError, cpu.meanNormalError, cpu.meanAlbedoError,
+           (unsigned long long)gpu.valid, (unsigned long long)gpu.offscreen, (unsigned long long)gpu.sky,
+           (unsigned long long)gpu.bad, gpu.meanDepthError, gpu.meanNormalError, gpu.meanAlbedoError, maxDifference,
+           (unsigned long long)mismatches);
+  m_verifyReport = report.data();
+  LOGI("Reprojection CPU verification\n%s\n", m_verifyReport.c_str());
+}
+
+bool ReprojectionAnalyzer::onUI()
+{
+  using namespace nvgui;
+
+  PropertyEditor::begin();
+  PropertyEditor::entry(
+      "Depth Tolerance",
+      [&] { return ImGui::SliderFloat("##depth", &tolerances.depth, 0.001f, 0.2f, "%.3f", ImGuiSliderFlags_Logarithmic); },
+      "Relative difference between the previous ViewZ and the reprojected one");
+  PropertyEditor::entry(
+      "Normal Tolerance",
+      [&] { return ImGui::SliderFloat("##normal", &tolerances.normal, 0.001f, 1.0f, "%.3f", ImGuiSliderFlags_Logarithmic); },
+      "1 - cos(angle) between the previous and the current normal");
+  PropertyEditor::entry(
+      "Albedo Tolerance", [&] { return ImGui::SliderFloat("##albedo", &tolerances.albedo, 0.01f, 1.0f, "%.2f"); },
+      "Largest channel difference of the diffuse albedo");
+  PropertyEditor::end();
+
+  if(m_hasResult)
+  {
+    const ReprojectionResult& r     = m_result;
+    const double              total = double(r.valid + r.offscreen + r.sky);
+    const double              bad   = r.valid ? 100.0 * double(r.bad) / double(r.valid) : 0.0;
+    ImGui::Text("Valid %llu, offscreen %llu, sky %llu", (unsigned long long)r.valid, (unsigned long long)r.offscreen,
+                (unsigned long long)r.sky);
+    ImGui::TextColored(bad > 1.0 ? ImVec4(1.0f, 0.3f, 0.3f, 1.0f) : ImVec4(0.5f, 0.9f, 0.5f, 1.0f),
+                       "Above tolerance %llu (%.2f%%)", (unsigned long long)r.bad, bad);
+    ImGui::Text("Mean error: depth %.4f normal %.4f albedo %.4f", r.meanDepthError, r.meanNormalError, r.meanAlbedoError);
+    ImGui::TextDisabled("%.0f pixels, RGB of the error view = depth/normal/albedo", total);
+  }
+
+  const bool verify = ImGui::Button("Verify on CPU");
+  ImGui::SetItemTooltip("Recompute the last frame on the CPU from downloaded buffers and compare");
+  if(!m_verifyReport.empty())
+  {
+    ImGui::TextUnformatted(m_verifyReport.c_str());
+  }
+  return verify;
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <nvvk/gbuffers.hpp>
+#include <nvvk/resource_allocator.hpp>
+
+#include "readback_ring.hpp"
+#include "shaders/host_device.h"
+
+#include <span>
+#include <string>
+#include <vector>
+
+namespace nvapp {
+class Application;
+}
+
+
+struct ReprojectionTolerances
+{
+  float depth  = 0.02f;  // relative ViewZ difference
+  float normal = 0.05f;  // 1 - cos(angle), about 18 degrees
+  float albedo = 0.1f;   // max. channel difference
+};
+
+struct ReprojectionResult
+{
+  uint64_t valid     = 0;
+  uint64_t offscreen = 0;
+  uint64_t sky       = 0;
+  uint64_t bad       = 0;
+  double   meanDepthError  = 0.0;  // over valid pixels
+  double   meanNormalError = 0.0;
+  double   meanAlbedoError = 0.0;
+};
+
+// One frame of dumped guide buffers, 'width' x 'height' RGBA pixels each (see downloadImage())
+struct ReprojectionFrame
+{
+  uint32_t               width  = 0;
+  uint32_t               height = 0;
+  std::vector<glm::vec4> viewZ;
+  std::vector<glm::vec4> normal;
+  std::vector<glm::vec4> albedo;
+  std::vector<glm::vec4> motion;  // unused in the previous frame
+};
+
+// CPU implementation of reprojection.slang: warps 'prev' with the motion vectors of 'cur'.
+// 'frameInfo' is the one 'cur' was rendered with. 'errorImage', when given, receives the debug view.
+ReprojectionResult computeReprojectionErrors(const ReprojectionFrame&      prev,
+                                             const ReprojectionFrame&      cur,
+                                             const shaderio::FrameInfo&    frameInfo,
+                                             const ReprojectionTolerances& tolerances,
+                                             std::vector<glm::vec4>*       errorImage = nullptr);
+
+// Converts the counters written by reprojection.slang
+ReprojectionResult reprojectionResultFromStats(const shaderio::ReprojectionStats& stats);
+
+
+// ReprojectionAnalyzer checks the motion vectors every frame: the previous ViewZ/normal/albedo are fetched
+// where the current motion vectors point to and compared with the current surface. Aggregates are read back
+// through a ReadbackRing, the per-pixel error (depth, normal, albedo relative to their tolerance in RGB) is
+// available as an image for display. The previous buffers are kept in two history sets used in turn.
+class ReprojectionAnalyzer
+{
+public:
+  // Images the current frame's buffers are read from, readable by compute shaders
+  struct Inputs
+  {
+    VkDescriptorImageInfo viewZ;
+    VkDescriptorImageInfo normal;
+    VkDescriptorImageInfo albedo;
+    VkDescriptorImageInfo motion;
+  };
+
+  // Same buffers for the CPU verification; images in VK_IMAGE_LAYOUT_GENERAL
+  struct InputImages
+  {
+    VkImage  viewZ;
+    VkFormat viewZFormat;
+    VkImage  normal;
+    VkFormat normalFormat;
+    VkImage  albedo;
+    VkFormat albedoFormat;
+    VkImage  motion;
+    VkFormat motionFormat;
+  };
+
+  ReprojectionAnalyzer() = default;
+  ~ReprojectionAnalyzer();
+
+  void init(nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv, VkSampler sampler, VkDescriptorPool imguiPool, uint32_t frameCycleSize);
+  void deinit();
+
+  bool isEnabled() const { return m_enabled; }
+  void setEnabled(bool enabled);
+
+  // (Re)creates the history for the maximum render size; the next frame has no history
+  void resize(VkCommandBuffer cmd, VkExtent2D maxSize);
+
+  // Fetches the result of the frame that last used 'cycleIndex'
+  void readResults(uint32_t cycleIndex);
+
+  // 'size' is the rendered region, 'frameInfo' the device address of the current FrameInfo. A replay with
+  // ReadbackRing::kReplaySlot does not advance the history.
+  void cmdAnalyze(VkCommandBuffer cmd, const Inputs& inputs, VkDeviceAddress frameInfo, VkExtent2D size, uint32_t cycleIndex);
+
+  const ReprojectionResult& result() const { return m_result; }
+  bool                      hasResult() const { return m_hasResult; }
+
+  // Debug view, for ImGui::Image
+  VkDescriptorSet errorDescriptorSet() const { return m_history.getDescriptorSet(eError); }
+
+  // Reruns the last analyzed frame on the CPU and compares with the GPU results. 'inputs' and 'frameInfo' must
+  // still be the ones of that frame. Waits for the GPU.
+  void verifyOnCpu(nvapp::Application* app, const InputImages& inputs, const shaderio::FrameInfo& frameInfo);
+
+  // Tolerances, aggregate results and the CPU verification; returns true when a verification is requested
+  bool onUI();
+
+  ReprojectionTolerances tolerances;
+
+private:
+  enum HistoryImage
+  {
+    eViewZ0,
+    eNormal0,
+    eAlbedo0,
+    eViewZ1,
+    eNormal1,
+    eAlbedo1,
+    eError,
+    eNumHistoryImages
+  };
+
+  // First image (ViewZ, followed by normal and albedo) of history set 0 or 1
+  static uint32_t historySet(uint32_t set) { return set == 0 ? eViewZ0 : eViewZ1; }
+
+  nvvk::ResourceAllocator* m_alloc          = nullptr;
+  VkDevice                 m_device         = VK_NULL_HANDLE;
+  VkDescriptorSetLayout    m_dsetLayout     = VK_NULL_HANDLE;
+  VkPipelineLayout         m_pipelineLayout = VK_NULL_HANDLE;
+  VkPipeline               m_pipeline       = VK_NULL_HANDLE;
+  nvvk::GBuffer            m_history;
+  nvvk::Buffer             m_stats;
+  ReadbackRing             m_readback;
+
+  ReprojectionResult m_result;
+  std::string        m_verifyReport;
+  VkExtent2D         m_lastSize{};
+  uint32_t           m_lastSet        = 0;  // history set written by the last analyzed frame
+  uint32_t           m_lastCycle      = 0;
+  uint32_t           m_analyzedFrames = 0;  // since the history was reset
+  bool               m_enabled        = false;
+  bool               m_hasResult      = false;
+};
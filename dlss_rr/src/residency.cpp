@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "residency.hpp"
+
+#include <nvutils/logger.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+
+float residencyPriority(const glm::vec3& center, float radius, const glm::vec3& eye, const glm::vec3& forward)
+{
+  const glm::vec3 toCenter = center - eye;
+  const float     distance = glm::length(toCenter);
+  if(distance <= radius)
+  {
+    return 1.0f;  // inside the bounds
+  }
+
+  float priority = radius / distance;
+  if(glm::dot(toCenter, forward) < -radius)
+  {
+    priority *= 0.1f;
+  }
+  return priority;
+}
+
+ResidencyDecision decideResidency(const ResidencySettings& settings, std::span<const ResidencyItem> items)
+{
+  ResidencyDecision decision;
+
+  auto rankPriority = [&](uint32_t i) {
+    const ResidencyItem& item = items[i];
+    return item.resident ? item.priority * settings.residentBias : item.priority;
+  };
+
+  std::vector<uint32_t> order(items.size());
+  std::iota(order.begin(), order.end(), 0u);
+  std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    const float pa = rankPriority(a);
+    const float pb = rankPriority(b);
+    return pa != pb ? pa > pb : a < b;
+  });
+
+  // Locked items stay whatever their priority, the rest fills up the budget in ranking order
+  std::vector<bool> wanted(items.size(), false);
+  uint64_t          wantedBytes   = 0;
+  uint64_t          residentBytes = 0;
+  for(uint32_t i = 0; i < uint32_t(items.size()); ++i)
+  {
+    if(items[i].resident)
+    {
+      residentBytes += items[i].bytes;
+    }
+    if(items[i].locked)
+    {
+      wanted[i] = true;
+      wantedBytes += items[i].bytes;
+    }
+  }
+  for(uint32_t i : order)
+  {
+    const ResidencyItem& item = items[i];
+    if(item.priority <= 0.0f)
+    {
+      break;
+    }
+    if(!wanted[i] && wantedBytes + item.bytes <= settings.budget)
+    {
+      wanted[i] = true;
+      wantedBytes += item.bytes;
+    }
+  }
+
+  uint64_t loadBytes = 0;
+  for(uint32_t i : order)
+  {
+    const ResidencyItem& item = items[i];
+    if(!wanted[i] || item.resident)
+    {
+      continue;
+    }
+    if(decision.loads.size() >= settings.maxLoads)
+    {
+      break;
+    }
+    if(!decision.loads.empty() && loadBytes + item.bytes > settings.maxLoadBytes)
+    {
+      continue;
+    }
+    decision.loads.push_back(i);
+    loadBytes += item.bytes;
+  }
+
+  // Everything outside of the wanted set can go, which always makes enough room as the wanted set fits
+  uint64_t projected = residentBytes + loadBytes;
+  for(auto it = order.rbegin(); it != order.rend() && projected > settings.budget; ++it)
+  {
+    const ResidencyItem& item = items[*it];
+    if(item.resident && !item.locked && !wanted[*it])
+    {
+      decision.evictions.push_back(*it);
+      projected -= item.bytes;
+    }
+  }
+
+  return decision;
+}
+
+bool residencySelfTest()
+{
+  // Priority: the size over the distance, a tenth behind the camera, 1 inside the bounds
+  const glm::vec3 eye(0.0f), forward(0.0f, 0.0f, -1.0f);
+  const float     ahead10  = residencyPriority({0.0f, 0.0f, -10.0f}, 1.0f, eye, forward);
+  const float     ahead20  = residencyPriority({0.0f, 0.0f, -20.0f}, 1.0f, eye, forward);
+  const float     side10   = residencyPriority({10.0f, 0.0f, 0.0f}, 1.0f, eye, forward);
+  const float     behind10 = residencyPriority({0.0f, 0.0f, 10.0f}, 1.0f, eye, forward);
+  const float     inside   = residencyPriority({0.0f, 0.0f, -0.5f}, 1.0f, eye, forward);
+  const bool priorities = std::abs(ahead10 - 0.1f) < 1e-6f && std::abs(ahead20 - 0.05f) < 1e-6f && side10 == ahead10
+                          && std::abs(behind10 - 0.1f * ahead10) < 1e-6f && inside == 1.0f;
+
+  // Eviction order: four resident items of 100 bytes in a budget of 400, two new ones of high priority. The lowest
+  // priority goes first; a locked item stays and makes the next lowest go.
+  ResidencySettings tight{.budget = 400, .maxLoads = 8, .maxLoadBytes = 1000, .residentBias = 1.25f};
+  std::vector<ResidencyItem> items = {
+      {.bytes = 100, .priority = 0.5f, .resident = true},
+      {.bytes = 100, .priority = 0.1f, .resident = true},
+      {.bytes = 100, .priority = 0.3f, .resident = true},
+      {.bytes = 100, .priority = 0.2f, .resident = true},
+      {.bytes = 100, .priority = 10.0f},
+      {.bytes = 100, .priority = 9.0f},
+  };
+  ResidencyDecision decision = decideResidency(tight, items);
+  bool              order    = decision.loads == std::vector<uint32_t>{4, 5} && decision.evictions == std::vector<uint32_t>{1, 3};
+  items[1].locked            = true;
+  decision                   = decideResidency(tight, items);
+  order = order && decision.loads == std::vector<uint32_t>{4, 5} && decision.evictions == std::vector<uint32_t>{3, 2};
+
+  // The resident bias keeps an item against a slightly better one, not against a clearly better one
+  ResidencySettings one{.budget = 100};
+  items = {{.bytes = 100, .priority = 1.0f, .resident = true}, {.bytes = 100, .priority = 1.2f}};
+  order = order && decideResidency(one, items).loads.empty();
+  items[1].priority = 1.3f;
+  decision          = decideResidency(one, items);
+  order = order && decision.loads == std::vector<uint32_t>{1} && decision.evictions == std::vector<uint32_t>{0};
+
+  // Per-update limits: at most maxLoads and maxLoadBytes, highest priority first, a single larger item still loads
+  ResidencySettings limited{.budget = 10000, .maxLoads = 2, .maxLoadBytes = 150};
+  items = {{.bytes = 100, .priority = 1.0f}, {.bytes = 100, .priority = 3.0f}, {.bytes = 50, .priority = 2.0f}, {.bytes = 10, .priority = 0.5f}};
+  bool limits = decideResidency(limited, items).loads == std::vector<uint32_t>{1, 2};
+  items       = {{.bytes = 500, .priority = 1.0f}, {.bytes = 10, .priority = 0.5f}};
+  limits      = limits && decideResidency(limited, items).loads == std::vector<uint32_t>{0};
+
+  // Random scenes over moving priorities: after every update the resident bytes stay within the budget, loads are
+  // missing items, evictions resident ones, and the same inputs give the same decision
+  std::mt19937                          rng(107);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  ResidencySettings                     settings{.budget = 4000, .maxLoads = 4, .maxLoadBytes = 1500};
+  items.assign(200, {});
+  for(ResidencyItem& item : items)
+  {
+    item.bytes = 10 + rng() % 300;
+  }
+  bool     budget = true, repeatable = true;
+  uint64_t maxResident = 0;
+  for(int update = 0; update < 100; ++update)
+  {
+    const glm::vec3 camera(std::sin(update * 0.1f) * 50.0f, 0.0f, std::cos(update * 0.1f) * 50.0f);
+    for(uint32_t i = 0; i < uint32_t(items.size()); ++i)
+    {
+      const glm::vec3 center(float(i % 20) * 5.0f - 50.0f, 0.0f, float(i / 20) * 10.0f - 50.0f);
+      items[i].priority = residencyPriority(center, 1.0f + unit(rng), camera, glm::normalize(-camera));
+    }
+
+    decision = decideResidency(settings, items);
+    const ResidencyDecision again = decideResidency(settings, items);
+    repeatable = repeatable && decision.loads == again.loads && decision.evictions == again.evictions;
+
+    uint64_t loadBytes = 0;
+    for(uint32_t i : decision.loads)
+    {
+      budget = budget && !items[i].resident && items[i].priority > 0.0f;
+      items[i].resident = true;
+      loadBytes += items[i].bytes;
+    }
+    budget = budget && decision.loads.size() <= settings.maxLoads && (decision.loads.size() <= 1 || loadBytes <= settings.maxLoadBytes);
+    for(uint32_t i : decision.evictions)
+    {
+      budget = budget && items[i].resident;
+      items[i].resident = false;
+    }
+    uint64_t resident = 0;
+    for(const ResidencyItem& item : items)
+    {
+      resident += item.resident ? item.bytes : 0;
+    }
+    budget      = budget && resident <= settings.budget;
+    maxResident = std::max(maxResident, resident);
+  }
+
+  const bool passed = priorities && order && limits && budget && repeatable;
+  LOGI("Residency self test %s: priorities %s, eviction order %s, limits %s, budget %s (at most %llu of %llu bytes), "
+       "repeatable %s\n",
+       passed ? "passed" : "FAILED", priorities ? "ok" : "FAILED", order ? "ok" : "FAILED", limits ? "ok" : "FAILED",
+       budget ? "ok" : "FAILED", (unsigned long long)maxResident, (unsigned long long)settings.budget,
+       repeatable ? "ok" : "FAILED");
+  return passed;
+}
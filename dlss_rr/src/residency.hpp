@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+// Residency policy of the geometry streaming, without any Vulkan: the same inputs always give the same
+// decision, so it can be exercised on its own.
+
+struct ResidencySettings
+{
+  uint64_t budget       = 256ull << 20;  // device memory for the full resolution BLASes
+  uint32_t maxLoads     = 8;             // started per update
+  uint64_t maxLoadBytes = 64ull << 20;   // started per update; a single larger item is still allowed
+  float    residentBias = 1.25f;         // priority factor of resident items, against thrashing
+};
+
+// One per streamed item (mesh)
+struct ResidencyItem
+{
+  uint64_t bytes    = 0;      // device memory when resident
+  float    priority = 0.0f;   // <= 0: not needed
+  bool     resident = false;  // loaded or being loaded, counts against the budget
+  bool     locked   = false;  // resident but can't be evicted yet, e.g. still loading
+};
+
+struct ResidencyDecision
+{
+  std::vector<uint32_t> loads;      // highest priority first
+  std::vector<uint32_t> evictions;  // lowest priority first
+};
+
+// Priority of an instance: its bounding sphere's size relative to the distance, as a stand-in for the
+// screen coverage. Spheres entirely behind the camera keep a tenth of it, they still show up in reflections
+// and shadows. 'forward' is normalized.
+float residencyPriority(const glm::vec3& center, float radius, const glm::vec3& eye, const glm::vec3& forward);
+
+// Items are ranked by priority (resident ones scaled by 'residentBias', ties by index) and the ranking is
+// filled up to the budget. Missing items of that set are loaded within the per-update limits. Resident items
+// outside of it are only evicted when the loads need the room, lowest priority first.
+ResidencyDecision decideResidency(const ResidencySettings& settings, std::span<const ResidencyItem> items);
+
+// Checks the priorities by distance and direction, the budget over repeated updates, the eviction order, the
+// per-update limits and that the same inputs give the same decision
+bool residencySelfTest();
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "simplified_blas.hpp"
+
+#include <nvapp/application.hpp>
+#include <nvvk/check_error.hpp>
+#include <nvvk/debug_util.hpp>
+#include <nvvk/staging.hpp>
+
+#include "shaders/host_device.h"
+
+#include <cassert>
+
+
+static VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+{
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+
+SimplifiedBlasSet::~SimplifiedBlasSet()
+{
+  assert(m_bTable.buffer == VK_NULL_HANDLE && "Must call destroy");
+}
+
+void SimplifiedBlasSet::create(nvapp::Application* app, nvvk::ResourceAllocator* alloc, std::span<const SimplifiedMesh> meshes)
+{
+  assert(m_bTable.buffer == VK_NULL_HANDLE && "Call destroy first");
+  m_alloc = alloc;
+  m_blas.assign(meshes.size(), {});
+  m_triangleCounts.assign(meshes.size(), 0);
+
+  struct Range
+  {
+    uint32_t firstVertex   = 0;
+    uint32_t firstTriangle = 0;
+  };
+
+  // All slots in one set of buffers
+  std::vector<glm::vec3>  positions;
+  std::vector<glm::uvec3> indices;
+  std::vector<glm::uvec3> shadeIndices;
+  std::vector<Range>      ranges(meshes.size());
+  for(size_t i = 0; i < meshes.size(); ++i)
+  {
+    const SimplifiedMesh& mesh = meshes[i];
+    ranges[i]                  = {uint32_t(positions.size()), uint32_t(indices.size())};
+    m_triangleCounts[i]        = uint32_t(mesh.triangles.size());
+    positions.insert(positions.end(), mesh.positions.begin(), mesh.positions.end());
+    for(const glm::uvec3& t : mesh.triangles)
+    {
+      indices.push_back(t);
+      shadeIndices.emplace_back(mesh.vertices[t.x], mesh.vertices[t.y], mesh.vertices[t.z]);
+    }
+  }
+
+  const VkBufferUsageFlags2KHR buildInput = VK_BUFFER_USAGE_2_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR
+                                            | VK_BUFFER_USAGE_2_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_2_TRANSFER_DST_BIT;
+  const VkBufferUsageFlags2KHR storage =
+      VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_2_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_2_TRANSFER_DST_BIT;
+
+  nvvk::StagingUploader uploader;
+  uploader.init(m_alloc);
+
+  std::vector<shaderio::SimplifiedPrimitive> table(meshes.size(), shaderio::SimplifiedPrimitive{});
+  if(!indices.empty())
+  {
+    NVVK_CHECK(m_alloc->createBuffer(m_bPositions, std::span(positions).size_bytes(), buildInput));
+    NVVK_CHECK(m_alloc->createBuffer(m_bIndices, std::span(indices).size_bytes(), buildInput));
+    NVVK_CHECK(m_alloc->createBuffer(m_bShadeIndices, std::span(shadeIndices).size_bytes(), storage));
+    NVVK_DBG_NAME(m_bPositions.buffer);
+    NVVK_DBG_NAME(m_bIndices.buffer);
+    NVVK_DBG_NAME(m_bShadeIndices.buffer);
+    NVVK_CHECK(uploader.appendBuffer(m_bPositions, 0, std::span(positions)));
+    NVVK_CHECK(uploader.appendBuffer(m_bIndices, 0, std::span(indices)));
+    NVVK_CHECK(uploader.appendBuffer(m_bShadeIndices, 0, std::span(shadeIndices)));
+    m_bytes = m_bPositions.bufferSize + m_bIndices.bufferSize + m_bShadeIndices.bufferSize;
+
+    for(size_t i = 0; i < meshes.size(); ++i)
+    {
+      if(m_triangleCounts[i] > 0)
+      {
+        table[i] = {.indices = (glm::uvec3*)(m_bShadeIndices.address + ranges[i].firstTriangle * sizeof(glm::uvec3)),
+                    .triangleCount = m_triangleCounts[i]};
+      }
+    }
+  }
+  NVVK_CHECK(m_alloc->createBuffer(m_bTable, std::max(std::span(table).size_bytes(), sizeof(shaderio::SimplifiedPrimitive)), storage));
+  NVVK_DBG_NAME(m_bTable.buffer);
+  NVVK_CHECK(uploader.appendBuffer(m_bTable, 0, std::span(table)));
+  m_bytes += m_bTable.bufferSize;
+
+  VkCommandBuffer cmd = app->createTempCmdBuffer();
+  uploader.cmdUploadAppended(cmd);
+
+  const VkMemoryBarrier2 uploaded{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                  .srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                  .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                  .dstStageMask  = VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                                  .dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR};
+  const VkDependencyInfo depUploaded{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &uploaded};
+  vkCmdPipelineBarrier2(cmd, &depUploaded);
+
+  // One BLAS per slot, all built at once with their own part of the scratch buffer
+  VkPhysicalDeviceAccelerationStructurePropertiesKHR asProps{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR};
+  VkPhysicalDeviceProperties2 props{.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2, .pNext = &asProps};
+  vkGetPhysicalDeviceProperties2(app->getPhysicalDevice(), &props);
+
+  std::vector<VkAccelerationStructureGeometryKHR>          geometries;
+  std::vector<VkAccelerationStructureBuildGeometryInfoKHR> buildInfos;
+  std::vector<VkAccelerationStructureBuildRangeInfoKHR>    buildRanges;
+  std::vector<VkDeviceSize>                                scratchOffsets;
+  geometries.reserve(meshes.size());
+  VkDeviceSize scratchSize = 0;
+  for(size_t i = 0; i < meshes.size(); ++i)
+  {
+    if(m_triangleCounts[i] == 0)
+    {
+      continue;
+    }
+    const Range& range = ranges[i];
+
+    geometries.push_back({
+        .sType        = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR,
+        .geometryType = VK_GEOMETRY_TYPE_TRIANGLES_KHR,
+        .geometry     = {.triangles = {.sType        = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_TRIANGLES_DATA_KHR,
+                                       .vertexFormat = VK_FORMAT_R32G32B32_SFLOAT,
+                                       .vertexData = {.deviceAddress = m_bPositions.address + range.firstVertex * sizeof(glm::vec3)},
+                                       .vertexStride = sizeof(glm::vec3),
+                                       .maxVertex    = uint32_t(meshes[i].positions.size()) - 1,
+                                       .indexType    = VK_INDEX_TYPE_UINT32,
+                                       .indexData = {.deviceAddress = m_bIndices.address + range.firstTriangle * sizeof(glm::uvec3)}}},
+        .flags        = VK_GEOMETRY_NO_DUPLICATE_ANY_HIT_INVOCATION_BIT_KHR,
+    });
+
+    VkAccelerationStructureBuildGeometryInfoKHR buildInfo{.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR,
+                                                          .type  = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR,
+                                                          .flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR,
+                                                          .mode  = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR,
+                                                          .geometryCount = 1,
+                                                          .pGeometries   = &geometries.back()};
+    VkAccelerationStructureBuildSizesInfoKHR sizeInfo{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR};
+    vkGetAccelerationStructureBuildSizesKHR(m_alloc->getDevice(), VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR,
+                                            &buildInfo, &m_triangleCounts[i], &sizeInfo);
+
+    const VkAccelerationStructureCreateInfoKHR createInfo{.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR,
+                                                          .size  = sizeInfo.accelerationStructureSize,
+                                                          .type  = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR};
+    NVVK_CHECK(m_alloc->createAcceleration(m_blas[i], createInfo));
+    NVVK_DBG_NAME(m_blas[i].accel);
+    m_bytes += sizeInfo.accelerationStructureSize;
+
+    buildInfo.dstAccelerationStructure = m_blas[i].accel;
+    buildInfos.push_back(buildInfo);
+    buildRanges.push_back({.primitiveCount = m_triangleCounts[i]});
+    scratchOffsets.push_back(scratchSize);
+    scratchSize = alignUp(scratchSize + sizeInfo.buildScratchSize, asProps.minAccelerationStructureScratchOffsetAlignment);
+  }
+
+  nvvk::Buffer scratch;
+  if(!buildInfos.empty())
+  {
+    NVVK_CHECK(m_alloc->createBuffer(scratch, scratchSize, VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_2_SHADER_DEVICE_ADDRESS_BIT,
+                                     VMA_MEMORY_USAGE_AUTO, {}, asProps.minAccelerationStructureScratchOffsetAlignment));
+    std::vector<const VkAccelerationStructureBuildRangeInfoKHR*> rangePointers;
+    for(size_t b = 0; b < buildInfos.size(); ++b)
+    {
+      buildInfos[b].scratchData.deviceAddress = scratch.address + scratchOffsets[b];
+      rangePointers.push_back(&buildRanges[b]);
+    }
+    vkCmdBuildAccelerationStructuresKHR(cmd, uint32_t(buildInfos.size()), buildInfos.data(), rangePointers.data());
+  }
+
+  app->submitAndWaitTempCmdBuffer(cmd);
+  m_alloc->destroyBuffer(scratch);
+  uploader.deinit();
+}
+
+void SimplifiedBlasSet::destroy()
+{
+  if(m_alloc == nullptr)
+  {
+    return;
+  }
+  for(nvvk::AccelerationStructure& blas : m_blas)
+  {
+    m_alloc->destroyAcceleration(blas);
+  }
+  m_alloc->destroyBuffer(m_bPositions);
+  m_alloc->destroyBuffer(m_bIndices);
+  m_alloc->destroyBuffer(m_bShadeIndices);
+  m_alloc->destroyBuffer(m_bTable);
+  m_blas.clear();
+  m_triangleCounts.clear();
+  m_bytes = 0;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <nvvk/resource_allocator.hpp>
+
+#include "mesh_simplify.hpp"
+
+#include <span>
+#include <vector>
+
+namespace nvapp {
+class Application;
+}
+
+
+// BLASes of simplified render primitives (streaming proxies, LOD levels), one per slot, with the table of
+// shaderio::SimplifiedPrimitive the hit shaders find their triangle indices in. The indices of the table
+// address the vertices of the original render primitive, see SimplifiedMesh::vertices.
+// Empty slots have no BLAS and a zero table entry.
+class SimplifiedBlasSet
+{
+public:
+  SimplifiedBlasSet() = default;
+  ~SimplifiedBlasSet();
+
+  // One slot per mesh, all BLASes are built in one go. Waits for the GPU.
+  void create(nvapp::Application* app, nvvk::ResourceAllocator* alloc, std::span<const SimplifiedMesh> meshes);
+  void destroy();
+
+  size_t          size() const { return m_blas.size(); }
+  VkDeviceAddress blasAddress(size_t slot) const { return m_blas[slot].address; }
+  uint32_t        triangleCount(size_t slot) const { return m_triangleCounts[slot]; }
+  VkDeviceAddress table() const { return m_bTable.address; }
+  VkDeviceSize    bytes() const { return m_bytes; }  // buffers and BLASes
+
+private:
+  nvvk::ResourceAllocator*                 m_alloc = nullptr;
+  std::vector<nvvk::AccelerationStructure> m_blas;
+  std::vector<uint32_t>                    m_triangleCounts;
+
+  nvvk::Buffer m_bPositions;
+  nvvk::Buffer m_bIndices;       // into m_bPositions, for the BLAS builds
+  nvvk::Buffer m_bShadeIndices;  // into the render primitive's vertices, for the hit shaders
+  nvvk::Buffer m_bTable;
+
+  VkDeviceSize m_bytes = 0;
+};
@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "stereo_reuse.hpp"
+
+#include <imgui/imgui.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <nvgui/property_editor.hpp>
+#include <nvvk/check_error.hpp>
+#include <nvvk/debug_util.hpp>
+#include <nvvk/descriptors.hpp>
+#include <nvvk/pipeline.hpp>
+#include <nvvk/shaders.hpp>
+
+#include <cassert>
+#include <iterator>
+
+
+StereoReuse::~StereoReuse()
+{
+  assert(m_capturePipeline == VK_NULL_HANDLE && "Must call deinit");
+}
+
+void StereoReuse::init(nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv, uint32_t frameCycleSize)
+{
+  assert(m_capturePipeline == VK_NULL_HANDLE && "Init already called");
+
+  m_alloc  = alloc;
+  m_device = alloc->getDevice();
+
+  NVVK_CHECK(m_alloc->createBuffer(m_stats, sizeof(shaderio::StereoReuseStats),
+                                   VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_2_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_2_TRANSFER_DST_BIT));
+  NVVK_DBG_NAME(m_stats.buffer);
+  m_readback.init(m_alloc, sizeof(shaderio::StereoReuseStats), frameCycleSize);
+
+  nvvk::DescriptorBindings bindings;
+  for(uint32_t binding : {shaderio::StereoReuseBindings::eStereoColor, shaderio::StereoReuseBindings::eStereoViewZ,
+                          shaderio::StereoReuseBindings::eStereoSpecHitDist})
+  {
+    bindings.addBinding(binding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+  }
+  for(uint32_t binding : {shaderio::StereoReuseBindings::eStereoSource, shaderio::StereoReuseBindings::eStereoResult,
+                          shaderio::StereoReuseBindings::eStereoStats})
+  {
+    bindings.addBinding(binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+  }
+  NVVK_CHECK(bindings.createDescriptorSetLayout(m_device, VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR, &m_dsetLayout));
+  NVVK_DBG_NAME(m_dsetLayout);
+
+  const VkPushConstantRange pushConstant{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(shaderio::StereoReusePushConstant)};
+  NVVK_CHECK(nvvk::createPipelineLayout(m_device, &m_pipelineLayout, {m_dsetLayout}, {pushConstant}));
+  NVVK_DBG_NAME(m_pipelineLayout);
+
+  VkShaderModule module = VK_NULL_HANDLE;
+  NVVK_CHECK(nvvk::createShaderModule(module, m_device, spirv));
+
+  VkComputePipelineCreateInfo pipelineInfo{
+      .sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+      .stage  = {.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, .stage = VK_SHADER_STAGE_COMPUTE_BIT, .module = module, .pName = "captureMain"},
+      .layout = m_pipelineLayout,
+  };
+  NVVK_CHECK(vkCreateComputePipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_capturePipeline));
+  NVVK_DBG_NAME(m_capturePipeline);
+  pipelineInfo.stage.pName = "statsMain";
+  NVVK_CHECK(vkCreateComputePipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_statsPipeline));
+  NVVK_DBG_NAME(m_statsPipeline);
+
+  vkDestroyShaderModule(m_device, module, nullptr);
+}
+
+void StereoReuse::deinit()
+{
+  vkDestroyPipeline(m_device, m_capturePipeline, nullptr);
+  vkDestroyPipeline(m_device, m_statsPipeline, nullptr);
+  vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
+  vkDestroyDescriptorSetLayout(m_device, m_dsetLayout, nullptr);
+  m_capturePipeline = VK_NULL_HANDLE;
+  m_statsPipeline   = VK_NULL_HANDLE;
+  m_pipelineLayout  = VK_NULL_HANDLE;
+  m_dsetLayout      = VK_NULL_HANDLE;
+
+  m_readback.deinit();
+  m_alloc->destroyBuffer(m_stats);
+  m_alloc->destroyBuffer(m_source);
+  m_alloc->destroyBuffer(m_classes);
+}
+
+void StereoReuse::resize(VkExtent2D maxSize)
+{
+  m_alloc->destroyBuffer(m_source);
+  m_alloc->destroyBuffer(m_classes);
+
+  // Both are written in full before they are read
+  const VkDeviceSize           pixels  = VkDeviceSize(maxSize.width) * maxSize.height;
+  const VkBufferUsageFlags2KHR storage = VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_2_SHADER_DEVICE_ADDRESS_BIT;
+  NVVK_CHECK(m_alloc->createBuffer(m_source, pixels * sizeof(shaderio::StereoSource), storage));
+  NVVK_DBG_NAME(m_source.buffer);
+  NVVK_CHECK(m_alloc->createBuffer(m_classes, pixels * sizeof(glm::vec4), storage));
+  NVVK_DBG_NAME(m_classes.buffer);
+
+  m_readback.invalidate();
+  m_result = {};
+}
+
+glm::mat4 StereoReuse::eyeView(const glm::mat4& view, uint32_t eye) const
+{
+  // The first eye is to the left of the camera: in its view space the scene moves right
+  const float offset = eye == 0 ? 0.5f * ipd : -0.5f * ipd;
+  return glm::translate(glm::mat4(1.0f), glm::vec3(offset, 0.0f, 0.0f)) * view;
+}
+
+void StereoReuse::setFrameInfo(shaderio::FrameInfo& second, const shaderio::FrameInfo& first) const
+{
+  second.flags                = (second.flags & ~FLAGS_STEREO_REUSE) | (reuse ? FLAGS_STEREO_REUSE : 0);
+  second.stereoSourceMVP      = first.proj * first.view;
+  second.stereoSource         = (shaderio::StereoSource*)m_source.address;
+  second.stereoResult         = (glm::vec4*)m_classes.address;
+  second.stereoDepthTolerance = depthTolerance;
+  second.stereoMinRoughness   = minRoughness;
+  second.stereoValidation     = validation;
+}
+
+void StereoReuse::readResults(uint32_t cycleIndex)
+{
+  const auto* stats = m_readback.map<shaderio::StereoReuseStats>(cycleIndex);
+  if(stats == nullptr || !enabled || !reuse)
+  {
+    return;
+  }
+
+  uint32_t surface = 0;
+  for(uint32_t i = 0; i < STEREO_CLASSES; ++i)
+  {
+    m_result.pixels[i] = stats->pixels[i];
+    surface += i == STEREO_SKY ? 0 : stats->pixels[i];
+  }
+  const uint32_t reused    = stats->pixels[STEREO_REUSED];
+  const uint32_t validated = stats->pixels[STEREO_VALIDATED];
+  m_result.reusedFraction  = surface ? double(reused) / surface : 0.0;
+  m_result.meanDepthError  = reused + validated ? double(stats->depthErrorSum) / STEREO_FIXED_POINT / (reused + validated) : 0.0;
+  m_result.meanLumError    = validated ? double(stats->lumErrorSum) / STEREO_FIXED_POINT / validated : 0.0;
+}
+
+void StereoReuse::pushDescriptors(VkCommandBuffer cmd, const Inputs& inputs)
+{
+  auto imageWrite = [](uint32_t binding, const VkDescriptorImageInfo& info) {
+    return VkWriteDescriptorSet{.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                                .dstBinding      = binding,
+                                .descriptorCount = 1,
+                                .descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                .pImageInfo      = &info};
+  };
+  auto bufferWrite = [](uint32_t binding, const VkDescriptorBufferInfo& info) {
+    return VkWriteDescriptorSet{.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                                .dstBinding      = binding,
+                                .descriptorCount = 1,
+                                .descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                .pBufferInfo     = &info};
+  };
+  const VkDescriptorBufferInfo sourceInfo{m_source.buffer, 0, VK_WHOLE_SIZE};
+  const VkDescriptorBufferInfo classesInfo{m_classes.buffer, 0, VK_WHOLE_SIZE};
+  const VkDescriptorBufferInfo statsInfo{m_stats.buffer, 0, VK_WHOLE_SIZE};
+
+  const VkWriteDescriptorSet writes[] = {
+      imageWrite(shaderio::StereoReuseBindings::eStereoColor, inputs.color),
+      imageWrite(shaderio::StereoReuseBindings::eStereoViewZ, inputs.viewZ),
+      imageWrite(shaderio::StereoReuseBindings::eStereoSpecHitDist, inputs.specHitDist),
+      bufferWrite(shaderio::StereoReuseBindings::eStereoSource, sourceInfo),
+      bufferWrite(shaderio::StereoReuseBindings::eStereoResult, classesInfo),
+      bufferWrite(shaderio::StereoReuseBindings::eStereoStats, statsInfo),
+  };
+  vkCmdPushDescriptorSetKHR(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, uint32_t(std::size(writes)), writes);
+}
+
+void StereoReuse::pushConstants(VkCommandBuffer cmd, VkExtent2D size)
+{
+  const shaderio::StereoReusePushConstant pushConst{.size = {int32_t(size.width), int32_t(size.height)}};
+  vkCmdPushConstants(cmd, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConst), &pushConst);
+}
+
+void StereoReuse::cmdCapture(VkCommandBuffer cmd, const Inputs& inputs, VkExtent2D size)
+{
+  vkCmdFillBuffer(cmd, m_stats.buffer, 0, VK_WHOLE_SIZE, 0);
+
+  // Clear done, last frame's second eye done reading the source
+  const VkMemoryBarrier2 before{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                .srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
+                                .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_READ_BIT,
+                                .dstStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                .dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT};
+  const VkDependencyInfo depBefore{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &before};
+  vkCmdPipelineBarrier2(cmd, &depBefore);
+
+  vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_capturePipeline);
+  pushDescriptors(cmd, inputs);
+  pushConstants(cmd, size);
+  const VkExtent2D groups = getGridSize(size);
+  vkCmdDispatch(cmd, groups.width, groups.height, 1);
+
+  // Source read by the second eye's ray generation, which also overwrites the captured buffers
+  const VkMemoryBarrier2 after{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                               .srcStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                               .srcAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT,
+                               .dstStageMask  = VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
+                               .dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT};
+  const VkDependencyInfo depAfter{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &after};
+  vkCmdPipelineBarrier2(cmd, &depAfter);
+}
+
+void StereoReuse::cmdReduce(VkCommandBuffer cmd, const Inputs& inputs, VkExtent2D size, uint32_t cycleIndex)
+{
+  // Classes written by the ray generation
+  const VkMemoryBarrier2 before{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                .srcStageMask  = VK_PIPELINE_STAGE_2_RAY_TRACING_SHADER_BIT_KHR,
+                                .srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT,
+                                .dstStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                .dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT};
+  const VkDependencyInfo depBefore{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &before};
+  vkCmdPipelineBarrier2(cmd, &depBefore);
+
+  vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_statsPipeline);
+  pushDescriptors(cmd, inputs);
+  pushConstants(cmd, size);
+  const VkExtent2D groups = getGridSize(size);
+  vkCmdDispatch(cmd, groups.width, groups.height, 1);
+
+  const VkMemoryBarrier2 after{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                               .srcStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                               .srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT,
+                               .dstStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                               .dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT};
+  const VkDependencyInfo depAfter{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO, .memoryBarrierCount = 1, .pMemoryBarriers = &after};
+  vkCmdPipelineBarrier2(cmd, &depAfter);
+
+  m_readback.cmdCopy(cmd, m_stats.buffer, cycleIndex);
+}
+
+bool StereoReuse::onUI()
+{
+  using namespace nvgui;
+
+  bool toggled = false;
+  PropertyEditor::begin();
+  toggled = PropertyEditor::entry("Enable", [&] { return ImGui::Checkbox("##stereo", &enabled); },
+                                  "Render a second eye with its own DLSS_RR after the first one");
+  if(enabled)
+  {
+    if(PropertyEditor::entry("Reuse Shading", [&] { return ImGui::Checkbox("##reuse", &reuse); },
+                             "Second eye: take the first eye's shading where it sees the same surface, trace the rest"))
+    {
+      m_readback.invalidate();
+      m_result = {};
+    }
+    PropertyEditor::entry("Show Eye", [&] { return ImGui::Combo("##eye", &showEye, "First (left)\0Second (right)\0"); },
+                          "Denoised output shown in the viewport");
+    PropertyEditor::entry(
+        "IPD", [&] { return ImGui::SliderFloat("##ipd", &ipd, 0.0f, 1.0f, "%.3f", ImGuiSliderFlags_Logarithmic); },
+        "Interpupillary distance in scene units; glTF scenes are in meters");
+    PropertyEditor::entry(
+        "Depth Tolerance",
+        [&] { return ImGui::SliderFloat("##depthTol", &depthTolerance, 0.001f, 0.1f, "%.3f", ImGuiSliderFlags_Logarithmic); },
+        "Relative ViewZ difference up to which both eyes see the same surface");
+    PropertyEditor::entry(
+        "Min Roughness", [&] { return ImGui::SliderFloat("##minRoughness", &minRoughness, 0.0f, 1.0f, "%.2f"); },
+        "Smoother surfaces reflect different things to each eye and are always shaded");
+    PropertyEditor::entry(
+        "Validation", [&] { return ImGui::SliderInt("##validation", (int*)&validation, 0, 64, "1 in %d"); },
+        "One of this many reusable pixels is shaded anyway to measure the error of the reuse; 0 disables it");
+  }
+  PropertyEditor::end();
+
+  const StereoReuseResult& r = m_result;
+  if(enabled && reuse && r.reusedFraction > 0.0)
+  {
+    ImGui::Text("Shading reused: %.1f%% of the surface pixels", r.reusedFraction * 100.0);
+    ImGui::Text("Traced: %u disoccluded, %u offscreen, %u view dependent", r.pixels[STEREO_DISOCCLUDED],
+                r.pixels[STEREO_OFFSCREEN], r.pixels[STEREO_VIEW_DEPENDENT]);
+    ImGui::Text("Reprojection error: depth %.4f, luminance %.3f (%u samples)", r.meanDepthError, r.meanLumError,
+                r.pixels[STEREO_VALIDATED]);
+    ImGui::SetItemTooltip("Mean relative ViewZ difference of the reused surfaces, and mean relative luminance difference "
+                          "between the reused and the shaded color of the validation pixels; includes the path tracing noise");
+  }
+  return toggled;
+}
+
+nlohmann::json StereoReuse::toJson() const
+{
+  static const char* classes[] = {"sky", "reused", "validated", "disoccluded", "offscreen", "view_dependent"};
+  nlohmann::json     pixels;
+  for(uint32_t i = 0; i < STEREO_CLASSES; ++i)
+  {
+    pixels[classes[i]] = m_result.pixels[i];
+  }
+  return {{"enabled", enabled},
+          {"reuse", reuse},
+          {"ipd", ipd},
+          {"depth_tolerance", depthTolerance},
+          {"min_roughness", minRoughness},
+          {"validation", validation},
+          {"pixels", pixels},
+          {"reused_fraction", m_result.reusedFraction},
+          {"mean_depth_error", m_result.meanDepthError},
+          {"mean_luminance_error", m_result.meanLumError}};
+}
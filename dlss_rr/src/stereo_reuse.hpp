@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <glm/glm.hpp>
+#include <nvvk/resource_allocator.hpp>
+#include <tinygltf/json.hpp>
+
+#include "readback_ring.hpp"
+#include "shaders/host_device.h"
+
+#include <array>
+#include <span>
+
+
+struct StereoReuseResult
+{
+  // Of the second eye, per STEREO_* class
+  std::array<uint32_t, STEREO_CLASSES> pixels{};
+  // Share of its surface pixels skipping the direct and indirect rays
+  double reusedFraction = 0.0;
+  // Relative ViewZ difference of the reused surfaces, relative luminance difference over the validated pixels
+  double meanDepthError = 0.0;
+  double meanLumError   = 0.0;
+};
+
+
+// StereoReuse renders a second eye next to the sample's view and reuses the first eye's shading for it
+// (stereo_reuse.slang). Both eyes are the camera shifted by half the interpupillary distance along its x axis and
+// share the render buffers: after the first eye's DLSS_RR, its noisy color, ViewZ and specular hit distance are
+// captured, then the second eye traces its primary rays, projects each hit into the first eye and takes that
+// shading where the first eye's ViewZ matches. Only disoccluded, offscreen and view-dependent pixels trace the
+// direct and indirect rays. Each eye has its own DLSS_RR instance. The per-pixel classes are reduced to statistics
+// and read back through a ReadbackRing.
+class StereoReuse
+{
+public:
+  // First eye's render buffers, in VK_IMAGE_LAYOUT_GENERAL
+  struct Inputs
+  {
+    VkDescriptorImageInfo color;
+    VkDescriptorImageInfo viewZ;
+    VkDescriptorImageInfo specHitDist;
+  };
+
+  StereoReuse() = default;
+  ~StereoReuse();
+
+  void init(nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv, uint32_t frameCycleSize);
+  void deinit();
+
+  // (Re)creates the per pixel buffers for the maximum render size
+  void resize(VkExtent2D maxSize);
+
+  // View matrix of eye 0 (first, left) or 1 (second, right) for the camera's 'view'
+  glm::mat4 eyeView(const glm::mat4& view, uint32_t eye) const;
+
+  // Stereo part of the second eye's FrameInfo, 'first' is the first eye's
+  void setFrameInfo(shaderio::FrameInfo& second, const shaderio::FrameInfo& first) const;
+
+  // Fetches the result of the frame that last used 'cycleIndex'
+  void readResults(uint32_t cycleIndex);
+
+  // After the first eye's DLSS_RR: copies its shading, for the second eye's ray generation
+  void cmdCapture(VkCommandBuffer cmd, const Inputs& inputs, VkExtent2D size);
+  // After the second eye's trace: statistics of its pixel classes
+  void cmdReduce(VkCommandBuffer cmd, const Inputs& inputs, VkExtent2D size, uint32_t cycleIndex);
+
+  const StereoReuseResult& result() const { return m_result; }
+
+  // Settings and the last result; returns true when the stereo views change
+  bool           onUI();
+  nlohmann::json toJson() const;
+
+  bool     enabled        = false;   // render the second eye
+  bool     reuse          = true;    // with the first eye's shading; shades every pixel otherwise
+  int      showEye        = 0;       // shown in the viewport
+  float    ipd            = 0.064f;  // interpupillary distance, in scene units (meters for glTF)
+  float    depthTolerance = 0.01f;   // relative ViewZ difference
+  float    minRoughness   = 0.3f;    // smoother surfaces are always shaded
+  uint32_t validation     = 16;      // one of this many reusable pixels is shaded to measure the error; 0: none
+
+private:
+  void pushDescriptors(VkCommandBuffer cmd, const Inputs& inputs);
+  void pushConstants(VkCommandBuffer cmd, VkExtent2D size);
+
+  nvvk::ResourceAllocator* m_alloc           = nullptr;
+  VkDevice                 m_device          = VK_NULL_HANDLE;
+  VkDescriptorSetLayout    m_dsetLayout      = VK_NULL_HANDLE;
+  VkPipelineLayout         m_pipelineLayout  = VK_NULL_HANDLE;
+  VkPipeline               m_capturePipeline = VK_NULL_HANDLE;
+  VkPipeline               m_statsPipeline   = VK_NULL_HANDLE;
+  nvvk::Buffer             m_source;   // StereoSource per pixel of the first eye
+  nvvk::Buffer             m_classes;  // written by the second eye's ray generation
+  nvvk::Buffer             m_stats;
+  ReadbackRing             m_readback;
+
+  StereoReuseResult m_result;
+};
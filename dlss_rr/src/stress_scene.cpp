@@ -0,0 +1,430 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "stress_scene.hpp"
+
+#include <nvutils/logger.hpp>
+#include <nvutils/parameter_registry.hpp>
+#include <tinygltf/tiny_gltf.h>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <span>
+#include <utility>
+#include <vector>
+
+
+static const float kSpacing = 3.0f;  // between the instances of the field
+
+// PCG32: the scenes must not depend on the standard library's distributions
+class Random
+{
+public:
+  explicit Random(uint64_t seed)
+      : m_state(seed * 6364136223846793005ull + 1442695040888963407ull)
+  {
+    next();
+  }
+
+  uint32_t next()
+  {
+    const uint64_t old = m_state;
+    m_state            = old * 6364136223846793005ull + 1442695040888963407ull;
+    const uint32_t xorShifted = uint32_t(((old >> 18u) ^ old) >> 27u);
+    const uint32_t rot        = uint32_t(old >> 59u);
+    return (xorShifted >> rot) | (xorShifted << ((32 - rot) & 31));
+  }
+
+  float    uniform() { return float(next() >> 8) / float(1 << 24); }  // [0, 1)
+  float    range(float a, float b) { return a + (b - a) * uniform(); }
+  uint32_t below(uint32_t n) { return n ? next() % n : 0; }
+
+private:
+  uint64_t m_state;
+};
+
+struct Geometry
+{
+  std::vector<glm::vec3>  positions;
+  std::vector<glm::vec3>  normals;
+  std::vector<glm::vec2>  uvs;
+  std::vector<glm::uvec3> triangles;
+};
+
+// Cube mapped sphere with n x n quads per face (12 n^2 triangles), its radius displaced by a few random waves
+static Geometry makeBlob(uint32_t n, float displacement, Random& rng)
+{
+  glm::vec3 waveDir[3];
+  float     waveFreq[3];
+  float     wavePhase[3];
+  for(int k = 0; k < 3; ++k)
+  {
+    waveDir[k]   = glm::normalize(glm::vec3(rng.range(-1, 1), rng.range(-1, 1), rng.range(-1, 1)) + glm::vec3(1e-3f));
+    waveFreq[k]  = rng.range(2.0f, 6.0f);
+    wavePhase[k] = rng.range(0.0f, 6.2831853f);
+  }
+
+  const glm::vec3 faceNormal[6] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+  const glm::vec3 faceU[6]      = {{0, 0, -1}, {0, 0, 1}, {1, 0, 0}, {1, 0, 0}, {1, 0, 0}, {-1, 0, 0}};
+  const glm::vec3 faceV[6]      = {{0, 1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}, {0, 1, 0}, {0, 1, 0}};
+
+  Geometry geometry;
+  for(int f = 0; f < 6; ++f)
+  {
+    const uint32_t base = uint32_t(geometry.positions.size());
+    for(uint32_t j = 0; j <= n; ++j)
+    {
+      for(uint32_t i = 0; i <= n; ++i)
+      {
+        const glm::vec2 uv(float(i) / float(n), float(j) / float(n));
+        const glm::vec3 dir = glm::normalize(faceNormal[f] + (uv.x * 2.0f - 1.0f) * faceU[f] + (uv.y * 2.0f - 1.0f) * faceV[f]);
+        float           radius = 1.0f;
+        for(int k = 0; k < 3; ++k)
+        {
+          radius += displacement * std::sin(glm::dot(dir, waveDir[k]) * waveFreq[k] + wavePhase[k]) / 3.0f;
+        }
+        geometry.positions.push_back(dir * radius);
+        geometry.uvs.push_back(uv);
+      }
+    }
+    for(uint32_t j = 0; j < n; ++j)
+    {
+      for(uint32_t i = 0; i < n; ++i)
+      {
+        const uint32_t v0 = base + j * (n + 1) + i;
+        const uint32_t v1 = v0 + 1;
+        const uint32_t v2 = v0 + n + 1;
+        const uint32_t v3 = v2 + 1;
+        geometry.triangles.emplace_back(v0, v1, v3);
+        geometry.triangles.emplace_back(v0, v3, v2);
+      }
+    }
+  }
+
+  // Area weighted vertex normals; the face seams keep their own vertices
+  geometry.normals.assign(geometry.positions.size(), glm::vec3(0.0f));
+  for(const glm::uvec3& t : geometry.triangles)
+  {
+    const glm::vec3 normal = glm::cross(geometry.positions[t.y] - geometry.positions[t.x], geometry.positions[t.z] - geometry.positions[t.x]);
+    geometry.normals[t.x] += normal;
+    geometry.normals[t.y] += normal;
+    geometry.normals[t.z] += normal;
+  }
+  for(glm::vec3& normal : geometry.normals)
+  {
+    normal = glm::normalize(normal);
+  }
+  return geometry;
+}
+
+static Geometry makeGround(float halfSize)
+{
+  Geometry geometry;
+  geometry.positions = {{-halfSize, 0, -halfSize}, {halfSize, 0, -halfSize}, {halfSize, 0, halfSize}, {-halfSize, 0, halfSize}};
+  geometry.normals.assign(4, glm::vec3(0, 1, 0));
+  const float tiles = halfSize / kSpacing;
+  geometry.uvs      = {{0, 0}, {tiles, 0}, {tiles, tiles}, {0, tiles}};
+  geometry.triangles = {{0, 2, 1}, {0, 3, 2}};
+  return geometry;
+}
+
+// Base color with round holes in the alpha channel, for the alpha tested materials
+static tinygltf::Image makeTexture(int size, Random& rng, int index)
+{
+  const glm::vec3 colorA(rng.range(0.2f, 1.0f), rng.range(0.2f, 1.0f), rng.range(0.2f, 1.0f));
+  const glm::vec3 colorB = colorA * rng.range(0.3f, 0.7f);
+  const int       cells  = 8;
+
+  tinygltf::Image image;
+  image.name       = "stress_texture_" + std::to_string(index);
+  image.width      = size;
+  image.height     = size;
+  image.component  = 4;
+  image.bits       = 8;
+  image.pixel_type = TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE;
+  image.mimeType   = "image/png";
+  image.image.resize(size_t(size) * size * 4);
+  for(int y = 0; y < size; ++y)
+  {
+    for(int x = 0; x < size; ++x)
+    {
+      const glm::vec2 cell = glm::vec2(float(x), float(y)) * float(cells) / float(size);
+      const bool      odd  = ((int(cell.x) + int(cell.y)) & 1) != 0;
+      const bool      hole = glm::length(glm::fract(cell) - 0.5f) < 0.3f;
+      const glm::vec3 c    = odd ? colorA : colorB;
+
+      unsigned char* pixel = &image.image[(size_t(y) * size + x) * 4];
+      pixel[0]             = (unsigned char)(c.r * 255.0f);
+      pixel[1]             = (unsigned char)(c.g * 255.0f);
+      pixel[2]             = (unsigned char)(c.b * 255.0f);
+      pixel[3]             = hole ? 0 : 255;
+    }
+  }
+  return image;
+}
+
+// Appends 'data' to the single buffer as its own view, returns the accessor
+template <typename T>
+static int addAccessor(tinygltf::Model& model, std::span<const T> data, int componentType, int type, int target)
+{
+  std::vector<unsigned char>& buffer = model.buffers[0].data;
+  const size_t                offset = (buffer.size() + 3) & ~size_t(3);
+  buffer.resize(offset + data.size_bytes());
+  memcpy(buffer.data() + offset, data.data(), data.size_bytes());
+
+  tinygltf::BufferView view;
+  view.buffer     = 0;
+  view.byteOffset = offset;
+  view.byteLength = data.size_bytes();
+  view.target     = target;
+  model.bufferViews.push_back(view);
+
+  tinygltf::Accessor accessor;
+  accessor.bufferView    = int(model.bufferViews.size()) - 1;
+  accessor.componentType = componentType;
+  accessor.count         = data.size();
+  accessor.type          = type;
+  model.accessors.push_back(accessor);
+  return int(model.accessors.size()) - 1;
+}
+
+// Primitive with the accessors of 'geometry' and no material yet
+static tinygltf::Primitive addGeometry(tinygltf::Model& model, const Geometry& geometry)
+{
+  const int position = addAccessor(model, std::span<const glm::vec3>(geometry.positions), TINYGLTF_COMPONENT_TYPE_FLOAT,
+                                   TINYGLTF_TYPE_VEC3, TINYGLTF_TARGET_ARRAY_BUFFER);
+  const int normal = addAccessor(model, std::span<const glm::vec3>(geometry.normals), TINYGLTF_COMPONENT_TYPE_FLOAT,
+                                 TINYGLTF_TYPE_VEC3, TINYGLTF_TARGET_ARRAY_BUFFER);
+  const int uv = addAccessor(model, std::span<const glm::vec2>(geometry.uvs), TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC2,
+                             TINYGLTF_TARGET_ARRAY_BUFFER);
+  const int indices = addAccessor(model, std::span<const uint32_t>(&geometry.triangles[0].x, geometry.triangles.size() * 3),
+                                  TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT, TINYGLTF_TYPE_SCALAR, TINYGLTF_TARGET_ELEMENT_ARRAY_BUFFER);
+
+  // POSITION needs its bounds, the instance culling and LOD selection use them
+  glm::vec3 bbMin = geometry.positions[0];
+  glm::vec3 bbMax = geometry.positions[0];
+  for(const glm::vec3& p : geometry.positions)
+  {
+    bbMin = glm::min(bbMin, p);
+    bbMax = glm::max(bbMax, p);
+  }
+  model.accessors[position].minValues = {bbMin.x, bbMin.y, bbMin.z};
+  model.accessors[position].maxValues = {bbMax.x, bbMax.y, bbMax.z};
+
+  tinygltf::Primitive primitive;
+  primitive.attributes = {{"POSITION", position}, {"NORMAL", normal}, {"TEXCOORD_0", uv}};
+  primitive.indices    = indices;
+  primitive.mode       = TINYGLTF_MODE_TRIANGLES;
+  return primitive;
+}
+
+static tinygltf::Material makeMaterial(const std::string& name, const glm::vec3& color, float roughness, float metallic, int texture)
+{
+  tinygltf::Material material;
+  material.name                                 = name;
+  material.pbrMetallicRoughness.baseColorFactor = {color.r, color.g, color.b, 1.0};
+  material.pbrMetallicRoughness.roughnessFactor = roughness;
+  material.pbrMetallicRoughness.metallicFactor  = metallic;
+  material.pbrMetallicRoughness.baseColorTexture.index = texture;
+  return material;
+}
+
+static tinygltf::Node makeNode(int mesh, const glm::vec3& translation, float rotationY, float scale)
+{
+  tinygltf::Node node;
+  node.mesh        = mesh;
+  node.translation = {translation.x, translation.y, translation.z};
+  node.rotation    = {0.0, std::sin(rotationY * 0.5), 0.0, std::cos(rotationY * 0.5)};
+  node.scale       = {scale, scale, scale};
+  return node;
+}
+
+
+void StressSceneSettings::registerParameters(nvutils::ParameterRegistry& registry, StressSceneSettings& settings)
+{
+  registry.add({"stressInstances", "Generates a stress scene with this many instances instead of loading the default scene"},
+               &settings.instances);
+  registry.add({"stressMeshes", "Stress scene: unique meshes"}, &settings.meshes);
+  registry.add({"stressTriangles", "Stress scene: triangles over all unique meshes"}, &settings.triangles);
+  registry.add({"stressTextures", "Stress scene: unique textures"}, &settings.textures);
+  registry.add({"stressTextureSize", "Stress scene: texture width and height"}, &settings.textureSize);
+  registry.add({"stressAlpha", "Stress scene: share of alpha tested instances, 0 to 1"}, &settings.alphaRatio);
+  registry.add({"stressEmitters", "Stress scene: emissive instances"}, &settings.emitters);
+  registry.add({"stressSeed", "Stress scene: random seed"}, &settings.seed);
+}
+
+std::string StressSceneSettings::name() const
+{
+  char name[128];
+  snprintf(name, sizeof(name), "stress_i%d_m%d_t%d_x%dx%d_a%.3f_e%d_s%d", instances, meshes, triangles, textures,
+           textureSize, alphaRatio, emitters, seed);
+  return name;
+}
+
+nlohmann::json StressSceneSettings::toJson() const
+{
+  return {{"instances", instances}, {"meshes", meshes},         {"triangles", triangles}, {"textures", textures},
+          {"texture_size", textureSize}, {"alpha_ratio", alphaRatio}, {"emitters", emitters}, {"seed", seed}};
+}
+
+tinygltf::Model createStressScene(const StressSceneSettings& settings)
+{
+  Random rng(uint64_t(uint32_t(settings.seed)));
+
+  const uint32_t instanceCount = uint32_t(std::max(settings.instances, 0));
+  const uint32_t meshCount     = uint32_t(std::max(settings.meshes, 1));
+  const uint32_t textureCount  = uint32_t(std::max(settings.textures, settings.alphaRatio > 0.0f ? 1 : 0));
+  const uint32_t variantCount  = std::max(textureCount, 4u);  // materials per kind
+  const uint32_t side          = uint32_t(std::ceil(std::sqrt(double(instanceCount))));
+  const float    halfExtent    = 0.5f * float(side) * kSpacing;
+
+  tinygltf::Model model;
+  model.asset.version   = "2.0";
+  model.asset.generator = "dlss_rr stress scene";
+  model.buffers.resize(1);
+  model.extensionsUsed.push_back("KHR_materials_emissive_strength");
+
+  // Textures and materials: ground, opaque and alpha tested variants, emitters
+  tinygltf::Sampler sampler;
+  sampler.minFilter = TINYGLTF_TEXTURE_FILTER_LINEAR_MIPMAP_LINEAR;
+  sampler.magFilter = TINYGLTF_TEXTURE_FILTER_LINEAR;
+  model.samplers.push_back(sampler);
+  for(uint32_t t = 0; t < textureCount; ++t)
+  {
+    model.images.push_back(makeTexture(std::max(settings.textureSize, 8), rng, int(t)));
+    tinygltf::Texture texture;
+    texture.sampler = 0;
+    texture.source  = int(t);
+    model.textures.push_back(texture);
+  }
+
+  model.materials.push_back(makeMaterial("ground", glm::vec3(0.5f), 0.8f, 0.0f, -1));
+  std::vector<int> opaqueMaterials;
+  std::vector<int> alphaMaterials;
+  for(uint32_t v = 0; v < variantCount; ++v)
+  {
+    const glm::vec3 tint(rng.range(0.5f, 1.0f), rng.range(0.5f, 1.0f), rng.range(0.5f, 1.0f));
+    const float     roughness = rng.range(0.1f, 0.9f);
+    const float     metallic  = rng.uniform() < 0.25f ? 1.0f : 0.0f;
+    const int       texture   = textureCount ? int(v % textureCount) : -1;
+
+    opaqueMaterials.push_back(int(model.materials.size()));
+    model.materials.push_back(makeMaterial("opaque_" + std::to_string(v), tint, roughness, metallic, texture));
+
+    if(texture >= 0)
+    {
+      tinygltf::Material alpha = makeMaterial("alpha_" + std::to_string(v), tint, roughness, 0.0f, texture);
+      alpha.alphaMode          = "MASK";
+      alpha.alphaCutoff        = 0.5;
+      alpha.doubleSided        = true;
+      alphaMaterials.push_back(int(model.materials.size()));
+      model.materials.push_back(alpha);
+    }
+  }
+  std::vector<int> emissiveMaterials;
+  for(uint32_t v = 0; v < 4; ++v)
+  {
+    const glm::vec3    color(rng.range(0.5f, 1.0f), rng.range(0.5f, 1.0f), rng.range(0.5f, 1.0f));
+    tinygltf::Material emissive = makeMaterial("emitter_" + std::to_string(v), glm::vec3(0.0f), 1.0f, 0.0f, -1);
+    emissive.emissiveFactor     = {color.r, color.g, color.b};
+    emissive.extensions["KHR_materials_emissive_strength"] =
+        tinygltf::Value(tinygltf::Value::Object{{"emissiveStrength", tinygltf::Value(20.0)}});
+    emissiveMaterials.push_back(int(model.materials.size()));
+    model.materials.push_back(emissive);
+  }
+
+  // Geometries; a mesh per used (geometry, material) pair shares the geometry's accessors
+  const uint32_t trianglesPerMesh = uint32_t(std::max(settings.triangles, 12)) / meshCount;
+  const uint32_t blobResolution   = std::max(uint32_t(std::lround(std::sqrt(double(trianglesPerMesh) / 12.0))), 1u);
+
+  std::vector<tinygltf::Primitive> geometries;
+  for(uint32_t g = 0; g < meshCount; ++g)
+  {
+    geometries.push_back(addGeometry(model, makeBlob(blobResolution, 0.3f, rng)));
+  }
+  const tinygltf::Primitive groundGeometry  = addGeometry(model, makeGround(halfExtent + kSpacing));
+  const tinygltf::Primitive emitterGeometry = addGeometry(model, makeBlob(4, 0.0f, rng));
+
+  std::map<std::pair<const tinygltf::Primitive*, int>, int> meshes;
+  auto meshFor = [&](const tinygltf::Primitive& geometry, int material) {
+    auto [it, inserted] = meshes.try_emplace({&geometry, material}, int(model.meshes.size()));
+    if(inserted)
+    {
+      tinygltf::Mesh mesh;
+      mesh.primitives.push_back(geometry);
+      mesh.primitives.back().material = material;
+      model.meshes.push_back(mesh);
+    }
+    return it->second;
+  };
+
+  tinygltf::Scene scene;
+  model.nodes.push_back(makeNode(meshFor(groundGeometry, 0), glm::vec3(0.0f), 0.0f, 1.0f));
+  scene.nodes.push_back(0);
+
+  for(uint32_t i = 0; i < instanceCount; ++i)
+  {
+    const uint32_t geometry = rng.below(meshCount);
+    const bool     alpha    = !alphaMaterials.empty() && rng.uniform() < settings.alphaRatio;
+    const uint32_t variant  = rng.below(variantCount);
+    const int      material = alpha ? alphaMaterials[variant % alphaMaterials.size()] : opaqueMaterials[variant];
+    const float    scale    = rng.range(0.5f, 1.2f);
+    const glm::vec3 position((float(i % side) + 0.5f) * kSpacing - halfExtent + rng.range(-0.5f, 0.5f), scale,
+                             (float(i / side) + 0.5f) * kSpacing - halfExtent + rng.range(-0.5f, 0.5f));
+
+    scene.nodes.push_back(int(model.nodes.size()));
+    model.nodes.push_back(makeNode(meshFor(geometries[geometry], material), position, rng.range(0.0f, 6.2831853f), scale));
+  }
+
+  for(int e = 0; e < settings.emitters; ++e)
+  {
+    const int       material = emissiveMaterials[rng.below(uint32_t(emissiveMaterials.size()))];
+    const glm::vec3 position(rng.range(-halfExtent, halfExtent), rng.range(4.0f, 8.0f), rng.range(-halfExtent, halfExtent));
+
+    scene.nodes.push_back(int(model.nodes.size()));
+    model.nodes.push_back(makeNode(meshFor(emitterGeometry, material), position, 0.0f, rng.range(0.2f, 0.4f)));
+  }
+
+  model.scenes.push_back(scene);
+  model.defaultScene = 0;
+  return model;
+}
+
+bool writeStressScene(const StressSceneSettings& settings, const std::filesystem::path& filename)
+{
+  const tinygltf::Model model = createStressScene(settings);
+
+  std::error_code ec;
+  std::filesystem::create_directories(filename.parent_path(), ec);
+
+  tinygltf::TinyGLTF writer;
+  if(!writer.WriteGltfSceneToFile(&model, filename.string(), true /*embedImages*/, true /*embedBuffers*/,
+                                  false /*prettyPrint*/, true /*writeBinary*/))
+  {
+    LOGE("Could not write %s\n", filename.string().c_str());
+    return false;
+  }
+  LOGI("Stress scene %s: %zu nodes, %zu meshes, %zu textures, %.1f MB\n", filename.string().c_str(), model.nodes.size(),
+       model.meshes.size(), model.textures.size(), double(model.buffers[0].data.size()) / (1 << 20));
+  return true;
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <tinygltf/json.hpp>
+
+#include <filesystem>
+#include <string>
+
+namespace nvutils {
+class ParameterRegistry;
+}
+namespace tinygltf {
+class Model;
+}
+
+
+// Procedural glTF scenes for scaling benchmarks: a field of instances of a few displaced, textured meshes on a
+// ground plane, some with alpha tested materials, and small emissive spheres above them. The same settings
+// always produce the same file, so reports of different runs compare.
+struct StressSceneSettings
+{
+  int   instances   = 0;        // 0: disabled
+  int   meshes      = 16;       // unique meshes the instances pick from
+  int   triangles   = 1 << 20;  // over all unique meshes
+  int   textures    = 8;        // unique base color textures
+  int   textureSize = 256;
+  float alphaRatio  = 0.0f;     // share of the instances with alpha tested materials
+  int   emitters    = 0;        // emissive instances, in addition to 'instances'
+  int   seed        = 1;
+
+  // Registers --stressInstances, --stressMeshes, --stressTriangles, --stressTextures, --stressTextureSize,
+  // --stressAlpha, --stressEmitters and --stressSeed
+  static void registerParameters(nvutils::ParameterRegistry& registry, StressSceneSettings& settings);
+
+  bool           isEnabled() const { return instances > 0; }
+  std::string    name() const;  // unique per settings, for file names
+  nlohmann::json toJson() const;
+};
+
+tinygltf::Model createStressScene(const StressSceneSettings& settings);
+
+// Writes createStressScene() as .glb; returns false when the file couldn't be written
+bool writeStressScene(const StressSceneSettings& settings, const std::filesystem::path& filename);
@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "tile_dispatch.hpp"
+
+#include <nvgui/property_editor.hpp>
+#include <nvutils/logger.hpp>
+#include <nvutils/parameter_registry.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <utility>
+
+
+namespace {
+
+constexpr double kTimingWeight = 0.25;  // of a new measurement in the running average per tile
+
+}  // namespace
+
+
+uint32_t mortonKey(glm::uvec2 position)
+{
+  uint32_t key = 0;
+  for(uint32_t bit = 0; bit < 16; ++bit)
+  {
+    key |= ((position.x >> bit) & 1u) << (2 * bit);
+    key |= ((position.y >> bit) & 1u) << (2 * bit + 1);
+  }
+  return key;
+}
+
+uint32_t hilbertKey(glm::uvec2 position, uint32_t side)
+{
+  uint32_t x = position.x, y = position.y;
+  uint32_t key = 0;
+  for(uint32_t s = side / 2; s > 0; s /= 2)
+  {
+    const uint32_t rx = (x & s) > 0 ? 1 : 0;
+    const uint32_t ry = (y & s) > 0 ? 1 : 0;
+    key += s * s * ((3 * rx) ^ ry);
+    // Rotate the quadrant, so that the curve within it starts next to where the previous quadrant's ended
+    if(ry == 0)
+    {
+      if(rx == 1)
+      {
+        x = side - 1 - x;
+        y = side - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return key;
+}
+
+std::vector<glm::uvec2> orderTiles(glm::uvec2 tileCount, TileOrder order)
+{
+  std::vector<glm::uvec2> tiles;
+  tiles.reserve(size_t(tileCount.x) * tileCount.y);
+  for(uint32_t y = 0; y < tileCount.y; ++y)
+  {
+    for(uint32_t x = 0; x < tileCount.x; ++x)
+    {
+      tiles.push_back({x, y});
+    }
+  }
+  if(order == TileOrder::eRowMajor)
+  {
+    return tiles;
+  }
+
+  const uint32_t side = std::bit_ceil(std::max({tileCount.x, tileCount.y, 1u}));
+  auto           key  = [&](glm::uvec2 tile) { return order == TileOrder::eMorton ? mortonKey(tile) : hilbertKey(tile, side); };
+  std::sort(tiles.begin(), tiles.end(), [&](glm::uvec2 a, glm::uvec2 b) { return key(a) < key(b); });
+  return tiles;
+}
+
+
+void TileDispatch::registerParameters(nvutils::ParameterRegistry& registry, Settings& settings)
+{
+  registry.add({"tiledDispatch", "Trace the frame in tiles, one ray tracing launch each"}, &settings.enabled);
+  registry.add({"tileSize", "Width and height of the ray tracing tiles in render pixels"}, &settings.tileSize);
+  registry.add({"tileOrder", "Order the tiles are traced in: 0 row by row, 1 Morton, 2 Hilbert"}, &settings.order);
+  registry.add({"tileBudgetMs", "Ray tracing per submission; the tiles of a frame beyond it go to the next ones. 0 traces all at once"},
+               &settings.budgetMs);
+  registry.add({"tileSelfTest", "Check the tile orders and the time slicing on the CPU and exit"}, &settings.selfTest);
+}
+
+void TileDispatch::init(const Settings& initSettings, uint32_t frameCycleSize)
+{
+  settings = initSettings;
+  m_tiles.clear();
+  m_next = 0;
+  m_cycleSlices.assign(frameCycleSize, {});
+  m_msPerTile       = 0.0;
+  m_slices          = 0;
+  m_lastFrameSlices = 0;
+  m_frame           = 0;
+  m_timedFrame      = 0;
+  m_frameMs         = 0.0;
+  m_lastFrameMs     = 0.0;
+}
+
+void TileDispatch::beginFrame(glm::uvec2 renderSize)
+{
+  const uint32_t   tileSize  = uint32_t(std::max(settings.tileSize, 8));
+  const glm::uvec2 tileCount = (renderSize + tileSize - 1u) / tileSize;
+  const TileOrder  order     = TileOrder(std::clamp(settings.order, 0, 2));
+
+  m_tiles.clear();
+  for(const glm::uvec2& tile : orderTiles(tileCount, order))
+  {
+    const glm::uvec2 offset = tile * tileSize;
+    m_tiles.push_back({offset, glm::min(glm::uvec2(tileSize), renderSize - offset)});
+  }
+  m_next   = 0;
+  m_slices = 0;
+  m_frame++;
+}
+
+void TileDispatch::addTiming(uint32_t cycleIndex, double ms)
+{
+  const CycleSlice slice = std::exchange(m_cycleSlices[cycleIndex], {});
+  if(slice.tiles == 0)
+  {
+    return;
+  }
+
+  // The slices are measured in submission order; those of a cancelled frame are dropped with the next frame
+  if(slice.frame != m_timedFrame)
+  {
+    m_timedFrame = slice.frame;
+    m_frameMs    = 0.0;
+  }
+  m_frameMs += std::max(ms, 0.0);
+  if(slice.last)
+  {
+    m_lastFrameMs = m_frameMs;
+  }
+
+  if(ms <= 0.0)
+  {
+    return;
+  }
+  const double sample = ms / slice.tiles;
+  m_msPerTile         = m_msPerTile == 0.0 ? sample : m_msPerTile + (sample - m_msPerTile) * kTimingWeight;
+}
+
+TileDispatch::Slice TileDispatch::nextSlice(uint32_t cycleIndex)
+{
+  const uint32_t remaining = uint32_t(m_tiles.size()) - m_next;
+  uint32_t       count     = remaining;
+  if(settings.budgetMs > 0.0f)
+  {
+    // Until a submission was measured one tile at a time, a frame may well be far over any budget
+    count = m_msPerTile > 0.0 ? uint32_t(std::clamp(std::floor(settings.budgetMs / m_msPerTile), 1.0, double(remaining))) : 1u;
+  }
+
+  Slice slice;
+  slice.tiles = std::span<const DispatchTile>(m_tiles).subspan(m_next, count);
+  slice.first = m_next == 0;
+  m_next += count;
+  slice.last = m_next == m_tiles.size();
+
+  m_cycleSlices[cycleIndex].tiles += count;
+  m_cycleSlices[cycleIndex].frame = m_frame;
+  m_cycleSlices[cycleIndex].last  = slice.last;
+  m_slices++;
+  if(slice.last)
+  {
+    m_lastFrameSlices = m_slices;
+  }
+  return slice;
+}
+
+void TileDispatch::onUI()
+{
+  using namespace nvgui;
+
+  PropertyEditor::begin();
+  PropertyEditor::entry("Enable", [&] { return ImGui::Checkbox("##tiledDispatch", &settings.enabled); },
+                        "One ray tracing launch per tile instead of one over the whole frame");
+  PropertyEditor::entry("Tile Size", [&] { return ImGui::SliderInt("##tileSize", &settings.tileSize, 32, 1024); },
+                        "Width and height of the tiles in render pixels");
+  PropertyEditor::entry("Order", [&] { return ImGui::Combo("##tileOrder", &settings.order, "Row Major\0Morton\0Hilbert\0"); },
+                        "Order the tiles are traced in; Morton and Hilbert keep consecutive tiles close together");
+  PropertyEditor::entry("Budget (ms)", [&] { return ImGui::SliderFloat("##tileBudget", &settings.budgetMs, 0.0f, 33.0f, "%.1f"); },
+                        "GPU time of the ray tracing per submission; the remaining tiles of the frame follow in the next "
+                        "ones. 0 traces the whole frame at once");
+  PropertyEditor::entry("Progressive", [&] { return ImGui::Checkbox("##tileProgressive", &settings.progressive); },
+                        "Show the tiles traced so far while a frame is spread over submissions");
+  PropertyEditor::end();
+}
+
+nlohmann::json TileDispatch::toJson() const
+{
+  static const char* orders[] = {"row_major", "morton", "hilbert"};
+  return {{"enabled", settings.enabled},
+          {"tile_size", settings.tileSize},
+          {"order", orders[std::clamp(settings.order, 0, 2)]},
+          {"budget_ms", settings.budgetMs},
+          {"tiles", tileCount()},
+          {"ms_per_tile", m_msPerTile},
+          {"submissions_per_frame", m_lastFrameSlices},
+          {"frame_ms", m_lastFrameMs}};
+}
+
+bool TileDispatch::selfTest()
+{
+  // Every order visits each tile of the grid exactly once, including grids that are not power of two squares
+  bool complete = true;
+  for(const glm::uvec2 grid : {glm::uvec2(8, 8), glm::uvec2(13, 7), glm::uvec2(1, 5), glm::uvec2(30, 17)})
+  {
+    for(TileOrder order : {TileOrder::eRowMajor, TileOrder::eMorton, TileOrder::eHilbert})
+    {
+      const std::vector<glm::uvec2> tiles = orderTiles(grid, order);
+      std::vector<uint32_t>         visits(size_t(grid.x) * grid.y, 0);
+      for(const glm::uvec2& tile : tiles)
+      {
+        complete = complete && tile.x < grid.x && tile.y < grid.y;
+        if(tile.x < grid.x && tile.y < grid.y)
+        {
+          visits[size_t(tile.y) * grid.x + tile.x]++;
+        }
+      }
+      complete = complete && tiles.size() == visits.size() && std::all_of(visits.begin(), visits.end(), [](uint32_t v) { return v == 1; });
+    }
+  }
+
+  // On a power of two square, consecutive Hilbert tiles are neighbours and every aligned group of four Morton tiles
+  // is a 2x2 block. The mean distance between consecutive tiles measures the locality of the other grids.
+  const glm::uvec2        square(16, 16);
+  std::vector<glm::uvec2> hilbert = orderTiles(square, TileOrder::eHilbert);
+  std::vector<glm::uvec2> morton  = orderTiles(square, TileOrder::eMorton);
+  bool                    local   = mortonKey({3, 5}) == 0x27 && hilbertKey({0, 0}, 16) == 0 && hilbertKey({15, 0}, 16) == 255;
+  for(size_t i = 1; i < hilbert.size(); ++i)
+  {
+    const glm::ivec2 step = glm::abs(glm::ivec2(hilbert[i]) - glm::ivec2(hilbert[i - 1]));
+    local                 = local && step.x + step.y == 1;
+  }
+  for(size_t i = 0; i < morton.size(); i += 4)
+  {
+    const glm::uvec2 block = morton[i] / 2u;
+    for(size_t j = 1; j < 4; ++j)
+    {
+      local = local && morton[i + j] / 2u == block;
+    }
+  }
+  auto meanStep = [](const std::vector<glm::uvec2>& tiles) {
+    double sum = 0.0;
+    for(size_t i = 1; i < tiles.size(); ++i)
+    {
+      sum += glm::length(glm::vec2(tiles[i]) - glm::vec2(tiles[i - 1]));
+    }
+    return sum / double(std::max<size_t>(tiles.size() - 1, 1));
+  };
+  const glm::uvec2 grid(30, 17);
+  const double     rowStep     = meanStep(orderTiles(grid, TileOrder::eRowMajor));
+  const double     mortonStep  = meanStep(orderTiles(grid, TileOrder::eMorton));
+  const double     hilbertStep = meanStep(orderTiles(grid, TileOrder::eHilbert));
+  local                        = local && hilbertStep < mortonStep && hilbertStep < rowStep;
+
+  // Slicing under a budget: the first submission records one tile, the later ones as many as the measured time per
+  // tile fits, and the slices of a frame cover its tiles in order, once each
+  TileDispatch dispatch;
+  dispatch.init({.enabled = true, .tileSize = 64, .budgetMs = 4.0f}, 3);
+  const glm::uvec2 renderSize(1000, 600);  // 16 x 10 tiles, the last column and row partial
+  const double     gpuMsPerTile = 0.5;
+  std::array<double, 3> cycleMs{};  // GPU time of the submission that last used the cycle
+  bool                  sliced = true;
+  uint32_t              cycle = 0, slices = 0;
+  for(int frame = 0; frame < 4; ++frame)
+  {
+    dispatch.beginFrame(renderSize);
+    std::vector<uint32_t> coverage(size_t(renderSize.x) * renderSize.y, 0);
+    slices = 0;
+    while(dispatch.inFrame())
+    {
+      dispatch.addTiming(cycle, cycleMs[cycle]);
+      const Slice slice = dispatch.nextSlice(cycle);
+      sliced = sliced && slice.first == (slices == 0) && !slice.tiles.empty() && slice.last == !dispatch.inFrame();
+      if(frame == 0 && slices == 0)
+      {
+        sliced = sliced && slice.tiles.size() == 1;
+      }
+      for(const DispatchTile& tile : slice.tiles)
+      {
+        for(uint32_t y = tile.offset.y; y < tile.offset.y + tile.size.y; ++y)
+        {
+          for(uint32_t x = tile.offset.x; x < tile.offset.x + tile.size.x; ++x)
+          {
+            coverage[size_t(y) * renderSize.x + x]++;
+          }
+        }
+      }
+      cycleMs[cycle] = gpuMsPerTile * double(slice.tiles.size());
+      cycle          = (cycle + 1) % 3;
+      slices++;
+    }
+    sliced = sliced && std::all_of(coverage.begin(), coverage.end(), [](uint32_t c) { return c == 1; });
+  }
+  // Once measured, 8 tiles fit the 4 ms
+  const uint32_t expectedSlices = (dispatch.tileCount() + 7) / 8;
+  sliced = sliced && std::abs(dispatch.msPerTile() - gpuMsPerTile) < 1e-6 && slices == expectedSlices
+           && dispatch.slicesPerFrame() == slices;
+  // The frame time sums the slices of a whole frame
+  sliced = sliced && std::abs(dispatch.frameMs() - gpuMsPerTile * dispatch.tileCount()) < 1e-6;
+
+  // Without a budget the frame is one slice
+  dispatch.settings.budgetMs = 0.0f;
+  dispatch.beginFrame(renderSize);
+  const Slice whole = dispatch.nextSlice(0);
+  sliced            = sliced && whole.first && whole.last && whole.tiles.size() == dispatch.tileCount();
+
+  const bool passed = complete && local && sliced;
+  LOGI("Tile dispatch self test %s: orders %s, locality %s (mean step %.2f row major, %.2f Morton, %.2f Hilbert), "
+       "slicing %s (%u submissions per frame)\n",
+       passed ? "passed" : "FAILED", complete ? "complete" : "INCOMPLETE", local ? "ok" : "FAILED", rowStep, mortonStep,
+       hilbertStep, sliced ? "ok" : "FAILED", slices);
+  return passed;
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <glm/glm.hpp>
+#include <tinygltf/json.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace nvutils {
+class ParameterRegistry;
+}
+
+
+enum class TileOrder
+{
+  eRowMajor,
+  eMorton,   // Z-order: the tiles of every aligned 2^k square follow each other
+  eHilbert,  // like Morton, and each tile is a neighbour of the one before
+};
+
+// Position along the Z-order curve: the interleaved bits of x and y
+uint32_t mortonKey(glm::uvec2 position);
+// Position along the Hilbert curve filling a 'side' x 'side' square, 'side' a power of two
+uint32_t hilbertKey(glm::uvec2 position, uint32_t side);
+
+// The tiles of a 'tileCount' grid in trace order. Morton and Hilbert run over the enclosing power of two square
+// and skip the tiles outside the grid.
+std::vector<glm::uvec2> orderTiles(glm::uvec2 tileCount, TileOrder order);
+
+// Pixels [offset, offset + size) of one ray tracing launch
+struct DispatchTile
+{
+  glm::uvec2 offset{0};
+  glm::uvec2 size{0};
+};
+
+
+// TileDispatch splits the ray tracing of a frame into launches of one tile each, traced in a spatially coherent
+// order so that neighbouring rays share BVH nodes and textures in the caches. With a time budget, the tiles of a
+// frame are spread over several submissions: each records as many tiles as the budget is estimated to fit, from the
+// GPU time per tile measured by earlier submissions. The passes before the ray tracing run with the first slice of
+// tiles, the ones after it with the last.
+class TileDispatch
+{
+public:
+  struct Settings
+  {
+    bool  enabled     = false;
+    int   tileSize    = 256;  // pixels of the render size
+    int   order       = int(TileOrder::eHilbert);
+    float budgetMs    = 0.0f;  // ray tracing per submission; 0 traces all tiles of a frame in one submission
+    bool  progressive = true;  // the viewport shows the traced tiles while a frame is spread over submissions
+    bool  selfTest    = false;
+  };
+
+  // Tiles recorded by one submission
+  struct Slice
+  {
+    std::span<const DispatchTile> tiles;
+    bool                          first = false;  // records the passes before the ray tracing
+    bool                          last  = false;  // records the passes after it
+  };
+
+  // Registers the --tile* options
+  static void registerParameters(nvutils::ParameterRegistry& registry, Settings& settings);
+
+  Settings settings;
+
+  void init(const Settings& initSettings, uint32_t frameCycleSize);
+  bool isEnabled() const { return settings.enabled; }
+
+  // Tiles the next frame of 'renderSize' with the current settings
+  void beginFrame(glm::uvec2 renderSize);
+  // Tiles of the frame remain to be recorded
+  bool inFrame() const { return m_next < m_tiles.size(); }
+  // Drops the rest of the frame, e.g. when the render buffers are recreated
+  void cancelFrame() { m_next = uint32_t(m_tiles.size()); }
+
+  // Ray tracing GPU time of the submission that last used 'cycleIndex', taken once its timings are collected
+  void addTiming(uint32_t cycleIndex, double ms);
+  // The tiles to record with the submission of 'cycleIndex': at least one, as many as fit the budget
+  Slice nextSlice(uint32_t cycleIndex);
+
+  uint32_t tileCount() const { return uint32_t(m_tiles.size()); }
+  double   msPerTile() const { return m_msPerTile; }
+  uint32_t slicesPerFrame() const { return m_lastFrameSlices; }
+  // Ray tracing GPU time of the last frame whose submissions were all measured, summed over its slices
+  double frameMs() const { return m_lastFrameMs; }
+
+  void           onUI();
+  nlohmann::json toJson() const;
+
+  // Checks that every order visits each tile once, the locality of Morton and Hilbert, and the slicing under a budget
+  static bool selfTest();
+
+private:
+  // Slice recorded with a frame cycle
+  struct CycleSlice
+  {
+    uint32_t tiles = 0;  // to divide its timing by
+    uint32_t frame = 0;
+    bool     last  = false;
+  };
+
+  std::vector<DispatchTile> m_tiles;
+  uint32_t                  m_next = 0;
+  std::vector<CycleSlice>   m_cycleSlices;
+  double                    m_msPerTile       = 0.0;  // running average, 0 until measured
+  uint32_t                  m_slices          = 0;
+  uint32_t                  m_lastFrameSlices = 0;
+  uint32_t                  m_frame           = 0;  // frames begun
+  uint32_t                  m_timedFrame      = 0;  // frame whose measured slices m_frameMs sums
+  double                    m_frameMs         = 0.0;
+  double                    m_lastFrameMs     = 0.0;
+};
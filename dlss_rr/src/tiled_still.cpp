@@ -0,0 +1,356 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "tiled_still.hpp"
+
+#include <nvutils/logger.hpp>
+#include <nvutils/parameter_registry.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <fstream>
+
+
+namespace {
+
+// Tile starts along one axis, spread evenly from 0 to 'image' - 'tile'
+std::vector<uint32_t> tileStarts(uint32_t image, uint32_t tile, uint32_t overlap)
+{
+  if(tile >= image)
+  {
+    return {0};
+  }
+  const uint32_t step  = std::max(tile - std::min(overlap, tile - 1), 1u);
+  const uint32_t count = 1 + (image - tile + step - 1) / step;
+  std::vector<uint32_t> starts(count);
+  for(uint32_t i = 0; i < count; ++i)
+  {
+    starts[i] = uint32_t((uint64_t(image - tile) * i + (count - 1) / 2) / (count - 1));
+  }
+  return starts;
+}
+
+// Ramp of one axis: 0 to 1 over 'ramp' pixels from the edges that are inside the image
+float axisWeight(uint32_t offset, uint32_t size, uint32_t image, uint32_t ramp, uint32_t pixel)
+{
+  if(ramp == 0)
+  {
+    return 1.0f;
+  }
+  float weight = 1.0f;
+  if(offset > 0)
+  {
+    weight = std::min(weight, (float(pixel) + 0.5f) / float(ramp));
+  }
+  if(offset + size < image)
+  {
+    weight = std::min(weight, (float(size - pixel) - 0.5f) / float(ramp));
+  }
+  return weight;
+}
+
+}  // namespace
+
+
+std::vector<StillTile> scheduleTiles(glm::uvec2 imageSize, glm::uvec2 maxTileSize, uint32_t overlap)
+{
+  const glm::uvec2            size = glm::min(imageSize, maxTileSize);
+  const std::vector<uint32_t> xs   = tileStarts(imageSize.x, size.x, overlap);
+  const std::vector<uint32_t> ys   = tileStarts(imageSize.y, size.y, overlap);
+
+  std::vector<StillTile> tiles;
+  tiles.reserve(xs.size() * ys.size());
+  for(uint32_t y : ys)
+  {
+    for(uint32_t x : xs)
+    {
+      tiles.push_back({.offset = {x, y}, .size = size});
+    }
+  }
+  return tiles;
+}
+
+glm::mat4 tileProjection(const glm::mat4& proj, glm::uvec2 imageSize, const StillTile& tile)
+{
+  // x' = scale * (x - center * w): the tile's center goes to the middle of the clip space, its edges to -1 and 1
+  const glm::vec2 scale  = glm::vec2(imageSize) / glm::vec2(tile.size);
+  const glm::vec2 center = (glm::vec2(tile.offset) + glm::vec2(tile.size) * 0.5f) / glm::vec2(imageSize) * 2.0f - 1.0f;
+
+  glm::mat4 crop(1.0f);
+  crop[0][0] = scale.x;
+  crop[1][1] = scale.y;
+  crop[3][0] = -scale.x * center.x;
+  crop[3][1] = -scale.y * center.y;
+  return crop * proj;
+}
+
+float tileBlendWeight(const StillTile& tile, glm::uvec2 imageSize, uint32_t ramp, glm::uvec2 pixel)
+{
+  return axisWeight(tile.offset.x, tile.size.x, imageSize.x, ramp, pixel.x)
+         * axisWeight(tile.offset.y, tile.size.y, imageSize.y, ramp, pixel.y);
+}
+
+
+void StillCompositor::init(glm::uvec2 imageSize, std::span<const StillTile> tiles, uint32_t ramp)
+{
+  m_imageSize = imageSize;
+  m_tiles.assign(tiles.begin(), tiles.end());
+  m_ramp = ramp;
+  m_sum.assign(size_t(imageSize.x) * imageSize.y, glm::vec3(0.0f));
+}
+
+void StillCompositor::add(const StillTile& tile, std::span<const glm::vec4> pixels)
+{
+  assert(pixels.size() == size_t(tile.size.x) * tile.size.y);
+  for(uint32_t y = 0; y < tile.size.y; ++y)
+  {
+    for(uint32_t x = 0; x < tile.size.x; ++x)
+    {
+      const glm::vec3 color(pixels[size_t(y) * tile.size.x + x]);
+      m_sum[size_t(tile.offset.y + y) * m_imageSize.x + tile.offset.x + x] += color * tileBlendWeight(tile, m_imageSize, m_ramp, {x, y});
+    }
+  }
+}
+
+float StillCompositor::weightSum(glm::uvec2 position) const
+{
+  float sum = 0.0f;
+  for(const StillTile& tile : m_tiles)
+  {
+    if(glm::all(glm::greaterThanEqual(position, tile.offset)) && glm::all(glm::lessThan(position, tile.offset + tile.size)))
+    {
+      sum += tileBlendWeight(tile, m_imageSize, m_ramp, position - tile.offset);
+    }
+  }
+  return sum;
+}
+
+glm::vec3 StillCompositor::pixel(glm::uvec2 position) const
+{
+  const float sum = weightSum(position);
+  return sum > 0.0f ? m_sum[size_t(position.y) * m_imageSize.x + position.x] / sum : glm::vec3(0.0f);
+}
+
+bool StillCompositor::writeImage(const std::filesystem::path& filename) const
+{
+  std::ofstream file(filename, std::ios::binary);
+  if(!file)
+  {
+    LOGE("Could not write %s\n", filename.string().c_str());
+    return false;
+  }
+  // Negative scale: little endian. Rows go from the bottom to the top.
+  file << "PF\n" << m_imageSize.x << " " << m_imageSize.y << "\n-1.0\n";
+
+  // The weight sums of a row, from the tiles crossing it
+  std::vector<float>     weights(m_imageSize.x);
+  std::vector<glm::vec3> row(m_imageSize.x);
+  for(uint32_t y = m_imageSize.y; y-- > 0;)
+  {
+    std::fill(weights.begin(), weights.end(), 0.0f);
+    for(const StillTile& tile : m_tiles)
+    {
+      if(y < tile.offset.y || y >= tile.offset.y + tile.size.y)
+      {
+        continue;
+      }
+      for(uint32_t x = 0; x < tile.size.x; ++x)
+      {
+        weights[tile.offset.x + x] += tileBlendWeight(tile, m_imageSize, m_ramp, {x, y - tile.offset.y});
+      }
+    }
+    for(uint32_t x = 0; x < m_imageSize.x; ++x)
+    {
+      row[x] = weights[x] > 0.0f ? m_sum[size_t(y) * m_imageSize.x + x] / weights[x] : glm::vec3(0.0f);
+    }
+    file.write(reinterpret_cast<const char*>(row.data()), row.size() * sizeof(glm::vec3));
+  }
+  return bool(file);
+}
+
+
+void TiledStill::registerParameters(nvutils::ParameterRegistry& registry, Settings& settings)
+{
+  registry.add({"stillWidth", "Render a still of this width in tiles, write it and exit"}, &settings.width);
+  registry.add({"stillHeight", "Height of the tiled still"}, &settings.height);
+  registry.add({"stillTile", "Output size of the still's tiles, at most the largest DLSS_RR output"}, &settings.tileSize);
+  registry.add({"stillOverlap", "Pixels blended between neighbouring tiles of the still"}, &settings.overlap);
+  registry.add({"stillWarmup", "Frames rendered per tile of the still, warming up the DLSS_RR history"}, &settings.warmup);
+  registry.add({"stillOutput", "PFM image the tiled still is written to"}, &settings.output);
+  registry.add({"stillSelfTest", "Check the tile scheduling, sub-frusta and blending of the tiled still on the CPU and exit"},
+               &settings.selfTest);
+}
+
+void TiledStill::init(const Settings& settings)
+{
+  m_settings = settings;
+  m_tiles.clear();
+  m_tile  = 0;
+  m_frame = 0;
+  if(!settings.isActive())
+  {
+    return;
+  }
+
+  // DLSS_RR crashes below 256 pixels, and the overlap has to leave a step between the tiles
+  m_settings.width    = std::max(m_settings.width, 256);
+  m_settings.height   = std::max(m_settings.height, 256);
+  m_settings.tileSize = std::max(m_settings.tileSize, 256);
+  m_settings.overlap  = std::clamp(m_settings.overlap, 0, m_settings.tileSize / 2);
+  m_settings.warmup   = std::max(m_settings.warmup, 1);
+
+  const glm::uvec2 imageSize(m_settings.width, m_settings.height);
+  m_tiles = scheduleTiles(imageSize, glm::uvec2(m_settings.tileSize), uint32_t(m_settings.overlap));
+  m_compositor.init(imageSize, m_tiles, uint32_t(m_settings.overlap));
+  LOGI("Tiled still %ux%u: %zu tiles of %ux%u, %d warm up frames each\n", imageSize.x, imageSize.y, m_tiles.size(),
+       tileSize().x, tileSize().y, m_settings.warmup);
+}
+
+glm::mat4 TiledStill::projection(const glm::mat4& proj) const
+{
+  return tileProjection(proj, glm::uvec2(m_settings.width, m_settings.height), m_tiles[m_tile]);
+}
+
+void TiledStill::addTile(std::span<const glm::vec4> pixels)
+{
+  m_compositor.add(m_tiles[m_tile], pixels);
+  LOGI("Tiled still: tile %u of %zu done\n", m_tile + 1, m_tiles.size());
+  m_tile++;
+  m_frame = 0;
+}
+
+bool TiledStill::writeImage() const
+{
+  if(!m_compositor.writeImage(m_settings.output))
+  {
+    return false;
+  }
+  LOGI("Tiled still written to %s\n", m_settings.output.string().c_str());
+  return true;
+}
+
+bool TiledStill::selfTest()
+{
+  const glm::uvec2 imageSize(1000, 700);
+  const glm::uvec2 maxTile(256, 256);
+  const uint32_t   overlap = 32;
+  const auto       image   = [](glm::uvec2 p) {
+    return glm::vec3(std::sin(p.x * 0.05f) + 1.0f, std::cos(p.y * 0.03f) + 1.0f, float((p.x ^ p.y) & 7) * 0.1f);
+  };
+
+  // Every pixel covered, tiles no larger than asked for, neighbours overlapping enough
+  const std::vector<StillTile> tiles = scheduleTiles(imageSize, maxTile, overlap);
+  std::vector<uint32_t>        coverage(size_t(imageSize.x) * imageSize.y, 0);
+  bool                         tilesValid = true;
+  for(size_t i = 0; i < tiles.size(); ++i)
+  {
+    const StillTile& tile = tiles[i];
+    tilesValid            = tilesValid && glm::all(glm::lessThanEqual(tile.size, maxTile))
+                 && glm::all(glm::lessThanEqual(tile.offset + tile.size, imageSize));
+    if(i > 0 && tiles[i - 1].offset.y == tile.offset.y)
+    {
+      tilesValid = tilesValid && tile.offset.x - tiles[i - 1].offset.x <= tile.size.x - overlap;
+    }
+    for(uint32_t y = 0; y < tile.size.y; ++y)
+    {
+      for(uint32_t x = 0; x < tile.size.x; ++x)
+      {
+        coverage[size_t(tile.offset.y + y) * imageSize.x + tile.offset.x + x]++;
+      }
+    }
+  }
+  const bool covered = std::find(coverage.begin(), coverage.end(), 0u) == coverage.end();
+
+  // Tiles of the synthetic image, each with an offset standing in for what differs between the tiles' DLSS_RR
+  // histories. Without the offsets the blend must give the image back; with them it mustn't show a step.
+  const float     tileBias = 0.25f;
+  StillCompositor exact, biased;
+  exact.init(imageSize, tiles, overlap);
+  biased.init(imageSize, tiles, overlap);
+  std::vector<glm::vec4> pixels;
+  for(size_t i = 0; i < tiles.size(); ++i)
+  {
+    const StillTile& tile = tiles[i];
+    pixels.resize(size_t(tile.size.x) * tile.size.y);
+    for(uint32_t y = 0; y < tile.size.y; ++y)
+    {
+      for(uint32_t x = 0; x < tile.size.x; ++x)
+      {
+        pixels[size_t(y) * tile.size.x + x] = glm::vec4(image(tile.offset + glm::uvec2(x, y)), 1.0f);
+      }
+    }
+    exact.add(tile, pixels);
+    for(glm::vec4& pixel : pixels)
+    {
+      pixel += glm::vec4(glm::vec3(tileBias * float(i % 2)), 0.0f);
+    }
+    biased.add(tile, pixels);
+  }
+
+  float maxError = 0.0f, maxStep = 0.0f;
+  for(uint32_t y = 0; y < imageSize.y; ++y)
+  {
+    for(uint32_t x = 0; x < imageSize.x; ++x)
+    {
+      const glm::vec3 expected = image({x, y});
+      maxError = std::max(maxError, glm::length(exact.pixel({x, y}) - expected) / std::max(glm::length(expected), 1.0f));
+      // Only the bias changes between neighbours once the image itself is taken out
+      const glm::vec3 bias = biased.pixel({x, y}) - expected;
+      if(x > 0)
+      {
+        const glm::vec3 leftBias = biased.pixel({x - 1, y}) - image({x - 1, y});
+        maxStep                  = std::max(maxStep, glm::length(bias - leftBias) / glm::length(glm::vec3(tileBias)));
+      }
+      if(y > 0)
+      {
+        const glm::vec3 topBias = biased.pixel({x, y - 1}) - image({x, y - 1});
+        maxStep                 = std::max(maxStep, glm::length(bias - topBias) / glm::length(glm::vec3(tileBias)));
+      }
+    }
+  }
+  // A hard switch between the tiles would step by the whole bias, the ramps spread it over the overlap
+  const float stepLimit = 4.0f / float(overlap);
+
+  // A point seen through a tile's sub-frustum lands on the same output pixel as through the full frustum
+  glm::mat4 proj = glm::perspectiveRH_ZO(glm::radians(45.0f), float(imageSize.x) / float(imageSize.y), 0.1f, 100.0f);
+  proj[1][1] *= -1;
+  float maxPixelError = 0.0f;
+  for(const StillTile& tile : tiles)
+  {
+    const glm::mat4 tileProj = tileProjection(proj, imageSize, tile);
+    for(int i = 0; i < 16; ++i)
+    {
+      const glm::vec4 point(float(i % 4) - 1.5f, float(i / 4) - 1.5f, -2.0f - float(i), 1.0f);
+      const glm::vec4 full      = proj * point;
+      const glm::vec4 cropped   = tileProj * point;
+      const glm::vec2 fullPixel = (glm::vec2(full) / full.w * 0.5f + 0.5f) * glm::vec2(imageSize);
+      const glm::vec2 tilePixel = (glm::vec2(cropped) / cropped.w * 0.5f + 0.5f) * glm::vec2(tile.size) + glm::vec2(tile.offset);
+      maxPixelError = std::max(maxPixelError, glm::length(tilePixel - fullPixel));
+    }
+  }
+
+  const bool passed = tilesValid && covered && maxError < 1e-5f && maxStep < stepLimit && maxPixelError < 1e-2f;
+  LOGI("Tiled still self test %s: %zu tiles %s, coverage %s, max relative blend error %.2e, max seam step %.3f of the "
+       "tile bias (limit %.3f), max sub-frustum error %.2e pixels\n",
+       passed ? "passed" : "FAILED", tiles.size(), tilesValid ? "valid" : "invalid", covered ? "complete" : "has holes",
+       maxError, maxStep, stepLimit, maxPixelError);
+  return passed;
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace nvutils {
+class ParameterRegistry;
+}
+
+
+// Output pixels [offset, offset + size) of a still rendered in tiles
+struct StillTile
+{
+  glm::uvec2 offset{0};
+  glm::uvec2 size{0};
+};
+
+// Tiles of at most 'maxTileSize' covering 'imageSize', row by row, neighbours overlapping by at least 'overlap' pixels.
+// All tiles have the same size, so that one DLSS_RR instance renders them all; the tiles of a row or column are spread
+// evenly, which makes some overlaps a little wider than asked for.
+std::vector<StillTile> scheduleTiles(glm::uvec2 imageSize, glm::uvec2 maxTileSize, uint32_t overlap);
+
+// Off-axis sub-frustum of 'tile': maps the tile's part of the clip space of 'proj' to the whole clip space. 'proj' is
+// the Vulkan style projection of the ray generation, normalized device coordinates (-1, -1) are the top left pixel.
+glm::mat4 tileProjection(const glm::mat4& proj, glm::uvec2 imageSize, const StillTile& tile);
+
+// Blend weight of the tile local 'pixel': ramps from 0 to 1 over 'ramp' pixels at the edges shared with another tile,
+// 1 along the image border. The weights of all tiles are positive, the compositor divides by their sum.
+float tileBlendWeight(const StillTile& tile, glm::uvec2 imageSize, uint32_t ramp, glm::uvec2 pixel);
+
+
+// StillCompositor blends the tiles into the full image. It keeps the weighted color sums only, 12 bytes per pixel,
+// and recomputes the sum of the weights when writing.
+class StillCompositor
+{
+public:
+  void init(glm::uvec2 imageSize, std::span<const StillTile> tiles, uint32_t ramp);
+
+  // Adds the tile's 'pixels', tile.size texels from the top left
+  void add(const StillTile& tile, std::span<const glm::vec4> pixels);
+
+  glm::vec3 pixel(glm::uvec2 position) const;
+  // Writes the image as a PFM (portable float map)
+  bool writeImage(const std::filesystem::path& filename) const;
+
+private:
+  float weightSum(glm::uvec2 position) const;
+
+  glm::uvec2             m_imageSize{0};
+  std::vector<StillTile> m_tiles;
+  uint32_t               m_ramp = 0;
+  std::vector<glm::vec3> m_sum;
+};
+
+
+// TiledStill renders a still larger than DLSS_RR outputs, e.g. 16K for print: the output buffers get the size of a
+// tile, and each tile is rendered with its sub-frustum for 'warmup' frames, starting from a reset DLSS_RR history and
+// jittered like any frame, before its output is blended into the still. Once all tiles are done the still is written
+// and the sample exits.
+class TiledStill
+{
+public:
+  struct Settings
+  {
+    int                   width    = 0;  // 0: disabled
+    int                   height   = 0;
+    int                   tileSize = 2048;  // output size of a tile, at most the largest output DLSS_RR supports
+    int                   overlap  = 64;    // pixels blended between neighbouring tiles
+    int                   warmup   = 16;    // frames rendered per tile, the last one is kept
+    std::filesystem::path output   = "still.pfm";
+    bool                  selfTest = false;
+
+    bool isActive() const { return width > 0 && height > 0 && !selfTest; }
+  };
+
+  // Registers the --still* options
+  static void registerParameters(nvutils::ParameterRegistry& registry, Settings& settings);
+
+  void init(const Settings& settings);
+  bool isActive() const { return !m_tiles.empty(); }
+
+  // Output size of every tile
+  glm::uvec2 tileSize() const { return m_tiles.front().size; }
+  // Aspect ratio of the camera, the whole still's
+  double aspectRatio() const { return double(m_settings.width) / m_settings.height; }
+  glm::mat4 projection(const glm::mat4& proj) const;
+
+  // Warm up frame of the current tile; 0 resets the DLSS_RR history
+  uint32_t frame() const { return m_frame; }
+  // The last frame of the current tile is recorded, its output is ready once that frame is done
+  bool tileRendered() const { return m_frame == uint32_t(m_settings.warmup); }
+  bool isComplete() const { return m_tile == m_tiles.size(); }
+  uint32_t tileIndex() const { return m_tile; }
+  uint32_t tileCount() const { return uint32_t(m_tiles.size()); }
+
+  // Call after a frame of the current tile was recorded
+  void advance() { m_frame++; }
+  // Blends the output of the current tile and moves on to the next one
+  void addTile(std::span<const glm::vec4> pixels);
+  bool writeImage() const;
+
+  // Renders a synthetic image in tiles on the CPU and compares it with the image rendered in one piece; checks the
+  // tile coverage and that the sub-frusta project points where the full frustum does
+  static bool selfTest();
+
+private:
+  Settings               m_settings;
+  std::vector<StillTile> m_tiles;
+  StillCompositor        m_compositor;
+  uint32_t               m_tile  = 0;
+  uint32_t               m_frame = 0;
+};
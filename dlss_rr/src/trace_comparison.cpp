@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "trace_comparison.hpp"
+
+#include <imgui/imgui.h>
+
+#include <nvutils/logger.hpp>
+
+#include <algorithm>
+#include <utility>
+
+
+void TraceComparison::start(uint32_t phases, uint32_t framesPerPhase, uint32_t latency)
+{
+  m_phases         = std::max(phases, 2u) & ~1u;  // as many with as without
+  m_phasesLeft     = m_phases;
+  m_framesPerPhase = std::max(framesPerPhase, latency + 1);
+  m_latency        = latency;
+  m_frame          = 0;
+  std::fill_n(m_sum, 2, 0.0);
+  std::fill_n(m_samples, 2, 0u);
+  if(m_setting)
+  {
+    m_before   = *m_setting;
+    *m_setting = false;
+  }
+}
+
+void TraceComparison::stop()
+{
+  if(running() && m_setting)
+  {
+    *m_setting = m_before;
+  }
+  m_phasesLeft = 0;
+}
+
+bool TraceComparison::advance(double traceMs)
+{
+  if(!running())
+  {
+    return false;
+  }
+
+  // Odd phases left: feature on
+  const bool with = (m_phasesLeft & 1) != 0;
+  if(m_frame >= m_latency)
+  {
+    m_sum[with] += traceMs;
+    m_samples[with]++;
+  }
+  if(++m_frame == m_framesPerPhase)
+  {
+    m_frame = 0;
+    m_phasesLeft--;
+  }
+  return running() && (m_phasesLeft & 1) != 0;
+}
+
+void TraceComparison::endFrame(double traceMs)
+{
+  if(!running())
+  {
+    return;
+  }
+  const bool with = advance(traceMs);
+  if(m_setting)
+  {
+    *m_setting = running() ? with : m_before;
+  }
+  if(!running() && (average(false) > 0.0 || average(true) > 0.0))
+  {
+    LOGI("%s comparison: %.*f %s %s, %.*f %s %s, %.1f%% saved\n", m_labels.name.c_str(), precision(), average(false),
+         m_labels.unit.c_str(), m_labels.without.c_str(), precision(), average(true), m_labels.unit.c_str(),
+         m_labels.with.c_str(), savings() * 100.0);
+  }
+}
+
+double TraceComparison::savings() const
+{
+  const double without = average(false);
+  return (without > 0.0 && m_samples[1] > 0) ? 1.0 - average(true) / without : 0.0;
+}
+
+float TraceComparison::progress() const
+{
+  return m_phases ? float(m_phases - m_phasesLeft) / float(m_phases) : 0.0f;
+}
+
+bool TraceComparison::onUI() const
+{
+  bool pressed = false;
+  if(!running())
+  {
+    pressed = ImGui::Button(("Compare Trace Time##" + m_labels.name).c_str());
+  }
+  else
+  {
+    ImGui::ProgressBar(progress());
+  }
+  resultUI();
+  return pressed;
+}
+
+void TraceComparison::resultUI() const
+{
+  if(average(true) <= 0.0)
+  {
+    return;
+  }
+  ImGui::Text("%s: %.*f %s %s, %.*f %s %s (%.1f%% saved)", m_labels.measure.c_str(), precision(), average(false),
+              m_labels.unit.c_str(), m_labels.without.c_str(), precision(), average(true), m_labels.unit.c_str(),
+              m_labels.with.c_str(), savings() * 100.0);
+}
+
+nlohmann::json TraceComparison::toJson() const
+{
+  if(m_labels.unit == "ms")
+  {
+    return {{"without_ms", average(false)}, {"with_ms", average(true)}, {"savings", savings()}};
+  }
+  return {{"unit", m_labels.unit}, {"without_mean", average(false)}, {"with_mean", average(true)}, {"savings", savings()}};
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <tinygltf/json.hpp>
+
+#include <cstdint>
+#include <string>
+
+
+// A/B measurement of the ray tracing time without and with a feature, e.g. LODs. Phases of 'framesPerPhase' frames
+// alternate between the two, the first 'latency' frames of a phase are skipped: their timings belong to the previous one.
+// A comparison can also be fed with another per frame cost, e.g. shader clocks, named by its unit.
+//
+// Bound to the setting it alternates, the comparison turns it off at start(), sets it in endFrame() and restores it
+// when done; unbound ones are advanced alongside a bound one.
+class TraceComparison
+{
+public:
+  struct Labels
+  {
+    std::string name;     // in the log, e.g. "LOD"
+    std::string measure;  // in the UI, e.g. "Raytrace"
+    std::string without;  // both settings, e.g. "without" and "with LODs"
+    std::string with;
+    std::string unit = "ms";
+  };
+
+  explicit TraceComparison(Labels labels, bool* setting = nullptr)
+      : m_labels(std::move(labels))
+      , m_setting(setting)
+  {
+  }
+
+  void start(uint32_t phases, uint32_t framesPerPhase, uint32_t latency);
+  void stop();  // restores the setting
+
+  // Call once per frame with the last trace time (or cost in the unit); returns whether the next frame uses the feature
+  bool advance(double traceMs);
+  // advance() that also sets the bound setting for the next frame, and restores it and logs the result at the end
+  void endFrame(double traceMs);
+
+  bool   running() const { return m_phasesLeft > 0; }
+  double average(bool with) const { return m_samples[with] ? m_sum[with] / double(m_samples[with]) : 0.0; }  // in the unit
+  double savings() const;  // fraction of the cost without, 0 when not measured
+  float  progress() const;
+
+  // "Compare Trace Time" button or the progress bar, then the result; returns whether the button was pressed
+  bool onUI() const;
+  void resultUI() const;
+
+  // Trace times as "without_ms"/"with_ms", other units as "without_mean"/"with_mean" and "unit"
+  nlohmann::json toJson() const;
+
+private:
+  int precision() const { return m_labels.unit == "ms" ? 3 : 0; }  // digits of the averages
+
+  Labels m_labels;
+  bool*  m_setting = nullptr;
+  bool   m_before  = false;  // the setting at start()
+
+  uint32_t m_phases         = 0;
+  uint32_t m_phasesLeft     = 0;
+  uint32_t m_framesPerPhase = 0;
+  uint32_t m_latency        = 0;
+  uint32_t m_frame          = 0;  // in the current phase
+  double   m_sum[2]         = {};
+  uint32_t m_samples[2]     = {};
+};